@@ -622,6 +622,8 @@ set(all_dependencies ${onnxruntime_test_providers_dependencies} )
   # the default logger tests conflict with the need to have an overall default logger
   # so skip in this type of
   target_compile_definitions(onnxruntime_test_all PUBLIC -DSKIP_DEFAULT_LOGGER_TESTS)
+  # the node capture tests parse the captured JSON
+  target_include_directories(onnxruntime_test_all PRIVATE ${PROJECT_SOURCE_DIR}/external/json)
   if (CMAKE_SYSTEM_NAME STREQUAL "iOS")
     target_compile_definitions(onnxruntime_test_all_xc PUBLIC -DSKIP_DEFAULT_LOGGER_TESTS)
   endif()
@@ -782,6 +784,23 @@ if(onnxruntime_BUILD_BENCHMARKS)
   target_link_libraries(onnxruntime_benchmark PRIVATE onnx_test_runner_common benchmark::benchmark ${onnx_test_libs})
   add_dependencies(onnxruntime_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
   set_target_properties(onnxruntime_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
+
+  file(GLOB onnxruntime_kernel_benchmark_src CONFIGURE_DEPENDS
+    "${TEST_SRC_DIR}/kernel_benchmark/*.h"
+    "${TEST_SRC_DIR}/kernel_benchmark/*.cc"
+  )
+  add_executable(onnxruntime_kernel_benchmark ${onnxruntime_kernel_benchmark_src})
+  target_include_directories(onnxruntime_kernel_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header} ${ONNXRUNTIME_ROOT}/core/mlas/inc
+                             ${PROJECT_SOURCE_DIR}/external/json)
+  if(WIN32)
+    target_compile_options(onnxruntime_kernel_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:-Xcompiler /wd4141>"
+                      "$<$<NOT:$<COMPILE_LANGUAGE:CUDA>>:/wd4141>")
+    target_compile_options(onnxruntime_kernel_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:SHELL:--compiler-options /utf-8>"
+            "$<$<NOT:$<COMPILE_LANGUAGE:CUDA>>:/utf-8>")
+  endif()
+  target_link_libraries(onnxruntime_kernel_benchmark PRIVATE benchmark::benchmark ${onnx_test_libs})
+  add_dependencies(onnxruntime_kernel_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
+  set_target_properties(onnxruntime_kernel_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
 endif()
 
 if(WIN32)
@@ -192,8 +192,14 @@ class ThreadPool {
   // Parallel sections are only implemented with the Eigen threadpool.
   // They have no effect when using OpenMP.
   //
-  // Parallel sections may not be nested, and may not be used inside
-  // parallel loops.
+  // Parallel sections may not be used inside parallel loops.  A
+  // section entered while another is already active on the same thread
+  // has no effect: loops run in the outer section, and its workers
+  // remain until the outer section ends.  This lets control flow
+  // operators such as Loop and Scan hold a single section across the
+  // execution of their subgraph, with the kernels in it reusing it.
+  // Sections and loops for a thread pool other than the one owning the
+  // active section are not supported and fail with an exception.
 
   class ParallelSection {
   public:
@@ -210,9 +216,7 @@ class ThreadPool {
     // point to avoid a dependence on the Eigen headers.
     std::unique_ptr<ThreadPoolParallelSection, void(*)(ThreadPoolParallelSection*)>
       ps_{nullptr, [](ThreadPoolParallelSection*){}};
-#ifndef _OPENMP
-    ThreadPool *tp_;
-#endif
+    ThreadPool *tp_{nullptr};
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
 
     // Non-owning reference to the current thread's paralel section
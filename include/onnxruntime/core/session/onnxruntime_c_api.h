@@ -1102,6 +1102,21 @@ struct OrtApi {
    * and that's recommended because turning this option on may hurt model accuracy.
    */
   ORT_API2_STATUS(SetGlobalDenormalAsZero, _Inout_ OrtThreadingOptions* tp_options);
+
+  /**
+   * Fill a string tensor from contiguous string contents, the same layout GetStringTensorContent produces.
+   * Strings may contain '\0' chars and need not be null-terminated.
+   * The contents are copied into the tensor, which stores every element as a separate string, so s and offsets
+   * don't need to outlive the call.
+   * \param value A string tensor created from OrtCreateTensor... function.
+   * \param s string contents of all the elements, one after another.
+   * \param s_len total data length in bytes.
+   * \param offsets offset of each element in s, in increasing order. Element i ends where element i + 1 starts,
+   *                the last element ends at s_len.
+   * \param offsets_len number of offsets, must equal the number of elements of the tensor.
+   */
+  ORT_API2_STATUS(FillStringTensorFromContent, _Inout_ OrtValue* value, _In_reads_(s_len) const void* s,
+                  size_t s_len, _In_reads_(offsets_len) const size_t* offsets, size_t offsets_len);
 };
 
 /*
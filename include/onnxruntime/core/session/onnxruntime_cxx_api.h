@@ -455,6 +455,7 @@ struct Value : Base<OrtValue> {
 
   void FillStringTensor(const char* const* s, size_t s_len);
   void FillStringTensorElement(const char* s, size_t index);
+  void FillStringTensorFromContent(const void* s, size_t s_len, const size_t* offsets, size_t offsets_count);
 };
 
 // Represents native memory allocation
@@ -798,6 +798,10 @@ inline void Value::FillStringTensorElement(const char* s, size_t index) {
   ThrowOnError(GetApi().FillStringTensorElement(p_, s, index));
 }
 
+inline void Value::FillStringTensorFromContent(const void* s, size_t s_len, const size_t* offsets, size_t offsets_count) {
+  ThrowOnError(GetApi().FillStringTensorFromContent(p_, s, s_len, offsets, offsets_count));
+}
+
 template <typename T>
 T* Value::GetTensorMutableData() {
   T* out;
@@ -40,3 +40,8 @@ static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save
 // Note that an alternative way not using this option at runtime is to train and export a model without denormals
 // and that's recommended because turning this option on may hurt model accuracy.
 static const char* const kOrtSessionOptionsConfigSetDenormalAsZero = "session.set_denormal_as_zero";
+
+// Path of a file the op type, attributes, input types and shapes and kernel time of every executed node are recorded
+// into, as JSON. The file is written when the session is destroyed. Recording is disabled if unset (the default).
+// Use onnxruntime_kernel_benchmark --capture=<file> to replay the recorded nodes in isolation with synthetic data.
+static const char* const kOrtSessionOptionsConfigNodeCaptureFile = "session.node_capture_file";
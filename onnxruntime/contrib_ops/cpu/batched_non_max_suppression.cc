@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/batched_non_max_suppression.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    BatchedNonMaxSuppression,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder(),
+    BatchedNonMaxSuppression);
+
+namespace {
+
+struct Detection {
+  float score;
+  int64_t class_index;
+  int64_t box_index;
+};
+
+// Orders by decreasing score, then by increasing class and box index.
+bool GreaterDetection(const Detection& lhs, const Detection& rhs) {
+  if (lhs.score != rhs.score) {
+    return lhs.score > rhs.score;
+  }
+  return lhs.class_index < rhs.class_index ||
+         (lhs.class_index == rhs.class_index && lhs.box_index < rhs.box_index);
+}
+
+}  // namespace
+
+Status BatchedNonMaxSuppression::Compute(OpKernelContext* context) const {
+  PrepareContext pc;
+  ORT_RETURN_IF_ERROR(PrepareCompute(context, pc));
+
+  // without max_output_boxes_per_class, the classes are only limited by max_total_boxes
+  int64_t max_output_boxes_per_class = max_total_boxes_;
+  float iou_threshold = .0f;
+  float score_threshold = .0f;
+  ORT_RETURN_IF_ERROR(GetThresholdsFromInputs(pc, max_output_boxes_per_class, iou_threshold, score_threshold));
+  max_output_boxes_per_class = std::min(max_output_boxes_per_class, max_total_boxes_);
+
+  const int64_t num_batches = pc.num_batches_;
+  Tensor* num_selected = context->Output(0, {num_batches});
+  Tensor* selected_boxes = context->Output(1, {num_batches, max_total_boxes_, 4});
+  Tensor* selected_scores = context->Output(2, {num_batches, max_total_boxes_});
+  Tensor* selected_classes = context->Output(3, {num_batches, max_total_boxes_});
+  Tensor* selected_indices = context->Output(4, {num_batches, max_total_boxes_});
+
+  auto* num_selected_data = num_selected->MutableData<int64_t>();
+  auto* selected_boxes_data = selected_boxes->MutableData<float>();
+  auto* selected_scores_data = selected_scores->MutableData<float>();
+  auto* selected_classes_data = selected_classes->MutableData<int64_t>();
+  auto* selected_indices_data = selected_indices == nullptr ? nullptr : selected_indices->MutableData<int64_t>();
+
+  // padding
+  std::fill_n(selected_boxes_data, selected_boxes->Shape().Size(), 0.f);
+  std::fill_n(selected_scores_data, selected_scores->Shape().Size(), 0.f);
+  std::fill_n(selected_classes_data, selected_classes->Shape().Size(), int64_t{-1});
+  if (selected_indices_data != nullptr) {
+    std::fill_n(selected_indices_data, selected_indices->Shape().Size(), int64_t{-1});
+  }
+
+  std::vector<std::vector<int64_t>> selected_boxes_per_class;
+  if (max_output_boxes_per_class > 0) {
+    ComputeSelectedBoxes(pc, GetCenterPointBox(), max_output_boxes_per_class, iou_threshold, score_threshold,
+                         context->GetOperatorThreadPool(), selected_boxes_per_class);
+  }
+
+  std::vector<Detection> detections;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    detections.clear();
+    for (int64_t class_index = 0; class_index < pc.num_classes_ && max_output_boxes_per_class > 0; ++class_index) {
+      const auto pair_index = batch_index * pc.num_classes_ + class_index;
+      const float* class_scores = pc.scores_data_ + pair_index * pc.num_boxes_;
+      for (int64_t box_index : selected_boxes_per_class[static_cast<size_t>(pair_index)]) {
+        detections.push_back({class_scores[box_index], class_index, box_index});
+      }
+    }
+
+    const auto count = std::min(static_cast<int64_t>(detections.size()), max_total_boxes_);
+    std::partial_sort(detections.begin(), detections.begin() + count, detections.end(), GreaterDetection);
+
+    num_selected_data[batch_index] = count;
+    const float* batch_boxes = pc.boxes_data_ + batch_index * pc.num_boxes_ * 4;
+    const int64_t output_offset = batch_index * max_total_boxes_;
+    for (int64_t i = 0; i < count; ++i) {
+      const auto& detection = detections[static_cast<size_t>(i)];
+      std::copy_n(batch_boxes + detection.box_index * 4, 4, selected_boxes_data + (output_offset + i) * 4);
+      selected_scores_data[output_offset + i] = detection.score;
+      selected_classes_data[output_offset + i] = detection.class_index;
+      if (selected_indices_data != nullptr) {
+        selected_indices_data[output_offset + i] = detection.box_index;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
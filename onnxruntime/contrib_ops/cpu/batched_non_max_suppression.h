@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/object_detection/non_max_suppression.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// NonMaxSuppression that keeps the max_total_boxes highest scoring boxes of each batch over all classes and emits
+// them in outputs padded to a fixed size.
+class BatchedNonMaxSuppression final : public OpKernel, public NonMaxSuppressionBase {
+ public:
+  explicit BatchedNonMaxSuppression(const OpKernelInfo& info) : OpKernel(info), NonMaxSuppressionBase(info) {
+    ORT_ENFORCE(info.GetAttr<int64_t>("max_total_boxes", &max_total_boxes_).IsOK());
+    ORT_ENFORCE(max_total_boxes_ >= 0, "max_total_boxes must not be negative");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t max_total_boxes_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -66,12 +67,8 @@ class AttentionCPUBase : public AttentionBase {
                              batch_size, sequence_length, past_sequence_length, head_size,
                              past_data, present_data, tp);
 
-    // Compute the attentionScore * Value. It does: out_tmp(B, N, S, H) = attention_probs(B, N, S, S*) x V(B, N, S*, H)
-    auto out_tmp_data =
-        allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * sizeof(T));
-    BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-
-    ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs), V,
+    // Compute the attentionScore * Value. It does: out(B, S, N, H) = attention_probs(B, N, S, S*) x V(B, N, S*, H)
+    ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(attention_probs), V,
                             batch_size, sequence_length, past_sequence_length, head_size, hidden_size,
                             past_data, present_data, tp);
 
@@ -105,43 +102,47 @@ class AttentionCPUBase : public AttentionBase {
     {
       if (mask_data != nullptr) {
         PrepareMask(mask_index, mask_index_dims, mask_data, is_unidirectional_, batch_size, sequence_length, past_sequence_length);
-      } else {  // no any mask
-        memset(attention_probs, 0, batch_size * num_heads_ * sequence_length * all_sequence_length * sizeof(T));
       }
 
       const int loop_len = batch_size * num_heads_;
       const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size * sequence_length * all_sequence_length);
-
-      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-        for (std::ptrdiff_t i = begin; i != end; ++i) {
-          const std::ptrdiff_t batch_index = i / num_heads_;
-
-          // broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
-          if (mask_data != nullptr) {
-            const T* broadcast_data_src = reinterpret_cast<T*>(mask_data) + batch_index * sequence_length * all_sequence_length;
-            T* broadcast_data_dest = reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i;
-            memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * all_sequence_length * sizeof(T));
-          }
-
-          const T* k = K + input_chunk_length * i;
-          if (nullptr != present) {
-            // concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-            k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+      if (mask_data != nullptr || present != nullptr) {
+        // The cost of copying the mask and the present state
+        const double cost = static_cast<double>(sequence_length * all_sequence_length + present_chunk_length);
+
+        ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const std::ptrdiff_t batch_index = i / num_heads_;
+
+            // broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
+            if (mask_data != nullptr) {
+              const T* broadcast_data_src = reinterpret_cast<T*>(mask_data) + batch_index * sequence_length * all_sequence_length;
+              T* broadcast_data_dest = reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i;
+              memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * all_sequence_length * sizeof(T));
+            }
+
+            if (nullptr != present) {
+              // concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+              ConcatStateChunk(past, K + input_chunk_length * i, present, past_chunk_length, present_chunk_length, i);
+            }
           }
+        });
+      }
 
-          // gemm
-          //                     original                 transposed             each iteration
-          // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
-          // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
-          // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
-                                    Q + input_chunk_length * i, k, 1.0,
-                                    reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i, nullptr);
-        }
-      });
+      // batched gemm over all of the heads
+      //                     original                 transposed             each matrix
+      // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
+      // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
+      // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
+      const T* k = (nullptr != present) ? present : K;
+      const size_t k_chunk_length = (nullptr != present) ? present_chunk_length : input_chunk_length;
+      MlasGemmBatch(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
+                    Q, head_size, input_chunk_length,
+                    k, head_size, k_chunk_length,
+                    mask_data != nullptr ? 1.0f : 0.0f,
+                    attention_probs, all_sequence_length, sequence_length * all_sequence_length,
+                    loop_len, tp);
     }
 
     //  attention_probs(B, N, S, S*) = Softmax(attention_probs)
@@ -154,7 +155,6 @@ class AttentionCPUBase : public AttentionBase {
 
   template <typename T>
   void ComputeVxAttentionScore(T* output,                 // buffer for the result with size BxSxNxH
-                               T* tmp_buffer,             // buffer for temp use with size is BxNxSxH
                                const T* attention_probs,  // Attention probs with size BxNxSxS*
                                const T* V,                // V value with size BxNxSxH
                                int batch_size,            // batch size
@@ -178,35 +178,41 @@ class AttentionCPUBase : public AttentionBase {
       present += batch_size * num_heads_ * all_sequence_length * head_size;
     }
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(sequence_length);
+    const int loop_len = batch_size * num_heads_;
 
-    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const T* v = V + input_chunk_length * i;
-        if (nullptr != present) {
+    if (nullptr != present) {
+      const double cost = static_cast<double>(present_chunk_length);
+
+      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
           // concatenate past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-          v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+          ConcatStateChunk(past, V + input_chunk_length * i, present, past_chunk_length, present_chunk_length, i);
         }
+      });
+    }
 
-        T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + input_chunk_length * i;
-        math::MatMul<T>(sequence_length, head_size, all_sequence_length,
-                        attention_probs + sequence_length * all_sequence_length * i,
-                        v, current_tmp_data, nullptr);
-
-        // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-        const int batch_index = static_cast<int>(i / num_heads_);
-        const int head_index = static_cast<int>(i % num_heads_);
-        T* src = current_tmp_data;
-        T* dest = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-        const auto bytes_to_copy = SafeInt<size_t>(head_size) * sizeof(T);
-        for (int j = 0; j < sequence_length; j++) {
-          memcpy(dest, src, bytes_to_copy);
-          src += head_size;
-          dest += hidden_size;
-        }
-      }
-    });
+    // batched gemm over all of the heads, which also does the transpose
+    //                     original                 each matrix
+    // A: attention_probs  (B x N x) S x S*         S x S*
+    // B: V                (B x N x) S* x H         S* x H
+    // C: output           (B x S x N x) H          S x H (with leading dimension NH)
+    const T* v = (nullptr != present) ? present : V;
+    const size_t v_chunk_length = (nullptr != present) ? present_chunk_length : input_chunk_length;
+
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(static_cast<size_t>(loop_len));
+    for (int i = 0; i < loop_len; i++) {
+      const int batch_index = i / num_heads_;
+      const int head_index = i % num_heads_;
+      data[i].A = attention_probs + sequence_length * all_sequence_length * static_cast<size_t>(i);
+      data[i].lda = all_sequence_length;
+      data[i].B = v + v_chunk_length * i;
+      data[i].ldb = head_size;
+      data[i].C = output + (static_cast<size_t>(batch_index) * sequence_length * num_heads_ + head_index) * head_size;
+      data[i].ldc = hidden_size;
+    }
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, head_size, all_sequence_length, 1.0f,
+                  data.data(), data.size(), 0.0f, tp);
   }
 };
 
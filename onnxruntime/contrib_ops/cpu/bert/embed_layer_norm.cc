@@ -3,9 +3,10 @@
 
 #include "embed_layer_norm.h"
 #include "embed_layer_norm_helper.h"
-#include "core/util/math_cpuonly.h"
+#include "contrib_ops/cpu/layer_norm_helper.h"
 #include "core/platform/threadpool.h"
 
+#include <algorithm>
 #include <atomic>
 
 namespace onnxruntime {
@@ -97,25 +98,10 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
       const T* input_position_embedding = position_embedding_data + position_col_index * hidden_size;
       const T* input_segment_embedding = (nullptr == segment_embedding_data) ? nullptr : segment_embedding_data + segment_col_index * hidden_size;
 
-      T sum = static_cast<T>(0);
-      for (int i = 0; i < hidden_size; i++) {
-        T subtotal = input_word_embedding[i] + input_position_embedding[i];
-        if (nullptr != segment_embedding_data)
-          subtotal += input_segment_embedding[i];
-        y[i] = subtotal;
-        sum += subtotal;
-      }
-      T mean = sum / hidden_size;
-      sum = 0;
-      for (int i = 0; i < hidden_size; i++) {
-        T a = y[i] - mean;
-        y[i] = a;
-        sum += a * a;
-      }
-      T e = sqrt(sum / hidden_size + static_cast<T>(epsilon_));
-      for (int i = 0; i < hidden_size; i++) {
-        y[i] = y[i] / e * gamma_data[i] + beta_data[i];
-      }
+      // the position and segment embeddings take the place of the skip and bias rows
+      layer_norm::ComputeRows(input_word_embedding, input_position_embedding, input_segment_embedding, gamma_data,
+                              beta_data, y, static_cast<T*>(nullptr), static_cast<T*>(nullptr),
+                              static_cast<T*>(nullptr), 1, hidden_size, epsilon_, false, nullptr);
     }, 0);
 
     if (failed.load(std::memory_order_acquire)) {
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cmath>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace layer_norm {
+
+// Normalizes `count` rows of `size` elements, where each row is x = input + skip + bias:
+//   y = (x - mean(x)) * inv_std_dev * gamma + beta, or
+//   y = x * inv_rms * gamma + beta when simplified.
+// skip (count x size), bias, beta, sum_output (receives x), mean and inv_std_dev (count) are optional.
+// The mean is 0 when simplified.
+template <typename T, typename U>
+void ComputeRows(const T* input, const T* skip, const T* bias, const T* gamma, const T* beta,
+                 T* output, T* sum_output, U* mean, U* inv_std_dev,
+                 int64_t count, int64_t size, float epsilon, bool simplified,
+                 concurrency::ThreadPool* thread_pool) {
+  concurrency::ThreadPool::TryBatchParallelFor(thread_pool, static_cast<int32_t>(count), [&](ptrdiff_t task_idx) {
+    const T* p_input = input + task_idx * size;
+    const T* p_skip = skip == nullptr ? nullptr : skip + task_idx * size;
+    T* p_output = output + task_idx * size;
+    T* p_sum = sum_output == nullptr ? p_output : sum_output + task_idx * size;
+
+    T row_mean = 0;
+    T mean_square = 0;
+
+    for (int64_t h = 0; h < size; h++) {
+      T value = p_input[h];
+      if (p_skip != nullptr) {
+        value += p_skip[h];
+      }
+      if (bias != nullptr) {
+        value += bias[h];
+      }
+      p_sum[h] = value;
+      row_mean += value;
+      mean_square += value * value;
+    }
+
+    if (simplified) {
+      row_mean = 0;
+      mean_square = std::sqrt(mean_square / size + epsilon);
+    } else {
+      row_mean = row_mean / size;
+      mean_square = std::sqrt(mean_square / size - row_mean * row_mean + epsilon);
+    }
+
+    for (int64_t h = 0; h < size; h++) {
+      T value = (p_sum[h] - row_mean) / mean_square * gamma[h];
+      if (beta != nullptr) {
+        value += beta[h];
+      }
+      p_output[h] = value;
+    }
+
+    if (mean != nullptr) {
+      mean[task_idx] = static_cast<U>(row_mean);
+    }
+    if (inv_std_dev != nullptr) {
+      inv_std_dev[task_idx] = static_cast<U>(1 / mean_square);
+    }
+  }, 0);
+}
+
+// float rows use the fused MLAS kernel, which partitions the rows over the thread pool itself.
+inline void ComputeRows(const float* input, const float* skip, const float* bias, const float* gamma,
+                        const float* beta, float* output, float* sum_output, float* mean, float* inv_std_dev,
+                        int64_t count, int64_t size, float epsilon, bool simplified,
+                        concurrency::ThreadPool* thread_pool) {
+  MlasLayerNormalization(input, skip, bias, gamma, beta, output, sum_output, mean, inv_std_dev,
+                         static_cast<size_t>(count), static_cast<size_t>(size), epsilon, simplified, thread_pool);
+}
+
+}  // namespace layer_norm
+}  // namespace contrib
+}  // namespace onnxruntime
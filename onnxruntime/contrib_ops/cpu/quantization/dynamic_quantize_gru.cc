@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/rnn/gru_base.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using namespace rnn::detail;
+
+class DynamicQuantizeGRU : public OpKernel, public GRUBase {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
+
+#ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+#endif
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DynamicQuantizeGRU() override = default;
+
+ private:
+#ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+  bool TryPackWeights(const Tensor& weights, size_t col_offset, size_t N, PackedWeights& packed_weights);
+#endif
+
+  Status ValidateQuantizationParameter(const Tensor& scale, const Tensor& zero_point, bool is_weight_signed,
+                                       const char* weight_name) const;
+
+  PackedWeights packed_W_;
+  PackedWeights packed_R_zr_;
+  PackedWeights packed_R_h_;
+  bool is_W_signed_{};
+  bool is_R_signed_{};
+};
+
+#ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+bool DynamicQuantizeGRU::TryPackWeights(const Tensor& weights, size_t col_offset, size_t N,
+                                        PackedWeights& packed_weights) {
+  // weights: [num_directions, input_size, 3*hidden_size]
+  // recurrence weights: [num_directions, hidden_size, 3*hidden_size]
+  const auto& shape = weights.Shape();
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t ldb = static_cast<size_t>(shape[2]);
+
+  const bool is_weight_signed = weights.IsDataType<int8_t>();
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, is_weight_signed);
+  if (packed_weights_size == 0) {
+    return false;
+  }
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
+  packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw()) + col_offset;
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(N, K, weights_data, ldb, is_weight_signed, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += ldb * K;
+  }
+
+  return true;
+}
+
+Status DynamicQuantizeGRU::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  if (input_idx != 1 && input_idx != 2) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 3 || shape[0] != num_directions_ || shape[2] != 3 * hidden_size_) {
+    return Status::OK();
+  }
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  if (input_idx == 1) {
+    is_packed = TryPackWeights(tensor, 0, 3 * hidden_size, packed_W_);
+    is_W_signed_ = tensor.IsDataType<int8_t>();
+  } else {
+    // R[zr] and R[h] are applied by separate GEMMs in each step so they are packed separately
+    is_packed = TryPackWeights(tensor, 0, 2 * hidden_size, packed_R_zr_) &&
+                TryPackWeights(tensor, 2 * hidden_size, hidden_size, packed_R_h_);
+    if (!is_packed) {
+      packed_R_zr_.buffer_.reset();
+      packed_R_h_.buffer_.reset();
+    }
+    is_R_signed_ = tensor.IsDataType<int8_t>();
+  }
+
+  return Status::OK();
+}
+#endif
+
+Status DynamicQuantizeGRU::ValidateQuantizationParameter(const Tensor& scale,
+                                                         const Tensor& zero_point,
+                                                         bool is_weight_signed,
+                                                         const char* weight_name) const {
+  for (const auto* shape : {&scale.Shape(), &zero_point.Shape()}) {
+    if ((shape->NumDimensions() != 1 && shape->NumDimensions() != 2) ||
+        (shape->NumDimensions() == 2 && (*shape)[1] != hidden_size_ * 3) ||
+        (*shape)[0] != num_directions_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Quantization parameters of input ", weight_name, " must have shape {", num_directions_,
+                             "} for per-tensor/layer quantization or shape {", num_directions_, ", 3*", hidden_size_,
+                             "} for per-channel quantization. Actual:", *shape);
+    }
+  }
+
+  if (scale.Shape() != zero_point.Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", weight_name,
+                           " scale and zero point must have the same shape");
+  }
+
+  // the GEMM applies a single zero point per direction
+  if (zero_point.Shape().NumDimensions() == 2) {
+    const int64_t zp_size_per_direction = zero_point.Shape()[1];
+    const uint8_t* zp_data = static_cast<const uint8_t*>(zero_point.DataRaw());
+    for (int64_t dir = 0; dir < num_directions_; dir++, zp_data += zp_size_per_direction) {
+      for (int64_t i = 0; i < zp_size_per_direction; i++) {
+        if (is_weight_signed ? zp_data[i] != 0 : zp_data[i] != zp_data[0]) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", weight_name,
+                                 is_weight_signed ? " weight zero point must be zero"
+                                                  : " weight zero point must be constant");
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
+
+  // weights. [num_directions, input_size, 3*hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
+  // recurrence weights. [num_directions, hidden_size, 3*hidden_size]
+  const Tensor* R = packed_R_zr_.buffer_ ? nullptr : context->Input<Tensor>(2);
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_zr_.shape_;
+
+  // optional
+  const auto* B = context->Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
+  const auto* sequence_lens = context->Input<Tensor>(4);  // [batch_size]
+  const auto* initial_h = context->Input<Tensor>(5);      // initial hidden. [num_directions, batch_size, hidden_size]
+
+  if (W_shape.NumDimensions() != 3 || R_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W and R must have 3 dimensions. Actual:",
+                           W_shape, " and ", R_shape);
+  }
+
+  // the quantized weights are stored as [num_directions, K, 3*hidden_size] so validate the transposed shapes
+  ORT_RETURN_IF_ERROR(ValidateCommonRnnInputs(X,
+                                              TensorShape({W_shape[0], W_shape[2], W_shape[1]}),
+                                              TensorShape({R_shape[0], R_shape[2], R_shape[1]}),
+                                              B, 3, sequence_lens, initial_h, num_directions_, hidden_size_));
+
+  const Tensor* w_scale = context->Input<Tensor>(6);
+  const Tensor* w_zp = context->Input<Tensor>(7);
+  const Tensor* r_scale = context->Input<Tensor>(8);
+  const Tensor* r_zp = context->Input<Tensor>(9);
+
+  const bool is_W_signed = (W != nullptr) ? W->IsDataType<int8_t>() : is_W_signed_;
+  const bool is_R_signed = (R != nullptr) ? R->IsDataType<int8_t>() : is_R_signed_;
+
+  ORT_RETURN_IF_ERROR(ValidateQuantizationParameter(*w_scale, *w_zp, is_W_signed, "W"));
+  ORT_RETURN_IF_ERROR(ValidateQuantizationParameter(*r_scale, *r_zp, is_R_signed, "R"));
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  const bool is_W_per_channel = w_scale->Shape().NumDimensions() == 2;
+  const bool is_R_per_channel = r_scale->Shape().NumDimensions() == 2;
+  const size_t W_scale_size = is_W_per_channel ? 3 * hidden_size : 1;
+  const size_t R_scale_size = is_R_per_channel ? 3 * hidden_size : 1;
+
+  const float* w_scale_data = w_scale->Data<float>();
+  const uint8_t* w_zp_data = static_cast<const uint8_t*>(w_zp->DataRaw());
+  const float* r_scale_data = r_scale->Data<float>();
+  const uint8_t* r_zp_data = static_cast<const uint8_t*>(r_zp->DataRaw());
+
+  // per-channel scales of R are split along with R so R[zr] and R[h] each see their own columns
+  const size_t R_h_scale_offset = is_R_per_channel ? 2 * hidden_size : 0;
+  const size_t R_zr_scale_size = is_R_per_channel ? 2 * hidden_size : 1;
+  const size_t R_h_scale_size = is_R_per_channel ? hidden_size : 1;
+
+  std::vector<QuantizationParameter> quant_para_W;
+  std::vector<QuantizationParameter> quant_para_R_zr;
+  std::vector<QuantizationParameter> quant_para_R_h;
+  quant_para_W.reserve(num_directions_);
+  quant_para_R_zr.reserve(num_directions_);
+  quant_para_R_h.reserve(num_directions_);
+  for (int dir = 0; dir < num_directions_; dir++) {
+    // zero_point and scale have same size
+    quant_para_W.emplace_back(w_scale_data + dir * W_scale_size, w_zp_data + dir * W_scale_size,
+                              is_W_signed, W_scale_size);
+    quant_para_R_zr.emplace_back(r_scale_data + dir * R_scale_size, r_zp_data + dir * R_scale_size,
+                                 is_R_signed, R_zr_scale_size);
+    quant_para_R_h.emplace_back(r_scale_data + dir * R_scale_size + R_h_scale_offset,
+                                r_zp_data + dir * R_scale_size + R_h_scale_offset,
+                                is_R_signed, R_h_scale_size);
+  }
+
+  const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
+
+  // the non-prepacked GEMM needs contiguous weights, so split R into R[zr] and R[h] if it wasn't prepacked
+  const uint8_t* R_zr_data = nullptr;
+  const uint8_t* R_h_data = nullptr;
+  IAllocatorUniquePtr<uint8_t> R_split_buffer;
+  if (R != nullptr) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+    const size_t R_zr_size = SafeInt<size_t>(num_directions_) * hidden_size * 2 * hidden_size;
+    const size_t R_h_size = SafeInt<size_t>(num_directions_) * hidden_size * hidden_size;
+    R_split_buffer = IAllocator::MakeUniquePtr<uint8_t>(alloc, R_zr_size + R_h_size);
+
+    uint8_t* R_zr_dst = R_split_buffer.get();
+    uint8_t* R_h_dst = R_zr_dst + R_zr_size;
+    const uint8_t* R_src = static_cast<const uint8_t*>(R->DataRaw());
+    for (size_t row = 0; row < num_directions_ * hidden_size; row++) {
+      R_zr_dst = std::copy_n(R_src, 2 * hidden_size, R_zr_dst);
+      R_h_dst = std::copy_n(R_src + 2 * hidden_size, hidden_size, R_h_dst);
+      R_src += 3 * hidden_size;
+    }
+
+    R_zr_data = R_split_buffer.get();
+    R_h_data = R_split_buffer.get() + R_zr_size;
+  }
+
+  // spans for first direction
+  const size_t W_size_per_direction = W_shape[1] * W_shape[2];
+  const size_t R_zr_size_per_direction = hidden_size * 2 * hidden_size;
+  const size_t R_h_size_per_direction = hidden_size * hidden_size;
+
+  GemmWeights<uint8_t> W_1(0, W_data, W_size_per_direction, packed_W_, &quant_para_W[0]);
+  GemmWeights<uint8_t> R_zr_1(0, R_zr_data, R_zr_size_per_direction, packed_R_zr_, &quant_para_R_zr[0]);
+  GemmWeights<uint8_t> R_h_1(0, R_h_data, R_h_size_per_direction, packed_R_h_, &quant_para_R_h[0]);
+
+  GemmWeights<uint8_t> W_2;
+  GemmWeights<uint8_t> R_zr_2;
+  GemmWeights<uint8_t> R_h_2;
+  if (direction_ == Direction::kBidirectional) {
+    W_2.Init(1, W_data, W_size_per_direction, packed_W_, &quant_para_W[1]);
+    R_zr_2.Init(1, R_zr_data, R_zr_size_per_direction, packed_R_zr_, &quant_para_R_zr[1]);
+    R_h_2.Init(1, R_h_data, R_h_size_per_direction, packed_R_h_, &quant_para_R_h[1]);
+  }
+
+  return GRUBase::ComputeImpl<uint8_t>(*context, W_1, W_2, R_zr_1, R_zr_2, R_h_1, R_h_2);
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeGRU,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    DynamicQuantizeGRU);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -61,9 +61,12 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
   packed_weights.weights_size_ = packed_weights_size;
   packed_weights.shape_ = shape;
 
+  // the gates are interleaved before packing so each tile of the GEMM output holds complete hidden units
+  std::vector<uint8_t> interleaved_weights(N * K);
   const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
   for (int i = 0; i < num_directions_; i++) {
-    MlasGemmPackB(N, K, weights_data, N, is_weight_signed, packed_weights_data);
+    lstm::InterleaveGates(weights_data, interleaved_weights.data(), hidden_size_, K, 1);
+    MlasGemmPackB(N, K, interleaved_weights.data(), N, is_weight_signed, packed_weights_data);
     packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
     weights_data += N * K;
   }
@@ -147,17 +150,55 @@ Status DynamicQuantizeLSTM::Compute(OpKernelContext* context) const {
   size_t W_scale_size = W_scale_shape.NumDimensions() == 2 ? W_scale_shape[1] : 1;
   size_t R_scale_size = R_scale_shape.NumDimensions() == 2 ? R_scale_shape[1] : 1;
 
-  QuantizationParameter quant_para_W_1(w_scale->Data<float>(),
+  // the columns of the weights have their gates interleaved (see lstm::InterleaveGates), so per-channel scales
+  // need to be interleaved the same way. the zero points are constant per tensor so can be used as is.
+  auto interleave_scale = [&](const Tensor* scale, size_t scale_size, std::vector<float>& interleaved) {
+    if (scale_size != 4 * static_cast<size_t>(hidden_size_)) {
+      return scale->Data<float>();
+    }
+
+    interleaved.resize(num_directions_ * scale_size);
+    lstm::InterleaveGates(scale->Data<float>(), interleaved.data(), hidden_size_, num_directions_, 1);
+    return static_cast<const float*>(interleaved.data());
+  };
+
+  std::vector<float> interleaved_W_scale;
+  std::vector<float> interleaved_R_scale;
+
+  QuantizationParameter quant_para_W_1(interleave_scale(w_scale, W_scale_size, interleaved_W_scale),
                                        static_cast<const uint8_t*>(w_zp->DataRaw()),
                                        is_W_signed,
                                        W_scale_size);
-  QuantizationParameter quant_para_R_1(r_scale->Data<float>(),
+  QuantizationParameter quant_para_R_1(interleave_scale(r_scale, R_scale_size, interleaved_R_scale),
                                        static_cast<const uint8_t*>(r_zp->DataRaw()),
                                        is_R_signed,
                                        R_scale_size);
 
-  const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
-  const uint8_t* R_data = R != nullptr ? static_cast<const uint8_t*>(R->DataRaw()) : nullptr;
+  // weights that were not prepacked still need their gates interleaved.
+  // anything with an unexpected shape is passed through as is to be rejected by the input validation.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto interleave = [&](const Tensor* weights, IAllocatorUniquePtr<uint8_t>& interleaved) -> const uint8_t* {
+    if (weights == nullptr) {
+      return nullptr;
+    }
+
+    const auto& shape = weights->Shape();
+    const auto* weights_data = static_cast<const uint8_t*>(weights->DataRaw());
+    if (shape.NumDimensions() != 3 || shape[2] != 4 * static_cast<int64_t>(hidden_size_)) {
+      return weights_data;
+    }
+
+    interleaved = IAllocator::MakeUniquePtr<uint8_t>(alloc, shape.Size());
+    lstm::InterleaveGates(weights_data, interleaved.get(), hidden_size_, shape[0] * shape[1], 1);
+    return interleaved.get();
+  };
+
+  IAllocatorUniquePtr<uint8_t> interleaved_W;
+  IAllocatorUniquePtr<uint8_t> interleaved_R;
+  const uint8_t* W_data = interleave(W, interleaved_W);
+  const uint8_t* R_data = interleave(R, interleaved_R);
 
   // spans for first direction
   const size_t W_size_per_direction = W_shape[1] * W_shape[2];
@@ -2,9 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
-#include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
-#include "core/platform/threadpool.h"
+#include "layer_norm_helper.h"
 #include "skip_layer_norm.h"
 
 namespace onnxruntime {
@@ -96,32 +95,20 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
 
   T* output_data = output->MutableData<T>();
 
-  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-                                               [&](ptrdiff_t task_idx) {
-                                                 const T* p_input = input_data + task_idx * hidden_size;
-                                                 const T* p_skip = skip_data + task_idx * hidden_size;
-                                                 T* p_output = output_data + task_idx * hidden_size;
-
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
-                                                   }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
-                                                 }
-
-                                                 mean = mean / hidden_size;
-                                                 mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-                                                 }
-                                               }, 0);
+  // optional outputs of the statistics per row and of the input + skip + bias sum
+  TensorShape mean_inv_std_var_shape({batch_size, sequence_length, 1});
+  Tensor* mean = p_ctx->Output(1, mean_inv_std_var_shape);
+  Tensor* inv_std_var = p_ctx->Output(2, mean_inv_std_var_shape);
+  Tensor* skip_input_bias_add_output = p_ctx->Output(3, input->Shape());
+
+  float* mean_data = mean == nullptr ? nullptr : mean->MutableData<float>();
+  float* inv_std_var_data = inv_std_var == nullptr ? nullptr : inv_std_var->MutableData<float>();
+  T* skip_input_bias_add_output_data =
+      skip_input_bias_add_output == nullptr ? nullptr : skip_input_bias_add_output->MutableData<T>();
+
+  layer_norm::ComputeRows(input_data, skip_data, bias_data, gamma_data, beta_data, output_data,
+                          skip_input_bias_add_output_data, mean_data, inv_std_var_data, task_count, hidden_size,
+                          epsilon_, false, p_ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
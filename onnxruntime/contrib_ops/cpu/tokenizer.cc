@@ -5,11 +5,20 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
 
+#include <array>
+#include <cctype>
+
 namespace onnxruntime {
 namespace contrib {
 
+namespace tokenizer_details {
+// Tokens of every input string. The tokens point into the input strings.
+using TokenRows = std::vector<std::vector<re2::StringPiece>>;
+}  // namespace tokenizer_details
+
 class Tokenizer final : public OpKernel {
  public:
   explicit Tokenizer(const OpKernelInfo& info);
@@ -20,20 +29,27 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      const std::vector<int64_t>& input_dims) const;
+  Status CharTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      const std::vector<int64_t>& input_dims) const;
+  Status SeparatorCharTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         const std::vector<int64_t>& input_dims) const;
+  Status SeparatorExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const;
+
+  Status TokenExpression(const std::string& s, std::vector<re2::StringPiece>& row) const;
+
+  void AddToken(const char* data, size_t len, std::vector<re2::StringPiece>& row) const;
+
+  Status OutputTokens(OpKernelContext* ctx, const std::vector<int64_t>& input_dims,
+                      const tokenizer_details::TokenRows& rows) const;
 
   bool mark_{false};
   std::string pad_value_;
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
+  // Set when every separator matches a single ASCII char. The strings are then split
+  // in one pass over their bytes instead of one regex search per separator.
+  bool separator_chars_only_{false};
+  std::array<bool, 256> separator_chars_{};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
   std::unique_ptr<re2::RE2> regex_;
 };
@@ -51,6 +67,62 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
+
+// Returns true if the separator expression matches exactly one ASCII char:
+// either a char that is not a regex meta character or an escaped punctuation char.
+// ASCII bytes never occur within multi byte utf8 sequences, so such separators
+// can be matched byte by byte.
+bool GetSeparatorChar(const std::string& sep, unsigned char& ch) {
+  static const std::string meta_chars("\\^$.|?*+()[]{}");
+  if (sep.size() == 1) {
+    ch = static_cast<unsigned char>(sep[0]);
+    return ch < 0x80 && meta_chars.find(sep[0]) == std::string::npos;
+  }
+  if (sep.size() == 2 && sep[0] == '\\') {
+    ch = static_cast<unsigned char>(sep[1]);
+    return ch < 0x80 && std::ispunct(ch);
+  }
+  return false;
+}
+
+// Approximate cost of tokenizing one input string, for the thread pool to size its batches.
+TensorOpCost TokenizeCost(const std::string* input, size_t count) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total_bytes += input[i].size();
+  }
+  const double bytes = static_cast<double>(total_bytes) / static_cast<double>(count) + 1;
+  return TensorOpCost{bytes, bytes, bytes * 16};
+}
+
+// Tokenizes every input string with tokenize, in parallel across the strings.
+template <class TokenizeFn>
+Status TokenizeStrings(OpKernelContext* ctx, const std::string* input, size_t count,
+                       const TokenizeFn& tokenize, TokenRows& rows) {
+  rows.resize(count);
+  std::vector<Status> statuses(count);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(count), TokenizeCost(input, count),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          statuses[i] = tokenize(input[i], rows[i]);
+        }
+      });
+  // Report the error of the first offending string
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
+Status ValidateUtf8(const std::string& s) {
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
+  }
+  return Status::OK();
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -90,6 +162,16 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   // Check if we have separators or tokenexp
   if (!char_tokenezation_) {
     if (!separators.empty()) {
+      separator_chars_only_ = true;
+      for (const auto& sep : separators) {
+        unsigned char ch = 0;
+        if (GetSeparatorChar(sep, ch)) {
+          separator_chars_[ch] = true;
+        } else {
+          separator_chars_only_ = false;
+        }
+      }
+
       re2::RE2::Options options;
       options.set_longest_match(true);
       for (const auto& sep : separators) {
@@ -113,291 +195,165 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               const std::vector<int64_t>& input_dims) const {
-  // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
+void Tokenizer::AddToken(const char* data, size_t len, std::vector<re2::StringPiece>& row) const {
+  // A token never has more utf8 chars than bytes
+  if (len < size_t(mincharnum_)) {
+    return;
   }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to apparently empty strings input.
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  size_t utf8_chars = 0;
+  utf8_len(reinterpret_cast<const unsigned char*>(data), len, utf8_chars);
+  if (utf8_chars >= size_t(mincharnum_)) {
+    row.emplace_back(data, len);
   }
+}
 
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+Status Tokenizer::CharTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const {
+  // With char tokenzation we get as many tokens as the number of
+  // utf8 characters in the string.
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
+  }
+  row.reserve(utf8_chars);
+  const size_t str_len = s.size();
+  for (size_t token_idx = 0; token_idx < str_len;) {
+    size_t tlen = 0;
+    bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+    assert(result);
+    (void)result;
+    assert(token_idx + tlen <= str_len);
+    row.emplace_back(s.data() + token_idx, tlen);
+    token_idx += tlen;
   }
+  return Status::OK();
+}
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
+Status Tokenizer::SeparatorCharTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const {
+  ORT_RETURN_IF_ERROR(ValidateUtf8(s));
+  const char* const data = s.data();
+  const size_t str_len = s.size();
+  size_t start_pos = 0;
+  for (size_t pos = 0; pos < str_len; ++pos) {
+    if (separator_chars_[static_cast<unsigned char>(data[pos])]) {
+      AddToken(data + start_pos, pos - start_pos, row);
+      start_pos = pos + 1;
     }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
   }
+  // trailing token
+  AddToken(data + start_pos, str_len - start_pos, row);
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::SeparatorExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& row) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
+  ORT_RETURN_IF_ERROR(ValidateUtf8(s));
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    std::vector<StringPiece> row{s};
-
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + submatch.as_string());
-            }
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
+  // Every separator splits the tokens left by the previous ones
+  row.emplace_back(s);
+  std::vector<StringPiece> tokens;
+  for (const auto& sep : separators_) {
+    tokens.clear();
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
+      size_t start_pos = 0;
+      StringPiece submatch;
+
+      bool match = true;
+      do {
+        match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        if (match) {
+          // Record  pos/len
+          assert(submatch.data() != nullptr);
+          size_t match_pos = submatch.data() - text.data();
+          assert(match_pos >= start_pos);
+          auto token_len = match_pos - start_pos;
+          size_t utf8_chars = 0;
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Match contains invalid utf8 chars: " + submatch.as_string());
+          }
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
           } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
+            size_t bytes = 0;
+            utf8_bytes(*submatch.data(), bytes);
+            start_pos = match_pos + bytes;
           }
-        } while (match);
-      }  // row
-      // Replace the row with the results of this tokenezation
-      row.swap(tokens);
-    }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+        } else {
+          // record trailing token
+          AddToken(text.data() + start_pos, end_pos - start_pos, tokens);
+        }
+      } while (match);
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
+    // Replace the row with the results of this tokenezation
+    row.swap(tokens);
   }
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::TokenExpression(const std::string& s, std::vector<re2::StringPiece>& row) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
+  ORT_RETURN_IF_ERROR(ValidateUtf8(s));
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-
-    size_t utf8_chars = 0;
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      // Guard against empty match and make
+      // sure we make progress either way
+      auto token_len = submatch.length();
+      size_t utf8_chars = 0;
+      if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        row.push_back(submatch);
+        start_pos = match_pos + token_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
+      }
     }
+  } while (match);
+  return Status::OK();
+}
 
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    do {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        // Guard against empty match and make
-        // sure we make progress either way
-        auto token_len = submatch.length();
-        utf8_chars = 0;
-        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Match contains invalid utf8 chars: " + submatch.as_string());
-        }
-        if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
-          start_pos = match_pos + token_len;
-        } else {
-          size_t bytes = 0;
-          utf8_bytes(*submatch.data(), bytes);
-          start_pos = match_pos + bytes;
-        }
-      }
-    } while (match);
+Status Tokenizer::OutputTokens(OpKernelContext* ctx, const std::vector<int64_t>& input_dims,
+                               const TokenRows& rows) const {
+  size_t max_tokens = 0;
+  for (const auto& row : rows) {
     max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
   }
 
-  // Check for empty output
   std::vector<int64_t> output_dims(input_dims);
   // Check if we have no output due to either empty input
   // everything is a separator
@@ -418,41 +374,34 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
-  }
-
+  // Every row owns max_tokens output strings so the rows are written in parallel.
+  // The strings are assigned in place, short tokens fit into the small string buffer.
+  const double cost = static_cast<double>(max_tokens) * 8;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows.size()),
+      TensorOpCost{cost, cost, cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t r = first; r < last; ++r) {
+          const auto& row = rows[r];
+          std::string* output = output_data + r * max_tokens;
+          std::string* const row_end = output + max_tokens;
+          if (mark_) {
+            (output++)->assign(&start_text, 1);
+          }
+          // Output tokens for this row
+          for (const auto& token : row) {
+            (output++)->assign(token.data(), token.size());
+          }
+          if (mark_) {
+            (output++)->assign(&end_text, 1);
+          }
+          // Padding strings
+          assert(output <= row_end);
+          while (output != row_end) {
+            *(output++) = pad_value_;
+          }
+        }
+      });
   return Status::OK();
 }
 
@@ -494,16 +443,39 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
     return s;
   }
 
+  auto const input_data = X->template Data<std::string>();
+  const size_t count = N * C;
+  TokenRows rows;
   if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
-  } else {
-    if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
+    s = TokenizeStrings(
+        ctx, input_data, count,
+        [this](const std::string& str, std::vector<re2::StringPiece>& row) { return CharTokenize(str, row); },
+        rows);
+  } else if (!separators_.empty()) {
+    if (separator_chars_only_) {
+      s = TokenizeStrings(
+          ctx, input_data, count,
+          [this](const std::string& str, std::vector<re2::StringPiece>& row) {
+            return SeparatorCharTokenize(str, row);
+          },
+          rows);
     } else {
-      assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
+      s = TokenizeStrings(
+          ctx, input_data, count,
+          [this](const std::string& str, std::vector<re2::StringPiece>& row) {
+            return SeparatorExpressionTokenize(str, row);
+          },
+          rows);
     }
+  } else {
+    assert(regex_ != nullptr);
+    s = TokenizeStrings(
+        ctx, input_data, count,
+        [this](const std::string& str, std::vector<re2::StringPiece>& row) { return TokenExpression(str, row); },
+        rows);
   }
+  ORT_RETURN_IF_ERROR(s);
+  s = OutputTokens(ctx, input_dims, rows);
   return s;
 }
 }  // namespace contrib
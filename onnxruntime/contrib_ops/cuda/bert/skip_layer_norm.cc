@@ -43,6 +43,8 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
   const Tensor* bias = ctx->Input<Tensor>(4);
 
   Tensor* output = ctx->Output(0, input->Shape());
+  // outputs 1 and 2 (mean and inv_std_var) are not produced by this kernel
+  Tensor* skip_input_bias_add_output = ctx->Output(3, input->Shape());
 
   const auto& input_dims = input->Shape().GetDims();
   if (input_dims.size() != 3) {
@@ -94,6 +96,7 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
 
   if (!LaunchSkipLayerNormKernel(
           output->template MutableData<T>(),
+          skip_input_bias_add_output != nullptr ? skip_input_bias_add_output->template MutableData<T>() : nullptr,
           input->template Data<T>(),
           skip->template Data<T>(),
           gamma->template Data<T>(),
@@ -30,8 +30,8 @@ namespace cuda {
 
 template <typename T, unsigned TPB>
 __global__ void SkipLayerNormKernelSmall(
-    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias, 
-    const T epsilon, T* output) {
+    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias,
+    const T epsilon, T* output, T* skip_input_bias_add_output) {
   const T reverse_ld = T(1.f / ld);
   const int offset = blockIdx.x * ld;
 
@@ -43,6 +43,9 @@ __global__ void SkipLayerNormKernelSmall(
 
   if (threadIdx.x < ld) {
     val = (bias == nullptr) ? input[idx] + skip[idx] : input[idx] + skip[idx] + bias[threadIdx.x];
+    if (skip_input_bias_add_output != nullptr) {
+      skip_input_bias_add_output[idx] = val;
+    }
     const T rldval = reverse_ld * val;
     thread_data = pair_sum(thread_data, cub::KeyValuePair<T, T>(rldval, rldval * val));
   }
@@ -52,8 +55,8 @@ __global__ void SkipLayerNormKernelSmall(
 
 template <typename T, unsigned TPB>
 __global__ void SkipLayerNormKernel(
-    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias, 
-    const T epsilon, T* output) {
+    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias,
+    const T epsilon, T* output, T* skip_input_bias_add_output) {
   const T reverse_ld = T(1.f / ld);
   const int offset = blockIdx.x * ld;
 
@@ -64,6 +67,9 @@ __global__ void SkipLayerNormKernel(
   for (int i = threadIdx.x; i < ld; i += TPB) {
     const int idx = offset + i;
     const T val = (bias == nullptr) ? input[idx] + skip[idx] : input[idx] + skip[idx] + bias[i];
+    if (skip_input_bias_add_output != nullptr) {
+      skip_input_bias_add_output[idx] = val;
+    }
     const T rldval = reverse_ld * val;
     thread_data = pair_sum(thread_data, cub::KeyValuePair<T, T>(rldval, rldval * val));
     output[idx] = val;
@@ -75,7 +81,8 @@ __global__ void SkipLayerNormKernel(
 template <typename T>
 bool ComputeSkipLayerNorm(
     cudaStream_t stream, const int ld, const int n, const T* input, const T* skip,
-    const T* beta, const T* gamma, const T* bias, const T epsilon, T* output) {
+    const T* beta, const T* gamma, const T* bias, const T epsilon, T* output,
+    T* skip_input_bias_add_output) {
   // this must be true because n is the total size of the tensor
   assert(n % ld == 0);
   const int grid_size = n / ld;
@@ -83,24 +90,29 @@ bool ComputeSkipLayerNorm(
   if (ld <= 32) {
     constexpr int block_size = 32;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output,
+                                               skip_input_bias_add_output);
   } else if (ld <= 128) {
     constexpr int block_size = 128;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output,
+                                               skip_input_bias_add_output);
   } else if (ld == 384) {
     constexpr int block_size = 384;
     SkipLayerNormKernelSmall<T, block_size>
-        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+        <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output,
+                                               skip_input_bias_add_output);
   } else {
     constexpr int block_size = 256;
-    SkipLayerNormKernel<T, block_size><<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+    SkipLayerNormKernel<T, block_size><<<grid_size, block_size, 0, stream>>>(
+        ld, input, skip, beta, gamma, bias, epsilon, output, skip_input_bias_add_output);
   }
   return CUDA_CALL(cudaPeekAtLastError());
 }
 
 bool LaunchSkipLayerNormKernel(
     void* output,
+    void* skip_input_bias_add_output,
     const void* input,
     const void* skip,
     const void* gamma,
@@ -124,7 +136,8 @@ bool LaunchSkipLayerNormKernel(
         reinterpret_cast<const half*>(gamma),
         reinterpret_cast<const half*>(bias),
         __float2half_rn(epsilon),
-        reinterpret_cast<half*>(output));
+        reinterpret_cast<half*>(output),
+        reinterpret_cast<half*>(skip_input_bias_add_output));
   } else {
     return ComputeSkipLayerNorm(
         stream,
@@ -136,7 +149,8 @@ bool LaunchSkipLayerNormKernel(
         reinterpret_cast<const float*>(gamma),
         reinterpret_cast<const float*>(bias),
         epsilon,
-        reinterpret_cast<float*>(output));
+        reinterpret_cast<float*>(output),
+        reinterpret_cast<float*>(skip_input_bias_add_output));
   }
 }
 
@@ -9,6 +9,7 @@ namespace cuda {
 
 bool LaunchSkipLayerNormKernel(
     void* output,        // output tensor
+    void* skip_input_bias_add_output,  // optional sum of input, skip and bias, may be nullptr
     const void* input,   // input tensor
     const void* skip,    // skip tensor
     const void* gamma,   // Layer normalization gamma tensor
@@ -221,10 +221,14 @@ ThreadPool::ParallelSection::ParallelSection(ThreadPool *tp) {
   // Nothing
   ORT_UNUSED_PARAMETER(tp);
 #else
-  ORT_ENFORCE(!current_parallel_section, "Nested parallelism not supported");
   ORT_ENFORCE(!ps_.get());
   tp_ = tp;
-  if (tp && tp->underlying_threadpool_) {
+  // A section that is already active on this thread is reused: control flow operators enter a section
+  // around the subgraph execution, and the kernels they run (e.g. RNNs) may enter their own.
+  ORT_ENFORCE(!current_parallel_section || !tp || !tp->underlying_threadpool_ ||
+                  current_parallel_section->tp_ == tp,
+              "Nested parallelism across thread pools not supported");
+  if (!current_parallel_section && tp && tp->underlying_threadpool_) {
     ps_ = tp->underlying_threadpool_->AllocateParallelSection();
     tp_->underlying_threadpool_->StartParallelSection(*ps_.get());
     current_parallel_section = this;
@@ -236,7 +240,7 @@ ThreadPool::ParallelSection::~ParallelSection() {
 #ifdef _OPENMP
   // Nothing
 #else
-  if (current_parallel_section) {
+  if (ps_) {
     tp_->underlying_threadpool_->EndParallelSection(*ps_.get());
     ps_.reset();
     current_parallel_section = nullptr;
@@ -246,8 +250,12 @@ ThreadPool::ParallelSection::~ParallelSection() {
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n) {
   if (underlying_threadpool_) {
-    if (ThreadPool::ParallelSection::current_parallel_section) {
-      underlying_threadpool_->RunInParallelSection(*(ThreadPool::ParallelSection::current_parallel_section->ps_.get()),
+    ParallelSection* ps = ThreadPool::ParallelSection::current_parallel_section;
+    // The Eigen pool keeps per-thread state that only allows one active section, so a loop for this pool
+    // cannot start its own section while the thread leads a section of another pool.
+    ORT_ENFORCE(!ps || ps->tp_ == this, "Nested parallelism across thread pools not supported");
+    if (ps) {
+      underlying_threadpool_->RunInParallelSection(*(ps->ps_.get()),
                                                    std::move(fn),
                                                    n);
     } else {
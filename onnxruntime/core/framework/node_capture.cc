@@ -0,0 +1,227 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_capture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// int32 and int64 inputs with at most this many elements have their values recorded.
+constexpr int64_t kMaxRecordedValues = 64;
+
+void WriteString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+              << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+template <typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out << value;
+}
+
+// JSON has no NaN or infinity literals, so those are written as the strings "NaN", "Infinity" and "-Infinity".
+void WriteValue(std::ostream& out, float value) {
+  if (std::isnan(value)) {
+    out << "\"NaN\"";
+  } else if (std::isinf(value)) {
+    out << (value < 0 ? "\"-Infinity\"" : "\"Infinity\"");
+  } else {
+    out << value;
+  }
+}
+
+template <typename Container>
+void WriteArray(std::ostream& out, const Container& values) {
+  out << '[';
+  bool first = true;
+  for (const auto& value : values) {
+    out << (first ? "" : ",");
+    WriteValue(out, value);
+    first = false;
+  }
+  out << ']';
+}
+
+void WriteAttribute(std::ostream& out, const AttributeProto& attribute) {
+  out << "{\"name\":";
+  WriteString(out, attribute.name());
+  out << ",\"type\":" << static_cast<int>(attribute.type());
+  switch (attribute.type()) {
+    case AttributeProto_AttributeType_FLOAT:
+      out << ",\"f\":";
+      WriteValue(out, attribute.f());
+      break;
+    case AttributeProto_AttributeType_INT:
+      out << ",\"i\":" << attribute.i();
+      break;
+    case AttributeProto_AttributeType_STRING:
+      out << ",\"s\":";
+      WriteString(out, attribute.s());
+      break;
+    case AttributeProto_AttributeType_FLOATS:
+      out << ",\"floats\":";
+      WriteArray(out, attribute.floats());
+      break;
+    case AttributeProto_AttributeType_INTS:
+      out << ",\"ints\":";
+      WriteArray(out, attribute.ints());
+      break;
+    case AttributeProto_AttributeType_STRINGS: {
+      out << ",\"strings\":[";
+      for (int i = 0; i < attribute.strings_size(); ++i) {
+        out << (i == 0 ? "" : ",");
+        WriteString(out, attribute.strings(i));
+      }
+      out << ']';
+      break;
+    }
+    case AttributeProto_AttributeType_TENSOR: {
+      static const char kHexDigits[] = "0123456789abcdef";
+      const std::string bytes = attribute.t().SerializeAsString();
+      std::string hex;
+      hex.reserve(bytes.size() * 2);
+      for (unsigned char c : bytes) {
+        hex.push_back(kHexDigits[c >> 4]);
+        hex.push_back(kHexDigits[c & 0xf]);
+      }
+      out << ",\"t\":\"" << hex << '"';
+      break;
+    }
+    default:
+      // graphs are not recorded, the nodes that have them can't be replayed on their own
+      break;
+  }
+  out << '}';
+}
+
+void WriteInput(std::ostream& out, const OrtValue* value, bool is_constant) {
+  if (value == nullptr || !value->IsAllocated()) {
+    out << "null";
+    return;
+  }
+  if (!value->IsTensor()) {
+    out << "{\"type\":0}";
+    return;
+  }
+
+  const Tensor& tensor = value->Get<Tensor>();
+  const TensorShape& shape = tensor.Shape();
+  out << "{\"type\":" << tensor.GetElementType() << ",\"shape\":";
+  WriteArray(out, shape.GetDims());
+  out << ",\"constant\":" << (is_constant ? "true" : "false");
+  if (tensor.Location().device.Type() == OrtDevice::CPU && shape.Size() <= kMaxRecordedValues) {
+    if (tensor.IsDataType<int64_t>()) {
+      out << ",\"values\":";
+      WriteArray(out, gsl::make_span(tensor.Data<int64_t>(), static_cast<size_t>(shape.Size())));
+    } else if (tensor.IsDataType<int32_t>()) {
+      out << ",\"values\":";
+      WriteArray(out, gsl::make_span(tensor.Data<int32_t>(), static_cast<size_t>(shape.Size())));
+    }
+  }
+  out << '}';
+}
+
+}  // namespace
+
+void NodeCapture::Record(const OpKernelContextInternal& context, const SessionState& session_state,
+                         const Node& node, long long elapsed_ns) {
+  std::ostringstream json;
+  json << std::setprecision(std::numeric_limits<float>::max_digits10);
+  json << "\"op_type\":";
+  WriteString(json, node.OpType());
+  json << ",\"domain\":";
+  WriteString(json, node.Domain());
+  json << ",\"since_version\":" << node.SinceVersion() << ",\"provider\":";
+  WriteString(json, node.GetExecutionProviderType());
+
+  // sorted so that nodes with the same attributes have the same record
+  const auto& attributes = node.GetAttributes();
+  std::vector<const AttributeProto*> sorted_attributes;
+  sorted_attributes.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    sorted_attributes.push_back(&attribute.second);
+  }
+  std::sort(sorted_attributes.begin(), sorted_attributes.end(),
+            [](const AttributeProto* a, const AttributeProto* b) { return a->name() < b->name(); });
+  json << ",\"attributes\":[";
+  for (size_t i = 0; i < sorted_attributes.size(); ++i) {
+    json << (i == 0 ? "" : ",");
+    WriteAttribute(json, *sorted_attributes[i]);
+  }
+
+  json << "],\"inputs\":[";
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  const auto& input_defs = node.InputDefs();
+  for (int i = 0; i < context.InputCount(); ++i) {
+    const bool is_constant = static_cast<size_t>(i) < input_defs.size() && input_defs[i]->Exists() &&
+                             graph_viewer.IsConstantInitializer(input_defs[i]->Name(), true);
+    json << (i == 0 ? "" : ",");
+    WriteInput(json, context.GetInputMLValue(i), is_constant);
+  }
+  json << "],\"outputs\":" << context.OutputCount();
+
+  std::string key = json.str();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = record_index_.find(key);
+  if (it == record_index_.end()) {
+    it = record_index_.emplace(key, records_.size()).first;
+    records_.push_back({node.Name(), std::move(key), 0, 0, std::numeric_limits<long long>::max(), 0});
+  }
+  NodeRecord& record = records_[it->second];
+  ++record.count;
+  record.total_ns += elapsed_ns;
+  record.min_ns = std::min(record.min_ns, elapsed_ns);
+  record.max_ns = std::max(record.max_ns, elapsed_ns);
+}
+
+Status NodeCapture::WriteToFile() const {
+  std::ofstream out(file_path_, std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(out.good(), "Failed to open node capture file ", file_path_);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  out << "{\"nodes\":[";
+  for (size_t i = 0; i < records_.size(); ++i) {
+    const NodeRecord& record = records_[i];
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    WriteString(out, record.name);
+    out << ",\"count\":" << record.count << ",\"total_ns\":" << record.total_ns << ",\"min_ns\":" << record.min_ns
+        << ",\"max_ns\":" << record.max_ns << ',' << record.json << '}';
+  }
+  out << "\n]}\n";
+
+  ORT_RETURN_IF_NOT(out.good(), "Failed to write node capture file ", file_path_);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernelContextInternal;
+class SessionState;
+
+/**
+Records the op type, attributes, input types and shapes and the kernel time of the nodes executed by the
+SequentialExecutor, enabled with the session config kOrtSessionOptionsConfigNodeCaptureFile.
+
+Executions of nodes with the same op, attributes and inputs are aggregated into one record with the count and the
+total, min and max kernel time, so the file stays small for models with repeated layers and for many runs.
+The values of small int32 and int64 inputs are recorded as they are usually shapes, axes or indices that the
+kernel can't run without. Other tensor data is not recorded.
+
+The file is JSON:
+  {"nodes": [{"name": "conv1", "count": 10, "total_ns": 123400, "min_ns": 12000, "max_ns": 13100,
+              "op_type": "Conv", "domain": "", "since_version": 11, "provider": "CPUExecutionProvider",
+              "attributes": [{"name": "strides", "type": 7, "ints": [1, 1]}, ...],
+              "inputs": [{"type": 1, "shape": [1, 3, 224, 224], "constant": false}, null, ...],
+              "outputs": 1}, ...]}
+Attribute types are AttributeProto::AttributeType values, float attributes that are NaN or infinite are the strings
+"NaN", "Infinity" and "-Infinity", and tensor attributes are the hex encoded serialized TensorProto. Input types are TensorProto::DataType values, 0 for inputs that are not tensors. Missing optional inputs
+are null. name is the name of the first node of the record.
+
+Use onnxruntime_kernel_benchmark --capture=<file> to replay the recorded nodes in isolation with synthetic data.
+*/
+class NodeCapture {
+ public:
+  explicit NodeCapture(std::string file_path) : file_path_(std::move(file_path)) {}
+
+  const std::string& FilePath() const noexcept { return file_path_; }
+
+  // Records an execution of node with the inputs of context that took elapsed_ns in Compute. Thread safe.
+  void Record(const OpKernelContextInternal& context, const SessionState& session_state, const Node& node,
+              long long elapsed_ns);
+
+  // Writes the records to FilePath().
+  Status WriteToFile() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeCapture);
+
+  struct NodeRecord {
+    std::string name;
+    std::string json;  // everything but the name and the counters, also the key of the record
+    size_t count;
+    long long total_ns;
+    long long min_ns;
+    long long max_ns;
+  };
+
+  const std::string file_path_;
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, size_t> record_index_;
+  std::vector<NodeRecord> records_;
+};
+
+}  // namespace onnxruntime
@@ -11,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/node_capture.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
@@ -128,6 +129,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                    const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                    const logging::Logger& logger) {
   const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  NodeCapture* const node_capture = session_state.GetNodeCapture();
   TimePoint tp;
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
@@ -297,6 +299,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     }
 
     Status compute_status;
+    TimePoint capture_begin_time;
     {
 #ifdef CONCURRENCY_VISUALIZER
       diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
@@ -306,6 +309,9 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
           MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Blue);
       node_compute_range.Begin();
 #endif
+      if (node_capture != nullptr) {
+        capture_begin_time = std::chrono::high_resolution_clock::now();
+      }
       ORT_TRY {
         if (p_op_kernel->KernelDef().AllocateInputsContiguously())
           utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context);
@@ -332,6 +338,12 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       return Status(compute_status.Category(), compute_status.Code(), msg_string);
     }
 
+    if (node_capture != nullptr) {
+      const auto elapsed = std::chrono::high_resolution_clock::now() - capture_begin_time;
+      node_capture->Record(op_kernel_context, session_state, node,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
     if (is_profiler_enabled) {
       // Calculate total output sizes for this operation.
       CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling);
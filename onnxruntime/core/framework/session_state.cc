@@ -801,6 +801,8 @@ Status SessionState::CreateSubgraphSessionState() {
                                                  thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
                                                  logger_, profiler_);
 
+      subgraph_session_state->SetNodeCapture(node_capture_);
+
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
 
@@ -48,6 +48,7 @@ struct SessionState;
 
 class ExecutionProviders;
 class KernelDef;
+class NodeCapture;
 class OpKernel;
 class NodeIndexInfo;
 struct SequentialExecutionPlan;
@@ -184,6 +185,16 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Set the recorder of the executed nodes, see NodeCapture. It is also used by the subgraphs created after this call.
+  */
+  void SetNodeCapture(NodeCapture* node_capture) noexcept { node_capture_ = node_capture; }
+
+  /**
+  Get the recorder of the executed nodes. nullptr if node capture is disabled.
+  */
+  NodeCapture* GetNodeCapture() const noexcept { return node_capture_; }
+
   /**
   Get cached memory pattern based on input shapes
   */
@@ -403,6 +414,7 @@ class SessionState {
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
+  NodeCapture* node_capture_ = nullptr;
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
@@ -529,9 +529,18 @@ GELU (Gaussian Error Linear Unit) approximation: Y=0.5*X*(1+tanh(0.797885*X+0.03
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
       .Output(1, "mean", "Saved mean used during training to speed up gradient computation", "U", OpSchema::Optional)
       .Output(2, "inv_std_var", "Saved inverse standard variance used during training to speed up gradient computation.", "U", OpSchema::Optional)
+      .Output(3, "input_skip_bias_sum", "Sum of the input, skip and bias tensors with shape (batch_size, sequence_length, hidden_size)", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float or half tensors.")
       .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput(ctx);
+        if (ctx.getNumOutputs() > 3) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 3);
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 3);
+          }
+        }
+      });
 }
 
 void RegisterContribSchemas() {
@@ -2040,6 +2049,118 @@ Example 4:
         a fixed size = [crop_height, crop_width]. The result is a 4-D tensor [num_boxes, crop_height, crop_width, depth].
         The resizing is corner aligned.)DOC");
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(BatchedNonMaxSuppression)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "center_point_box",
+          "Integer indicate the format of the box data. The default is 0. "
+          "0 - the box data is supplied as [y1, x1, y2, x2] where (y1, x1) and (y2, x2) are the coordinates of any "
+          "diagonal pair of box corners. "
+          "1 - the box data is supplied as [x_center, y_center, width, height].",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Attr(
+          "max_total_boxes",
+          "Maximum number of boxes selected per batch over all classes, which is the size of the padded outputs.",
+          AttributeProto::INT)
+      .Input(
+          0,
+          "boxes",
+          "An input tensor with shape [num_batches, spatial_dimension, 4]. "
+          "The single box data format is indicated by center_point_box.",
+          "tensor(float)")
+      .Input(
+          1,
+          "scores",
+          "An input tensor with shape [num_batches, num_classes, spatial_dimension]",
+          "tensor(float)")
+      .Input(
+          2,
+          "max_output_boxes_per_class",
+          "Integer representing the maximum number of boxes to be selected per batch per class. "
+          "It is a scalar. Default to max_total_boxes.",
+          "tensor(int64)",
+          OpSchema::Optional)
+      .Input(
+          3,
+          "iou_threshold",
+          "Float representing the threshold for deciding whether boxes overlap too much with respect to IOU. "
+          "It is scalar. Value range [0, 1]. Default to 0.",
+          "tensor(float)",
+          OpSchema::Optional)
+      .Input(
+          4,
+          "score_threshold",
+          "Float representing the threshold for deciding when to remove boxes based on score. It is a scalar.",
+          "tensor(float)",
+          OpSchema::Optional)
+      .Output(
+          0,
+          "num_selected",
+          "Number of boxes selected for each batch, with shape [num_batches].",
+          "tensor(int64)")
+      .Output(
+          1,
+          "selected_boxes",
+          "Selected boxes in the format of the input boxes, with shape [num_batches, max_total_boxes, 4]. "
+          "The boxes past num_selected are 0.",
+          "tensor(float)")
+      .Output(
+          2,
+          "selected_scores",
+          "Scores of the selected boxes, with shape [num_batches, max_total_boxes]. "
+          "The scores past num_selected are 0.",
+          "tensor(float)")
+      .Output(
+          3,
+          "selected_classes",
+          "Class indices of the selected boxes, with shape [num_batches, max_total_boxes]. "
+          "The indices past num_selected are -1.",
+          "tensor(int64)")
+      .Output(
+          4,
+          "selected_indices",
+          "Indices of the selected boxes in the spatial dimension of the input boxes, with shape "
+          "[num_batches, max_total_boxes]. The indices past num_selected are -1.",
+          "tensor(int64)",
+          OpSchema::Optional)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::INT64);
+        updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::FLOAT);
+        updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::FLOAT);
+        updateOutputElemType(ctx, 3, ONNX_NAMESPACE::TensorProto::INT64);
+        if (ctx.getNumOutputs() > 4) {
+          updateOutputElemType(ctx, 4, ONNX_NAMESPACE::TensorProto::INT64);
+        }
+
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+        auto& boxes_shape = getInputShape(ctx, 0);
+        if (boxes_shape.dim_size() != 3) {
+          fail_shape_inference("boxes must be a 3D tensor.");
+        }
+
+        const auto& num_batches = boxes_shape.dim(0);
+        const int64_t max_total_boxes = getAttribute(ctx, "max_total_boxes", 0);
+
+        *getOutputShape(ctx, 0)->add_dim() = num_batches;
+        for (size_t i = 1; i < ctx.getNumOutputs(); ++i) {
+          auto* output_shape = getOutputShape(ctx, i);
+          *output_shape->add_dim() = num_batches;
+          output_shape->add_dim()->set_dim_value(max_total_boxes);
+          if (i == 1) {
+            output_shape->add_dim()->set_dim_value(4);
+          }
+        }
+      })
+      .SetDoc(R"DOC(
+        Filters out boxes that have high intersection-over-union (IOU) overlap with previously selected boxes, like
+        NonMaxSuppression, and then keeps the max_total_boxes highest scoring boxes of each batch over all classes.
+        The outputs have a fixed size of max_total_boxes per batch, padded past the number of selected boxes, which
+        suits models that require static output shapes.)DOC");
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(LayerNormalization)
       .SetDomain(kOnnxDomain)
       .SinceVersion(1)
@@ -152,6 +152,26 @@ MlasActivation(
 //
 // Matrix/matrix multiply routines.
 //
+// N.B. The optional output processor is invoked for each tile of matrix C as
+// soon as the tile is complete, while it is still in cache. Tiles are
+// disjoint and may be processed concurrently. The columns of a tile start at
+// a multiple of 16 unless the matrices are small enough to bypass the tiled
+// path, in which case the processor is invoked once for the complete output.
+//
+
+class MLAS_SGEMM_OUTPUT_PROCESSOR {
+public:
+    virtual
+    void
+    Process(
+        float*,         // Supplies the address of the tile to process
+        size_t,         // Supplies the start row index of the tile in matrix C
+        size_t,         // Supplies the start col index of the tile in matrix C
+        size_t,         // Supplies the element count per row to process
+        size_t,         // Supplies the element count per col to process
+        size_t          // Supplies the leading dimension of matrix C
+        ) const = 0;
+};
 
 void
 MLASCALL
@@ -169,7 +189,8 @@ MlasGemm(
     float beta,
     float* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
     );
 
 void
@@ -186,6 +207,62 @@ MlasGemm(
     float beta,
     float* C,
     size_t ldc,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
+    );
+
+//
+// Batched matrix/matrix multiply routines.
+//
+// N.B. Each matrix of the batch shares the transpose operations and the shape
+// of the operation. The complete batch is scheduled across the thread pool
+// with a single dispatch.
+//
+
+struct MLAS_SGEMM_DATA_PARAMS {
+    const float* A;
+    size_t lda;
+    const float* B;
+    size_t ldb;
+    float* C;
+    size_t ldc;
+};
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    float beta,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchSize,
     MLAS_THREADPOOL* ThreadPool
     );
 
@@ -341,6 +418,49 @@ MlasGemmPackB(
     void* PackedB
     );
 
+//
+// Single precision matrix/matrix multiply with matrix B packed from half
+// precision values. The packed buffer holds half precision values, so it uses
+// half the memory and bandwidth of MlasGemmPackB; the values are expanded to
+// single precision as they are used and the products accumulate in single
+// precision.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBHalfSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const unsigned short* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemmPackedBHalf(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -368,6 +488,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmDepthwise,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -445,6 +566,18 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Pooling routines.
 //
@@ -518,6 +651,60 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Layer normalization routines.
+//
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Channel normalization routines.
+//
+
+void
+MLASCALL
+MlasChannelAffine(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    size_t C,
+    size_t ChannelSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasInstanceNormalization(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    size_t C,
+    size_t ChannelSize,
+    float Epsilon,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -0,0 +1,443 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    channelnorm.cpp
+
+Abstract:
+
+    This module implements routines to apply a per channel scale and bias to a
+    batch of channels (inference batch normalization) and to compute the
+    instance normalization of a batch of channels.
+
+    The instance normalization accumulates the sum and the sum of squares of a
+    channel in a single pass and then applies the normalization and the
+    channel scale and bias as a single multiply add. The values are shifted by
+    the first element of the channel before accumulating to avoid catastrophic
+    cancellation when the variance is small relative to the mean.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a channel normalization
+// operation on worker threads.
+//
+
+struct MLAS_CHANNEL_NORMALIZATION_WORK_BLOCK {
+    int32_t ThreadCountNC;
+    bool Normalize;
+    float Epsilon;
+    const float* Input;
+    const float* Scale;
+    const float* Bias;
+    float* Output;
+    size_t C;
+    size_t NC;
+    size_t ChannelSize;
+};
+
+void
+MlasChannelAffineKernel(
+    const float* Input,
+    float* Output,
+    size_t ChannelSize,
+    float Shift,
+    float Scale,
+    float Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = (Input - Shift) * Scale + Bias for a single
+    channel.
+
+Arguments:
+
+    Input - Supplies the input channel.
+
+    Output - Supplies the output channel.
+
+    ChannelSize - Supplies the number of elements of the channel.
+
+    Shift - Supplies the value to subtract from each element.
+
+    Scale - Supplies the value to multiply each element by.
+
+    Bias - Supplies the value to add to each element.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+    size_t i = 0;
+
+    for (; i + 8 <= ChannelSize; i += 8) {
+
+        MLAS_FLOAT32X4 Value0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i), ShiftVector);
+        MLAS_FLOAT32X4 Value1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i + 4), ShiftVector);
+
+        MlasStoreFloat32x4(Output + i, MlasMultiplyAddFloat32x4(Value0, ScaleVector, BiasVector));
+        MlasStoreFloat32x4(Output + i + 4, MlasMultiplyAddFloat32x4(Value1, ScaleVector, BiasVector));
+    }
+
+    if (i + 4 <= ChannelSize) {
+
+        MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i), ShiftVector);
+
+        MlasStoreFloat32x4(Output + i, MlasMultiplyAddFloat32x4(Value, ScaleVector, BiasVector));
+
+        i += 4;
+    }
+
+    for (; i < ChannelSize; i++) {
+        Output[i] = (Input[i] - Shift) * Scale + Bias;
+    }
+}
+
+void
+MlasInstanceNormalizationKernel(
+    const float* Input,
+    float* Output,
+    size_t ChannelSize,
+    float Scale,
+    float Bias,
+    float Epsilon
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the instance normalization of a single channel.
+
+Arguments:
+
+    Input - Supplies the input channel.
+
+    Output - Supplies the output channel.
+
+    ChannelSize - Supplies the number of elements of the channel.
+
+    Scale - Supplies the scale to apply to the normalized channel.
+
+    Bias - Supplies the bias to apply to the normalized channel.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Shift = Input[0];
+
+    //
+    // Accumulate the shifted sum and sum of squares of the channel.
+    //
+
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SquareVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SquareVector1 = MlasZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 8 <= ChannelSize; i += 8) {
+
+        MLAS_FLOAT32X4 Value0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i), ShiftVector);
+        MLAS_FLOAT32X4 Value1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i + 4), ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Value0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Value1);
+        SquareVector0 = MlasMultiplyAddFloat32x4(Value0, Value0, SquareVector0);
+        SquareVector1 = MlasMultiplyAddFloat32x4(Value1, Value1, SquareVector1);
+    }
+
+    if (i + 4 <= ChannelSize) {
+
+        MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i), ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Value);
+        SquareVector0 = MlasMultiplyAddFloat32x4(Value, Value, SquareVector0);
+
+        i += 4;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquares = MlasReduceAddFloat32x4(MlasAddFloat32x4(SquareVector0, SquareVector1));
+
+    for (; i < ChannelSize; i++) {
+
+        float Value = Input[i] - Shift;
+
+        Sum += Value;
+        SumSquares += Value * Value;
+    }
+
+    float ShiftedMean = Sum / float(ChannelSize);
+    float Variance = std::max(SumSquares / float(ChannelSize) - ShiftedMean * ShiftedMean, 0.0f);
+
+    //
+    // Fold the normalization into the channel scale and bias, keeping the
+    // values centered by the shift.
+    //
+
+    float ChannelScale = Scale / std::sqrt(Variance + Epsilon);
+
+    MlasChannelAffineKernel(Input, Output, ChannelSize, Shift, ChannelScale, Bias - ShiftedMean * ChannelScale);
+}
+
+void
+MlasChannelNormalizationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    channel normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_CHANNEL_NORMALIZATION_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N*C dimension.
+    //
+
+    size_t nc;
+    size_t CountNC;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountNC, WorkBlock->NC, &nc, &CountNC);
+
+    const size_t ChannelSize = WorkBlock->ChannelSize;
+
+    for (size_t i = nc; i < nc + CountNC; i++) {
+
+        const size_t c = i % WorkBlock->C;
+        const size_t Offset = i * ChannelSize;
+
+        if (WorkBlock->Normalize) {
+            MlasInstanceNormalizationKernel(WorkBlock->Input + Offset, WorkBlock->Output + Offset, ChannelSize,
+                WorkBlock->Scale[c], WorkBlock->Bias[c], WorkBlock->Epsilon);
+        } else {
+            MlasChannelAffineKernel(WorkBlock->Input + Offset, WorkBlock->Output + Offset, ChannelSize, 0.0f,
+                WorkBlock->Scale[c], WorkBlock->Bias[c]);
+        }
+    }
+}
+
+void
+MlasExecuteChannelNormalization(
+    MLAS_CHANNEL_NORMALIZATION_WORK_BLOCK* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine partitions a channel normalization operation across threads.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the channel normalization
+        parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of channels and try
+    // to keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountNC = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountNC) > WorkBlock->NC) {
+        ThreadCountNC = int32_t(WorkBlock->NC);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((WorkBlock->NC * WorkBlock->ChannelSize) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountNC) > BlockCount) {
+        ThreadCountNC = int32_t(BlockCount);
+    }
+
+    WorkBlock->ThreadCountNC = ThreadCountNC;
+
+    MlasExecuteThreaded(MlasChannelNormalizationThreaded, WorkBlock, ThreadCountNC, ThreadPool);
+}
+
+void
+MLASCALL
+MlasChannelAffine(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    size_t C,
+    size_t ChannelSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine applies a per channel scale and bias to a batch of channels:
+
+        Output[n, c, i] = Input[n, c, i] * Scale[c] + Bias[c]
+
+    This is the inference form of batch normalization once the running mean
+    and variance are folded into the scale and bias.
+
+Arguments:
+
+    Input - Supplies the input buffer of N*C channels of ChannelSize elements.
+
+    Scale - Supplies the scale of C elements.
+
+    Bias - Supplies the bias of C elements.
+
+    Output - Supplies the output buffer of N*C channels of ChannelSize
+        elements. The output buffer may be the same as the input buffer.
+
+    N - Supplies the batch size.
+
+    C - Supplies the number of channels.
+
+    ChannelSize - Supplies the number of elements per channel.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || C == 0 || ChannelSize == 0) {
+        return;
+    }
+
+    MLAS_CHANNEL_NORMALIZATION_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Normalize = false;
+    WorkBlock.Epsilon = 0.0f;
+    WorkBlock.Input = Input;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.C = C;
+    WorkBlock.NC = N * C;
+    WorkBlock.ChannelSize = ChannelSize;
+
+    MlasExecuteChannelNormalization(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasInstanceNormalization(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    size_t C,
+    size_t ChannelSize,
+    float Epsilon,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the instance normalization of a batch of channels.
+    Each channel is normalized by its own mean and standard deviation and then
+    scaled and biased by the per channel scale and bias.
+
+Arguments:
+
+    Input - Supplies the input buffer of N*C channels of ChannelSize elements.
+
+    Scale - Supplies the scale of C elements.
+
+    Bias - Supplies the bias of C elements.
+
+    Output - Supplies the output buffer of N*C channels of ChannelSize
+        elements. The output buffer may be the same as the input buffer.
+
+    N - Supplies the batch size.
+
+    C - Supplies the number of channels.
+
+    ChannelSize - Supplies the number of elements per channel.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || C == 0 || ChannelSize == 0) {
+        return;
+    }
+
+    MLAS_CHANNEL_NORMALIZATION_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Normalize = true;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.Input = Input;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.C = C;
+    WorkBlock.NC = N * C;
+    WorkBlock.ChannelSize = ChannelSize;
+
+    MlasExecuteChannelNormalization(&WorkBlock, ThreadPool);
+}
@@ -736,6 +736,297 @@ Return Value:
     }
 }
 
+void
+MlasConvDepthwiseOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a depthwise convolution for a single channel of a
+    two dimensional image in NCHW format.
+
+    The output columns where every filter tap samples inside the input row
+    are accumulated in registers without bounds checks. The remaining columns
+    along the left and right edges check each filter tap against the padding.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input channel.
+
+    Filter - Supplies the filter for the channel.
+
+    Output - Supplies the output channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t InputHeight = ptrdiff_t(Parameters->InputShape[0]);
+    const ptrdiff_t InputWidth = ptrdiff_t(Parameters->InputShape[1]);
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const ptrdiff_t OutputWidth = ptrdiff_t(Parameters->OutputShape[1]);
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const ptrdiff_t DilationHeight = ptrdiff_t(Parameters->DilationShape[0]);
+    const ptrdiff_t DilationWidth = ptrdiff_t(Parameters->DilationShape[1]);
+    const ptrdiff_t PaddingTop = ptrdiff_t(Parameters->Padding[0]);
+    const ptrdiff_t PaddingLeft = ptrdiff_t(Parameters->Padding[1]);
+    const ptrdiff_t StrideHeight = ptrdiff_t(Parameters->StrideShape[0]);
+    const ptrdiff_t StrideWidth = ptrdiff_t(Parameters->StrideShape[1]);
+
+    //
+    // Compute the range of output columns where every filter tap samples
+    // inside the input row.
+    //
+
+    const ptrdiff_t LastTapOffset = ptrdiff_t(KernelWidth - 1) * DilationWidth - PaddingLeft;
+
+    ptrdiff_t InteriorStart = (PaddingLeft + StrideWidth - 1) / StrideWidth;
+    ptrdiff_t InteriorEnd = 0;
+
+    if (InputWidth > LastTapOffset) {
+        InteriorEnd = (InputWidth - LastTapOffset + StrideWidth - 1) / StrideWidth;
+    }
+
+    InteriorStart = std::min(InteriorStart, OutputWidth);
+    InteriorEnd = std::max(std::min(InteriorEnd, OutputWidth), InteriorStart);
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        const ptrdiff_t OriginInputY = ptrdiff_t(oh) * StrideHeight - PaddingTop;
+
+        //
+        // Process the output columns along the left and right edges.
+        //
+
+        for (ptrdiff_t ow = 0; ow < OutputWidth; ow++) {
+
+            if (ow == InteriorStart) {
+                ow = InteriorEnd;
+                if (ow == OutputWidth) {
+                    break;
+                }
+            }
+
+            const ptrdiff_t OriginInputX = ow * StrideWidth - PaddingLeft;
+
+            float Accumulator = 0.0f;
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                const ptrdiff_t ih = OriginInputY + ptrdiff_t(kh) * DilationHeight;
+
+                if (ih < 0 || ih >= InputHeight) {
+                    continue;
+                }
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    const ptrdiff_t iw = OriginInputX + ptrdiff_t(kw) * DilationWidth;
+
+                    if (iw >= 0 && iw < InputWidth) {
+                        Accumulator += Input[ih * InputWidth + iw] * Filter[kh * KernelWidth + kw];
+                    }
+                }
+            }
+
+            Output[ow] = Accumulator;
+        }
+
+        //
+        // Process the interior output columns.
+        //
+
+        ptrdiff_t ow = InteriorStart;
+
+        if (StrideWidth == 1) {
+
+            while (ow + 16 <= InteriorEnd) {
+
+                MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+                MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+                MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+                MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+                for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                    const ptrdiff_t ih = OriginInputY + ptrdiff_t(kh) * DilationHeight;
+
+                    if (ih < 0 || ih >= InputHeight) {
+                        continue;
+                    }
+
+                    const float* input = Input + ih * InputWidth + ow - PaddingLeft;
+                    const float* filter = Filter + kh * KernelWidth;
+
+                    for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                        MLAS_FLOAT32X4 FilterVector = MlasBroadcastFloat32x4(filter[kw]);
+
+                        Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input), FilterVector, Accumulator0);
+                        Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 4), FilterVector, Accumulator1);
+                        Accumulator2 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 8), FilterVector, Accumulator2);
+                        Accumulator3 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 12), FilterVector, Accumulator3);
+
+                        input += DilationWidth;
+                    }
+                }
+
+                MlasStoreFloat32x4(&Output[ow], Accumulator0);
+                MlasStoreFloat32x4(&Output[ow + 4], Accumulator1);
+                MlasStoreFloat32x4(&Output[ow + 8], Accumulator2);
+                MlasStoreFloat32x4(&Output[ow + 12], Accumulator3);
+
+                ow += 16;
+            }
+
+            while (ow + 4 <= InteriorEnd) {
+
+                MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+                for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                    const ptrdiff_t ih = OriginInputY + ptrdiff_t(kh) * DilationHeight;
+
+                    if (ih < 0 || ih >= InputHeight) {
+                        continue;
+                    }
+
+                    const float* input = Input + ih * InputWidth + ow - PaddingLeft;
+                    const float* filter = Filter + kh * KernelWidth;
+
+                    for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                        MLAS_FLOAT32X4 FilterVector = MlasBroadcastFloat32x4(filter[kw]);
+
+                        Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input), FilterVector, Accumulator);
+
+                        input += DilationWidth;
+                    }
+                }
+
+                MlasStoreFloat32x4(&Output[ow], Accumulator);
+
+                ow += 4;
+            }
+        }
+
+        while (ow < InteriorEnd) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                const ptrdiff_t ih = OriginInputY + ptrdiff_t(kh) * DilationHeight;
+
+                if (ih < 0 || ih >= InputHeight) {
+                    continue;
+                }
+
+                const float* input = Input + ih * InputWidth + ow * StrideWidth - PaddingLeft;
+                const float* filter = Filter + kh * KernelWidth;
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    Accumulator += *input * filter[kw];
+
+                    input += DilationWidth;
+                }
+            }
+
+            Output[ow] = Accumulator;
+
+            ow += 1;
+        }
+
+        Output += OutputWidth;
+    }
+}
+
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of channels to use for this thread. Each group of a
+    // depthwise convolution maps a single input channel to a single output
+    // channel.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t BatchGroupCount = Parameters->BatchCount * GroupCount;
+
+    size_t BatchGroupStart;
+    size_t BatchGroupRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, BatchGroupCount,
+        &BatchGroupStart, &BatchGroupRemaining);
+
+    const size_t BatchGroupEnd = BatchGroupStart + BatchGroupRemaining;
+
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    for (size_t bg = BatchGroupStart; bg < BatchGroupEnd; bg++) {
+
+        size_t group = bg % GroupCount;
+
+        const float* input = WorkBlock->Input + bg * InputSize;
+        const float* filter = WorkBlock->Filter + group * K;
+        float* output = WorkBlock->Output + bg * OutputSize;
+
+        MlasConvDepthwiseOperation(Parameters, input, filter, output);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, 1, OutputSize,
+            OutputSize);
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -910,6 +1201,48 @@ Return Value:
         return;
     }
 
+    //
+    // Schedule the channels of a depthwise convolution across multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmDepthwise) {
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        int32_t TargetThreadCount;
+        double Complexity = double(BatchGroupCount) * double(OutputSize) * double(K);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+        int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(TargetThreadCount) >= BatchGroupCount) {
+            TargetThreadCount = int32_t(BatchGroupCount);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+
+        return;
+    }
+
     //
     // Iterate over each batch and group.
     //
@@ -988,6 +1321,15 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmDepthwise:
+                {
+                    //
+                    // Depthwise convolutions are scheduled above.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1148,6 +1490,18 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Detect a depthwise convolution, where each group maps a single input
+    // channel to a single output channel.
+    //
+
+    if (Dimensions == 2 && InputChannels == 1 && FilterCount == 1 && GroupCount > 1) {
+
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1381,3 +1735,136 @@ MlasConvDepthwise<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a depthwise convolution for channels last (NHWC)
+    images.
+
+Arguments:
+
+    Input - Supplies the convolution patches for each output element. Each
+        patch is formatted as KernelSize rows of Channels elements.
+
+    Filter - Supplies the filter formatted as KernelSize rows of Channels
+        elements.
+
+    Bias - Supplies the optional bias vector of Channels elements.
+
+    Output - Supplies the output buffer formatted as OutputCount rows of
+        Channels elements.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output elements.
+
+    KernelSize - Supplies the number of elements of each convolution patch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 Accumulator0;
+            MLAS_FLOAT32X4 Accumulator1;
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(&Bias[ChannelOffset]);
+                Accumulator1 = MlasLoadFloat32x4(&Bias[ChannelOffset + 4]);
+            } else {
+                Accumulator0 = MlasZeroFloat32x4();
+                Accumulator1 = MlasZeroFloat32x4();
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[ChannelKernelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[ChannelKernelOffset + 4]);
+                MLAS_FLOAT32X4 FilterVector0 = MlasLoadFloat32x4(&Filter[ChannelKernelOffset]);
+                MLAS_FLOAT32X4 FilterVector1 = MlasLoadFloat32x4(&Filter[ChannelKernelOffset + 4]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(InputVector0, FilterVector0, Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(InputVector1, FilterVector1, Accumulator1);
+                ChannelKernelOffset += Channels;
+            }
+
+            MlasStoreFloat32x4(&Output[0], Accumulator0);
+            MlasStoreFloat32x4(&Output[4], Accumulator1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        if (c >= 4) {
+
+            MLAS_FLOAT32X4 Accumulator;
+
+            if (Bias != nullptr) {
+                Accumulator = MlasLoadFloat32x4(&Bias[ChannelOffset]);
+            } else {
+                Accumulator = MlasZeroFloat32x4();
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(&Input[ChannelKernelOffset]);
+                MLAS_FLOAT32X4 FilterVector = MlasLoadFloat32x4(&Filter[ChannelKernelOffset]);
+
+                Accumulator = MlasMultiplyAddFloat32x4(InputVector, FilterVector, Accumulator);
+                ChannelKernelOffset += Channels;
+            }
+
+            MlasStoreFloat32x4(&Output[0], Accumulator);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float Accumulator = (Bias != nullptr) ? Bias[ChannelOffset] : 0.0f;
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                Accumulator += Input[ChannelKernelOffset] * Filter[ChannelKernelOffset];
+                ChannelKernelOffset += Channels;
+            }
+
+            *Output++ = Accumulator;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += Channels * KernelSize;
+        OutputCount -= 1;
+    }
+}
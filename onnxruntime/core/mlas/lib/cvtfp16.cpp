@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16.cpp
+
+Abstract:
+
+    This module implements routines to convert between half precision and
+    single precision floating point values.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasHalfToFloat(
+    unsigned short Value
+    )
+{
+    const uint32_t Sign = uint32_t(Value & 0x8000) << 16;
+    const uint32_t Exponent = (Value >> 10) & 0x1F;
+    const uint32_t Mantissa = Value & 0x3FF;
+
+    uint32_t Bits;
+
+    if (Exponent == 0x1F) {
+
+        //
+        // Infinity or NaN.
+        //
+
+        Bits = Sign | 0x7F800000 | (Mantissa << 13);
+
+    } else if (Exponent != 0) {
+
+        //
+        // Normal value, rebias the exponent from 15 to 127.
+        //
+
+        Bits = Sign | ((Exponent + (127 - 15)) << 23) | (Mantissa << 13);
+
+    } else if (Mantissa != 0) {
+
+        //
+        // Denormal value, which is a normal single precision value.
+        //
+
+        const float Magnitude = float(Mantissa) * (1.0f / 16777216.0f);
+
+        return Sign != 0 ? -Magnitude : Magnitude;
+
+    } else {
+
+        Bits = Sign;
+    }
+
+    float Result;
+    memcpy(&Result, &Bits, sizeof(float));
+
+    return Result;
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision values to the
+    destination buffer of single precision values.
+
+Arguments:
+
+    Source - Supplies the address of the half precision values.
+
+    Destination - Supplies the address of the single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasHalfToFloat(Source[i]);
+    }
+}
+
+//
+// The x64 build with MSVC implements MlasConvertHalfToFloatBuffer in assembly
+// (amd64/cvtfp16a.asm).
+//
+
+#if !defined(_M_AMD64)
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatKernel(Source, Destination, Count);
+#else
+    MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16_avx2.cpp
+
+Abstract:
+
+    This module implements routines to convert half precision values to single
+    precision values using the F16C instructions, which are available on all
+    processors that support AVX2.
+
+--*/
+
+#include "../../mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision values to the
+    destination buffer of single precision values.
+
+Arguments:
+
+    Source - Supplies the address of the half precision values.
+
+    Destination - Supplies the address of the single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 16) {
+
+        __m128i Half0 = _mm_loadu_si128((const __m128i*)&Source[0]);
+        __m128i Half1 = _mm_loadu_si128((const __m128i*)&Source[8]);
+
+        _mm256_storeu_ps(&Destination[0], _mm256_cvtph_ps(Half0));
+        _mm256_storeu_ps(&Destination[8], _mm256_cvtph_ps(Half1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+
+        //
+        // Convert the remaining values through a zero padded buffer.
+        //
+
+        MLAS_DECLSPEC_ALIGN(unsigned short Buffer[8], 16) = { 0 };
+
+        for (size_t i = 0; i < Count; i++) {
+            Buffer[i] = Source[i];
+        }
+
+        MLAS_DECLSPEC_ALIGN(float Result[8], 32);
+
+        _mm256_store_ps(Result, _mm256_cvtph_ps(_mm_load_si128((const __m128i*)Buffer)));
+
+        for (size_t i = 0; i < Count; i++) {
+            Destination[i] = Result[i];
+        }
+    }
+}
@@ -0,0 +1,236 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the layer normalization of a single
+    row using the AVX2 and FMA3 instructions.
+
+--*/
+
+#include "../../mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x8(
+    __m256 Vector
+    )
+{
+    __m128 Vector128 = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Vector128 = _mm_add_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+    Vector128 = _mm_add_ss(Vector128, _mm_shuffle_ps(Vector128, Vector128, 1));
+    return _mm_cvtss_f32(Vector128);
+}
+
+void
+MLASCALL
+MlasLayerNormalizationKernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the kernel for the layer normalization of a single
+    row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies a row to add to the input row.
+
+    Bias - Optionally supplies a bias to add to the input row.
+
+    Gamma - Supplies the scale to apply to the normalized row.
+
+    Beta - Optionally supplies the shift to apply to the normalized row.
+
+    Output - Supplies the output row.
+
+    SumOutput - Optionally supplies the row to receive the sum of the input,
+        skip and bias rows.
+
+    D - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    Simplified - Supplies true to normalize by the root mean square of the row
+        without subtracting the mean, else false.
+
+    Statistics - Supplies a two element buffer to receive the mean and the
+        inverse standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* Buffer = (SumOutput != nullptr) ? SumOutput : Output;
+
+    float Shift = 0.0f;
+
+    if (!Simplified) {
+        Shift = Input[0] + ((Skip != nullptr) ? Skip[0] : 0.0f) + ((Bias != nullptr) ? Bias[0] : 0.0f);
+    }
+
+    //
+    // Add the skip and bias rows to the input row and accumulate the shifted
+    // sum and sum of squares.
+    //
+
+    __m256 ShiftVector = _mm256_set1_ps(Shift);
+    __m256 SumVector0 = _mm256_setzero_ps();
+    __m256 SumVector1 = _mm256_setzero_ps();
+    __m256 SquareVector0 = _mm256_setzero_ps();
+    __m256 SquareVector1 = _mm256_setzero_ps();
+
+    size_t d = 0;
+
+    for (; d + 16 <= D; d += 16) {
+
+        __m256 Value0 = _mm256_loadu_ps(Input + d);
+        __m256 Value1 = _mm256_loadu_ps(Input + d + 8);
+
+        if (Skip != nullptr) {
+            Value0 = _mm256_add_ps(Value0, _mm256_loadu_ps(Skip + d));
+            Value1 = _mm256_add_ps(Value1, _mm256_loadu_ps(Skip + d + 8));
+        }
+
+        if (Bias != nullptr) {
+            Value0 = _mm256_add_ps(Value0, _mm256_loadu_ps(Bias + d));
+            Value1 = _mm256_add_ps(Value1, _mm256_loadu_ps(Bias + d + 8));
+        }
+
+        _mm256_storeu_ps(Buffer + d, Value0);
+        _mm256_storeu_ps(Buffer + d + 8, Value1);
+
+        Value0 = _mm256_sub_ps(Value0, ShiftVector);
+        Value1 = _mm256_sub_ps(Value1, ShiftVector);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Value0);
+        SumVector1 = _mm256_add_ps(SumVector1, Value1);
+        SquareVector0 = _mm256_fmadd_ps(Value0, Value0, SquareVector0);
+        SquareVector1 = _mm256_fmadd_ps(Value1, Value1, SquareVector1);
+    }
+
+    if (d + 8 <= D) {
+
+        __m256 Value = _mm256_loadu_ps(Input + d);
+
+        if (Skip != nullptr) {
+            Value = _mm256_add_ps(Value, _mm256_loadu_ps(Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Value = _mm256_add_ps(Value, _mm256_loadu_ps(Bias + d));
+        }
+
+        _mm256_storeu_ps(Buffer + d, Value);
+
+        Value = _mm256_sub_ps(Value, ShiftVector);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Value);
+        SquareVector0 = _mm256_fmadd_ps(Value, Value, SquareVector0);
+
+        d += 8;
+    }
+
+    float Sum = MlasReduceAddFloat32x8(_mm256_add_ps(SumVector0, SumVector1));
+    float SumSquares = MlasReduceAddFloat32x8(_mm256_add_ps(SquareVector0, SquareVector1));
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        Buffer[d] = Value;
+
+        Value -= Shift;
+
+        Sum += Value;
+        SumSquares += Value * Value;
+    }
+
+    //
+    // Compute the statistics of the row.
+    //
+
+    float ShiftedMean = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+        Variance = SumSquares / float(D);
+    } else {
+        ShiftedMean = Sum / float(D);
+        Variance = std::max(SumSquares / float(D) - ShiftedMean * ShiftedMean, 0.0f);
+    }
+
+    float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+    Statistics[0] = Shift + ShiftedMean;
+    Statistics[1] = InvStdDev;
+
+    //
+    // Normalize the row and apply the scale and shift. The row is centered by
+    // the shift and then by the shifted mean to avoid rounding the mean to the
+    // precision of the values.
+    //
+
+    __m256 ShiftedMeanVector = _mm256_set1_ps(ShiftedMean);
+    __m256 InvStdDevVector = _mm256_set1_ps(InvStdDev);
+
+    d = 0;
+
+    for (; d + 8 <= D; d += 8) {
+
+        __m256 Value = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(Buffer + d), ShiftVector), ShiftedMeanVector);
+
+        Value = _mm256_mul_ps(Value, InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Value = _mm256_fmadd_ps(Value, _mm256_loadu_ps(Gamma + d), _mm256_loadu_ps(Beta + d));
+        } else {
+            Value = _mm256_mul_ps(Value, _mm256_loadu_ps(Gamma + d));
+        }
+
+        _mm256_storeu_ps(Output + d, Value);
+    }
+
+    for (; d < D; d++) {
+
+        float Value = ((Buffer[d] - Shift) - ShiftedMean) * InvStdDev * Gamma[d];
+
+        if (Beta != nullptr) {
+            Value += Beta[d];
+        }
+
+        Output[d] = Value;
+    }
+}
@@ -0,0 +1,446 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the layer normalization of a
+    batch of rows, optionally fused with a residual add and a bias add.
+
+    This implementation uses a single pass over the row to accumulate the sum
+    and the sum of squares followed by a pass that normalizes the row. The
+    values are shifted by the first element of the row before accumulating to
+    avoid catastrophic cancellation when the variance is small relative to the
+    mean.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a layer normalization operation
+// on worker threads.
+//
+
+struct MLAS_LAYER_NORMALIZATION_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool Simplified;
+    float Epsilon;
+    const float* Input;
+    const float* Skip;
+    const float* Bias;
+    const float* Gamma;
+    const float* Beta;
+    float* Output;
+    float* SumOutput;
+    float* Mean;
+    float* InvStdDev;
+    size_t N;
+    size_t D;
+};
+
+void
+MLASCALL
+MlasLayerNormalizationKernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the layer normalization of
+    a single row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies a row to add to the input row.
+
+    Bias - Optionally supplies a bias to add to the input row.
+
+    Gamma - Supplies the scale to apply to the normalized row.
+
+    Beta - Optionally supplies the shift to apply to the normalized row.
+
+    Output - Supplies the output row.
+
+    SumOutput - Optionally supplies the row to receive the sum of the input,
+        skip and bias rows.
+
+    D - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    Simplified - Supplies true to normalize by the root mean square of the row
+        without subtracting the mean, else false.
+
+    Statistics - Supplies a two element buffer to receive the mean and the
+        inverse standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* Buffer = (SumOutput != nullptr) ? SumOutput : Output;
+
+    float Shift = 0.0f;
+
+    if (!Simplified) {
+        Shift = Input[0] + ((Skip != nullptr) ? Skip[0] : 0.0f) + ((Bias != nullptr) ? Bias[0] : 0.0f);
+    }
+
+    //
+    // Add the skip and bias rows to the input row and accumulate the shifted
+    // sum and sum of squares.
+    //
+
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SquareVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SquareVector1 = MlasZeroFloat32x4();
+
+    size_t d = 0;
+
+    for (; d + 8 <= D; d += 8) {
+
+        MLAS_FLOAT32X4 Value0 = MlasLoadFloat32x4(Input + d);
+        MLAS_FLOAT32X4 Value1 = MlasLoadFloat32x4(Input + d + 4);
+
+        if (Skip != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Skip + d));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Skip + d + 4));
+        }
+
+        if (Bias != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Bias + d));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Bias + d + 4));
+        }
+
+        MlasStoreFloat32x4(Buffer + d, Value0);
+        MlasStoreFloat32x4(Buffer + d + 4, Value1);
+
+        Value0 = MlasSubtractFloat32x4(Value0, ShiftVector);
+        Value1 = MlasSubtractFloat32x4(Value1, ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Value0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Value1);
+        SquareVector0 = MlasMultiplyAddFloat32x4(Value0, Value0, SquareVector0);
+        SquareVector1 = MlasMultiplyAddFloat32x4(Value1, Value1, SquareVector1);
+    }
+
+    if (d + 4 <= D) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input + d);
+
+        if (Skip != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Skip + d));
+        }
+
+        if (Bias != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias + d));
+        }
+
+        MlasStoreFloat32x4(Buffer + d, Value);
+
+        Value = MlasSubtractFloat32x4(Value, ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Value);
+        SquareVector0 = MlasMultiplyAddFloat32x4(Value, Value, SquareVector0);
+
+        d += 4;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquares = MlasReduceAddFloat32x4(MlasAddFloat32x4(SquareVector0, SquareVector1));
+
+    for (; d < D; d++) {
+
+        float Value = Input[d];
+
+        if (Skip != nullptr) {
+            Value += Skip[d];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        Buffer[d] = Value;
+
+        Value -= Shift;
+
+        Sum += Value;
+        SumSquares += Value * Value;
+    }
+
+    //
+    // Compute the statistics of the row.
+    //
+
+    float ShiftedMean = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+        Variance = SumSquares / float(D);
+    } else {
+        ShiftedMean = Sum / float(D);
+        Variance = std::max(SumSquares / float(D) - ShiftedMean * ShiftedMean, 0.0f);
+    }
+
+    float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+    Statistics[0] = Shift + ShiftedMean;
+    Statistics[1] = InvStdDev;
+
+    //
+    // Normalize the row and apply the scale and shift. The row is centered by
+    // the shift and then by the shifted mean to avoid rounding the mean to the
+    // precision of the values.
+    //
+
+    MLAS_FLOAT32X4 ShiftedMeanVector = MlasBroadcastFloat32x4(ShiftedMean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    d = 0;
+
+    for (; d + 4 <= D; d += 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Buffer + d);
+
+        Value = MlasSubtractFloat32x4(MlasSubtractFloat32x4(Value, ShiftVector), ShiftedMeanVector);
+        Value = MlasMultiplyFloat32x4(Value, InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Value = MlasMultiplyAddFloat32x4(Value, MlasLoadFloat32x4(Gamma + d), MlasLoadFloat32x4(Beta + d));
+        } else {
+            Value = MlasMultiplyFloat32x4(Value, MlasLoadFloat32x4(Gamma + d));
+        }
+
+        MlasStoreFloat32x4(Output + d, Value);
+    }
+
+    for (; d < D; d++) {
+
+        float Value = ((Buffer[d] - Shift) - ShiftedMean) * InvStdDev * Gamma[d];
+
+        if (Beta != nullptr) {
+            Value += Beta[d];
+        }
+
+        Output[d] = Value;
+    }
+}
+
+void
+MlasLayerNormalizationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYER_NORMALIZATION_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    for (size_t i = n; i < n + CountN; i++) {
+
+        const size_t Offset = i * D;
+
+        float Statistics[2];
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.LayerNormalizationKernel(
+#else
+        MlasLayerNormalizationKernel(
+#endif
+            WorkBlock->Input + Offset,
+            (WorkBlock->Skip != nullptr) ? WorkBlock->Skip + Offset : nullptr,
+            WorkBlock->Bias,
+            WorkBlock->Gamma,
+            WorkBlock->Beta,
+            WorkBlock->Output + Offset,
+            (WorkBlock->SumOutput != nullptr) ? WorkBlock->SumOutput + Offset : nullptr,
+            D,
+            WorkBlock->Epsilon,
+            WorkBlock->Simplified,
+            Statistics);
+
+        if (WorkBlock->Mean != nullptr) {
+            WorkBlock->Mean[i] = Statistics[0];
+        }
+
+        if (WorkBlock->InvStdDev != nullptr) {
+            WorkBlock->InvStdDev[i] = Statistics[1];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SumOutput,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of a batch of rows. Each row
+    is first summed with the optional skip and bias rows and then normalized
+    by its mean and standard deviation. The simplified form normalizes by the
+    root mean square of the row without subtracting the mean.
+
+Arguments:
+
+    Input - Supplies the input buffer of N rows of D elements.
+
+    Skip - Optionally supplies a buffer of N rows of D elements to add to the
+        input buffer, else nullptr.
+
+    Bias - Optionally supplies a bias of D elements to add to each row, else
+        nullptr.
+
+    Gamma - Supplies the scale of D elements to apply to each normalized row.
+
+    Beta - Optionally supplies the shift of D elements to apply to each
+        normalized row, else nullptr.
+
+    Output - Supplies the output buffer of N rows of D elements. The output
+        buffer may be the same as the input buffer.
+
+    SumOutput - Optionally supplies the buffer of N rows of D elements to
+        receive the sum of the input, skip and bias values, else nullptr.
+
+    Mean - Optionally supplies the buffer of N elements to receive the mean of
+        each row, else nullptr. The mean is zero for the simplified form.
+
+    InvStdDev - Optionally supplies the buffer of N elements to receive the
+        inverse standard deviation of each row, else nullptr.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of elements per row.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    Simplified - Supplies true to normalize by the root mean square of each
+        row, else false.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || D == 0) {
+        return;
+    }
+
+    MLAS_LAYER_NORMALIZATION_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the layer normalization parameters to the work block.
+    //
+
+    WorkBlock.Simplified = Simplified;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.Input = Input;
+    WorkBlock.Skip = Skip;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Gamma = Gamma;
+    WorkBlock.Beta = Beta;
+    WorkBlock.Output = Output;
+    WorkBlock.SumOutput = SumOutput;
+    WorkBlock.Mean = Mean;
+    WorkBlock.InvStdDev = InvStdDev;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = int32_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = int32_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasLayerNormalizationThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -26,12 +26,24 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the maximum dimension and the maximum number of multiply/add
+// operations of the matrices that are multiplied directly by the small matrix
+// kernels, bypassing the scheduling of the operation and the packing of
+// matrix B. Beyond this point, the wider platform kernels are faster than the
+// portable small matrix kernels despite their setup costs.
+//
+
+#define MLAS_SGEMM_SMALL_THRESHOLD          32
+#define MLAS_SGEMM_SMALL_COMPLEXITY         512
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
 //
 
 struct MLAS_SGEMM_WORK_BLOCK {
+    int32_t ThreadCountBatch;
     int32_t ThreadCountM;
     int32_t ThreadCountN;
     CBLAS_TRANSPOSE TransA;
@@ -44,10 +56,17 @@ struct MLAS_SGEMM_WORK_BLOCK {
     const float* B;
     size_t ldb;
     const void* PackedB;
+    bool PackedBIsHalf;
     float* C;
     size_t ldc;
     float alpha;
     float beta;
+    size_t BatchSize;
+    size_t StrideA;
+    size_t StrideB;
+    size_t StrideC;
+    const MLAS_SGEMM_DATA_PARAMS* Data;
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor;
 };
 
 void
@@ -375,6 +394,68 @@ Return Value:
     }
 }
 
+void
+MlasSgemmPackBHalfStrip(
+    CBLAS_TRANSPOSE TransB,
+    unsigned short* D,
+    const unsigned short* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a strip of half precision elements from the source
+    matrix to the destination packed buffer, in the layout produced by
+    MlasSgemmCopyPackB.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous. Any remaining columns less than 16 elements wide are
+    zero-padded. Packing is done once per weight matrix, so this routine is not
+    vectorized.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the first row of the strip of the source
+        matrix (the first column if TransB is CblasTrans).
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of matrix B to copy.
+
+    CountK - Supplies the number of rows of matrix B to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountX = std::min(CountN - n, size_t(16));
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            for (size_t x = 0; x < CountX; x++) {
+                D[x] = (TransB == CblasNoTrans) ? B[k * ldb + n + x] : B[(n + x) * ldb + k];
+            }
+
+            for (size_t x = CountX; x < 16; x++) {
+                D[x] = 0;
+            }
+
+            D += 16;
+        }
+    }
+}
+
 template<unsigned N>
 inline
 void
@@ -753,87 +834,369 @@ Return Value:
     }
 }
 
+//
+// Templates used with loop unrolling to perform an action on one row or one
+// vector of a tile for the small matrix kernels.
+//
+
+struct MlasSgemmSmallZeroVector
+{
+    template<size_t VectorCount, size_t Vector>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[VectorCount]
+        )
+    {
+        Accumulators[Vector] = MlasZeroFloat32x4();
+    }
+};
+
+struct MlasSgemmSmallLoadBVector
+{
+    template<size_t VectorCount, size_t Vector>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 BElements[VectorCount],
+        const float* B
+        )
+    {
+        BElements[Vector] = MlasLoadFloat32x4(B + Vector * 4);
+    }
+};
+
+struct MlasSgemmSmallMultiplyAddVector
+{
+    template<size_t VectorCount, size_t Vector>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[VectorCount],
+        MLAS_FLOAT32X4 ABroadcast,
+        const MLAS_FLOAT32X4 BElements[VectorCount]
+        )
+    {
+        Accumulators[Vector] = MlasMultiplyAddFloat32x4(BElements[Vector], ABroadcast, Accumulators[Vector]);
+    }
+};
+
+struct MlasSgemmSmallStoreVector
+{
+    template<size_t VectorCount, size_t Vector>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[VectorCount],
+        float* C,
+        MLAS_FLOAT32X4 AlphaBroadcast,
+        MLAS_FLOAT32X4 BetaBroadcast,
+        bool ZeroMode
+        )
+    {
+        MLAS_FLOAT32X4 Result = MlasMultiplyFloat32x4(Accumulators[Vector], AlphaBroadcast);
+
+        if (!ZeroMode) {
+            Result = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(C + Vector * 4), BetaBroadcast, Result);
+        }
+
+        MlasStoreFloat32x4(C + Vector * 4, Result);
+    }
+};
+
+template<size_t VectorCount>
+struct MlasSgemmSmallZeroRow
+{
+    template<size_t RowCount, size_t Row>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[RowCount][VectorCount]
+        )
+    {
+        MlasLoopUnroll<VectorCount, MlasSgemmSmallZeroVector>()(Accumulators[Row]);
+    }
+};
+
+template<size_t VectorCount>
+struct MlasSgemmSmallMultiplyAddRow
+{
+    template<size_t RowCount, size_t Row>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[RowCount][VectorCount],
+        const float* A,
+        size_t StrideRowA,
+        const MLAS_FLOAT32X4 BElements[VectorCount]
+        )
+    {
+        MLAS_FLOAT32X4 ABroadcast = MlasBroadcastFloat32x4(A + Row * StrideRowA);
+
+        MlasLoopUnroll<VectorCount, MlasSgemmSmallMultiplyAddVector>()(Accumulators[Row], ABroadcast, BElements);
+    }
+};
+
+template<size_t VectorCount>
+struct MlasSgemmSmallStoreRow
+{
+    template<size_t RowCount, size_t Row>
+    MLAS_FORCEINLINE
+    static
+    void
+    Iteration(
+        MLAS_FLOAT32X4 Accumulators[RowCount][VectorCount],
+        float* C,
+        size_t ldc,
+        MLAS_FLOAT32X4 AlphaBroadcast,
+        MLAS_FLOAT32X4 BetaBroadcast,
+        bool ZeroMode
+        )
+    {
+        MlasLoopUnroll<VectorCount, MlasSgemmSmallStoreVector>()(Accumulators[Row], C + Row * ldc,
+            AlphaBroadcast, BetaBroadcast, ZeroMode);
+    }
+};
+
+template<size_t RowCount, size_t VectorCount>
 MLAS_FORCEINLINE
-float*
-MlasSgemmKernelLoop(
+void
+MlasSgemmSmallKernel(
     const float* A,
+    size_t StrideRowA,
+    size_t StrideKA,
     const float* B,
+    size_t ldb,
     float* C,
-    size_t CountK,
-    size_t CountM,
-    size_t CountN,
-    size_t lda,
     size_t ldc,
+    size_t K,
     float alpha,
-    bool ZeroMode
+    float beta
     )
 /*++
 
 Routine Description:
 
-    This routine steps through the rows of the input and output matrices calling
-    the kernel until all rows have been processed.
+    This routine computes a register blocked tile of RowCount rows and
+    VectorCount groups of four columns of matrix C for the small matrix path.
 
 Arguments:
 
-    A - Supplies the address of matrix A.
-
-    B - Supplies the address of matrix B. The matrix data has been packed using
-        MlasSgemmCopyPackB or MlasSgemmTransposePackB.
+    A - Supplies the address of the first row of the tile from matrix A.
 
-    C - Supplies the address of matrix C.
+    StrideRowA - Supplies the number of elements between rows of matrix A.
 
-    CountK - Supplies the number of columns from matrix A and the number of rows
-        from matrix B to iterate over.
+    StrideKA - Supplies the number of elements between columns of matrix A.
 
-    CountM - Supplies the number of rows from matrix A and matrix C to iterate
-        over.
+    B - Supplies the address of the first column of the tile from matrix B,
+        which is not transposed.
 
-    CountN - Supplies the number of columns from matrix B and matrix C to
-        iterate over.
+    ldb - Supplies the first dimension of matrix B.
 
-    lda - Supplies the first dimension of matrix A.
+    C - Supplies the address of the tile from matrix C.
 
     ldc - Supplies the first dimension of matrix C.
 
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
     alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
 
-    ZeroMode - Supplies true if the output matrix must be zero initialized,
-        else false if the output matrix is accumulated into.
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
 Return Value:
 
-    Returns the next address of matrix C.
+    None.
 
 --*/
 {
-    do {
+    MLAS_FLOAT32X4 Accumulators[RowCount][VectorCount];
 
-        size_t RowsHandled;
+    MlasLoopUnroll<RowCount, MlasSgemmSmallZeroRow<VectorCount>>()(Accumulators);
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-        RowsHandled = MlasPlatform.GemmFloatKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
-#elif defined(MLAS_TARGET_POWER)
-        RowsHandled = MlasSgemmKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
-#else
-        if (ZeroMode) {
-            RowsHandled = MlasSgemmKernelZero(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
-        } else {
-            RowsHandled = MlasSgemmKernelAdd(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+    for (size_t k = 0; k < K; k++) {
+
+        MLAS_FLOAT32X4 BElements[VectorCount];
+
+        MlasLoopUnroll<VectorCount, MlasSgemmSmallLoadBVector>()(BElements, B);
+        MlasLoopUnroll<RowCount, MlasSgemmSmallMultiplyAddRow<VectorCount>>()(Accumulators, A, StrideRowA, BElements);
+
+        A += StrideKA;
+        B += ldb;
+    }
+
+    MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+    MLAS_FLOAT32X4 BetaBroadcast = MlasBroadcastFloat32x4(beta);
+
+    MlasLoopUnroll<RowCount, MlasSgemmSmallStoreRow<VectorCount>>()(Accumulators, C, ldc,
+        AlphaBroadcast, BetaBroadcast, beta == 0.0f);
+}
+
+template<size_t RowCount, size_t CountN>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallKernelPartialN(
+    const float* A,
+    size_t StrideRowA,
+    size_t StrideKA,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t K,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a tile of RowCount rows and CountN columns of
+    matrix C for the small matrix path, where CountN is less than four.
+
+Arguments:
+
+    See MlasSgemmSmallKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Accumulators[RowCount][CountN] = {};
+
+    for (size_t k = 0; k < K; k++) {
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const float AElement = A[r * StrideRowA];
+
+            for (size_t n = 0; n < CountN; n++) {
+                Accumulators[r][n] += B[n] * AElement;
+            }
         }
-#endif
 
-        C += ldc * RowsHandled;
-        A += lda * RowsHandled;
-        CountM -= RowsHandled;
+        A += StrideKA;
+        B += ldb;
+    }
 
-    } while (CountM > 0);
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t n = 0; n < CountN; n++) {
 
-    return C;
+            float* c = C + r * ldc + n;
+            float Result = Accumulators[r][n] * alpha;
+
+            if (beta != 0.0f) {
+                Result = (*c * beta) + Result;
+            }
+
+            *c = Result;
+        }
+    }
 }
 
+template<size_t RowCount>
 void
-MlasSgemmOperation(
+MlasSgemmSmallRows(
+    const float* A,
+    size_t StrideRowA,
+    size_t StrideKA,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t N,
+    size_t K,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of matrix C for the small matrix path
+    by stepping through the columns with the largest tile that fits.
+
+Arguments:
+
+    See MlasSgemmSmallKernel. N supplies the number of columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    while (N - n >= 8) {
+        MlasSgemmSmallKernel<RowCount, 2>(A, StrideRowA, StrideKA, B + n, ldb, C + n, ldc, K, alpha, beta);
+        n += 8;
+    }
+
+    if (N - n >= 4) {
+        MlasSgemmSmallKernel<RowCount, 1>(A, StrideRowA, StrideKA, B + n, ldb, C + n, ldc, K, alpha, beta);
+        n += 4;
+    }
+
+    switch (N - n) {
+
+        case 3:
+            MlasSgemmSmallKernelPartialN<RowCount, 3>(A, StrideRowA, StrideKA, B + n, ldb, C + n, ldc, K, alpha, beta);
+            break;
+
+        case 2:
+            MlasSgemmSmallKernelPartialN<RowCount, 2>(A, StrideRowA, StrideKA, B + n, ldb, C + n, ldc, K, alpha, beta);
+            break;
+
+        case 1:
+            MlasSgemmSmallKernelPartialN<RowCount, 1>(A, StrideRowA, StrideKA, B + n, ldb, C + n, ldc, K, alpha, beta);
+            break;
+    }
+}
+
+MLAS_FORCEINLINE
+bool
+MlasSgemmIsSmall(
+    size_t M,
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the small matrix path should be used for
+    a SGEMM operation of the supplied dimensions.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+Return Value:
+
+    Returns true if the small matrix path should be used, else false.
+
+--*/
+{
+    return M <= MLAS_SGEMM_SMALL_THRESHOLD && N <= MLAS_SGEMM_SMALL_THRESHOLD &&
+        K <= MLAS_SGEMM_SMALL_THRESHOLD && M * N * K <= MLAS_SGEMM_SMALL_COMPLEXITY;
+}
+
+void
+MlasSgemmSmall(
     CBLAS_TRANSPOSE TransA,
     CBLAS_TRANSPOSE TransB,
     size_t M,
@@ -853,7 +1216,12 @@ MlasSgemmOperation(
 Routine Description:
 
     This routine implements the single precision matrix/matrix multiply
-    operation (SGEMM).
+    operation (SGEMM) for small matrices as selected by MlasSgemmIsSmall.
+
+    Matrix A is read in place and matrix B is read in place unless it is
+    transposed, so the setup cost of the packed kernels is avoided. The
+    register blocked tiles are selected at compile time from the rows and
+    columns that remain.
 
 Arguments:
 
@@ -890,29 +1258,226 @@ Return Value:
 
 --*/
 {
-    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
-    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+    float PanelB[MLAS_SGEMM_SMALL_THRESHOLD * MLAS_SGEMM_SMALL_THRESHOLD];
 
     //
-    // Handle the special case of a small M. The data from matrix B is not
-    // referenced multiple times, so using a local packed buffer is a wasted
-    // memory copy.
+    // The tiles step through the rows of matrix B, so a transposed matrix B
+    // is first copied to a local buffer.
     //
 
-    if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+    if (TransB != CblasNoTrans) {
 
-#if defined(MLAS_TARGET_AMD64)
+        for (size_t k = 0; k < K; k++) {
+            for (size_t n = 0; n < N; n++) {
+                PanelB[k * N + n] = B[n * ldb + k];
+            }
+        }
 
-        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+        B = PanelB;
+        ldb = N;
+    }
 
-        if (TransB == CblasNoTrans) {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
-        } else {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
-        }
+    const size_t StrideRowA = (TransA == CblasNoTrans) ? lda : 1;
+    const size_t StrideKA = (TransA == CblasNoTrans) ? 1 : lda;
 
-        if (SgemmKernelM1Routine != nullptr) {
+    size_t m = 0;
+
+    while (M - m >= 4) {
+        MlasSgemmSmallRows<4>(A + m * StrideRowA, StrideRowA, StrideKA, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+        m += 4;
+    }
+
+    switch (M - m) {
+
+        case 3:
+            MlasSgemmSmallRows<3>(A + m * StrideRowA, StrideRowA, StrideKA, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+            break;
+
+        case 2:
+            MlasSgemmSmallRows<2>(A + m * StrideRowA, StrideRowA, StrideKA, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+            break;
+
+        case 1:
+            MlasSgemmSmallRows<1>(A + m * StrideRowA, StrideRowA, StrideKA, B, ldb, C + m * ldc, ldc, N, K, alpha, beta);
+            break;
+    }
+}
+
+MLAS_FORCEINLINE
+float*
+MlasSgemmKernelLoop(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the rows of the input and output matrices calling
+    the kernel until all rows have been processed.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed using
+        MlasSgemmCopyPackB or MlasSgemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of rows
+        from matrix B to iterate over.
+
+    CountM - Supplies the number of rows from matrix A and matrix C to iterate
+        over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the next address of matrix C.
+
+--*/
+{
+    do {
+
+        size_t RowsHandled;
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+        RowsHandled = MlasPlatform.GemmFloatKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+#elif defined(MLAS_TARGET_POWER)
+        RowsHandled = MlasSgemmKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+#else
+        if (ZeroMode) {
+            RowsHandled = MlasSgemmKernelZero(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+        } else {
+            RowsHandled = MlasSgemmKernelAdd(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+        }
+#endif
+
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+
+    } while (CountM > 0);
+
+    return C;
+}
+
+void
+MlasSgemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor,
+    size_t RangeStartM,
+    size_t RangeStartN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    OutputProcessor - Optionally supplies the processor to invoke on each
+        completed tile of matrix C.
+
+    RangeStartM - Supplies the row of the full output matrix that matrix C
+        starts at, as reported to the output processor.
+
+    RangeStartN - Supplies the column of the full output matrix that matrix C
+        starts at, as reported to the output processor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+
+    //
+    // Handle the special case of a small M. The data from matrix B is not
+    // referenced multiple times, so using a local packed buffer is a wasted
+    // memory copy.
+    //
+
+    if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+
+#if defined(MLAS_TARGET_AMD64)
+
+        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+
+        if (TransB == CblasNoTrans) {
+            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
+        } else {
+            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
+        }
+
+        if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C, RangeStartM, RangeStartN, 1, N, ldc);
+            }
             return;
         }
 
@@ -920,6 +1485,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C, RangeStartM, RangeStartN, 1, N, ldc);
+            }
             return;
         }
 
@@ -948,6 +1516,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C, RangeStartM, RangeStartN, M, 1, ldc);
+            }
             return;
         }
 
@@ -1059,6 +1630,15 @@ Return Value:
 
             ZeroMode = false;
         }
+
+        //
+        // Process the completed slice of the output matrix while it is still
+        // in cache.
+        //
+
+        if (OutputProcessor != nullptr) {
+            OutputProcessor->Process(C + n, RangeStartM, RangeStartN + n, M, CountN, ldc);
+        }
     }
 }
 
@@ -1073,10 +1653,13 @@ MlasSgemmPackedOperation(
     const float* A,
     size_t lda,
     const void* PackedB,
+    float* PanelB,
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor,
+    size_t RangeStartM
     )
 /*++
 
@@ -1106,9 +1689,11 @@ Arguments:
 
     PackedB - Supplies the address of packed matrix B.
 
-    AlignedN - Supplies the total number of aligned columns for packed matrix B.
+    PanelB - Supplies the buffer to expand each slice of half precision packed
+        matrix B into if matrix B was packed by MlasGemmPackBHalf, else nullptr
+        if packed by MlasGemmPackB.
 
-    ldb - Supplies the first dimension of matrix B.
+    AlignedN - Supplies the total number of aligned columns for packed matrix B.
 
     beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
@@ -1116,6 +1701,12 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    OutputProcessor - Optionally supplies the processor to invoke on each
+        completed tile of matrix C.
+
+    RangeStartM - Supplies the row of the full output matrix that matrix C
+        starts at, as reported to the output processor.
+
 Return Value:
 
     None.
@@ -1124,6 +1715,14 @@ Return Value:
 {
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
+    const bool PackedBIsHalf = (PanelB != nullptr);
+
+    //
+    // Half precision slices are narrower to fit the expansion buffer.
+    //
+
+    const size_t StrideN = PackedBIsHalf ? MLAS_SGEMM_PACKED_HALF_STRIDEN : MLAS_SGEMM_PACKED_STRIDEN;
+
     //
     // Step through each slice of matrix B along the N dimension.
     //
@@ -1134,7 +1733,7 @@ Return Value:
 
         const size_t SliceStartN = RangeStartN + n;
 
-        CountN = std::min(RangeCountN - n, size_t(MLAS_SGEMM_PACKED_STRIDEN));
+        CountN = std::min(RangeCountN - n, StrideN);
 
         //
         // Multiply the output matrix by beta as needed.
@@ -1159,7 +1758,31 @@ Return Value:
             // Step through each slice of matrix A along the M dimension.
             //
 
-            const float* pb = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
+            const float* pb;
+
+            if (PackedBIsHalf) {
+
+                //
+                // The packed columns are zero padded to a multiple of 16.
+                //
+
+                const size_t AlignedCountN = (CountN + 15) & ~size_t(15);
+
+#if defined(MLAS_TARGET_AMD64)
+                MlasPlatform.ConvertHalfToFloatKernel(
+#else
+                MlasConvertHalfToFloatKernel(
+#endif
+                    (const unsigned short*)PackedB + AlignedN * k + CountK * SliceStartN, PanelB,
+                    CountK * AlignedCountN);
+
+                pb = PanelB;
+
+            } else {
+
+                pb = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
+            }
+
             float* c = C + n;
 
             if (TransA == CblasNoTrans) {
@@ -1195,9 +1818,62 @@ Return Value:
 
             ZeroMode = false;
         }
+
+        //
+        // Process the completed slice of the output matrix while it is still
+        // in cache.
+        //
+
+        if (OutputProcessor != nullptr) {
+            OutputProcessor->Process(C + n, RangeStartM, SliceStartN, M, CountN, ldc);
+        }
     }
 }
 
+void
+MlasSgemmPackedHalfOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor,
+    size_t RangeStartM
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for matrix B packed by MlasGemmPackBHalf.
+
+    The buffer used to expand matrix B to single precision is local to this
+    routine so that the single precision packed path does not reserve it.
+
+Arguments:
+
+    See MlasSgemmPackedOperation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_PACKED_HALF_STRIDEN * MLAS_SGEMM_PACKED_STRIDEK], 16 * sizeof(float));
+
+    MlasSgemmPackedOperation(TransA, M, RangeStartN, RangeCountN, K, alpha, A,
+        lda, PackedB, PanelB, AlignedN, beta, C, ldc, OutputProcessor, RangeStartM);
+}
+
 void
 MlasSgemmThreaded(
     void* Context,
@@ -1208,7 +1884,7 @@ MlasSgemmThreaded(
 Routine Description:
 
     This routine is invoked from a worker thread to execute a segment of a
-    SGEMM operation.
+    SGEMM operation or of a batch of SGEMM operations.
 
 Arguments:
 
@@ -1226,9 +1902,21 @@ Return Value:
 
     const int32_t ThreadCountM = WorkBlock->ThreadCountM;
     const int32_t ThreadCountN = WorkBlock->ThreadCountN;
+    const int32_t ThreadCountGemm = ThreadCountM * ThreadCountN;
+
+    const int32_t ThreadIdBatch = ThreadId / ThreadCountGemm;
+    const int32_t ThreadIdM = (ThreadId % ThreadCountGemm) / ThreadCountN;
+    const int32_t ThreadIdN = (ThreadId % ThreadCountGemm) % ThreadCountN;
+
+    //
+    // Partition the operation along the batch dimension.
+    //
+
+    size_t RangeStartBatch;
+    size_t RangeCountBatch;
 
-    const int32_t ThreadIdM = ThreadId / ThreadCountN;
-    const int32_t ThreadIdN = ThreadId % ThreadCountN;
+    MlasPartitionWork(ThreadIdBatch, WorkBlock->ThreadCountBatch, WorkBlock->BatchSize,
+        &RangeStartBatch, &RangeCountBatch);
 
     //
     // Partition the operation along the M dimension.
@@ -1259,34 +1947,78 @@ Return Value:
 
     RangeCountN = std::min(N - RangeStartN, RangeCountN);
 
+    if (RangeCountM == 0 || RangeCountN == 0) {
+        return;
+    }
+
     //
-    // Dispatch the partitioned operation.
+    // Dispatch the partitioned operation for each matrix of the batch range.
     //
 
     CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
+    CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
+
+    for (size_t b = RangeStartBatch; b < RangeStartBatch + RangeCountBatch; b++) {
+
+        const float* A;
+        size_t lda;
+        const float* B;
+        size_t ldb;
+        float* C;
+        size_t ldc;
+
+        if (WorkBlock->Data != nullptr) {
+            const MLAS_SGEMM_DATA_PARAMS* Data = &WorkBlock->Data[b];
+            A = Data->A;
+            lda = Data->lda;
+            B = Data->B;
+            ldb = Data->ldb;
+            C = Data->C;
+            ldc = Data->ldc;
+        } else {
+            A = WorkBlock->A + b * WorkBlock->StrideA;
+            lda = WorkBlock->lda;
+            B = (WorkBlock->B != nullptr) ? WorkBlock->B + b * WorkBlock->StrideB : nullptr;
+            ldb = WorkBlock->ldb;
+            C = WorkBlock->C + b * WorkBlock->StrideC;
+            ldc = WorkBlock->ldc;
+        }
 
-    const size_t lda = WorkBlock->lda;
-    const size_t ldc = WorkBlock->ldc;
+        A += RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
+        C += RangeStartM * ldc + RangeStartN;
 
-    const float* A = WorkBlock->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
-    float* C = WorkBlock->C + RangeStartM * ldc + RangeStartN;
+        if (B != nullptr) {
 
-    if (WorkBlock->B != nullptr) {
+            B += RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
-        CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
+            if (MlasSgemmIsSmall(RangeCountM, RangeCountN, WorkBlock->K)) {
+                MlasSgemmSmall(TransA, TransB, RangeCountM, RangeCountN, WorkBlock->K,
+                    WorkBlock->alpha, A, lda, B, ldb, WorkBlock->beta, C, ldc);
+                if (WorkBlock->OutputProcessor != nullptr) {
+                    WorkBlock->OutputProcessor->Process(C, RangeStartM, RangeStartN,
+                        RangeCountM, RangeCountN, ldc);
+                }
+                continue;
+            }
 
-        const size_t ldb = WorkBlock->ldb;
+            MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, WorkBlock->K,
+                WorkBlock->alpha, A, lda, B, ldb, WorkBlock->beta, C, ldc,
+                WorkBlock->OutputProcessor, RangeStartM, RangeStartN);
 
-        const float* B = WorkBlock->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
+        } else if (WorkBlock->PackedBIsHalf) {
 
-        MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, WorkBlock->K,
-            WorkBlock->alpha, A, lda, B, ldb, WorkBlock->beta, C, ldc);
+            MlasSgemmPackedHalfOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
+                WorkBlock->K, WorkBlock->alpha, A, lda, WorkBlock->PackedB,
+                BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, WorkBlock->beta, C, ldc,
+                WorkBlock->OutputProcessor, RangeStartM);
 
-    } else {
+        } else {
 
-        MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
-            WorkBlock->K, WorkBlock->alpha, A, lda, WorkBlock->PackedB,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, WorkBlock->beta, C, ldc);
+            MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
+                WorkBlock->K, WorkBlock->alpha, A, lda, WorkBlock->PackedB, nullptr,
+                BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, WorkBlock->beta, C, ldc,
+                WorkBlock->OutputProcessor, RangeStartM);
+        }
     }
 }
 
@@ -1302,6 +2034,11 @@ Routine Description:
     This routine schedules the single precision matrix/matrix multiply
     operation (SGEMM) across one or more threads.
 
+    For a batch of SGEMM operations, the complete batch x M x N space is
+    partitioned with a single dispatch to the thread pool: small batches are
+    first split across threads by matrix and any remaining threads then
+    partition each matrix along the M or N dimension.
+
 Arguments:
 
     WorkBlock - Supplies the structure containing the GEMM parameters.
@@ -1315,6 +2052,7 @@ Return Value:
 
 --*/
 {
+    const size_t BatchSize = WorkBlock->BatchSize;
     const size_t M = WorkBlock->M;
     const size_t N = WorkBlock->N;
     const size_t K = WorkBlock->K;
@@ -1322,24 +2060,45 @@ Return Value:
     //
     // Compute the number of target threads given the complexity of the SGEMM
     // operation. Small requests should run using the single threaded path.
+    // Each matrix of a batch is limited to the maximum thread count used for
+    // a single SGEMM operation.
     //
 
-    const double Complexity = double(M) * double(N) * double(K);
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    const double TargetThreads = std::min(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY) + 1.0,
+        double(MLAS_MAXIMUM_THREAD_COUNT) * double(BatchSize));
 
     int32_t TargetThreadCount;
 
-    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
-        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreads >= double(MaximumThreadCount)) {
+        TargetThreadCount = MaximumThreadCount;
     } else {
-        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        TargetThreadCount = int32_t(TargetThreads);
     }
 
-    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    //
+    // Distribute the matrices of the batch across the threads. If there are
+    // fewer matrices than threads, then the remaining threads are used to
+    // segment each matrix.
+    //
 
-    if (TargetThreadCount >= MaximumThreadCount) {
-        TargetThreadCount = MaximumThreadCount;
+    if (size_t(TargetThreadCount) <= BatchSize) {
+
+        WorkBlock->ThreadCountBatch = TargetThreadCount;
+        WorkBlock->ThreadCountM = 1;
+        WorkBlock->ThreadCountN = 1;
+
+        MlasExecuteThreaded(MlasSgemmThreaded, WorkBlock, TargetThreadCount, ThreadPool);
+        return;
     }
 
+    WorkBlock->ThreadCountBatch = int32_t(BatchSize);
+
+    TargetThreadCount = int32_t((size_t(TargetThreadCount) + BatchSize - 1) / BatchSize);
+
     //
     // Segment the operation across multiple threads.
     //
@@ -1369,7 +2128,8 @@ Return Value:
         WorkBlock->ThreadCountN = 1;
     }
 
-    MlasExecuteThreaded(MlasSgemmThreaded, WorkBlock, TargetThreadCount, ThreadPool);
+    MlasExecuteThreaded(MlasSgemmThreaded, WorkBlock,
+        TargetThreadCount * WorkBlock->ThreadCountBatch, ThreadPool);
 }
 
 void
@@ -1388,7 +2148,8 @@ MlasGemm(
     float beta,
     float* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1429,12 +2190,28 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    OutputProcessor - Optionally supplies the processor to invoke on each
+        completed tile of matrix C.
+
 Return Value:
 
     None.
 
 --*/
 {
+    //
+    // Handle the case of small matrices, where the cost of scheduling the
+    // operation and of packing matrix B dominates the multiply.
+    //
+
+    if (MlasSgemmIsSmall(M, N, K)) {
+        MlasSgemmSmall(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+        if (OutputProcessor != nullptr) {
+            OutputProcessor->Process(C, 0, 0, M, N, ldc);
+        }
+        return;
+    }
+
     MLAS_SGEMM_WORK_BLOCK WorkBlock;
 
     //
@@ -1456,6 +2233,8 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.BatchSize = 1;
+    WorkBlock.OutputProcessor = OutputProcessor;
 
     //
     // Schedule the operation across a set of worker threads.
@@ -1478,7 +2257,8 @@ MlasGemm(
     float beta,
     float* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1515,6 +2295,9 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    OutputProcessor - Optionally supplies the processor to invoke on each
+        completed tile of matrix C.
+
 Return Value:
 
     None.
@@ -1540,6 +2323,205 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.BatchSize = 1;
+    WorkBlock.OutputProcessor = OutputProcessor;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasSgemmSchedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    float beta,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same shape. The matrices of the batch
+    are described by an array of pointers and leading dimensions.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for each matrix A.
+
+    TransB - Supplies the transpose operation for each matrix B.
+
+    M - Supplies the number of rows of each matrix A and matrix C.
+
+    N - Supplies the number of columns of each matrix B and matrix C.
+
+    K - Supplies the number of columns of each matrix A and the number of rows
+        of each matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    Data - Supplies an array of BatchSize entries describing the addresses
+        and the first dimensions of matrices A, B, and C.
+
+    BatchSize - Supplies the number of matrix multiplications.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchSize == 0) {
+        return;
+    }
+
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block.
+    //
+
+    memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_WORK_BLOCK));
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.BatchSize = BatchSize;
+    WorkBlock.Data = Data;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasSgemmSchedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same shape. The matrices of the batch
+    are located at a fixed stride from each other.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for each matrix A.
+
+    TransB - Supplies the transpose operation for each matrix B.
+
+    M - Supplies the number of rows of each matrix A and matrix C.
+
+    N - Supplies the number of columns of each matrix B and matrix C.
+
+    K - Supplies the number of columns of each matrix A and the number of rows
+        of each matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first matrix A.
+
+    lda - Supplies the first dimension of each matrix A.
+
+    StrideA - Supplies the number of elements between consecutive matrices A.
+        A stride of zero broadcasts the same matrix to the complete batch.
+
+    B - Supplies the address of the first matrix B.
+
+    ldb - Supplies the first dimension of each matrix B.
+
+    StrideB - Supplies the number of elements between consecutive matrices B.
+        A stride of zero broadcasts the same matrix to the complete batch.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of the first matrix C.
+
+    ldc - Supplies the first dimension of each matrix C.
+
+    StrideC - Supplies the number of elements between consecutive matrices C.
+
+    BatchSize - Supplies the number of matrix multiplications.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchSize == 0) {
+        return;
+    }
+
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block.
+    //
+
+    memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_WORK_BLOCK));
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.BatchSize = BatchSize;
+    WorkBlock.StrideA = StrideA;
+    WorkBlock.StrideB = StrideB;
+    WorkBlock.StrideC = StrideC;
 
     //
     // Schedule the operation across a set of worker threads.
@@ -1648,3 +2630,189 @@ Return Value:
         PackedB = (float*)PackedB + AlignedN * CountK;
     }
 }
+
+size_t
+MLASCALL
+MlasGemmPackBHalfSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer
+    of half precision values.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    //
+    // Compute the number of bytes required to hold the packed buffer.
+    //
+
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = AlignedN * K * sizeof(unsigned short);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const unsigned short* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B of half precision values to the
+    destination buffer. The destination buffer should be sized based on
+    MlasGemmPackBHalfSize(). For best performance, the destination buffer
+    should be aligned to the value returned from
+    MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+        MlasSgemmPackBHalfStrip(TransB, (unsigned short*)PackedB,
+            B + ((TransB == CblasNoTrans) ? k * ldb : k), ldb, N, CountK);
+
+        PackedB = (unsigned short*)PackedB + AlignedN * CountK;
+    }
+}
+
+void
+MLASCALL
+MlasGemmPackedBHalf(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B packed from half precision values.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B from MlasGemmPackBHalf.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block.
+    //
+
+    memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_WORK_BLOCK));
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.PackedB = PackedB;
+    WorkBlock.PackedBIsHalf = true;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.BatchSize = 1;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasSgemmSchedule(&WorkBlock, ThreadPool);
+}
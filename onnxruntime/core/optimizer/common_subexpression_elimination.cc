@@ -76,6 +76,11 @@ void UpdateHashWithContainer(const Container& c, std::size_t& hash) {
 
 using OutputIndex = int;
 
+class EquivalenceClass;
+
+// Explicit inputs to an operation, sequence of inputs for each formal parameter.
+using OperationInputs = std::vector<std::vector<const EquivalenceClass*>>;
+
 constexpr OutputIndex kInvalidOutputIndex = -1;
 
 const NodeArg* Normalize(const NodeArg* node_arg) {
@@ -89,7 +94,7 @@ class EquivalenceClass {
   bool operator==(const EquivalenceClass& other) const;
 
   friend struct ::std::hash<EquivalenceClass>;
-  friend std::vector<std::vector<const EquivalenceClass*>> Normalize(const Node& node, const std::vector<const EquivalenceClass*>& inputs);
+  friend OperationInputs Normalize(const Node& node, const std::vector<const EquivalenceClass*>& inputs);
 
   explicit EquivalenceClass(const NodeArg* non_op_value)
       : attributes_(nullptr),
@@ -99,27 +104,32 @@ class EquivalenceClass {
         hash_(CalculateHash()) {
   }
 
-  EquivalenceClass(const Node& node, const std::vector<const EquivalenceClass*>& explicit_inputs,
+  // operation_hash is the hash of the operation shared by all outputs of the node, see CalculateOperationHash().
+  EquivalenceClass(const Node& node, const OperationInputs& inputs, std::size_t operation_hash,
                    OutputIndex output_index, int discriminator)
       : op_type_(node.OpType()),
         domain_(node.Domain()),
-        inputs_(Normalize(node, explicit_inputs)),
+        inputs_(inputs),
         attributes_(&node.GetAttributes()),
         output_index_(output_index),
         non_op_value_(nullptr),
         discriminator_(discriminator),
-        hash_(CalculateHash()) {
+        hash_(CalculateHash(operation_hash)) {
   }
 
+  // Hash of the operation, attributes and input equivalence classes of a node. Inputs are hashed by the cached
+  // hash of their equivalence class, so every subexpression is hashed once no matter how deep it is.
+  static std::size_t CalculateOperationHash(const Node& node, const OperationInputs& inputs);
+
  private:
-  std::size_t CalculateHash() const;
+  std::size_t CalculateHash(std::size_t operation_hash = 0) const;
 
   // Operation and domain of the node that produces this value.
   const std::string op_type_;
   const std::string domain_;
 
   // Explicit inputs to the operation, sequence of inputs for each formal parameter.
-  const std::vector<std::vector<const EquivalenceClass*>> inputs_;
+  const OperationInputs inputs_;
 
   // Attributes of the operation.
   const NodeAttributes* attributes_;
@@ -141,10 +151,10 @@ class EquivalenceClass {
   const std::size_t hash_;
 };
 
-std::vector<std::vector<const EquivalenceClass*>> Normalize(const Node& node, const std::vector<const EquivalenceClass*>& inputs) {
+OperationInputs Normalize(const Node& node, const std::vector<const EquivalenceClass*>& inputs) {
   const auto& arg_count = node.InputArgCount();
   auto input_iter = inputs.begin();
-  std::vector<std::vector<const EquivalenceClass*>> result(arg_count.size());
+  OperationInputs result(arg_count.size());
 
   for (std::size_t arg_index = 0; arg_index < arg_count.size(); ++arg_index) {
     auto& arg = result[arg_index];
@@ -269,21 +279,16 @@ bool EquivalenceClass::operator==(const EquivalenceClass& other) const {
          SameAttributes(attributes_, other.attributes_);
 }
 
-std::size_t EquivalenceClass::CalculateHash() const {
+std::size_t EquivalenceClass::CalculateOperationHash(const Node& node, const OperationInputs& inputs) {
   std::size_t hash = 0;
-  UpdateHash(output_index_, hash);
-  UpdateHash(discriminator_, hash);
-  UpdateHash(non_op_value_, hash);
-  UpdateHash(op_type_, hash);
-  UpdateHash(domain_, hash);
-  if (attributes_ != nullptr) {
-    for (const auto& kv : *attributes_) {
-      UpdateHash(kv.first, hash);
-      UpdateHash(kv.second, &GetAttributeHash, hash);
-    }
+  UpdateHash(node.OpType(), hash);
+  UpdateHash(node.Domain(), hash);
+  for (const auto& kv : node.GetAttributes()) {
+    UpdateHash(kv.first, hash);
+    UpdateHash(kv.second, &GetAttributeHash, hash);
   }
 
-  for (const auto& arg : inputs_) {
+  for (const auto& arg : inputs) {
     for (const EquivalenceClass* input : arg) {
       UpdateHash(input, DeepPointerHash{}, hash);
     }
@@ -292,6 +297,15 @@ std::size_t EquivalenceClass::CalculateHash() const {
   return hash;
 }
 
+std::size_t EquivalenceClass::CalculateHash(std::size_t operation_hash) const {
+  // The operation is hashed once per node by CalculateOperationHash and only combined with the output here.
+  std::size_t hash = operation_hash;
+  UpdateHash(output_index_, hash);
+  UpdateHash(discriminator_, hash);
+  UpdateHash(non_op_value_, hash);
+  return hash;
+}
+
 // Representative of an equivalence class.
 // node_index and output_index define the node that produced the node_arg.
 // For inputs and constant initializers, output_index == kInvalidOutputIndex.
@@ -353,6 +367,10 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
 
   int unique_discriminator = 1;
 
+  // Nodes, in topological order, with at least one output that is not the representative of its equivalence class.
+  // Only these can be eliminated, so the replacement pass below visits them instead of the whole graph.
+  std::vector<NodeIndex> nodes_with_duplicate_outputs;
+
   for (NodeIndex node_index : node_topology_list) {
     Node* node = graph.GetNode(node_index);
     if (node == nullptr)
@@ -382,10 +400,15 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
       discriminator = ++unique_discriminator;
     }
 
+    const OperationInputs operation_inputs = Normalize(*node, input_values);
+    const std::size_t operation_hash = EquivalenceClass::CalculateOperationHash(*node, operation_inputs);
+
+    bool has_duplicate_output = false;
     for (OutputIndex output_index = 0, end = static_cast<int>(node->OutputDefs().size());
          output_index < end; ++output_index) {
       const NodeArg* output_def = node->OutputDefs()[output_index];
-      auto equivalence_class = onnxruntime::make_unique<EquivalenceClass>(*node, input_values, output_index, discriminator);
+      auto equivalence_class = onnxruntime::make_unique<EquivalenceClass>(*node, operation_inputs, operation_hash,
+                                                                          output_index, discriminator);
       auto* raw_ptr = equivalence_class.get();
 
       auto it = value_to_representative.find(raw_ptr);
@@ -393,16 +416,26 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
         unique_equivalence_classes.push_back(std::move(equivalence_class));
         it = value_to_representative.emplace_hint(it, raw_ptr,
                                                   Representative{output_def, node_index, output_index});
+      } else {
+        has_duplicate_output = true;
       }
 
       equivalence_classes[output_def] = it->first;
     }
+
+    if (has_duplicate_output) {
+      nodes_with_duplicate_outputs.push_back(node_index);
+    }
+  }
+
+  if (nodes_with_duplicate_outputs.empty()) {
+    return Status::OK();
   }
 
   std::unordered_set<const NodeArg*> graph_outputs;
   graph_outputs.insert(graph_viewer.GetOutputs().begin(), graph_viewer.GetOutputs().end());
 
-  for (NodeIndex node_index : node_topology_list) {
+  for (NodeIndex node_index : nodes_with_duplicate_outputs) {
     Node* node = graph.GetNode(node_index);
     if (node == nullptr)
       continue;
@@ -5,6 +5,7 @@
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
+#include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
 
@@ -55,8 +56,44 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
+// A kernel registration is matched on the op and the types of a node's inputs and outputs, so the registration found
+// for one node applies to every node with the same op and types. Look it up once for each of those in a pass.
+static const KernelCreateInfo* FindKernelCreateInfo(
+    const IExecutionProvider& execution_provider, const Node& node,
+    std::unordered_map<std::string, const KernelCreateInfo*>& kernel_create_infos) {
+  std::string key = node.Domain() + ':' + node.OpType() + ':' + std::to_string(node.SinceVersion());
+  auto add_types = [&key](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+    key += '|';
+    for (const auto* def : defs) {
+      key += ',';
+      if (def->Exists() && def->Type() != nullptr) {
+        key += *def->Type();
+      }
+    }
+  };
+
+  add_types(node.InputDefs());
+  add_types(node.OutputDefs());
+
+  auto entry = kernel_create_infos.find(key);
+  if (entry == kernel_create_infos.end()) {
+    const KernelCreateInfo* kernel_create_info = nullptr;
+    if (!execution_provider.GetKernelRegistry()->TryFindKernel(node, execution_provider.Type(),
+                                                                &kernel_create_info)
+             .IsOK()) {
+      kernel_create_info = nullptr;
+    }
+
+    entry = kernel_create_infos.emplace(std::move(key), kernel_create_info).first;
+  }
+
+  return entry->second;
+}
+
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  bool have_updated_nodes = false;
+  // Nodes downstream of a folded node whose output shapes may change once shape inferencing is re-run.
+  std::unordered_set<NodeIndex> nodes_to_reinfer;
+  std::unordered_map<std::string, const KernelCreateInfo*> kernel_create_infos;
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
@@ -68,12 +105,15 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
 
     ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
 
-    // Updating a node may allow shape inferencing to infer output shapes of following nodes,
-    // so re-run the shape inferencing. use have_updated_nodes as that only applies to this Graph
-    // (vs. 'modified' which is passed into subgraphs and applies to the main graph and all subgraphs)
+    // Folding a node may allow shape inferencing to infer output shapes of the nodes consuming its outputs,
+    // and in turn of their consumers, so re-run the shape inferencing on those nodes only. This only applies to
+    // this Graph (vs. 'modified' which is passed into subgraphs and applies to the main graph and all subgraphs).
     // Ignore any control flow node containing subgraphs as UpdateShapeInference is not intended to be used on it.
-    if (have_updated_nodes && !node->ContainsSubgraph()) {
+    if (nodes_to_reinfer.erase(i) && !node->ContainsSubgraph()) {
       ORT_RETURN_IF_ERROR(graph.UpdateShapeInference(*node));
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        nodes_to_reinfer.insert(it->Index());
+      }
     }
 
     bool converted_to_constant = false;
@@ -116,7 +156,8 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         node->SetExecutionProviderType(kCpuExecutionProvider);
       }
 
-      auto kernel = info.CreateKernel(node);
+      const auto* kernel_create_info = FindKernelCreateInfo(execution_provider_, *node, kernel_create_infos);
+      auto kernel = kernel_create_info != nullptr ? info.CreateKernel(node, *kernel_create_info) : nullptr;
 
       // undo the EP change to the value that was assigned at graph partitioning time
       if (!cpu_ep) {
@@ -174,11 +215,14 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     if (converted_to_constant) {
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        nodes_to_reinfer.insert(it->Index());
+      }
+
       // Remove the output edges of the constant node and then remove the node itself.
       graph_utils::RemoveNodeOutputEdges(graph, *node);
       graph.RemoveNode(node->Index());
       modified = true;
-      have_updated_nodes = true;
     }
   }
 
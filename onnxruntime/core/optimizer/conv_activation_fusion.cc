@@ -90,6 +90,13 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
       continue;
     }
 
+    // the CPU FusedConv kernel is float only, Conv also supports float16
+    const auto* output_type = node->OutputDefs()[0]->Type();
+    if (node->GetExecutionProviderType() == kCpuExecutionProvider &&
+        (output_type == nullptr || *output_type != "tensor(float)")) {
+      continue;
+    }
+
     const auto& next_node = *(node->OutputNodesBegin());
 
     if (next_node.GetExecutionProviderType() != node->GetExecutionProviderType()) {
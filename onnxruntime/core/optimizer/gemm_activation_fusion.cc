@@ -56,6 +56,12 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
       continue;
     }
 
+    // FusedGemm is float only, Gemm also supports float16
+    const auto* output_type = node.OutputDefs()[0]->Type();
+    if (output_type == nullptr || *output_type != "tensor(float)") {
+      continue;
+    }
+
     const Node& next_node = *(node.OutputNodesBegin());
     if (!IsFusableActivation(next_node) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
       continue;
@@ -25,15 +25,30 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // A transformer that made no changes when last applied will make none when applied again unless another
+  // transformer has modified the graph since, so it can be skipped until then.
+  const auto& level_transformers = transformers->second;
+  std::vector<bool> at_fixed_point(level_transformers.size(), false);
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < level_transformers.size(); ++i) {
+      const auto& transformer = level_transformers[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      if (at_fixed_point[i])
+        continue;
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      if (modified) {
+        std::fill(at_fixed_point.begin(), at_fixed_point.end(), false);
+      } else {
+        at_fixed_point[i] = true;
+      }
     }
     if (!graph_changed) {
       break;
@@ -82,6 +82,13 @@ std::unique_ptr<const OpKernel> OptimizerExecutionFrame::Info::CreateKernel(cons
   return nullptr;
 }
 
+std::unique_ptr<const OpKernel> OptimizerExecutionFrame::Info::CreateKernel(
+    const Node* node, const KernelCreateInfo& kernel_create_info) const {
+  OpKernelInfo kernel_info(*node, *kernel_create_info.kernel_def, execution_provider_, initializers_,
+                           ort_value_name_idx_map_, FuncManager(), data_transfer_mgr_);
+  return std::unique_ptr<const OpKernel>(kernel_create_info.kernel_create_func(kernel_info));
+}
+
 // For optimizer, probably no need to pass feed_mlvalue_idxs, feeds to initialize IExecutionFrame.
 // If needed, the parameters of OptimizerExecutionFrame ctor can be changed later.
 OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info, const std::vector<int>& fetch_mlvalue_idxs)
@@ -15,6 +15,7 @@
 
 namespace onnxruntime {
 class DataTransferManager;
+struct KernelCreateInfo;
 
 class OptimizerExecutionFrame final : public IExecutionFrame {
  public:
@@ -53,6 +54,10 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
 
     std::unique_ptr<const OpKernel> CreateKernel(const Node* node) const;
 
+    // Create the kernel for a node from a kernel registration that was already looked up for it, e.g. for an
+    // earlier node with the same op and input/output types.
+    std::unique_ptr<const OpKernel> CreateKernel(const Node* node, const KernelCreateInfo& kernel_create_info) const;
+
     const DataTransferManager& GetDataTransferManager() const { return data_transfer_mgr_; }
 
    private:
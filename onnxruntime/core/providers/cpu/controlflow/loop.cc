@@ -189,6 +189,7 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
+  void SetupCarriedVarAllocators();
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
   // create the single Loop output from a collection of per-iteration outputs
@@ -210,9 +211,25 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // The loop carried variables are double buffered. The buffer fed to iteration N - 1 is dead once iteration N
+  // starts, so if nothing else refers to it the subgraph output for iteration N is written directly into it
+  // instead of a new buffer being allocated.
+  // spare buffer available for the next subgraph output of each loop carried variable
+  std::vector<OrtValue> carried_var_spares_;
+  // data of the buffer handed out to the subgraph for each loop carried variable in the current iteration
+  std::vector<const void*> carried_var_allocated_;
+  // data of the buffer that is currently fed in for each loop carried variable if that buffer is exclusively ours
+  std::vector<const void*> carried_var_owned_;
+  // custom allocators for the loop carried variable subgraph outputs. key is index in fetches.
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
+static const void* TensorDataOrNull(const OrtValue& value) {
+  return value.IsAllocated() && value.IsTensor() ? value.Get<Tensor>().DataRaw() : nullptr;
+}
+
 static Status ConcatenateCpuOutput(std::vector<OrtValue>& per_iteration_output,
                                    void* output, size_t output_size_in_bytes) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
@@ -405,9 +422,58 @@ Status LoopImpl::Initialize() {
 
   loop_output_tensors_.resize(info_.num_outputs - info_.num_loop_carried_vars);
 
+  SetupCarriedVarAllocators();
+
   return status;
 }
 
+void LoopImpl::SetupCarriedVarAllocators() {
+  carried_var_spares_.resize(info_.num_loop_carried_vars);
+  carried_var_allocated_.assign(info_.num_loop_carried_vars, nullptr);
+  carried_var_owned_.assign(info_.num_loop_carried_vars, nullptr);
+
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    // + 2 to skip 'M' and 'cond' Loop inputs. the element type of a loop carried variable can't change.
+    const auto* input = context_.GetInputMLValue(i + 2);
+    if (!input || !input->IsTensor()) {
+      continue;
+    }
+
+    const auto* element_type = input->Get<Tensor>().DataType();
+
+    // + 1 to skip 'cond' in the subgraph outputs
+    fetch_allocators_[i + 1] = [this, i, element_type](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                      OrtValue& ort_value, bool& allocated) {
+      auto& spare = carried_var_spares_[i];
+      if (spare.IsAllocated()) {
+        const auto& spare_tensor = spare.Get<Tensor>();
+        if (spare_tensor.Shape() == shape && spare_tensor.Location().device == location.device) {
+          ort_value = spare;
+        }
+
+        // the shape changed or the spare is being used, so either way we're done with it
+        spare = OrtValue();
+      }
+
+      if (!ort_value.IsAllocated()) {
+        auto allocator = session_state_.GetAllocator(location);
+        if (!allocator) {
+          // let the execution frame handle the allocation
+          return Status::OK();
+        }
+
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        ort_value.Init(new Tensor(element_type, shape, std::move(allocator)), ml_tensor, ml_tensor->GetDeleteFunc());
+      }
+
+      carried_var_allocated_[i] = ort_value.Get<Tensor>().DataRaw();
+      allocated = true;
+
+      return Status::OK();
+    };
+  }
+}
+
 void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   feeds.reserve(info_.num_subgraph_inputs + info_.num_implicit_inputs);
 
@@ -431,6 +497,27 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
+  // track which loop carried variable buffers can be re-used. a buffer is only re-used if we allocated it and
+  // no other subgraph output refers to it (e.g. the same value is also a loop output, or was passed through).
+  auto num_references = [&last_outputs](const void* data) {
+    return std::count_if(last_outputs.cbegin(), last_outputs.cend(),
+                         [data](const OrtValue& value) { return TensorDataOrNull(value) == data; });
+  };
+
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    // the input to the iteration that just completed is no longer needed unless it was passed through
+    const auto& last_input = next_inputs[i + 2];  // skip iter_num and cond
+    const void* last_input_data = TensorDataOrNull(last_input);
+    if (last_input_data && last_input_data == carried_var_owned_[i] && num_references(last_input_data) == 0) {
+      carried_var_spares_[i] = last_input;
+    }
+
+    const void* output_data = TensorDataOrNull(last_outputs[i + 1]);  // skip cond
+    bool owned = output_data && output_data == carried_var_allocated_[i] && num_references(output_data) == 1;
+    carried_var_owned_[i] = owned ? output_data : nullptr;
+    carried_var_allocated_[i] = nullptr;
+  }
+
   // simple copy for cond and loop carried vars. start at 1 to skip iter_num in input
   for (int i = 1; i < info_.num_subgraph_inputs; ++i) {
     next_inputs[i] = last_outputs[i - 1];
@@ -478,8 +565,14 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
-                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+    {
+      // Hold one parallel section while the subgraph runs so its kernels reuse the same set of workers instead
+      // of waking and synchronizing the pool for each of their parallel loops. The section ends before the
+      // outputs are saved so the workers do not spin through that serial work.
+      concurrency::ThreadPool::ParallelSection ps(context_.GetOperatorThreadPool());
+      status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators_,
+                                      ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+    }
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -269,8 +269,13 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     }
 
     // Create Executor and run graph.
-    status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
-                                    ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger());
+    {
+      // Hold one parallel section while the subgraph runs so its kernels reuse the same set of workers instead
+      // of waking and synchronizing the pool for each of their parallel loops.
+      concurrency::ThreadPool::ParallelSection ps(context.GetOperatorThreadPool());
+      status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
+                                      ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger());
+    }
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -43,6 +43,24 @@ Status Einsum::Compute(OpKernelContext* context) const {
   return DeviceCompute(context, inputs, allocator, tp);
 }
 
+std::vector<size_t> Einsum::GetContractionOrder(EinsumComputePreprocessor& einsum_compute_preprocessor) const {
+  const auto& homogenized_input_dims = einsum_compute_preprocessor.GetHomogenizedInputDims();
+
+  // The inputs are contracted left to right when there are less than 3 of them
+  if (homogenized_input_dims.size() < 3) {
+    return {};
+  }
+
+  std::lock_guard<OrtMutex> lock(contraction_order_mutex_);
+  if (contraction_order_input_dims_ != homogenized_input_dims) {
+    contraction_order_ = EinsumOp::ComputeContractionOrder(
+        homogenized_input_dims, einsum_compute_preprocessor.GetMappedSubscriptIndicesToOutputindices());
+    contraction_order_input_dims_ = homogenized_input_dims;
+  }
+
+  return contraction_order_;
+}
+
 Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                              AllocatorPtr allocator, concurrency::ThreadPool* tp) const {
   // EinsumComputePreprocessor section -
@@ -54,6 +72,8 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
   // Compute all required metadata to be used at Einsum compute time and return error status code if one was generated
   ORT_RETURN_IF_ERROR(einsum_compute_preprocessor.Run());
 
+  const auto contraction_order = GetContractionOrder(einsum_compute_preprocessor);
+
   // EinsumComputeProcessor section -
   if (inputs[0]->IsDataType<float>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<float>(context, allocator,
@@ -66,6 +86,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<float>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<float>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::DataCopy);
+    einsum_compute_processor.SetContractionOrder(contraction_order);
     return einsum_compute_processor.Run();
   } else if (inputs[0]->IsDataType<int32_t>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<int32_t>(context,
@@ -80,6 +101,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<int32_t>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::DataCopy);
 
+    einsum_compute_processor.SetContractionOrder(contraction_order);
     return einsum_compute_processor.Run();
   } else if (inputs[0]->IsDataType<double>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<double>(context,
@@ -93,6 +115,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<double>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<double>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::DataCopy);
+    einsum_compute_processor.SetContractionOrder(contraction_order);
     return einsum_compute_processor.Run();
   } else if (inputs[0]->IsDataType<int64_t>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<int64_t>(context,
@@ -106,6 +129,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::DataCopy);
 
+    einsum_compute_processor.SetContractionOrder(contraction_order);
     return einsum_compute_processor.Run();
   }
 
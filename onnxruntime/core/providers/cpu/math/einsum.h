@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include "einsum_utils/einsum_compute_preprocessor.h"
 #include "einsum_utils/einsum_typed_compute_processor.h"
 
@@ -25,8 +26,17 @@ class Einsum : public OpKernel {
   virtual Status DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp) const;
 
+  // Returns the order in which the inputs are contracted pair-wise (see EinsumOp::ComputeContractionOrder())
+  // The order only depends on the input shapes, so it is cached and re-used while the shapes don't change
+  std::vector<size_t> GetContractionOrder(EinsumComputePreprocessor& einsum_compute_preprocessor) const;
+
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+ private:
+  mutable OrtMutex contraction_order_mutex_;
+  mutable std::vector<TensorShape> contraction_order_input_dims_;
+  mutable std::vector<size_t> contraction_order_;
 };
 
 }  // namespace onnxruntime
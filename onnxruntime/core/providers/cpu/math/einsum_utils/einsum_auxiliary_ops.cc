@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
 
 using namespace onnxruntime::common;
 
@@ -28,25 +30,93 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
   return TransposeBase::DoTranspose(permutation, input, output, input_shape_override);
 }
 
+// Multiplies a single pair of matrices, either of which may be stored transposed
+template <typename T>
+static void MatMulSingleBatch(const T* input_1_data, const T* input_2_data, T* output_data,
+                              size_t M, size_t K, size_t N, bool transpose_input_1, bool transpose_input_2,
+                              concurrency::ThreadPool* tp) {
+  if (!transpose_input_1 && !transpose_input_2) {
+    math::MatMul<T>(static_cast<int>(M), static_cast<int>(N), static_cast<int>(K),
+                    input_1_data, input_2_data, output_data, tp);
+    return;
+  }
+
+  // Eigen matrices are column major, so compute the transposed output (N x M) = op(input_2)' * op(input_1)'
+  auto output_mat = EigenMatrixMap<T>(output_data, N, M);
+  if (transpose_input_1 && transpose_input_2) {
+    output_mat.noalias() = ConstEigenMatrixMap<T>(input_2_data, K, N).transpose() *
+                           ConstEigenMatrixMap<T>(input_1_data, M, K).transpose();
+  } else if (transpose_input_1) {
+    output_mat.noalias() = ConstEigenMatrixMap<T>(input_2_data, N, K) *
+                           ConstEigenMatrixMap<T>(input_1_data, M, K).transpose();
+  } else {
+    output_mat.noalias() = ConstEigenMatrixMap<T>(input_2_data, K, N).transpose() *
+                           ConstEigenMatrixMap<T>(input_1_data, K, M);
+  }
+}
+
+// double is multiplied with the (MLAS backed) Gemm which supports transposed inputs natively
+static void MatMulSingleBatch(const double* input_1_data, const double* input_2_data, double* output_data,
+                              size_t M, size_t K, size_t N, bool transpose_input_1, bool transpose_input_2,
+                              concurrency::ThreadPool* tp) {
+  math::Gemm<double, concurrency::ThreadPool>(transpose_input_1 ? CblasTrans : CblasNoTrans,
+                                              transpose_input_2 ? CblasTrans : CblasNoTrans,
+                                              M, N, K, 1.0, input_1_data, input_2_data, 0.0, output_data, tp);
+}
+
 // CPU specific MatMul helper
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
+  // When there are enough batches to keep all the threads busy, the batches are multiplied in parallel
+  // (each on a single thread). Otherwise each multiplication uses the thread pool.
+  if (num_batches > 1 &&
+      num_batches >= static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp))) {
+    const double flops = static_cast<double>(M) * static_cast<double>(N) * static_cast<double>(K);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_batches),
+        TensorOpCost{static_cast<double>((M + N) * K * sizeof(T)), static_cast<double>(M * N * sizeof(T)), flops * 2},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            MatMulSingleBatch(input_1_data + i * left_stride, input_2_data + i * right_stride,
+                              output_data + i * output_stride, M, K, N, transpose_input_1, transpose_input_2,
+                              nullptr);
+          }
+        });
+    return Status::OK();
+  }
+
   for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+    MatMulSingleBatch(input_1_data + i * left_stride, input_2_data + i * right_stride,
+                      output_data + i * output_stride, M, K, N, transpose_input_1, transpose_input_2, tp);
   }
 
   return Status::OK();
 }
 
+// float batches are multiplied by a single strided batched MLAS Gemm, which supports transposed inputs natively
+// and partitions all of the batches across the thread pool at once
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N,
+                     bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
+                     void* /*einsum_cuda_assets*/) {
+  MlasGemmBatch(transpose_input_1 ? CblasTrans : CblasNoTrans,
+                transpose_input_2 ? CblasTrans : CblasNoTrans,
+                M, N, K, 1.f,
+                input_1_data, transpose_input_1 ? M : K, left_stride,
+                input_2_data, transpose_input_2 ? K : N, right_stride,
+                0.f,
+                output_data, N, output_stride,
+                num_batches, tp);
+
+  return Status::OK();
+}
+
 // CPU specific ReduceSum helper
 template <typename T>
 Tensor ReduceSum(const Tensor& input, const std::vector<int64_t>& reduce_axes,
@@ -272,6 +342,26 @@ bool IsTransposeRequired(size_t input_rank, const std::vector<size_t>& permutati
   return transpose_required;
 }
 
+bool IsTransposeRequired(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutation) {
+  ORT_ENFORCE(input_dims.size() == permutation.size(), "The rank of the input must match permutation size for Transpose");
+
+  // The layout of the data only changes if the axes with a dim value greater than 1 are re-ordered
+  size_t last_permuted_axis = 0;
+  bool seen_non_trivial_axis = false;
+  for (const auto& axis : permutation) {
+    if (input_dims[axis] == 1) {
+      continue;
+    }
+    if (seen_non_trivial_axis && axis < last_permuted_axis) {
+      return true;
+    }
+    last_permuted_axis = axis;
+    seen_non_trivial_axis = true;
+  }
+
+  return false;
+}
+
 // The following are thin wrappers over device specific helpers
 std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t>& input_shape_override,
                                   const std::vector<size_t>& permutation, AllocatorPtr allocator,
@@ -304,6 +394,7 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t
 template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
                                const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+                               bool transpose_input_1, bool transpose_input_2,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                const DeviceHelpers::MatMul<T>& device_matmul_func) {
   // Sanity checks before the actual MatMul
@@ -336,7 +427,8 @@ std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>
   T* output_data = output->template MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N,
+                                   transpose_input_1, transpose_input_2, tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Exception during MatMul operation: ",
@@ -362,12 +454,14 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const std::vector<int64_t
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
     const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    bool transpose_input_1, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<float>& device_matmul_func);
 
@@ -386,12 +480,14 @@ template std::unique_ptr<Tensor> ReduceSum<float>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int32_t>(
     const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
     const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    bool transpose_input_1, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int32_t>& device_matmul_func);
 
@@ -411,12 +507,14 @@ template std::unique_ptr<Tensor> ReduceSum<int32_t>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<double>(
     const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
     const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    bool transpose_input_1, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<double>& device_matmul_func);
 
@@ -436,7 +534,8 @@ template std::unique_ptr<Tensor> ReduceSum<double>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template Tensor DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
@@ -448,6 +547,7 @@ template Tensor DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
 template std::unique_ptr<Tensor> MatMul<int64_t>(
     const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
     const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    bool transpose_input_1, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int64_t>& device_matmul_func);
 
@@ -31,10 +31,13 @@ using Transpose = std::function<Status(const std::vector<size_t>& permutation, c
                                        void* einsum_cuda_assets)>;
 
 // MatMul op - Multiplies two inputs of shapes [num_batches, M, K] and [num_batches, K, N]
+// If `transpose_input_1` is set, each matrix of the first input is stored as [K, M] instead
+// If `transpose_input_2` is set, each matrix of the second input is stored as [N, K] instead
 template <typename T>
 using MatMul = std::function<Status(const T* input_1_data, const T* input_2_data, T* output_data,
                                     size_t left_stride, size_t right_stride, size_t output_stride,
-                                    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                                    size_t num_batches, size_t M, size_t K, size_t N,
+                                    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
                                     void* einsum_cuda_assets)>;
 
 // ReduceSum op - Reduces along `reduce_axes`
@@ -67,9 +70,18 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
               void* einsum_cuda_assets);
 
+// float uses a single strided batched MLAS Gemm
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N,
+                     bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
+                     void* einsum_cuda_assets);
+
 template <typename T>
 Tensor ReduceSum(const Tensor& input, const std::vector<int64_t>& reduce_axes,
                  bool keep_dims, AllocatorPtr allocator,
@@ -85,6 +97,10 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 // This helps decide if we need to apply (and pay the cost) of a Transpose
 bool IsTransposeRequired(size_t input_rank, const std::vector<size_t>& permutation);
 
+// Same as above, but also considers the dim values of the input: moving axes with a dim value of 1 doesn't change
+// the layout of the data, so a permutation that only moves such axes can be applied with a Reshape instead
+bool IsTransposeRequired(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutation);
+
 // Thin wrapper over the Transpose op to be called from Einsum that does some checks and invokes the device specific helper
 std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t>& input_shape_override,
                                   const std::vector<size_t>& permutation, AllocatorPtr allocator, void* einsum_cuda_assets,
@@ -93,9 +109,13 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t
 // Thin wrapper over the MatMul op to be called from Einsum that does some checks and invokes the device specific helper
 // Not using the MatMulHelper for checks and to compute output dims as it adds a lot of checking overhead involving transposes of the inputs
 // In our case, we have a more simplistic version which doesn't need to have those checks
+// The shape overrides are the logical shapes [num_batches, M, K] and [num_batches, K, N] of the inputs
+// `transpose_input_1` and `transpose_input_2` indicate that the matrices of the corresponding input are stored
+// transposed (as [K, M] and [N, K] respectively)
 template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>& input_1_shape_override,
                                const Tensor& input_2, const std::vector<int64_t>& input_2_shape_override,
+                               bool transpose_input_1, bool transpose_input_2,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                const DeviceHelpers::MatMul<T>& device_matmul_func);
 
@@ -3,6 +3,9 @@
 
 #include "einsum_compute_preprocessor.h"
 
+#include <limits>
+#include <numeric>
+
 namespace onnxruntime {
 
 EinsumComputePreprocessor::EinsumComputePreprocessor(EinsumEquationPreprocessor& einsum_equation_preprocessor,
@@ -454,7 +457,7 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
     }
 
     // (Identify no-op transpose and prevent triggering the transpose)
-    if (EinsumOp::IsTransposeRequired(preprocessed ? preprocessed->Shape().GetDims().size() : inputs_[input_iter]->Shape().GetDims().size(),
+    if (EinsumOp::IsTransposeRequired(preprocessed ? preprocessed->Shape().GetDims() : inputs_[input_iter]->Shape().GetDims(),
                                       permutation)) {
       preprocessed = EinsumOp::Transpose(preprocessed ? *preprocessed : *inputs_[input_iter],
                                          preprocessed ? preprocessed->Shape().GetDims() : inputs_[input_iter]->Shape().GetDims(),
@@ -476,4 +479,126 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
   return Status::OK();
 }
 
+namespace EinsumOp {
+
+// Contracts `current` (the dims of the result so far) with `operand` and returns the number of multiply-adds
+// required to do so. Dims that neither appear in the output nor in any of the `remaining` operands are reduced.
+static double ContractOperand(std::vector<int64_t>& current, const std::vector<int64_t>& operand,
+                              const std::vector<const std::vector<int64_t>*>& remaining,
+                              const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  double cost = 1.0;
+  for (size_t i = 0; i < current.size(); ++i) {
+    current[i] = std::max(current[i], operand[i]);
+    cost *= static_cast<double>(current[i]);
+  }
+
+  for (size_t i = 0; i < current.size(); ++i) {
+    if (subscript_indices_to_output_indices[i] != -1) {
+      continue;
+    }
+    bool is_needed = false;
+    for (const auto* dims : remaining) {
+      if ((*dims)[i] > 1) {
+        is_needed = true;
+        break;
+      }
+    }
+    if (!is_needed) {
+      current[i] = 1;
+    }
+  }
+
+  return cost;
+}
+
+// Returns the total number of multiply-adds required to contract the inputs in the given order
+static double ContractionCost(const std::vector<std::vector<int64_t>>& input_dims, const std::vector<size_t>& order,
+                              const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  std::vector<const std::vector<int64_t>*> remaining;
+  for (size_t i = 1; i < order.size(); ++i) {
+    remaining.push_back(&input_dims[order[i]]);
+  }
+
+  std::vector<int64_t> current = input_dims[order[0]];
+  double cost = 0.0;
+  for (size_t i = 1; i < order.size(); ++i) {
+    remaining.erase(remaining.begin());
+    cost += ContractOperand(current, input_dims[order[i]], remaining, subscript_indices_to_output_indices);
+  }
+
+  return cost;
+}
+
+std::vector<size_t> ComputeContractionOrder(const std::vector<TensorShape>& homogenized_input_dims,
+                                            const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_inputs = homogenized_input_dims.size();
+
+  std::vector<std::vector<int64_t>> input_dims;
+  input_dims.reserve(num_inputs);
+  for (const auto& dims : homogenized_input_dims) {
+    input_dims.push_back(dims.GetDims());
+  }
+
+  std::vector<size_t> best_order(num_inputs);
+  std::iota(best_order.begin(), best_order.end(), 0);
+  if (num_inputs < 3) {
+    return best_order;
+  }
+
+  double best_cost = ContractionCost(input_dims, best_order, subscript_indices_to_output_indices);
+
+  // Greedily build an order from each possible first input: at each step, contract the input that is the cheapest
+  // to contract with the result so far
+  for (size_t first_input = 0; first_input < num_inputs; ++first_input) {
+    std::vector<size_t> order{first_input};
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < num_inputs; ++i) {
+      if (i != first_input) {
+        candidates.push_back(i);
+      }
+    }
+
+    std::vector<int64_t> current = input_dims[first_input];
+    double cost = 0.0;
+    while (!candidates.empty() && cost < best_cost) {
+      size_t best_candidate = 0;
+      double best_step_cost = std::numeric_limits<double>::max();
+      std::vector<int64_t> best_step_result;
+
+      for (size_t c = 0; c < candidates.size(); ++c) {
+        std::vector<const std::vector<int64_t>*> remaining;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+          if (i != c) {
+            remaining.push_back(&input_dims[candidates[i]]);
+          }
+        }
+
+        std::vector<int64_t> step_result = current;
+        double step_cost = ContractOperand(step_result, input_dims[candidates[c]], remaining,
+                                           subscript_indices_to_output_indices);
+        if (step_cost < best_step_cost) {
+          best_step_cost = step_cost;
+          best_candidate = c;
+          best_step_result = std::move(step_result);
+        }
+      }
+
+      cost += best_step_cost;
+      current = std::move(best_step_result);
+      order.push_back(candidates[best_candidate]);
+      candidates.erase(candidates.begin() + best_candidate);
+    }
+
+    // Only deviate from the left to right order if it is strictly cheaper
+    if (candidates.empty() && cost < best_cost) {
+      best_cost = cost;
+      best_order = std::move(order);
+    }
+  }
+
+  return best_order;
+}
+
+}  // namespace EinsumOp
+
 }  // namespace onnxruntime
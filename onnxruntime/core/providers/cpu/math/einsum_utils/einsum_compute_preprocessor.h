@@ -76,9 +76,8 @@ struct EinsumEquationPreprocessor {
   }
 
   // Holds the pre-processed equation string
-  // In theory, we could re-write the einsum equation to lower overall cost of intermediate arrays
-  // See numpy.einsum_path for details/examples
-  // These are very advanced optimizations that we don't require for the average use-case
+  // (The order in which the inputs are contracted is chosen at compute time based on the input shapes -
+  // see EinsumOp::ComputeContractionOrder())
   std::string einsum_preprocessed_equation_;
 
   // In explicit form, holds the left side of the einsum equation
@@ -225,4 +224,16 @@ class EinsumComputePreprocessor final {
   void* einsum_ep_assets_;
 };
 
+namespace EinsumOp {
+
+// Chooses the order in which 3 or more inputs are contracted pair-wise, based on the number of multiply-adds of
+// each pair-wise contraction (computed from the homogenized input dims).
+// The order is built greedily (contracting the cheapest input with the result so far at each step) and the left to
+// right order is kept unless the greedy order is strictly cheaper.
+// See numpy.einsum_path for details/examples
+std::vector<size_t> ComputeContractionOrder(const std::vector<TensorShape>& homogenized_input_dims,
+                                            const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+}  // namespace EinsumOp
+
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "einsum_typed_compute_processor.h"
 
+#include <numeric>
+
 namespace onnxruntime {
 
 template <typename T>
@@ -49,7 +51,7 @@ void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candidate_outp
 
   // Transpose to the required final output order
   // (Identify no-op transposes and prevent triggering the transpose)
-  if (EinsumOp::IsTransposeRequired(candidate_output_shape_without_reduced_dims.size(), output_permutation)) {
+  if (EinsumOp::IsTransposeRequired(candidate_output_shape_without_reduced_dims, output_permutation)) {
     auto candidate_output_transposed = EinsumOp::Transpose(candidate_output, candidate_output_shape_without_reduced_dims,
                                                            output_permutation,
                                                            allocator_, einsum_ep_assets_, device_transpose_func_);
@@ -137,11 +139,14 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
                     "Einsum op: Input dimensions must be equal along an axis to be reduced across all inputs");
         reduced_size *= left_dim;
       } else if (has_left_dim) {  // if it is only in one of left and right, we can reduce right away
+        // (reduce the already reduced operand if there are several such dims)
         current_left = EinsumOp::ReduceSum<T>(
-            left, left_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+            current_left ? *current_left : left, current_left ? current_left->Shape().GetDims() : left_dims, {i},
+            allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
       } else if (has_right_dim) {
         current_right = EinsumOp::ReduceSum<T>(
-            right, right_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+            current_right ? *current_right : right, current_right ? current_right->Shape().GetDims() : right_dims, {i},
+            allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
       }
     } else {  // This dimension is not reduced (i.e.) it appears in the output after processing these 2 operands
       // Both the left and right operands have non-trivial dimension value along this axis
@@ -165,33 +170,57 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
 
   // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
+  // If the axes are already ordered like this: [lro, reduce_dims, lo, ro], the left operand is multiplied
+  // as transposed matrices instead
   std::vector<size_t> left_permutation;
   left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
   left_permutation.insert(left_permutation.end(), lro.begin(), lro.end());
   left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
   left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
   left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().GetDims().size() : left_dims.size(),
-                                    left_permutation)) {
-    current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                       current_left ? current_left->Shape().GetDims() : left_dims,
-                                       left_permutation, allocator_, einsum_ep_assets_,
-                                       device_transpose_func_);
+  bool transpose_left = false;
+  const std::vector<int64_t> current_left_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+  if (EinsumOp::IsTransposeRequired(current_left_dims, left_permutation)) {
+    std::vector<size_t> left_transposed_permutation;
+    left_transposed_permutation.reserve(left_permutation.size());
+    left_transposed_permutation.insert(left_transposed_permutation.end(), lro.begin(), lro.end());
+    left_transposed_permutation.insert(left_transposed_permutation.end(), reduce_dims.begin(), reduce_dims.end());
+    left_transposed_permutation.insert(left_transposed_permutation.end(), lo.begin(), lo.end());
+    left_transposed_permutation.insert(left_transposed_permutation.end(), ro.begin(), ro.end());
+    if (EinsumOp::IsTransposeRequired(current_left_dims, left_transposed_permutation)) {
+      current_left = EinsumOp::Transpose(current_left ? *current_left : left, current_left_dims,
+                                         left_permutation, allocator_, einsum_ep_assets_,
+                                         device_transpose_func_);
+    } else {
+      transpose_left = true;
+    }
   }
 
   // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
+  // If the axes are already ordered like this: [lro, ro, reduce_dims, lo], the right operand is multiplied
+  // as transposed matrices instead
   std::vector<size_t> right_permutation;
   right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
   right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
   right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
   right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
   right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                        current_right ? current_right->Shape().GetDims() : right_dims,
-                                        right_permutation, allocator_, einsum_ep_assets_,
-                                        device_transpose_func_);
+  bool transpose_right = false;
+  const std::vector<int64_t> current_right_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+  if (EinsumOp::IsTransposeRequired(current_right_dims, right_permutation)) {
+    std::vector<size_t> right_transposed_permutation;
+    right_transposed_permutation.reserve(right_permutation.size());
+    right_transposed_permutation.insert(right_transposed_permutation.end(), lro.begin(), lro.end());
+    right_transposed_permutation.insert(right_transposed_permutation.end(), ro.begin(), ro.end());
+    right_transposed_permutation.insert(right_transposed_permutation.end(), reduce_dims.begin(), reduce_dims.end());
+    right_transposed_permutation.insert(right_transposed_permutation.end(), lo.begin(), lo.end());
+    if (EinsumOp::IsTransposeRequired(current_right_dims, right_transposed_permutation)) {
+      current_right = EinsumOp::Transpose(current_right ? *current_right : right, current_right_dims,
+                                          right_permutation, allocator_, einsum_ep_assets_,
+                                          device_transpose_func_);
+    } else {
+      transpose_right = true;
+    }
   }
 
   // Calculate output size
@@ -252,14 +281,23 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   // Multiply the mutated inputs
   auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, {lro_size, lo_size, reduced_size},
                                     current_right ? *current_right : right, {lro_size, reduced_size, ro_size},
+                                    transpose_left, transpose_right,
                                     allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
 
   output->Reshape(output_dims);
 
   if (!is_final_pair) {  // This is not the final pair - so bring the axes order to what the inputs conformed to
-    if (EinsumOp::IsTransposeRequired(output_dims.size(), output_permutation)) {
+    if (EinsumOp::IsTransposeRequired(output_dims, output_permutation)) {
       output = EinsumOp::Transpose(*output, output_dims, output_permutation, allocator_,
                                    einsum_ep_assets_, device_transpose_func_);
+    } else {
+      // Only axes with a dim value of 1 are moved, so the data is already in the required order
+      std::vector<int64_t> permuted_output_dims;
+      permuted_output_dims.reserve(output_permutation.size());
+      for (const auto& axis : output_permutation) {
+        permuted_output_dims.push_back(output_dims[axis]);
+      }
+      output->Reshape(permuted_output_dims);
     }
   } else {  // This is the final pair - Transpose directly to the output ordering required and copy the contents to the op's output
     FinalizeOutput(*output, current_subscript_order);
@@ -279,10 +317,17 @@ void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelp
   device_data_copy_func_ = device_data_copy_func;
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::SetContractionOrder(const std::vector<size_t>& contraction_order) {
+  contraction_order_ = contraction_order;
+}
+
 template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
   const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
 
+  const auto& mapped_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+
   auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
 
   const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
@@ -293,9 +338,45 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // The order in which the inputs are processed (left to right unless a contraction order has been set)
+  std::vector<size_t> order = contraction_order_;
+  if (order.empty()) {
+    order.resize(num_inputs);
+    std::iota(order.begin(), order.end(), 0);
+  }
+  ORT_ENFORCE(order.size() == static_cast<size_t>(num_inputs), "Einsum op: Invalid contraction order");
+
+  std::vector<int64_t> position_in_order(num_inputs);
+  for (size_t i = 0; i < order.size(); ++i) {
+    position_in_order[order[i]] = static_cast<int64_t>(i);
+  }
+
+  // For each subscript index, find the position (in the processing order) of the last input that needs it.
+  // The subscript index is reduced when that input is processed.
+  // If the value is -1, the subscript index appears in the output and is never reduced.
+  // When the inputs are not processed left to right, an input may be processed after the last input the subscript
+  // index appears in. The subscript index can be reduced earlier as long as the remaining inputs have a dim value
+  // of 1 for it.
+  std::vector<int64_t> subscript_indices_to_last_position(num_subscript_labels, -1);
+  for (int64_t i = 0; i < num_subscript_labels; ++i) {
+    if (mapped_indices_to_output_indices[i] != -1) {
+      continue;
+    }
+    int64_t last_position = mapped_indices_to_last_input_index[i] == -1
+                                ? 0
+                                : position_in_order[mapped_indices_to_last_input_index[i]];
+    for (int64_t position = last_position + 1; position < num_inputs; ++position) {
+      if (homogenized_input_dims[order[position]][i] > 1) {
+        last_position = position;
+      }
+    }
+    subscript_indices_to_last_position[i] = last_position;
+  }
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
+  const size_t first_input = order[0];
   {
     std::vector<int64_t> reduced_dims;
     std::vector<int64_t> preserved_dims;           // dims which were not reduced
@@ -304,7 +385,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     preserved_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (int64_t i = 0; i < num_subscript_labels; ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (subscript_indices_to_last_position[i] == 0) {
         reduced_dims.push_back(i);
       } else {
         preserved_dims.push_back(i);
@@ -313,14 +394,15 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[first_input] ? *preprocessed_inputs[first_input]
+                                                                        : *raw_inputs[first_input],
+                                      homogenized_input_dims[first_input].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first_input]) {
+        result = std::move(preprocessed_inputs[first_input]);
       }
     }
 
@@ -328,7 +410,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     if (num_inputs == 1) {
       // Finalize the output by applying any transpose required to get
       // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+      FinalizeOutput(result ? *result : *raw_inputs[first_input], preserved_dims);
 
       return Status::OK();
     }
@@ -338,21 +420,22 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int position = 1; position < num_inputs; ++position) {
+      const size_t input = order[position];
       std::vector<int64_t> reduced_dims;
       reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
+        if (subscript_indices_to_last_position[dim] == position) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (position == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first_input],
+                                      result ? result->Shape() : homogenized_input_dims[first_input],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
                                       reduced_dims, is_final_pair);
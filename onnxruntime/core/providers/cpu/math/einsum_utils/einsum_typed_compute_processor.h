@@ -33,6 +33,10 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Set the order in which the inputs are contracted pair-wise (see EinsumOp::ComputeContractionOrder())
+  // If not set, the inputs are contracted left to right
+  void SetContractionOrder(const std::vector<size_t>& contraction_order);
+
   Status Run();
 
  private:
@@ -65,6 +69,9 @@ class EinsumTypedComputeProcessor {
   EinsumOp::DeviceHelpers::ReduceSum<T> device_reduce_sum_func_;
   EinsumOp::DeviceHelpers::DataCopy device_data_copy_func_;
 
+  // The order in which the inputs are contracted pair-wise
+  std::vector<size_t> contraction_order_;
+
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
 };
@@ -6,39 +6,76 @@
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
+#include "Eigen/src/Core/arch/Default/Half.h"
 
 namespace onnxruntime {
 
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
     7,
     8,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 // opset 9 added support for additional types (int32, uint32, int64, uint64), however we haven't enabled those yet.
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
     9,
     10,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 // opset 11 made bias input 'C' optional
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
     11,
     12,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 // opset 13 Adds BFloat16 support but we are not supporting it yet
-ONNX_CPU_OPERATOR_KERNEL(
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     13,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+// float16 weights are packed in half precision and the GEMM is computed in float
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 bool GemmPackBFp32(const OpKernelInfo& info,
                    const Tensor& tensor_b,
                    bool trans_b,
@@ -71,6 +108,46 @@ bool GemmPackBFp32(const OpKernelInfo& info,
   return true;
 }
 
+bool GemmPackBFp16(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  const size_t packed_b_size = MlasGemmPackBHalfSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasGemmPackBHalf(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    &tensor_b.Data<MLFloat16>()->val,
+                    trans_b ? K : N,
+                    packed_b_data);
+  return true;
+}
+
+void ConvertHalfToFloat(const MLFloat16* input, float* output, size_t count) {
+  MlasConvertHalfToFloatBuffer(&input->val, output, count);
+}
+
+void ConvertFloatToHalf(const float* input, MLFloat16* output, size_t count) {
+  auto input_vector = ConstEigenVectorMap<float>(input, count);
+  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(output)), count);
+  output_vector = input_vector.template cast<Eigen::half>();
+}
+
 template <typename T>
 static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
                               const T* c_data, const TensorShape* c_shape,
@@ -149,6 +226,17 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  // only pack Matrix B, keeping it in half precision
+  if (input_idx == 1) {
+    is_packed = GemmPackBFp16(Info(), tensor, trans_B_ != CblasNoTrans, packed_b_, b_shape_);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -257,4 +345,74 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  // the GEMM is computed in float. Only B is kept in half precision when it is prepacked.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto a_data = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(M * K));
+  ConvertHalfToFloat(A->Data<MLFloat16>(), a_data.get(), static_cast<size_t>(M * K));
+
+  auto y_data = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(M * N));
+
+  IAllocatorUniquePtr<float> c_data;
+  const TensorShape* c_shape = nullptr;
+  if (C != nullptr) {
+    const size_t c_size = static_cast<size_t>(C->Shape().Size());
+    c_data = IAllocator::MakeUniquePtr<float>(alloc, c_size);
+    ConvertHalfToFloat(C->Data<MLFloat16>(), c_data.get(), c_size);
+    c_shape = &C->Shape();
+  }
+
+  if (B) {
+    auto b_data = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(K * N));
+    ConvertHalfToFloat(B->Data<MLFloat16>(), b_data.get(), static_cast<size_t>(K * N));
+    Gemm<float>::ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, a_data.get(), b_data.get(), beta_,
+                             c_data.get(), c_shape, y_data.get(), thread_pool);
+  } else {
+    GemmBroadcastBias(M, N, beta_, c_data.get(), c_shape, y_data.get());
+    MlasGemmPackedBHalf(
+        trans_A_,
+        static_cast<size_t>(M),
+        static_cast<size_t>(N),
+        static_cast<size_t>(K),
+        alpha_,
+        a_data.get(),
+        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
+        packed_b_.get(),
+        c_data ? beta_ : 0.0f,
+        y_data.get(),
+        static_cast<size_t>(N),
+        thread_pool);
+  }
+
+  ConvertFloatToHalf(y_data.get(), Y->MutableData<MLFloat16>(), static_cast<size_t>(M * N));
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -13,4 +13,17 @@ bool GemmPackBFp32(const OpKernelInfo& info,
                    BufferUniquePtr& packed_b,
                    TensorShape& b_shape);
 
+// Packs a float16 weight matrix for MlasGemmPackedBHalf. The weights stay in half
+// precision and are expanded to float inside the GEMM, halving the memory footprint
+// and bandwidth of large weights.
+bool GemmPackBFp16(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   TensorShape& b_shape);
+
+// Conversions used by the float16 kernels, which compute in float.
+void ConvertHalfToFloat(const MLFloat16* input, float* output, size_t count);
+void ConvertFloatToHalf(const float* input, MLFloat16* output, size_t count);
+
 };  // namespace onnxruntime
@@ -24,6 +24,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 // opset 9 supports more types
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
@@ -41,6 +48,14 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     9,
@@ -73,6 +88,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
@@ -159,39 +181,131 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const auto* b_data = b ? b->Data<float>() : nullptr;
   auto* y_data = y->MutableData<float>();
 
-  // TODO: replace it with GemmBatch for performance, it's OK for now as GemmBatch unrolls as well
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t lda = trans_a ? M : K;
+
+  if (packed_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasGemm(
+          trans_a ? CblasTrans : CblasNoTrans,
+          M,
+          N,
+          K,
+          alpha_attr_,
+          a_data + helper.LeftOffsets()[i],
+          lda,
+          packed_b_.get(),
+          0.0f,
+          y_data + helper.OutputOffsets()[i],
+          N,
+          thread_pool);
+    }
+    return Status::OK();
+  }
+
+  // Schedule the complete broadcast batch with a single dispatch to the thread pool, so that
+  // small matrices from many batches can use all of the threads.
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = lda;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = trans_b ? K : N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+
+  MlasGemmBatch(
+      trans_a ? CblasTrans : CblasNoTrans,
+      trans_b ? CblasTrans : CblasNoTrans,
+      M,
+      N,
+      K,
+      alpha_attr_,
+      data.data(),
+      max_len,
+      0.0f,
+      thread_pool);
+
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  // only pack Matrix B, keeping it in half precision
+  if (input_idx == 1) {
+    is_packed = GemmPackBFp16(Info(), tensor, false, packed_b_, b_shape_);
+  }
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // the product is computed in float
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  const size_t a_size = static_cast<size_t>(a->Shape().Size());
+  auto a_data = IAllocator::MakeUniquePtr<float>(alloc, a_size);
+  ConvertHalfToFloat(a->Data<MLFloat16>(), a_data.get(), a_size);
+
+  IAllocatorUniquePtr<float> b_data;
+  if (b) {
+    const size_t b_size = static_cast<size_t>(b_shape.Size());
+    b_data = IAllocator::MakeUniquePtr<float>(alloc, b_size);
+    ConvertHalfToFloat(b->Data<MLFloat16>(), b_data.get(), b_size);
+  }
+
+  const size_t y_size = static_cast<size_t>(y->Shape().Size());
+  auto y_data = IAllocator::MakeUniquePtr<float>(alloc, y_size);
+
   size_t max_len = helper.OutputOffsets().size();
   for (size_t i = 0; i < max_len; i++) {
     if (packed_b_) {
-      MlasGemm(
-          trans_a ? CblasTrans : CblasNoTrans,
+      MlasGemmPackedBHalf(
+          CblasNoTrans,
           static_cast<size_t>(helper.M()),
           static_cast<size_t>(helper.N()),
           static_cast<size_t>(helper.K()),
-          alpha_attr_,
-          a_data + helper.LeftOffsets()[i],
-          static_cast<size_t>(trans_a ? helper.M() : helper.K()),
+          1.0f,
+          a_data.get() + helper.LeftOffsets()[i],
+          static_cast<size_t>(helper.K()),
           packed_b_.get(),
           0.0f,
-          y_data + helper.OutputOffsets()[i],
+          y_data.get() + helper.OutputOffsets()[i],
           static_cast<size_t>(helper.N()),
           thread_pool);
       continue;
     }
-    math::Gemm<float, concurrency::ThreadPool>(
-        trans_a ? CblasTrans : CblasNoTrans,
-        trans_b ? CblasTrans : CblasNoTrans,
-        helper.M(),
-        helper.N(),
-        helper.K(),
-        alpha_attr_,
-        a_data + helper.LeftOffsets()[i],
-        b_data + helper.RightOffsets()[i],
-        0.0f,
-        y_data + helper.OutputOffsets()[i],
+    math::MatMul<float>(
+        static_cast<int>(helper.M()),
+        static_cast<int>(helper.N()),
+        static_cast<int>(helper.K()),
+        a_data.get() + helper.LeftOffsets()[i],
+        b_data.get() + helper.RightOffsets()[i],
+        y_data.get() + helper.OutputOffsets()[i],
         thread_pool);
   }
 
+  ConvertFloatToHalf(y_data.get(), y->MutableData<MLFloat16>(), y_size);
+
   return Status::OK();
 }
 
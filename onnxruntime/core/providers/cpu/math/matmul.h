@@ -38,4 +38,20 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
 };
 
+// float16 MatMul. A prepacked B is kept in half precision and expanded to float
+// inside the GEMM; the product is computed in float.
+template <>
+class MatMul<MLFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
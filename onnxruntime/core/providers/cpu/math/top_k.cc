@@ -140,6 +140,171 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// A value and its index within the row, so that candidates can be compared without reading through the index.
+template <typename T>
+struct ValueIndex {
+  T value_;
+  int64_t index_;
+};
+
+template <class Comparator>
+struct ValueIndexCmp {
+  bool operator()(const ValueIndex<typename Comparator::DataType>& lhs,
+                  const ValueIndex<typename Comparator::DataType>& rhs) const {
+    return comparer_.CompareValueOnly(lhs.value_, rhs.value_) ||
+           // when values are equal the lower index is preferred
+           (lhs.value_ == rhs.value_ && lhs.index_ < rhs.index_);
+  }
+
+  Comparator comparer_;
+};
+
+// Selects the (unsorted) top k elements of data[begin, end) into candidates, where the range is contiguous and
+// end - begin >= k.
+//
+// The values are filtered against a threshold that only ever improves: the worst of the first k values, and then the
+// k-th best candidate each time the candidates buffer fills up. The filter checks a block of values with a branch
+// free loop that the compiler vectorizes, and only blocks containing a value that beats the threshold are scanned
+// for candidates. As the threshold converges to the k-th best value very few blocks pass the filter when k is small
+// relative to the row size.
+template <class Comparator>
+static void SelectTopKContiguous(const typename Comparator::DataType* data, int64_t begin, int64_t end,
+                                 const unsigned k, std::vector<ValueIndex<typename Comparator::DataType>>& candidates) {
+  using T = typename Comparator::DataType;
+  constexpr int64_t kBlockSize = 16;
+
+  const Comparator comparer;
+  const ValueIndexCmp<Comparator> candidate_cmp{comparer};
+  const size_t capacity = std::max<size_t>(size_t{4} * k, 1024);
+
+  candidates.clear();
+
+  int64_t i = begin;
+  T threshold = data[i];
+  for (; i < begin + k; ++i) {
+    candidates.push_back({data[i], i});
+    if (comparer.CompareValueOnly(threshold, data[i])) {
+      threshold = data[i];
+    }
+  }
+
+  // a value equal to the threshold never qualifies as it has a higher index than the value that set the threshold
+  auto add_candidates = [&](int64_t block_begin, int64_t block_end) {
+    for (int64_t j = block_begin; j < block_end; ++j) {
+      if (comparer.CompareValueOnly(data[j], threshold)) {
+        candidates.push_back({data[j], j});
+      }
+    }
+
+    if (candidates.size() >= capacity) {
+      std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), candidate_cmp);
+      candidates.resize(k);
+      threshold = candidates[k - 1].value_;
+    }
+  };
+
+  for (; i + kBlockSize <= end; i += kBlockSize) {
+    const T* block = data + i;
+    int any_candidate = 0;
+    for (int64_t j = 0; j < kBlockSize; ++j) {
+      any_candidate |= static_cast<int>(comparer.CompareValueOnly(block[j], threshold));
+    }
+
+    if (any_candidate != 0) {
+      add_candidates(i, i + kBlockSize);
+    }
+  }
+
+  add_candidates(i, end);
+
+  if (candidates.size() > k) {
+    std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), candidate_cmp);
+    candidates.resize(k);
+  }
+}
+
+// Finds the top k elements of each row for a contiguous axis (the elements of the axis are adjacent) using
+// SelectTopKContiguous. When there are fewer rows than threads each row is split into ranges that are selected
+// concurrently, and the top k of the candidates of the ranges are then merged.
+template <class Comparator>
+static void FindTopKElementsContiguous(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                                       const unsigned k, bool sorted,
+                                       EigenMatrixMapRowMajor<typename Comparator::DataType>& values_map,
+                                       EigenMatrixMapRowMajor<int64_t>& indices_map,
+                                       concurrency::ThreadPool* threadpool) {
+  using T = typename Comparator::DataType;
+
+  // the minimum number of elements a thread selects from, so that each range amortizes the merge of its candidates
+  constexpr int64_t kMinRangeSize = 16 * 1024;
+
+  const ValueIndexCmp<Comparator> candidate_cmp{Comparator()};
+  const int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  int64_t ranges_per_row = 1;
+  if (rows < tp_threads) {
+    const int64_t min_range_size = std::max(kMinRangeSize, int64_t{4} * k);
+    ranges_per_row = std::max(std::min((tp_threads + rows - 1) / rows, cols / min_range_size), int64_t{1});
+  }
+
+  const int64_t num_ranges = rows * ranges_per_row;
+  const int64_t num_threads = std::max(std::min({tp_threads, num_ranges, rows * cols / kMinRangeSize}),
+                                       int64_t{1});
+
+  auto write_row = [k, sorted, &candidate_cmp, &values_map, &indices_map](
+                       int64_t row, std::vector<ValueIndex<T>>& candidates) {
+    if (sorted) {
+      std::sort(candidates.begin(), candidates.begin() + k, candidate_cmp);
+    }
+
+    for (unsigned l = 0; l < k; ++l) {
+      values_map(row, l) = candidates[l].value_;
+      indices_map(row, l) = candidates[l].index_;
+    }
+  };
+
+  // the candidates of each range when the rows are split
+  std::vector<ValueIndex<T>> range_candidates(ranges_per_row > 1 ? num_ranges * k : 0);
+
+  auto select_ranges = [&](std::ptrdiff_t batch) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch, num_threads, num_ranges);
+    std::vector<ValueIndex<T>> candidates;
+
+    for (auto range = work.start; range < work.end; ++range) {
+      const int64_t row = range / ranges_per_row;
+      // the ranges of a row hold at least cols / ranges_per_row >= k elements each
+      const int64_t begin = (range % ranges_per_row) * cols / ranges_per_row;
+      const int64_t end = (range % ranges_per_row + 1) * cols / ranges_per_row;
+
+      SelectTopKContiguous<Comparator>(input_data + row * cols, begin, end, k, candidates);
+
+      if (ranges_per_row == 1) {
+        write_row(row, candidates);
+      } else {
+        std::copy(candidates.begin(), candidates.end(), range_candidates.begin() + range * k);
+      }
+    }
+  };
+
+  if (num_threads <= 1) {
+    select_ranges(0);
+  } else {
+    concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_threads, select_ranges);
+  }
+
+  if (ranges_per_row > 1) {
+    // rows < tp_threads here, and merging ranges_per_row * k candidates is cheap compared to selecting them.
+    concurrency::ThreadPool::TryBatchParallelFor(
+        threadpool, static_cast<int32_t>(rows),
+        [&](std::ptrdiff_t row) {
+          auto row_begin = range_candidates.begin() + row * ranges_per_row * k;
+          std::vector<ValueIndex<T>> candidates(row_begin, row_begin + ranges_per_row * k);
+          std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), candidate_cmp);
+          write_row(row, candidates);
+        },
+        0);
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -164,6 +329,13 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t num_blocks = input_shape[axis_parsed];
   const int64_t block_slice = reduced_cols / k;
 
+  // large rows along a contiguous axis with a small k are filtered by value rather than selected through indices,
+  // and can be split across threads.
+  if (block_slice == 1 && num_blocks >= 4096 && int64_t{64} * k <= num_blocks) {
+    FindTopKElementsContiguous<Comparator>(input_data, rows, cols, k, sorted, values_map, indices_map, threadpool);
+    return;
+  }
+
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
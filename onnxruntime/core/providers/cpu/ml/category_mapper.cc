@@ -35,13 +35,10 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
     auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
     auto out = output.begin();
 
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
     std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
+                  [&out, this](const std::string& value) {
+                    const auto* map_to = string_to_int_map_.Find(value);
+                    *out = map_to == nullptr ? default_int_ : *map_to;
                     ++out;
                   });
   } else {
@@ -52,12 +49,10 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
     auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
     auto out = output.begin();
 
-    const auto map_end = int_to_string_map_.end();
-
     std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
+                  [&out, this](const int64_t& value) {
+                    const auto* map_to = int_to_string_map_.Find(value);
+                    *out = map_to == nullptr ? default_string_ : *map_to;
                     ++out;
                   });
   }
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace onnxruntime {
+namespace ml {
+
+// Hash map for lookup tables that are built once when a kernel is constructed and only read afterwards.
+// Entries are kept in flat arrays and found by linear probing over a power of two table that holds the
+// full hash of every entry, so a miss rarely compares keys and a lookup touches a few cache lines instead
+// of following the bucket lists of std::unordered_map. There is no erase.
+template <class K, class V, class Hash = std::hash<K>>
+class StaticHashMap {
+ public:
+  StaticHashMap() = default;
+
+  size_t Size() const { return keys_.size(); }
+  bool Empty() const { return keys_.empty(); }
+
+  // Makes room for num_entries entries without growing the table.
+  void Reserve(size_t num_entries) {
+    keys_.reserve(num_entries);
+    values_.reserve(num_entries);
+    size_t capacity = 8;
+    while (capacity < num_entries * 2) {
+      capacity *= 2;
+    }
+    if (capacity > slots_.size()) {
+      Rehash(capacity);
+    }
+  }
+
+  // Inserts the key or replaces the value of an existing one, like std::unordered_map::operator[].
+  // Returns true if the key was inserted.
+  bool Assign(const K& key, const V& value) {
+    if ((keys_.size() + 1) * 2 > slots_.size()) {
+      Rehash(slots_.empty() ? 8 : slots_.size() * 2);
+    }
+    const size_t hash = HashOf(key);
+    size_t pos = hash & mask_;
+    for (;;) {
+      Slot& slot = slots_[pos];
+      if (slot.index == kEmptySlot) {
+        ORT_ENFORCE(keys_.size() < kEmptySlot, "Too many entries for StaticHashMap");
+        slot.hash = hash;
+        slot.index = static_cast<uint32_t>(keys_.size());
+        keys_.push_back(key);
+        values_.push_back(value);
+        return true;
+      }
+      if (slot.hash == hash && keys_[slot.index] == key) {
+        values_[slot.index] = value;
+        return false;
+      }
+      pos = (pos + 1) & mask_;
+    }
+  }
+
+  // Returns nullptr if the key is not present.
+  const V* Find(const K& key) const {
+    if (keys_.empty()) {
+      return nullptr;
+    }
+    const size_t hash = HashOf(key);
+    size_t pos = hash & mask_;
+    for (;;) {
+      const Slot& slot = slots_[pos];
+      if (slot.index == kEmptySlot) {
+        return nullptr;
+      }
+      if (slot.hash == hash && keys_[slot.index] == key) {
+        return &values_[slot.index];
+      }
+      pos = (pos + 1) & mask_;
+    }
+  }
+
+ private:
+  static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+  struct Slot {
+    size_t hash;
+    uint32_t index;  // into keys_ and values_
+  };
+
+  size_t HashOf(const K& key) const {
+    // std::hash of integers is the identity in most standard libraries, which clusters
+    // consecutive keys in a linear probing table. Mix the bits before use.
+    uint64_t h = static_cast<uint64_t>(hasher_(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  void Rehash(size_t capacity) {
+    slots_.assign(capacity, Slot{0, kEmptySlot});
+    mask_ = capacity - 1;
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      const size_t hash = HashOf(keys_[i]);
+      size_t pos = hash & mask_;
+      while (slots_[pos].index != kEmptySlot) {
+        pos = (pos + 1) & mask_;
+      }
+      slots_[pos] = Slot{hash, static_cast<uint32_t>(i)};
+    }
+  }
+
+  Hash hasher_;
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  std::vector<K> keys_;
+  std::vector<V> values_;
+};
+
+template <class K, class V, class Hash>
+constexpr uint32_t StaticHashMap<K, V, Hash>::kEmptySlot;
+
+}  // namespace ml
+}  // namespace onnxruntime
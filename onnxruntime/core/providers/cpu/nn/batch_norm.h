@@ -24,9 +24,30 @@
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/nn/batch_norm_helper.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
+// Computes Y = X * scale[c] + bias[c] for the N * C channels of sample_size elements.
+template <typename T>
+void BatchNormChannelAffine(const T* X, const T* scale, const T* bias, T* Y,
+                            size_t N, size_t C, size_t sample_size, concurrency::ThreadPool* /*thread_pool*/) {
+  ConstEigenVectorArrayMap<T> scale_arr(scale, C);
+  ConstEigenVectorArrayMap<T> bias_arr(bias, C);
+  EigenArrayMap<T> Y_arr(Y, sample_size, N * C);
+  ConstEigenArrayMap<T> X_arr(X, sample_size, N * C);
+  for (size_t nc = 0; nc < N * C; ++nc) {
+    Y_arr.col(nc) = X_arr.col(nc) * scale_arr(nc % C) + bias_arr(nc % C);
+  }
+}
+
+// float channels use the MLAS kernel, which partitions the channels over the thread pool.
+inline void BatchNormChannelAffine(const float* X, const float* scale, const float* bias, float* Y,
+                                   size_t N, size_t C, size_t sample_size, concurrency::ThreadPool* thread_pool) {
+  MlasChannelAffine(X, scale, bias, Y, N, C, sample_size, thread_pool);
+}
+
 template <typename T>
 class BatchNorm : public OpKernel {
  public:
@@ -83,17 +104,12 @@ class BatchNorm : public OpKernel {
     //   (x * inv_var * scale) + (bias - est_mean * inv_var * scale)
     Eigen::Array<T, Eigen::Dynamic, 1> new_scale = inv_std * scale_arr;
     Eigen::Array<T, Eigen::Dynamic, 1> new_bias = bias_arr - mean_arr * new_scale;
-    EigenArrayMap<T> Y_arr(Y->template MutableData<T>(),
-                           is_spatial_ ? sample_size : sample_size_incl_all_channels,
-                           is_spatial_ ? N * C : N);
-    ConstEigenArrayMap<T> X_arr(X->template Data<T>(),
-                                is_spatial_ ? sample_size : sample_size_incl_all_channels,
-                                is_spatial_ ? N * C : N);
     if (is_spatial_) {  // spatial == 1
-      for (size_t nc = 0; nc < N * C; ++nc) {
-        Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
-      }
+      BatchNormChannelAffine(X->template Data<T>(), new_scale.data(), new_bias.data(), Y->template MutableData<T>(),
+                             N, C, sample_size, p_op_kernel_context->GetOperatorThreadPool());
     } else {  // spatial == 0
+      EigenArrayMap<T> Y_arr(Y->template MutableData<T>(), sample_size_incl_all_channels, N);
+      ConstEigenArrayMap<T> X_arr(X->template Data<T>(), sample_size_incl_all_channels, N);
       for (size_t n = 0; n < N; ++n) {
         Y_arr.col(n) = X_arr.col(n) * new_scale.col(0) + new_bias.col(0);
       }
@@ -18,6 +18,7 @@
 #include "core/providers/cpu/nn/conv.h"
 
 #include "core/common/safeint.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -156,14 +157,23 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto* W = context->Input<Tensor>(1);
   const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
+  return ComputeFloat(context, X, W, B, [context](const TensorShape& shape) {
+    return context->Output(0, shape)->template MutableData<float>();
+  });
+}
+
+Status Conv<float>::ComputeFloat(OpKernelContext* context, const Tensor* X, const Tensor* W, const Tensor* B,
+                                 const std::function<float*(const TensorShape&)>& allocate_output) const {
   const int64_t N = X->Shape()[0];
-  const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W->Shape(), channels_last_));
 
   std::vector<int64_t> kernel_shape;
   ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
 
+  const size_t kernel_rank = kernel_shape.size();
+
   std::vector<int64_t> pads(conv_attrs_.pads);
   if (pads.empty()) {
     pads.resize(kernel_shape.size() * 2, 0);
@@ -177,14 +187,25 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     strides.resize(kernel_shape.size(), 1);
   }
 
-  std::vector<int64_t> Y_dims({N, M});
-  TensorShape input_shape = X->Shape().Slice(2);
+  const int64_t C = X->Shape()[channels_last_ ? 1 + kernel_rank : 1];
+  const size_t spatial_dim_start = channels_last_ ? 1 : 2;
+  const size_t spatial_dim_end = spatial_dim_start + kernel_rank;
+
+  std::vector<int64_t> Y_dims({N});
+  if (!channels_last_) {
+    Y_dims.push_back(M);
+  }
+  TensorShape input_shape = X->Shape().Slice(spatial_dim_start, spatial_dim_end);
   ORT_RETURN_IF_ERROR(conv_attrs_.InferOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
-  Tensor* Y = context->Output(0, TensorShape(Y_dims));
-  TensorShape output_shape = Y->Shape().Slice(2);
+  if (channels_last_) {
+    Y_dims.push_back(M);
+  }
+  const TensorShape Y_shape(Y_dims);
+  auto* Ydata = allocate_output(Y_shape);
+  TensorShape output_shape = Y_shape.Slice(spatial_dim_start, spatial_dim_end);
 
   // Bail out early if one of the dimensions is zero.
-  if (Y->Shape().Size() == 0) {
+  if (Y_shape.Size() == 0) {
     return Status::OK();
   }
 
@@ -193,11 +214,14 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
   const auto* Xdata = X->template Data<float>();
   const auto* Bdata = B != nullptr ? B->template Data<float>() : nullptr;
-  auto* Ydata = Y->template MutableData<float>();
 
-  const size_t kernel_rank = kernel_shape.size();
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
+  if (channels_last_) {
+    return ComputeChannelsLast(X, W, Bdata, Ydata, C, M, input_shape, output_shape,
+                               kernel_shape, strides, dilations, pads, alloc, thread_pool);
+  }
+
   if (kernel_rank >= 1 && kernel_rank <= 3) {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
@@ -233,7 +257,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     const int64_t output_image_size = output_shape.Size();
     const int64_t kernel_size = TensorShape(kernel_shape).Size();
     const int64_t X_offset = C / conv_attrs_.group * input_image_size;
-    const int64_t Y_offset = Y->Shape().Size() / Y->Shape()[0] / conv_attrs_.group;
+    const int64_t Y_offset = Y_shape.Size() / Y_shape[0] / conv_attrs_.group;
     const int64_t W_offset = W->Shape().Size() / conv_attrs_.group;
     const int64_t kernel_dim = C / conv_attrs_.group * kernel_size;
     const int64_t col_buffer_size = kernel_dim * output_image_size;
@@ -280,16 +304,320 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+Status Conv<float>::ComputeChannelsLast(const Tensor* X, const Tensor* W, const float* Bdata, float* Ydata,
+                                        int64_t C, int64_t M,
+                                        const TensorShape& input_shape, const TensorShape& output_shape,
+                                        const std::vector<int64_t>& kernel_shape, const std::vector<int64_t>& strides,
+                                        const std::vector<int64_t>& dilations, const std::vector<int64_t>& pads,
+                                        const AllocatorPtr& alloc, concurrency::ThreadPool* thread_pool) const {
+  const int64_t N = X->Shape()[0];
+  const size_t kernel_rank = kernel_shape.size();
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  int64_t group_count = conv_attrs_.group;
+  int64_t group_input_channels = W->Shape()[1];
+  int64_t group_output_channels = M / group_count;
+
+  // Test for depthwise convolution.
+  const bool is_depthwise_conv = (group_input_channels == 1 && group_output_channels == 1);
+  if (is_depthwise_conv) {
+    // Update the input and output channels to the number of groups in order to
+    // reuse as much of the below standard convolution path.
+    group_input_channels = group_count;
+    group_output_channels = group_count;
+    group_count = 1;
+  }
+
+  // Test for pointwise convolution, which uses the input tensor directly as
+  // the A matrix of the GEMM.
+  const bool is_pointwise_conv =
+      kernel_size == 1 &&
+      std::all_of(strides.begin(), strides.end(), [](int64_t v) { return v == 1; }) &&
+      std::all_of(pads.begin(), pads.end(), [](int64_t v) { return v == 0; });
+
+  const int64_t X_offset = C * input_image_size;
+  const int64_t Y_offset = M * output_image_size;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  const int64_t col_buffer_size = kernel_dim * output_image_size;
+
+  const auto* Wdata = W->template Data<float>();
+
+  // Reorder the filter from OIHW to HWIO, which matches the order of the
+  // im2col transform. Pointwise convolutions use the original filter as a
+  // transposed B matrix instead.
+  BufferUniquePtr reordered_W_buffer;
+  if (!is_pointwise_conv || is_depthwise_conv) {
+    auto* reordered_W = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * W->Shape().Size()));
+    reordered_W_buffer = BufferUniquePtr(reordered_W, BufferDeleter(alloc));
+    const int64_t filter_input_channels = W->Shape()[1];
+    for (int64_t k = 0; k < kernel_size; k++) {
+      for (int64_t ic = 0; ic < filter_input_channels; ic++) {
+        for (int64_t oc = 0; oc < M; oc++) {
+          *reordered_W++ = Wdata[(oc * filter_input_channels + ic) * kernel_size + k];
+        }
+      }
+    }
+  }
+  const auto* reordered_W = static_cast<const float*>(reordered_W_buffer.get());
+
+  BufferUniquePtr col_buffer;
+  if (!is_pointwise_conv) {
+    int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_col_buffer_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+  }
+
+  // Replicate the logic from MlasSgemmSchedule to control the number of
+  // worker threads used for the convolution.
+  constexpr int32_t maximum_thread_count = 16;
+  constexpr double thread_complexity = static_cast<double>(64 * 1024);
+
+  const double complexity = static_cast<double>(output_image_size) *
+                            static_cast<double>(M) *
+                            static_cast<double>(is_depthwise_conv ? kernel_size : kernel_dim);
+
+  int32_t thread_count = maximum_thread_count;
+  if (complexity < thread_complexity * maximum_thread_count) {
+    thread_count = static_cast<int32_t>(complexity / thread_complexity) + 1;
+  }
+  if (thread_count > output_image_size) {
+    // Ensure that every thread produces at least one output.
+    thread_count = static_cast<int32_t>(output_image_size);
+  }
+  thread_count = std::min(thread_count, concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+
+  const auto* Xdata = X->template Data<float>();
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    if (col_buffer && kernel_rank > 2) {
+      // Threaded implementation of ND convolution is not yet supported, so
+      // prepare all im2col transformations here.
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        math::Im2col<float, StorageOrder::NHWC>()(
+            Xdata + group_id * group_input_channels,
+            group_input_channels,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<int64_t>(kernel_rank),
+            static_cast<float*>(col_buffer.get()) + group_id * col_buffer_size);
+      }
+    }
+
+    auto conv_worker = [&](ptrdiff_t batch) {
+      auto work = concurrency::ThreadPool::PartitionWork(batch, thread_count, static_cast<ptrdiff_t>(output_image_size));
+      int64_t output_start = static_cast<int64_t>(work.start);
+      int64_t output_count = static_cast<int64_t>(work.end - work.start);
+
+      auto* worker_output = Ydata + output_start * M;
+
+      // Initialize the output with the bias, which is then accumulated into by
+      // the GEMM for each group.
+      float gemm_beta = 0.0f;
+      if (Bdata != nullptr && !is_depthwise_conv) {
+        for (int64_t i = 0; i < output_count; i++) {
+          std::copy_n(Bdata, static_cast<size_t>(M), worker_output + i * M);
+        }
+        gemm_beta = 1.0f;
+      }
+
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        // Prepare the im2col transformation or use the input buffer directly for
+        // pointwise convolutions.
+        const float* worker_gemm_input;
+        if (col_buffer) {
+          auto* worker_col_buffer = static_cast<float*>(col_buffer.get()) + output_start * kernel_dim;
+          if (kernel_rank == 2) {
+            math::Im2col<float, StorageOrder::NHWC>()(
+                Xdata + group_id * group_input_channels,
+                group_input_channels,
+                C,
+                input_shape[0],
+                input_shape[1],
+                kernel_shape[0],
+                kernel_shape[1],
+                dilations[0],
+                dilations[1],
+                pads[0],
+                pads[1],
+                strides[0],
+                strides[1],
+                output_shape[1],
+                output_start,
+                output_count,
+                worker_col_buffer);
+          } else if (kernel_rank == 1) {
+            math::Im2col<float, StorageOrder::NHWC>()(
+                Xdata + group_id * group_input_channels,
+                group_input_channels,
+                C,
+                1,
+                input_shape[0],
+                1,
+                kernel_shape[0],
+                1,
+                dilations[0],
+                0,
+                pads[0],
+                1,
+                strides[0],
+                output_shape[0],
+                output_start,
+                output_count,
+                worker_col_buffer);
+          } else {
+            // Use the im2col buffer prepared outside the thread, indexed by group.
+            worker_col_buffer += group_id * col_buffer_size;
+          }
+          worker_gemm_input = worker_col_buffer;
+        } else {
+          worker_gemm_input = Xdata + output_start * C + group_id * group_input_channels;
+        }
+
+        if (is_depthwise_conv) {
+          MlasConvDepthwise(worker_gemm_input,
+                            reordered_W,
+                            Bdata,
+                            worker_output,
+                            static_cast<size_t>(M),
+                            static_cast<size_t>(output_count),
+                            static_cast<size_t>(kernel_size));
+        } else if (is_pointwise_conv) {
+          MlasGemm(CblasNoTrans,
+                   CblasTrans,
+                   static_cast<size_t>(output_count),
+                   static_cast<size_t>(group_output_channels),
+                   static_cast<size_t>(kernel_dim),
+                   1.0f,
+                   worker_gemm_input,
+                   static_cast<size_t>(C),
+                   Wdata + group_id * group_output_channels * kernel_dim,
+                   static_cast<size_t>(kernel_dim),
+                   gemm_beta,
+                   worker_output + group_id * group_output_channels,
+                   static_cast<size_t>(M),
+                   nullptr);
+        } else {
+          MlasGemm(CblasNoTrans,
+                   CblasNoTrans,
+                   static_cast<size_t>(output_count),
+                   static_cast<size_t>(group_output_channels),
+                   static_cast<size_t>(kernel_dim),
+                   1.0f,
+                   worker_gemm_input,
+                   static_cast<size_t>(kernel_dim),
+                   reordered_W + group_id * group_output_channels,
+                   static_cast<size_t>(M),
+                   gemm_beta,
+                   worker_output + group_id * group_output_channels,
+                   static_cast<size_t>(M),
+                   nullptr);
+        }
+      }
+
+      MlasActivation(&activation_, worker_output, nullptr, static_cast<size_t>(output_count),
+                     static_cast<size_t>(M), static_cast<size_t>(M));
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, thread_count, conv_worker);
+
+    Xdata += X_offset;
+    Ydata += Y_offset;
+  }
+
+  return Status::OK();
+}
+
+Status Conv<MLFloat16>::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto to_float = [&alloc](const Tensor& input) {
+    auto output = onnxruntime::make_unique<Tensor>(DataTypeImpl::GetType<float>(), input.Shape(), alloc);
+    ConvertHalfToFloat(input.template Data<MLFloat16>(), output->template MutableData<float>(),
+                       static_cast<size_t>(input.Shape().Size()));
+    return output;
+  };
+
+  auto X_float = to_float(*X);
+  auto W_float = to_float(*W);
+  std::unique_ptr<Tensor> B_float;
+  if (B != nullptr) {
+    B_float = to_float(*B);
+  }
+
+  Tensor* Y = nullptr;
+  std::unique_ptr<Tensor> Y_float;
+  ORT_RETURN_IF_ERROR(ComputeFloat(context, X_float.get(), W_float.get(), B_float.get(),
+                                   [context, &alloc, &Y, &Y_float](const TensorShape& shape) {
+                                     Y = context->Output(0, shape);
+                                     Y_float = onnxruntime::make_unique<Tensor>(DataTypeImpl::GetType<float>(),
+                                                                                shape, alloc);
+                                     return Y_float->template MutableData<float>();
+                                   }));
+
+  if (Y_float != nullptr) {
+    ConvertFloatToHalf(Y_float->template Data<float>(), Y->template MutableData<MLFloat16>(),
+                       static_cast<size_t>(Y_float->Shape().Size()));
+  }
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Conv,
     1, 10,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
 
-ONNX_CPU_OPERATOR_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Conv,
+    1, 10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Conv,
+    11,
+    float,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    Conv<float>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Conv,
     11,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace contrib {
+
+// The com.microsoft domain version of the operator adds the channels_last
+// attribute.
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    Conv,
+    1,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
 
+}  // namespace contrib
+
+#endif
+
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
@@ -26,14 +28,44 @@ class Conv<float> : public OpKernel {
  public:
   Conv<float>(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     activation_.ActivationKind = MlasIdentityActivation;
+    channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  protected:
+  // Computes the convolution of X with W and the optional bias B. allocate_output
+  // is called with the inferred output shape and returns the output buffer.
+  Status ComputeFloat(OpKernelContext* context, const Tensor* X, const Tensor* W, const Tensor* B,
+                      const std::function<float*(const TensorShape&)>& allocate_output) const;
+
+  // Computes the convolution for input and output tensors in channels last
+  // (NHWC) format.
+  Status ComputeChannelsLast(const Tensor* X, const Tensor* W, const float* Bdata, float* Ydata,
+                             int64_t C, int64_t M,
+                             const TensorShape& input_shape, const TensorShape& output_shape,
+                             const std::vector<int64_t>& kernel_shape, const std::vector<int64_t>& strides,
+                             const std::vector<int64_t>& dilations, const std::vector<int64_t>& pads,
+                             const AllocatorPtr& alloc, concurrency::ThreadPool* thread_pool) const;
+
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+  // The input and output tensors are in channels last (NHWC) format. This is
+  // only set by the com.microsoft domain version of the operator.
+  bool channels_last_;
+};
+
+// The float16 inputs are expanded to float and the convolution is computed in float.
+// The weights are kept in half precision between runs.
+template <>
+class Conv<MLFloat16> final : public Conv<float> {
+ public:
+  Conv<MLFloat16>(const OpKernelInfo& info) : Conv<float>(info) {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
 };
 
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "string_normalizer.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <codecvt>
@@ -15,6 +16,7 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -192,52 +194,58 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      Utf8Converter& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
-  }
+inline bool IsAscii(const std::string& s) {
+  return std::all_of(s.cbegin(), s.cend(), [](char ch) { return static_cast<unsigned char>(ch) < 0x80; });
+}
 
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
+inline wchar_t AsciiToLower(wchar_t ch) {
+  return (ch >= L'A' && ch <= L'Z') ? ch - L'A' + L'a' : ch;
+}
 
-  output_dims.push_back(C);
+inline wchar_t AsciiToUpper(wchar_t ch) {
+  return (ch >= L'a' && ch <= L'z') ? ch - L'a' + L'A' : ch;
+}
 
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+// Checks whether the locale maps every ASCII char to the same char as the C locale.
+// It does not for some locales, e.g. the Turkish dotless i.
+bool HasAsciiCaseChange(const Locale& loc) {
+  for (wchar_t ch = 0; ch < 0x80; ++ch) {
+    std::wstring lower(1, ch);
+    std::wstring upper(1, ch);
+    loc.ChangeCase(StringNormalizer::LOWER, lower);
+    loc.ChangeCase(StringNormalizer::UPPER, upper);
+    if (lower[0] != AsciiToLower(ch) || upper[0] != AsciiToUpper(ch)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
+Status ChangeCase(const Locale& loc, bool ascii_case_change, Utf8Converter& converter,
+                  StringNormalizer::CaseAction caseaction, const std::string& s, std::string& result) {
+  if (caseaction == StringNormalizer::NONE) {
+    result = s;
+    return Status::OK();
+  }
+  if (ascii_case_change && IsAscii(s)) {
+    result = s;
+    if (caseaction == StringNormalizer::LOWER) {
+      std::transform(result.begin(), result.end(), result.begin(),
+                     [](char ch) { return static_cast<char>(AsciiToLower(ch)); });
     } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+      std::transform(result.begin(), result.end(), result.begin(),
+                     [](char ch) { return static_cast<char>(AsciiToUpper(ch)); });
     }
-    ++output_idx;
-    ++first;
+    return Status::OK();
+  }
+  std::wstring wstr = converter.from_bytes(s);
+  if (wstr == wconv_error) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input contains invalid utf8 chars at: " + s);
   }
+  // In place transform
+  loc.ChangeCase(caseaction, wstr);
+  result = converter.to_bytes(wstr);
   return Status::OK();
 }
 }  // namespace string_normalizer
@@ -271,8 +279,9 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
     compare_caseaction_ = (case_change_action_ == UPPER) ? UPPER : LOWER;
   }
 
-  locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
+  const std::string locale_name = info.GetAttrOrDefault("locale", default_locale);
+  locale_ = onnxruntime::make_unique<Locale>(locale_name);
+  ascii_case_change_ = HasAsciiCaseChange(*locale_);
   Utf8Converter converter(conv_error, wconv_error);
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
@@ -282,15 +291,17 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       auto p = stopwords_.insert(sw);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(wstr);
+      std::string cased;
+      status = ChangeCase(*locale_, ascii_case_change_, converter, compare_caseaction_, sw, cased);
+      ORT_ENFORCE(status.IsOK(), "Stopword contains invalid utf8 chars");
+      auto p = stopwords_.insert(std::move(cased));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -318,70 +329,76 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
+  // Normalize every string in parallel. Strings that are filtered out are left empty.
   auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
-    }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+  const bool compare_cased = !is_case_sensitive_ && !stopwords_.empty();
+  std::vector<std::string> results(C);
+  std::vector<uint8_t> keep(C, 1);
+  std::vector<Status> statuses(C);
+
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < C; ++i) {
+    total_bytes += input_data[i].size();
+  }
+  const double bytes = static_cast<double>(total_bytes) / static_cast<double>(C) + 1;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(C), TensorOpCost{bytes, bytes, bytes * 32},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // Converters may keep conversion state, so use one per batch
+        Utf8Converter converter(conv_error, wconv_error);
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const std::string& s = input_data[i];
+          if (!compare_cased) {
+            if (!stopwords_.empty() && stopwords_.count(s) != 0) {
+              keep[i] = 0;
+              continue;
+            }
+            statuses[i] = ChangeCase(*locale_, ascii_case_change_, converter, case_change_action_, s, results[i]);
+            continue;
+          }
+          // When a case action is required it is the same as the compare case action,
+          // so the converted string is the output.
+          statuses[i] = ChangeCase(*locale_, ascii_case_change_, converter, compare_caseaction_, s, results[i]);
+          if (!statuses[i].IsOK()) {
+            continue;
+          }
+          if (stopwords_.count(results[i]) != 0) {
+            keep[i] = 0;
+          } else if (case_change_action_ == NONE) {
+            results[i] = s;
           }
         }
-        ++first;
-      }
-      if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
-      }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      });
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  const size_t output_count = static_cast<size_t>(std::count(keep.cbegin(), keep.cend(), uint8_t{1}));
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (output_count == 0) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(output_count);
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+  size_t output_idx = 0;
+  for (size_t i = 0; i < C; ++i) {
+    if (keep[i]) {
+      *(output_data + output_idx) = std::move(results[i]);
+      ++output_idx;
     }
   }
-  return status;
+  return Status::OK();
 }
 }  // namespace onnxruntime
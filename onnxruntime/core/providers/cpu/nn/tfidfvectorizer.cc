@@ -6,8 +6,10 @@
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
+#include "core/providers/cpu/ml/static_hash_map.h"
+
 #include <functional>
-#include <unordered_map>
+#include <limits>
 
 namespace onnxruntime {
 
@@ -23,61 +25,70 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+constexpr uint32_t kNoToken = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
 
-template <>
-struct NgramPart<int64_t>;
+// The pool n-grams as a flat automaton over token ids.
+// Every distinct pool item gets a token id. Node 0 is the root and every n-gram is the
+// path of its token ids from the root. For (1,2,3) node 2 would be a child of 1 but
+// have ngram id == 0 because (1,2) does not exists. Node 3 would have a valid id.
+// All edges live in one hash table keyed by (node, token id), so walking the automaton
+// does integer lookups only and no per node maps are allocated.
+class NgramAutomaton {
+ public:
+  NgramAutomaton() : ngram_ids_(1, 0) {}
 
-template <>
-struct NgramPart<std::string>;
+  bool Empty() const { return ngram_ids_.size() == 1; }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  // 0 - means no entry, search for a bigger N
+  size_t NgramId(uint32_t node) const { return ngram_ids_[node]; }
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+  uint32_t Child(uint32_t node, uint32_t token) const {
+    const auto* child = edges_.Find(Edge(node, token));
+    return child == nullptr ? kNoNode : *child;
+  }
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  uint32_t AddChild(uint32_t node, uint32_t token) {
+    const auto child = Child(node, token);
+    if (child != kNoNode) {
+      return child;
+    }
+    const auto new_node = static_cast<uint32_t>(ngram_ids_.size());
+    ngram_ids_.push_back(0);
+    edges_.Assign(Edge(node, token), new_node);
+    return new_node;
+  }
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+  void SetNgramId(uint32_t node, size_t ngram_id) { ngram_ids_[node] = ngram_id; }
+
+ private:
+  static uint64_t Edge(uint32_t node, uint32_t token) {
+    return (static_cast<uint64_t>(node) << 32) | token;
+  }
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  std::vector<size_t> ngram_ids_;
+  ml::StaticHashMap<uint64_t, uint32_t> edges_;
 };
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class TokenMap>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            TokenMap& tokens, NgramAutomaton& automaton) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, onnxruntime::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
+    uint32_t node = 0;
+    for (size_t n = 0; n < ngram_size; ++n, ++first) {
+      const auto* token = tokens.Find(*first);
+      uint32_t token_id = static_cast<uint32_t>(tokens.Size());
+      if (token == nullptr) {
+        tokens.Assign(*first, token_id);
+      } else {
+        token_id = *token;
       }
-      ++n;
-      m = &p.first->second->leafs_;
+      node = automaton.AddChild(node, token_id);
     }
+    ORT_ENFORCE(automaton.NgramId(node) == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    automaton.SetNgramId(node, ngram_id);
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -89,10 +100,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -127,11 +134,10 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float>   weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Token ids of the pool_strings or pool_int64s entries
+  ml::StaticHashMap<std::string, uint32_t> str_tokens_;
+  ml::StaticHashMap<int64_t, uint32_t> int64_tokens_;
+  NgramAutomaton automaton_;
 
   size_t output_size_ = 0;
 
@@ -237,9 +243,11 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->int64_tokens_, impl_->automaton_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->str_tokens_, impl_->automaton_);
         }
       } else {
         ngram_id += ngrams;
@@ -310,68 +318,58 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
   }
 }
 
-void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                                  std::vector<uint32_t>& frequencies) const {
-  auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
-
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
+void TfIdfVectorizer::ComputeImpl(const Tensor& X, ptrdiff_t row_num, size_t row_size,
+                                  std::vector<uint32_t>& tokens, std::vector<uint32_t>& frequencies) const {
   const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
+  // Look every row item up once. The n-gram search below then only deals with token ids.
+  tokens.resize(row_size);
+  const size_t row_offset = row_num * row_size;
+  auto to_token = [](const uint32_t* token) { return token == nullptr ? kNoToken : *token; };
+  if (X.IsDataTypeString()) {
+    const auto* items = X.Data<std::string>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      tokens[i] = to_token(impl.str_tokens_.Find(items[i]));
+    }
+  } else if (X.IsDataType<int32_t>()) {
+    const auto* items = X.Data<int32_t>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      tokens[i] = to_token(impl.int64_tokens_.Find(int64_t{items[i]}));
+    }
+  } else {
+    const auto* items = X.Data<int64_t>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      tokens[i] = to_token(impl.int64_tokens_.Find(items[i]));
+    }
+  }
+
+  const auto& automaton = impl.automaton_;
+  const size_t max_gram_length = impl.max_gram_length_;
+  const size_t max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
+  size_t start_ngram_size = impl.min_gram_length_;
 
-    while (ngram_start < ngram_row_end) {
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_size) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t node = 0;
+      for (size_t ngram_size = 1, pos = ngram_start;
+           ngram_size <= max_gram_length && pos < row_size;
+           ++ngram_size, pos += skip_distance) {
+        if (tokens[pos] == kNoToken) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        node = automaton.Child(node, tokens[pos]);
+        if (node == kNoNode) {
+          break;
+        }
+        if (ngram_size >= start_ngram_size && automaton.NgramId(node) != 0) {
+          impl.IncrementCount(automaton.NgramId(node), row_num, frequencies);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -417,8 +415,8 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   frequencies.resize(num_rows * impl_->output_size_, 0);
 
   if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      (X->IsDataTypeString() && impl_->str_tokens_.Empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_tokens_.Empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -428,11 +426,18 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
-  };
-
-  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
+  // Rows are processed in batches that share the token buffer. Every row only updates its own frequencies.
+  const double row_items = static_cast<double>(C);
+  const double row_cost = row_items * static_cast<double>(impl_->max_gram_length_ * (impl_->max_skip_count_ + 1)) * 8;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{row_items * X->DataType()->Size(), 0, row_cost},
+      [this, X, C, &frequencies](ptrdiff_t first, ptrdiff_t last) {
+        std::vector<uint32_t> tokens;
+        for (ptrdiff_t row_num = first; row_num < last; ++row_num) {
+          ComputeImpl(*X, row_num, C, tokens, frequencies);
+        }
+      });
 
   OutputResult(ctx, B, frequencies);
 
@@ -20,8 +20,9 @@ class TfIdfVectorizer final : public OpKernel {
 
  private:
 
-  void ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                     std::vector<uint32_t>& frequencies) const;
+  // tokens is scratch space for the token ids of the row items
+  void ComputeImpl(const Tensor& X, ptrdiff_t row_num, size_t row_size,
+                   std::vector<uint32_t>& tokens, std::vector<uint32_t>& frequencies) const;
 
   // Apply weighing criteria and output
   void OutputResult(OpKernelContext* ctx, size_t b_dim, const std::vector<uint32_t>& frequences) const;
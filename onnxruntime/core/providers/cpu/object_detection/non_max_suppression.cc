@@ -13,8 +13,10 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
-#include <utility>
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -111,128 +113,227 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
-Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
-  PrepareContext pc;
-  auto ret = PrepareCompute(ctx, pc);
-  ORT_RETURN_IF_NOT(ret.IsOK(), ret.ErrorMessage());
+namespace {
+
+// Boxes are converted to corners once per batch and stored as separate arrays of y_min, x_min, y_max, x_max and area
+// of num_boxes elements each, so that the IOU of a candidate against a block of selected boxes vectorizes.
+constexpr int64_t kBoxArrayCount = 5;
+
+void ConvertBoxes(const float* boxes, int64_t num_boxes, int64_t center_point_box, float* corners) {
+  float* y_min = corners;
+  float* x_min = corners + num_boxes;
+  float* y_max = corners + 2 * num_boxes;
+  float* x_max = corners + 3 * num_boxes;
+  float* area = corners + 4 * num_boxes;
+
+  for (int64_t i = 0; i < num_boxes; ++i, boxes += 4) {
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(boxes[1], boxes[3], x_min[i], x_max[i]);
+      MaxMin(boxes[0], boxes[2], y_min[i], y_max[i]);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      float box_width_half = boxes[2] / 2;
+      float box_height_half = boxes[3] / 2;
+      x_min[i] = boxes[0] - box_width_half;
+      x_max[i] = boxes[0] + box_width_half;
+      y_min[i] = boxes[1] - box_height_half;
+      y_max[i] = boxes[1] + box_height_half;
+    }
+    area[i] = (y_max[i] - y_min[i]) * (x_max[i] - x_min[i]);
+  }
+}
 
-  int64_t max_output_boxes_per_class = 0;
-  float iou_threshold = .0f;
-  float score_threshold = .0f;
+struct ScoreIndex {
+  float score_;
+  int64_t index_;
+};
 
-  ret = GetThresholdsFromInputs(pc, max_output_boxes_per_class, iou_threshold, score_threshold);
-  ORT_RETURN_IF_NOT(ret.IsOK(), ret.ErrorMessage());
+// Orders by decreasing score, then by increasing box index.
+inline bool GreaterScore(const ScoreIndex& lhs, const ScoreIndex& rhs) {
+  return lhs.score_ > rhs.score_ || (lhs.score_ == rhs.score_ && lhs.index_ < rhs.index_);
+}
 
-  if (0 == max_output_boxes_per_class) {
-    ctx->Output(0, {0, 3});
-    return Status::OK();
+// The boxes selected for a class, in the same layout as the converted boxes.
+class SelectedBoxes {
+ public:
+  void Clear() {
+    y_min_.clear();
+    x_min_.clear();
+    y_max_.clear();
+    x_max_.clear();
+    area_.clear();
   }
 
-  const auto* const boxes_data = pc.boxes_data_;
-  const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfo {
-    float score_{};
-    int64_t index_{};
-    float box_[4]{};
-    float area_{};
-
-    BoxInfo() = default;
-    explicit BoxInfo(float score, int64_t idx, int64_t center_point_box, const float* box) : score_(score), index_(idx) {
-      if (0 == center_point_box) {
-        // boxes data format [y1, x1, y2, x2],
-        MaxMin(box[1], box[3], box_[1], box_[3]);
-        MaxMin(box[0], box[2], box_[0], box_[2]);
-      } else {
-        // boxes data format [x_center, y_center, width, height]
-        float box_width_half = box[2] / 2;
-        float box_height_half = box[3] / 2;
-        box_[1] = box[0] - box_width_half;
-        box_[3] = box[0] + box_width_half;
-        box_[0] = box[1] - box_height_half;
-        box_[2] = box[1] + box_height_half;
+  void Add(float y_min, float x_min, float y_max, float x_max, float area) {
+    y_min_.push_back(y_min);
+    x_min_.push_back(x_min);
+    y_max_.push_back(y_max);
+    x_max_.push_back(x_max);
+    area_.push_back(area);
+  }
+
+  // Returns true if the IOU (Intersection Over Union) of the box with any selected box exceeds iou_threshold.
+  bool Suppress(float y_min, float x_min, float y_max, float x_max, float area, float iou_threshold) const {
+    // the blocks are checked with a branch free loop that the compiler vectorizes. An empty intersection never
+    // suppresses since the IOU is then 0 or NaN and iou_threshold is not negative.
+    constexpr size_t kBlockSize = 16;
+    const size_t count = area_.size();
+    for (size_t start = 0; start < count; start += kBlockSize) {
+      const size_t end = std::min(start + kBlockSize, count);
+      int suppressed = 0;
+      for (size_t i = start; i < end; ++i) {
+        const float intersection_y = std::max(std::min(y_max, y_max_[i]) - std::max(y_min, y_min_[i]), .0f);
+        const float intersection_x = std::max(std::min(x_max, x_max_[i]) - std::max(x_min, x_min_[i]), .0f);
+        const float intersection_area = intersection_x * intersection_y;
+        const float union_area = area + area_[i] - intersection_area;
+        suppressed |= static_cast<int>(intersection_area / union_area > iou_threshold);
+      }
+      if (suppressed != 0) {
+        return true;
       }
-      area_ = (box_[2] - box_[0]) * (box_[3] - box_[1]);
     }
+    return false;
+  }
 
-    inline bool operator<(const BoxInfo& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+ private:
+  std::vector<float> y_min_;
+  std::vector<float> x_min_;
+  std::vector<float> y_max_;
+  std::vector<float> x_max_;
+  std::vector<float> area_;
+};
+
+void SuppressClass(const float* scores, const float* corners, int64_t num_boxes,
+                   const float* score_threshold, int64_t max_output_boxes_per_class, float iou_threshold,
+                   std::vector<ScoreIndex>& candidates, SelectedBoxes& selected,
+                   std::vector<int64_t>& selected_indices) {
+  candidates.clear();
+  if (score_threshold != nullptr) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      if (scores[box_index] > *score_threshold) {
+        candidates.push_back({scores[box_index], box_index});
+      }
+    }
+  } else {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      candidates.push_back({scores[box_index], box_index});
     }
+  }
 
-    inline bool SuppressByIOU(const BoxInfo& rhs, float iou_threshold) const {
-      const float intersection_x_min = std::max(box_[1], rhs.box_[1]);
-      const float intersection_y_min = std::max(box_[0], rhs.box_[0]);
-      const float intersection_x_max = std::min(box_[3], rhs.box_[3]);
-      const float intersection_y_max = std::min(box_[2], rhs.box_[2]);
+  const float* y_min = corners;
+  const float* x_min = corners + num_boxes;
+  const float* y_max = corners + 2 * num_boxes;
+  const float* x_max = corners + 3 * num_boxes;
+  const float* area = corners + 4 * num_boxes;
+
+  selected.Clear();
+
+  // The candidates are sorted by chunks as they are consumed: most classes select a few boxes out of thousands of
+  // candidates, so sorting all of them up front is wasted work.
+  size_t sorted_count = 0;
+  for (size_t next = 0;
+       next < candidates.size() && static_cast<int64_t>(selected_indices.size()) < max_output_boxes_per_class;
+       ++next) {
+    if (next == sorted_count) {
+      const auto unsorted_count = candidates.size() - sorted_count;
+      const auto remaining_count = static_cast<size_t>(
+          std::min(max_output_boxes_per_class - static_cast<int64_t>(selected_indices.size()),
+                   static_cast<int64_t>(unsorted_count)));
+      const auto chunk_size = std::min(unsorted_count, std::max<size_t>(2 * remaining_count, 64));
+      std::partial_sort(candidates.begin() + sorted_count, candidates.begin() + sorted_count + chunk_size,
+                        candidates.end(), GreaterScore);
+      sorted_count += chunk_size;
+    }
 
-      const float intersection_area = std::max(intersection_x_max - intersection_x_min, .0f) *
-                                      std::max(intersection_y_max - intersection_y_min, .0f);
-      if (intersection_area <= .0f) {
-        return false;
-      }
-      const float union_area = area_ + rhs.area_ - intersection_area;
-      const float intersection_over_union = intersection_area / union_area;
-      return intersection_over_union > iou_threshold;
+    const auto box_index = candidates[next].index_;
+    if (!selected.Suppress(y_min[box_index], x_min[box_index], y_max[box_index], x_max[box_index], area[box_index],
+                           iou_threshold)) {
+      selected.Add(y_min[box_index], x_min[box_index], y_max[box_index], x_max[box_index], area[box_index]);
+      selected_indices.push_back(box_index);
     }
-  };
+  }
+}
 
-  const auto center_point_box = GetCenterPointBox();
+}  // namespace
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfo> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min(max_output_boxes_per_class, pc.num_boxes_));
+void NonMaxSuppressionBase::ComputeSelectedBoxes(const PrepareContext& pc, int64_t center_point_box,
+                                                 int64_t max_output_boxes_per_class, float iou_threshold,
+                                                 float score_threshold, concurrency::ThreadPool* thread_pool,
+                                                 std::vector<std::vector<int64_t>>& selected_boxes) {
+  const int64_t num_boxes = pc.num_boxes_;
+  const int64_t num_pairs = pc.num_batches_ * pc.num_classes_;
+  selected_boxes.clear();
+  selected_boxes.resize(static_cast<size_t>(num_pairs));
 
+  // the boxes of a batch are shared by all of its classes
+  std::vector<float> corners(SafeInt<size_t>(pc.num_batches_) * num_boxes * kBoxArrayCount);
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfo> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index, center_point_box, batch_boxes + (box_index * 4));
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index, center_point_box, batch_boxes + (box_index * 4));
-        }
-      }
-      std::priority_queue<BoxInfo, std::vector<BoxInfo>> sorted_boxes(std::less<BoxInfo>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfo& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (next_top_score.SuppressByIOU(selected_index, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
+    ConvertBoxes(pc.boxes_data_ + batch_index * num_boxes * 4, num_boxes, center_point_box,
+                 corners.data() + batch_index * num_boxes * kBoxArrayCount);
+  }
+
+  const float* score_threshold_data = pc.score_threshold_ != nullptr ? &score_threshold : nullptr;
+
+  // each pair reads its scores and boxes, and sorts its candidates
+  const TensorOpCost cost{static_cast<double>(num_boxes * (1 + kBoxArrayCount) * sizeof(float)), 0.0,
+                          static_cast<double>(num_boxes) * 16};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_pairs), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<ScoreIndex> candidates;
+        candidates.reserve(static_cast<size_t>(num_boxes));
+        SelectedBoxes selected;
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+        for (std::ptrdiff_t pair_index = first; pair_index < last; ++pair_index) {
+          const int64_t batch_index = pair_index / pc.num_classes_;
+          SuppressClass(pc.scores_data_ + pair_index * num_boxes,
+                        corners.data() + batch_index * num_boxes * kBoxArrayCount, num_boxes, score_threshold_data,
+                        max_output_boxes_per_class, iou_threshold, candidates, selected,
+                        selected_boxes[static_cast<size_t>(pair_index)]);
         }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+      });
+}
+
+Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
+  PrepareContext pc;
+  auto ret = PrepareCompute(ctx, pc);
+  ORT_RETURN_IF_NOT(ret.IsOK(), ret.ErrorMessage());
+
+  int64_t max_output_boxes_per_class = 0;
+  float iou_threshold = .0f;
+  float score_threshold = .0f;
+
+  ret = GetThresholdsFromInputs(pc, max_output_boxes_per_class, iou_threshold, score_threshold);
+  ORT_RETURN_IF_NOT(ret.IsOK(), ret.ErrorMessage());
+
+  if (0 == max_output_boxes_per_class) {
+    ctx->Output(0, {0, 3});
+    return Status::OK();
+  }
+
+  std::vector<std::vector<int64_t>> selected_boxes;
+  ComputeSelectedBoxes(pc, GetCenterPointBox(), max_output_boxes_per_class, iou_threshold, score_threshold,
+                       ctx->GetOperatorThreadPool(), selected_boxes);
+
+  size_t num_selected = 0;
+  for (const auto& pair_boxes : selected_boxes) {
+    num_selected += pair_boxes.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* selected_indices = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+
+  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
+    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
+      for (int64_t box_index : selected_boxes[static_cast<size_t>(batch_index * pc.num_classes_ + class_index)]) {
+        *selected_indices++ = SelectedIndex(batch_index, class_index, box_index);
+      }
+    }
+  }
 
   return Status::OK();
 }
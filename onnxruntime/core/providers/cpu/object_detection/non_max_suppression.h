@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
 
+namespace concurrency {
+class ThreadPool;
+}
+
 struct PrepareContext;
 
 class NonMaxSuppressionBase {
@@ -23,6 +29,13 @@ class NonMaxSuppressionBase {
                                         float& iou_threshold,
                                         float& score_threshold);
 
+  // Runs the suppression of every (batch, class) pair on the thread pool. selected_boxes[batch * num_classes + class]
+  // receives the indices of the boxes selected for the pair in order of decreasing score.
+  static void ComputeSelectedBoxes(const PrepareContext& pc, int64_t center_point_box,
+                                   int64_t max_output_boxes_per_class, float iou_threshold, float score_threshold,
+                                   concurrency::ThreadPool* thread_pool,
+                                   std::vector<std::vector<int64_t>>& selected_boxes);
+
   int64_t GetCenterPointBox() const {
     return center_point_box_;
   }
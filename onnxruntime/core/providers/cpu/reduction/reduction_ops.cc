@@ -243,6 +243,47 @@ bool SetupForReduce(const Tensor* input_tensor_ptr,
   }
   return need_copy;
 }
+FastReduceKind OptimizeShapeForFastReduce(const std::vector<int64_t>& input_shape,
+                                          const std::vector<int64_t>& reduced_axes,
+                                          std::vector<int64_t>& fast_shape) {
+  std::vector<bool> is_reduced(input_shape.size(), false);
+  for (auto a : reduced_axes) {
+    is_reduced[a] = true;
+  }
+
+  // merge consecutive axes of the same kind. axes of dimension 1 can be treated as either kind so are skipped.
+  fast_shape.clear();
+  std::vector<bool> fast_is_reduced;
+  for (size_t i = 0; i < input_shape.size(); ++i) {
+    if (input_shape[i] == 1) {
+      continue;
+    }
+    if (!fast_shape.empty() && fast_is_reduced.back() == is_reduced[i]) {
+      fast_shape.back() *= input_shape[i];
+    } else {
+      fast_shape.push_back(input_shape[i]);
+      fast_is_reduced.push_back(is_reduced[i]);
+    }
+  }
+
+  switch (fast_shape.size()) {
+    case 0:
+      // all dimensions are 1
+      fast_shape = {1, 1};
+      return FastReduceKind::kKR;
+    case 1:
+      fast_shape = fast_is_reduced[0] ? std::vector<int64_t>{1, fast_shape[0]}
+                                      : std::vector<int64_t>{fast_shape[0], 1};
+      return FastReduceKind::kKR;
+    case 2:
+      return fast_is_reduced[0] ? FastReduceKind::kRK : FastReduceKind::kKR;
+    case 3:
+      return fast_is_reduced[0] ? FastReduceKind::kNone : FastReduceKind::kKRK;
+    default:
+      return FastReduceKind::kNone;
+  }
+}
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  const std::vector<int64_t>& reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
@@ -356,6 +397,23 @@ void NoTransposeReduce(Tensor* output, const TensorShape& new_input_shape, const
     return;
   }
 
+  if (AGG::fast_reduce() && new_input_shape.Size() > 0) {
+    std::vector<int64_t> fast_shape;
+    switch (OptimizeShapeForFastReduce(new_input_shape.GetDims(), reduced_axes, fast_shape)) {
+      case FastReduceKind::kKR:
+        AGG::FastReduceKR(from_data, fast_shape, to_data, tp);
+        return;
+      case FastReduceKind::kRK:
+        AGG::FastReduceRK(from_data, fast_shape, to_data, tp);
+        return;
+      case FastReduceKind::kKRK:
+        AGG::FastReduceKRK(from_data, fast_shape, to_data, tp);
+        return;
+      default:
+        break;
+    }
+  }
+
   if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
     NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
     if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
@@ -43,6 +43,63 @@ class ResultsNoTransposePrepareForReduce {
   }
 };
 
+// Reductions which can be expressed on a shape where consecutive kept (K) or reduced (R) axes
+// have been merged and axes of dimension 1 removed. These are computed directly on the strided input
+// without the index tables built by NoTransposePrepareForReduce.
+enum class FastReduceKind {
+  kNone,  // no fast path
+  kKR,    // [K, R] -> [K], reduce the inner dimension
+  kRK,    // [R, K] -> [K], reduce the outer dimension
+  kKRK,   // [K, R, K] -> [K, K], reduce the middle dimension
+};
+
+// Classifies the reduction of input_shape over reduced_axes (sorted and non-negative).
+// fast_shape receives the merged dimensions matching the returned kind.
+FastReduceKind OptimizeShapeForFastReduce(const std::vector<int64_t>& input_shape,
+                                          const std::vector<int64_t>& reduced_axes,
+                                          std::vector<int64_t>& fast_shape);
+
+// [K, R] -> [K]. reduce_row(row, R) aggregates one contiguous row.
+template <typename T, typename TVAL, typename FROW>
+void FastReduceKRImpl(const T* data, const std::vector<int64_t>& fast_shape, TVAL* out,
+                      concurrency::ThreadPool* tp, FROW reduce_row) {
+  const int64_t N = fast_shape[1];
+  concurrency::ThreadPool::TryParallelFor(
+      tp, fast_shape[0], TensorOpCost{static_cast<double>(N * sizeof(T)), static_cast<double>(sizeof(TVAL)),
+                                      static_cast<double>(N * 2)},
+      [data, N, out, &reduce_row](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          out[i] = reduce_row(data + i * N, N);
+        }
+      });
+}
+
+// [K0, R, K1] -> [K0, K1]. [R, K] is handled as K0 == 1. The kept elements are processed as contiguous
+// runs: init(out, in, n) starts a run from the first reduced row, update(out, in, n) accumulates each of the
+// following rows, and finalize(out, n) completes it.
+template <typename T, typename FINIT, typename FUPDATE, typename FFINAL>
+void FastReduceKRKImpl(const T* data, int64_t K0, int64_t R, int64_t K1, T* out, concurrency::ThreadPool* tp,
+                       FINIT init, FUPDATE update, FFINAL finalize) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, K0 * K1, TensorOpCost{static_cast<double>(R * sizeof(T)), static_cast<double>(sizeof(T)),
+                                static_cast<double>(R)},
+      [=, &init, &update, &finalize](std::ptrdiff_t first, std::ptrdiff_t last) {
+        while (first < last) {
+          const int64_t i = first / K1;
+          const int64_t k = first % K1;
+          const int64_t n = std::min<int64_t>(last - first, K1 - k);
+          const T* in = data + i * R * K1 + k;
+          T* o = out + first;
+          init(o, in, n);
+          for (int64_t r = 1; r < R; ++r) {
+            update(o, in + r * K1, n);
+          }
+          finalize(o, n);
+          first += n;
+        }
+      });
+}
+
 template <typename T>
 inline T reduce_sqrt(T value) { return std::sqrt(value); }
 
@@ -114,6 +171,18 @@ class ReduceAggregator {
   inline TVAL get_value() { return accumulator_; }
   inline void enforce(const ResultsNoTransposePrepareForReduce&) {}
   static inline bool two_loops() { return false; }
+
+  // Aggregators implementing the FastReduceKind paths override these.
+  static inline bool fast_reduce() { return false; }
+  static void FastReduceKR(const T*, const std::vector<int64_t>&, TVAL*, concurrency::ThreadPool*) {
+    ORT_THROW("must be overloaded.");
+  }
+  static void FastReduceRK(const T*, const std::vector<int64_t>&, TVAL*, concurrency::ThreadPool*) {
+    ORT_THROW("must be overloaded.");
+  }
+  static void FastReduceKRK(const T*, const std::vector<int64_t>&, TVAL*, concurrency::ThreadPool*) {
+    ORT_THROW("must be overloaded.");
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -124,6 +193,28 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
   inline TVAL aggall(const T* from_data) {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).sum();
   }
+
+  static inline bool fast_reduce() { return true; }
+  static void FastReduceKR(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRImpl(data, fast_shape, out, tp,
+                     [](const T* row, int64_t n) { return ConstEigenVectorArrayMap<T>(row, n).sum(); });
+  }
+  static void FastReduceRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, 1, fast_shape[0], fast_shape[1], out, tp, CopyRow, AddRow, [](T*, int64_t) {});
+  }
+  static void FastReduceKRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                            concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp, CopyRow, AddRow,
+                      [](T*, int64_t) {});
+  }
+
+ protected:
+  static void CopyRow(T* out, const T* in, int64_t n) { std::copy_n(in, n, out); }
+  static void AddRow(T* out, const T* in, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) += ConstEigenVectorArrayMap<T>(in, n);
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -144,6 +235,27 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).mean();
   }
   inline T get_value() { return this->accumulator_ / static_cast<T>(this->N_); }
+
+  static void FastReduceKR(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRImpl(data, fast_shape, out, tp, [](const T* row, int64_t n) {
+      return ConstEigenVectorArrayMap<T>(row, n).sum() / static_cast<T>(n);
+    });
+  }
+  static void FastReduceRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    const T N = static_cast<T>(fast_shape[0]);
+    FastReduceKRKImpl(data, 1, fast_shape[0], fast_shape[1], out, tp, ReduceAggregatorSum<T, TVAL>::CopyRow,
+                      ReduceAggregatorSum<T, TVAL>::AddRow,
+                      [N](T* o, int64_t n) { EigenVectorArrayMap<T>(o, n) /= N; });
+  }
+  static void FastReduceKRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                            concurrency::ThreadPool* tp) {
+    const T N = static_cast<T>(fast_shape[1]);
+    FastReduceKRKImpl(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp,
+                      ReduceAggregatorSum<T, TVAL>::CopyRow, ReduceAggregatorSum<T, TVAL>::AddRow,
+                      [N](T* o, int64_t n) { EigenVectorArrayMap<T>(o, n) /= N; });
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -154,6 +266,28 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).maxCoeff();
   }
   inline void update(const T& v) { this->accumulator_ = v > this->accumulator_ ? v : this->accumulator_; }
+
+  static inline bool fast_reduce() { return true; }
+  static void FastReduceKR(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRImpl(data, fast_shape, out, tp,
+                     [](const T* row, int64_t n) { return ConstEigenVectorArrayMap<T>(row, n).maxCoeff(); });
+  }
+  static void FastReduceRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, 1, fast_shape[0], fast_shape[1], out, tp, CopyRow, MaxRow, [](T*, int64_t) {});
+  }
+  static void FastReduceKRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                            concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp, CopyRow, MaxRow,
+                      [](T*, int64_t) {});
+  }
+
+ private:
+  static void CopyRow(T* out, const T* in, int64_t n) { std::copy_n(in, n, out); }
+  static void MaxRow(T* out, const T* in, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = EigenVectorArrayMap<T>(out, n).max(ConstEigenVectorArrayMap<T>(in, n));
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -253,6 +387,28 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).minCoeff();
   }
   inline void update(const T& v) { this->accumulator_ = v < this->accumulator_ ? v : this->accumulator_; }
+
+  static inline bool fast_reduce() { return true; }
+  static void FastReduceKR(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRImpl(data, fast_shape, out, tp,
+                     [](const T* row, int64_t n) { return ConstEigenVectorArrayMap<T>(row, n).minCoeff(); });
+  }
+  static void FastReduceRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                           concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, 1, fast_shape[0], fast_shape[1], out, tp, CopyRow, MinRow, [](T*, int64_t) {});
+  }
+  static void FastReduceKRK(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                            concurrency::ThreadPool* tp) {
+    FastReduceKRKImpl(data, fast_shape[0], fast_shape[1], fast_shape[2], out, tp, CopyRow, MinRow,
+                      [](T*, int64_t) {});
+  }
+
+ private:
+  static void CopyRow(T* out, const T* in, int64_t n) { std::copy_n(in, n, out); }
+  static void MinRow(T* out, const T* in, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = EigenVectorArrayMap<T>(out, n).min(ConstEigenVectorArrayMap<T>(in, n));
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -10,6 +10,7 @@
 #endif
 
 #include "deep_cpu_lstm.h"
+#include "uni_directional_lstm.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -193,9 +194,12 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
   packed_weights.weights_size_ = packed_weights_size;
   packed_weights.shape_ = shape;
 
+  // the gates are interleaved before packing so each tile of the GEMM output holds complete hidden units
+  std::vector<float> interleaved_weights(N * K);
   const auto* weights_data = weights.Data<float>();
   for (int i = 0; i < num_directions_; i++) {
-    MlasGemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    lstm::InterleaveGates(weights_data, interleaved_weights.data(), hidden_size_, 1, K);
+    MlasGemmPackB(CblasTrans, N, K, interleaved_weights.data(), K, packed_weights_data);
     packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
     weights_data += N * K;
   }
@@ -233,8 +237,30 @@ Status DeepCpuLstmOp::Compute(OpKernelContext* context) const {
     const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
     const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_.shape_;
 
-    const auto* input_weights = (W != nullptr) ? W->Data<float>() : nullptr;
-    const auto* recurrent_weights = (R != nullptr) ? R->Data<float>() : nullptr;
+    // weights that were not prepacked still need their gates interleaved. see lstm::InterleaveGates.
+    // anything with an unexpected shape is passed through as is to be rejected by the input validation.
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+    auto interleave = [&](const Tensor* weights, IAllocatorUniquePtr<float>& interleaved) -> const float* {
+      if (weights == nullptr) {
+        return nullptr;
+      }
+
+      const auto& shape = weights->Shape();
+      if (shape.NumDimensions() != 3 || shape[1] != 4 * static_cast<int64_t>(hidden_size_)) {
+        return weights->Data<float>();
+      }
+
+      interleaved = IAllocator::MakeUniquePtr<float>(alloc, shape.Size());
+      lstm::InterleaveGates(weights->Data<float>(), interleaved.get(), hidden_size_, shape[0], shape[2]);
+      return interleaved.get();
+    };
+
+    IAllocatorUniquePtr<float> interleaved_W;
+    IAllocatorUniquePtr<float> interleaved_R;
+    const auto* input_weights = interleave(W, interleaved_W);
+    const auto* recurrent_weights = interleave(R, interleaved_R);
 
     // spans for first direction
     const size_t input_weights_size_per_direction = W_shape[1] * W_shape[2];
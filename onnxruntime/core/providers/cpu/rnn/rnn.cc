@@ -151,6 +151,10 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
 
   int64_t Y_frame_size = batch_size * hidden_size_;
 
+  // Enter a parallel section encompassing the per-step GEMMs below so the
+  // workers are summoned once rather than for every step.
+  concurrency::ThreadPool::ParallelSection ps(tp);
+
   for (int direction = 0; direction < num_directions; direction++) {
     auto activation_func = GetFuncByName<float>(activations_[direction], "Tanh");
     bool isReverse = direction_ == "reverse" || direction == 1;
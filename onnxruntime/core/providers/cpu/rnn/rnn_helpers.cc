@@ -201,6 +201,30 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
   std::cout << std::endl;
 }
 
+namespace {
+
+// Applies the optional row epilogue to each tile of the float GEMM output as soon as MLAS completes it.
+class SGemmRowEpilogueOutputProcessor : public MLAS_SGEMM_OUTPUT_PROCESSOR {
+ public:
+  explicit SGemmRowEpilogueOutputProcessor(const GemmRowEpilogue* epilogue) : epilogue_(epilogue) {}
+
+  void Process(float* C,
+               size_t StartM,
+               size_t StartN,
+               size_t CountM,
+               size_t CountN,
+               size_t ldc) const override {
+    for (size_t m = 0; m < CountM; m++) {
+      epilogue_->Process(C + m * ldc, static_cast<int>(StartM + m), static_cast<int>(StartN), static_cast<int>(CountN));
+    }
+  }
+
+ private:
+  const GemmRowEpilogue* epilogue_;
+};
+
+}  // namespace
+
 void ComputeGemm(const int M,
                  const int N,
                  const int K,
@@ -213,29 +237,74 @@ void ComputeGemm(const int M,
                  float* C_end,
                  const int ldc,
                  AllocatorPtr /*allocator*/,
-                 concurrency::ThreadPool* thread_pool) {
+                 concurrency::ThreadPool* thread_pool,
+                 const GemmRowEpilogue* epilogue) {
   // validate all the inputs
   // need to use the lda/ldb/ldc strides which should be >= the columns for the span
   ORT_ENFORCE(A + (M * K) <= A_end);
   ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
 
+  SGemmRowEpilogueOutputProcessor epilogue_processor(epilogue);
+  const MLAS_SGEMM_OUTPUT_PROCESSOR* output_processor = epilogue != nullptr ? &epilogue_processor : nullptr;
+
   if (weights.is_prepacked_) {
     MlasGemm(
         CblasNoTrans,
         M, N, K, alpha,
         A, K,
         weights.buffer_, beta,
-        C, ldc, thread_pool);
+        C, ldc, thread_pool, output_processor);
   } else {
-    ::onnxruntime::math::GemmEx<float>(
+    MlasGemm(
         CblasNoTrans, CblasTrans,
         M, N, K, alpha,
         A, K,
         static_cast<const float*>(weights.buffer_), K, beta,
-        C, ldc, thread_pool);
+        C, ldc, thread_pool, output_processor);
   }
 }
 
+namespace {
+
+// Converts the int32 accumulator tile to float and then applies the optional row epilogue to the same
+// tile so the output is only brought into cache once per GEMM.
+class QGemmRowEpilogueOutputProcessor : public MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR {
+ public:
+  QGemmRowEpilogueOutputProcessor(float* output,
+                                  size_t ld_output,
+                                  const float* scale,
+                                  MLAS_QGEMM_OUTPUT_MODE mode,
+                                  MLAS_QUANTIZATION_GRANULARITY quant_gran,
+                                  const GemmRowEpilogue* epilogue)
+      : MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR(output, ld_output, scale, nullptr, mode, quant_gran),
+        output_(output),
+        ld_output_(ld_output),
+        epilogue_(epilogue) {}
+
+  void Process(const int32_t* C,
+               size_t StartM,
+               size_t StartN,
+               size_t CountM,
+               size_t CountN,
+               size_t ldc) const override {
+    MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR::Process(C, StartM, StartN, CountM, CountN, ldc);
+
+    if (epilogue_ != nullptr) {
+      for (size_t m = StartM; m < StartM + CountM; m++) {
+        epilogue_->Process(output_ + m * ld_output_ + StartN,
+                           static_cast<int>(m), static_cast<int>(StartN), static_cast<int>(CountN));
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ld_output_;
+  const GemmRowEpilogue* epilogue_;
+};
+
+}  // namespace
+
 void ComputeGemm(const int M,
                  const int N,
                  const int K,
@@ -248,7 +317,8 @@ void ComputeGemm(const int M,
                  float* C_end,
                  const int ldc,
                  AllocatorPtr allocator,
-                 concurrency::ThreadPool* thread_pool) {
+                 concurrency::ThreadPool* thread_pool,
+                 const GemmRowEpilogue* epilogue) {
   // validate all the inputs
   // need to use the lda/ldb/ldc strides which should be >= the columns for the span
   ORT_ENFORCE(A + (M * K) <= A_end);
@@ -282,10 +352,11 @@ void ComputeGemm(const int M,
     tmp_res_buffer_holder = BufferUniquePtr(C_buffer, BufferDeleter(allocator));
   }
 
-  MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR output_processor(
-      C, ldc, scale_multiplier.data(), nullptr,
+  QGemmRowEpilogueOutputProcessor output_processor(
+      C, ldc, scale_multiplier.data(),
       beta == 1.0f ? MLAS_QGEMM_OUTPUT_MODE::AccumulateMode : MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-      scale_multiplier.size() == 1 ? MLAS_QUANTIZATION_GRANULARITY::PerMatrix : MLAS_QUANTIZATION_GRANULARITY::PerColumn);
+      scale_multiplier.size() == 1 ? MLAS_QUANTIZATION_GRANULARITY::PerMatrix : MLAS_QUANTIZATION_GRANULARITY::PerColumn,
+      epilogue);
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
   if (weights.is_prepacked_) {
     MlasGemm(static_cast<size_t>(M),
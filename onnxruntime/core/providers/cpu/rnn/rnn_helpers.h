@@ -218,6 +218,20 @@ struct GemmWeights {
   QuantizationParameter* quant_para_{nullptr};
 };
 
+// Post-processing applied to a range of one row of the float GEMM output while it is still hot in cache.
+// It runs from the MLAS output processor on each tile as soon as the tile is complete: with quantized weights
+// right after the int32 accumulator tile is converted to float, with float weights right after the last K
+// slice of the tile, so bias, clip and gate activations are fused into the GEMM. Tile columns start at a
+// multiple of 16 unless the GEMM is small enough that MLAS hands over the whole output in one call.
+// Implementations are called concurrently for disjoint ranges and must not depend on any other part of C.
+class GemmRowEpilogue {
+ public:
+  virtual void Process(float* C_row, int row, int col_begin, int col_count) const = 0;
+
+ protected:
+  ~GemmRowEpilogue() = default;
+};
+
 void ComputeGemm(const int M,
                  const int N,
                  const int K,
@@ -230,7 +244,8 @@ void ComputeGemm(const int M,
                  float* C_end,
                  const int ldc,
                  AllocatorPtr /*allocator*/,
-                 concurrency::ThreadPool* thread_pool);
+                 concurrency::ThreadPool* thread_pool,
+                 const GemmRowEpilogue* epilogue = nullptr);
 
 void ComputeGemm(const int M,
                  const int N,
@@ -244,7 +259,8 @@ void ComputeGemm(const int M,
                  float* C_end,
                  const int ldc,
                  AllocatorPtr allocator,
-                 concurrency::ThreadPool* thread_pool);
+                 concurrency::ThreadPool* thread_pool,
+                 const GemmRowEpilogue* epilogue = nullptr);
 
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+
+namespace onnxruntime {
+namespace gru {
+
+using namespace rnn::detail;
+
+template <typename T>
+class UniDirectionalGru {
+ public:
+  UniDirectionalGru(AllocatorPtr allocator, int seq_length, int batch_size, int input_size, int hidden_size,
+                    bool linear_before_reset, Direction direction, const gsl::span<const T>& bias,
+                    const gsl::span<const T>& initial_hidden_state, const ActivationFuncs::Entry& activation_func_f,
+                    const ActivationFuncs::Entry& activation_func_g, float clip,
+                    onnxruntime::concurrency::ThreadPool* ttp);
+
+  // recurrent_weights_ZR holds R[zr] and recurrent_weights_H holds R[h] so that each of the per-step
+  // recurrent GEMMs can run against contiguous (or prepacked) weights.
+  template <typename WeightT>
+  void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
+               const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights_ZR,
+               const GemmWeights<WeightT>& recurrent_weights_H, gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+
+  ~UniDirectionalGru() = default;
+
+ private:
+  // Epilogue of the Ht-1 * R[zr] GEMM. Adds the bias and clips the z and r gate inputs, applies f() to both,
+  // and writes rt (.) Ht-1 (or rt (.) (Ht-1 * (Rh^T) + Rbh) if linear_before_reset_) to cur_h_.
+  class ZRGateEpilogue : public GemmRowEpilogue {
+   public:
+    ZRGateEpilogue(const UniDirectionalGru& gru, const T* prev_Ht) : gru_(gru), prev_Ht_(prev_Ht) {}
+    void Process(float* C_row, int row, int col_begin, int col_count) const override;
+
+   private:
+    const UniDirectionalGru& gru_;
+    const T* prev_Ht_;
+  };
+
+  // Epilogue of the (rt (.) Ht-1) * Rh GEMM. Adds the bias and clips the h gate input, and computes
+  // Ht = (1 - zt) (.) g(ht) + zt (.) Ht-1 directly into the output.
+  class HGateEpilogue : public GemmRowEpilogue {
+   public:
+    HGateEpilogue(const UniDirectionalGru& gru, int step, int min_sequence_length,
+                  const gsl::span<const int>& sequence_lengths, const T* prev_Ht, T* output, bool output_sequence)
+        : gru_(gru),
+          step_(step),
+          min_sequence_length_(min_sequence_length),
+          sequence_lengths_(sequence_lengths),
+          prev_Ht_(prev_Ht),
+          output_(output),
+          output_sequence_(output_sequence) {}
+    void Process(float* C_row, int row, int col_begin, int col_count) const override;
+
+   private:
+    const UniDirectionalGru& gru_;
+    int step_;
+    int min_sequence_length_;
+    gsl::span<const int> sequence_lengths_;
+    const T* prev_Ht_;
+    T* output_;
+    bool output_sequence_;
+  };
+
+  AllocatorPtr allocator_;
+
+  int seq_length_;
+  int batch_size_;
+  int input_size_;
+  int hidden_size_;
+  bool linear_before_reset_;
+
+  const float clip_;
+
+  Direction direction_;
+  bool use_bias_;
+
+  IAllocatorUniquePtr<T> outputZRH_ptr_;
+  gsl::span<T> outputZRH_;
+
+  IAllocatorUniquePtr<T> cur_h_ptr_;
+  IAllocatorUniquePtr<T> batched_hidden0_ptr_;
+  IAllocatorUniquePtr<int> sequence_lengths_ptr_;
+  gsl::span<T> cur_h_;
+  gsl::span<T> batched_hidden0_;
+  gsl::span<int> sequence_lengths_;
+
+  // Wb[zr] and Rb[zr] can always be added together upfront, and repeated to match the batch size for
+  // faster GEMM calculations, so these two members are all the
+  // Wb[z] + Rb[z] values added together, repeated batch_size_ times
+  IAllocatorUniquePtr<T> batched_bias_WRz_ptr_, batched_bias_WRr_ptr_;
+  gsl::span<T> batched_bias_WRz_, batched_bias_WRr_;
+
+  // Wbh and Rbh can only be combined upfront if linear_before_reset_ is false
+  IAllocatorUniquePtr<T> batched_bias_WRh_ptr_;
+  gsl::span<T> batched_bias_WRh_;
+
+  // if linear_before_reset_ is true, we need to setup Wbh and Rbh separately
+  IAllocatorUniquePtr<T> batched_bias_Wh_ptr_, batched_bias_Rh_ptr_;
+  gsl::span<T> batched_bias_Wh_, batched_bias_Rh_;
+
+  IAllocatorUniquePtr<T> linear_output_ptr_;
+  gsl::span<T> linear_output_;
+
+  IAllocatorUniquePtr<T> inputs_reverse_ptr_;
+  IAllocatorUniquePtr<T> outputs_reverse_ptr_;
+  gsl::span<T> inputs_reverse_;
+  gsl::span<T> outputs_reverse_;
+
+  deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_{};
+
+  float zr_alpha_{};
+  float zr_beta_{};
+  float h_alpha_{};
+  float h_beta_{};
+
+  deepcpu::GruResetGateFuncPtr reset_gate_{};
+  deepcpu::ActivationFuncPtr update_gate_{};
+  deepcpu::GruOutputGateFuncPtr output_gate_{};
+
+  void AllocateBuffers();
+
+  onnxruntime::concurrency::ThreadPool* ttp_;
+};
+
+}  // namespace gru
+}  // namespace onnxruntime
@@ -89,8 +89,6 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
 
   batched_internal_memory_prev_ =
       Allocate(allocator_, batch_size_ * hidden_size_, batched_internal_memory_prev_ptr_);
-  batched_internal_memory_clipped_ =
-      Allocate(allocator_, batch_size_ * hidden_size_, batched_internal_memory_clipped_ptr_, fill);
 
   output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_);
 
@@ -217,8 +215,6 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   // LSTM Layer
   gsl::span<T> batched_hidden_state_one_step = batched_hidden0_;
-  gsl::span<T> batched_internal_state_prev_one_step = batched_internal_memory_prev_;
-  gsl::span<T> batched_internal_state_clipped_one_step = batched_internal_memory_clipped_;
 
   int output_step_length = batch_size_ * hidden_size_;
 
@@ -257,7 +253,8 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
-  // apply the weights to all the inputs and save to output_IOFC
+  // apply the weights to all the inputs and save to output_IOFC. the columns of each row are ordered
+  // i, o, f, c for each hidden unit as the weights are interleaved.
   ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs.cbegin(), inputs.cend(),
               input_weights,
               beta, output_iofc_.begin(), output_iofc_.end(), hidden_size_x4, allocator_, thread_pool_);
@@ -266,13 +263,6 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   beta = 1.0f;  // calls to ComputeGemm now add to existing data
 
-  // NOTE: we could refine the bounds checking in the calls below that use these values to instead
-  // explicitly check just the range for each iteration, however if it's going to run over
-  // it should also run over on the last iteration, so this should be good enough to catch any
-  // logic errors causing bounds violations.
-  const span_T_iter C_prev_end = batched_internal_state_prev_one_step.end();
-  const span_T_iter C_prev_clipped_end = batched_internal_state_clipped_one_step.end();
-
   int num_seq_to_compute = batch_size_;
   if (batch_parallel_) {
     num_seq_to_compute = batch_size_ / num_threads_;
@@ -289,10 +279,6 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     if ((seq_start + num_seq_to_compute) > batch_size_)
       num_seq_to_compute_adjusted = batch_size_ - seq_start;
 
-    // these are all batch * hidden_size_ and get updated in-place when running GateComputations so non-const iters
-    span_T_iter c_prev = batched_internal_state_prev_one_step.begin() + seq_start * hidden_size_;
-    span_T_iter c_prev_clipped = batched_internal_state_clipped_one_step.begin() + seq_start * hidden_size_;
-
     // hidden state can be provided as input for first step, so need to special case that.
     // after the first step this will switch to the output from the previous step
     span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin() + seq_start * hidden_size_;
@@ -300,21 +286,11 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     // run through steps sequentially
     for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
-      const std::string row_str = " [row=" + std::to_string(row) + ",seqno=" + std::to_string(step) + "]";
+      const std::string row_str = " [row=" + std::to_string(seq_start) + ",seqno=" + std::to_string(step) + "]";
 #endif
 
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + seq_start) * hidden_size_x4;
 
-      // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,       // Ht-1
-                  recurrent_weights,                        // R[iofc]
-                  beta, step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4, allocator_, ttp);
-
-      DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
-
       span_T_iter batched_output;
       span_T_iter batched_output_end;
       if (output_sequence) {
@@ -324,12 +300,34 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       } else {
         batched_output = final_hidden_state.begin();
         batched_output_end = final_hidden_state.end();
+
+        // Ht is written to final_hidden_state by the GEMM epilogue while other tiles may still be reading Ht-1
+        // from it, so copy Ht-1 to batched_hidden0_, which is no longer needed after the first step.
+        if (step > 0) {
+          auto rows = gsl::make_span(&*previous_state, num_seq_to_compute_adjusted * hidden_size_);
+          gsl::copy(rows, batched_hidden0_.subspan(seq_start * hidden_size_, rows.size()));
+          previous_state = batched_hidden0_.cbegin() + seq_start * hidden_size_;
+          previous_state_end = batched_hidden0_.cend();
+        }
       }
 
-      span_T_iter step_out_IOFC_end = step_out_IOFC + num_seq_to_compute_adjusted * hidden_size_x4;
-      GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
-                       batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
-                       num_seq_to_compute_adjusted, output_sequence);
+      ORT_ENFORCE(batched_output + (seq_start + num_seq_to_compute_adjusted) * hidden_size_ <= batched_output_end);
+      GateEpilogue gate_epilogue(*this, step, seq_start, min_sequence_length, sequence_lengths, &*batched_output,
+                                 output_sequence);
+
+      // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
+      // the epilogue calculates the gates, Ct and Ht from each tile of the result
+      // Do it sequentially to avoid nested parallelism
+      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
+                  previous_state, previous_state_end,       // Ht-1
+                  recurrent_weights,                        // R[iofc]
+                  beta, step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                  hidden_size_x4, allocator_, ttp, &gate_epilogue);
+
+      DumpMatrix("C" + row_str, batched_internal_memory_prev_.data() + seq_start * hidden_size_,
+                 num_seq_to_compute_adjusted, hidden_size_);
+      DumpMatrix("H" + row_str, &*batched_output + seq_start * hidden_size_, num_seq_to_compute_adjusted,
+                 hidden_size_);
 
       // copy last row to final_cell_state
       for (int lrow = seq_start; lrow < seq_start + num_seq_to_compute_adjusted; ++lrow) {
@@ -344,16 +342,6 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         }
       }
 
-      if (output_sequence) {
-        // set to 0 if step >= sequence_length
-        for (int lrow = seq_start; lrow < seq_start + num_seq_to_compute_adjusted; lrow++) {
-          if (step >= min_sequence_length && step >= sequence_lengths[lrow]) {
-            auto output_lrow = outputs.begin() + step * output_step_length + lrow * hidden_size_;
-            std::fill_n(output_lrow, hidden_size_, (T)0);
-          }
-        }
-      }
-
       previous_state = batched_output + seq_start * hidden_size_;
       previous_state_end = batched_output_end;
     }
@@ -364,6 +352,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     double cost = max_sequence_length * (gemm_cost + num_seq_to_compute);
     ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool_);
   } else {
+    // Enter a parallel section encompassing the per-step GEMMs so the
+    // workers are summoned once for the whole sequence rather than once
+    // per step.
+    onnxruntime::concurrency::ThreadPool::ParallelSection ps(thread_pool_);
     sequences_calculator(0, thread_pool_);
   }
 
@@ -400,129 +392,94 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                        num_directions, thread_pool_);
 }
 
-// #define PREVIOUS_BROKEN_VERSION
-
-// This function can't use session thread pool
 template <typename T>
-void UniDirectionalLstm<T>::GateComputations(
-    span_T_iter& out, span_T_iter& out_end, span_T_iter& C_prev,
-    const span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
-    span_T_iter& C_prev_clipped, const span_T_iter& C_prev_clipped_end, span_T_iter& batched_output,
-    span_T_iter& batched_output_end, const gsl::span<const int>& seq_lengths, const int min_sequence_length,
-    const int step, const int row, const int local_fused_hidden_rows, bool output_sequence) {
-  int hidden_size_x4 = 4 * hidden_size_;
-
-  // Activation gates.
-  for (int b = 0; b < local_fused_hidden_rows; b++) {
-    if (step >= min_sequence_length && step >= seq_lengths[row + b]) {
-      if (output_sequence) {
-        auto fill_output = batched_output + (row + b) * hidden_size_;
-        std::fill(fill_output, fill_output + hidden_size_, T{});
-      }
-
-      continue;
+void UniDirectionalLstm<T>::GateEpilogue::Process(float* C_row, int row, int col_begin, int col_count) const {
+  // the tiles of the GEMM output start at a multiple of 16 columns and N is 4 * hidden_size, so each tile holds the
+  // complete [i o f c] group of the hidden units it covers
+  ORT_ENFORCE(col_begin % 4 == 0 && col_count % 4 == 0, "LSTM gate epilogue requires tiles of complete hidden units");
+
+  const int hidden_size = lstm_.hidden_size_;
+  const int batch_row = row_offset_ + row;
+  const int unit_begin = col_begin / 4;
+  const int unit_count = col_count / 4;
+  T* pH_row = output_ + batch_row * hidden_size;
+
+  if (step_ >= min_sequence_length_ && step_ >= sequence_lengths_[batch_row]) {
+    if (output_sequence_) {
+      std::fill_n(pH_row + unit_begin, unit_count, T{});
     }
 
-    // std::string row_str = " row[" + std::to_string(row + b) + "]";
-
-    // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
-    float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
-    float* po = pi + hidden_size_;
-    float* pf = po + hidden_size_;
-    float* pc = pf + hidden_size_;
+    return;
+  }
 
-#ifdef PREVIOUS_BROKEN_VERSION
-    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev, C_prev_end, hidden_size_);
-#else
-    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
-#endif
+  // Ct-1, which is updated in-place to Ct
+  T* pC_row = lstm_.batched_internal_memory_prev_.data() + batch_row * hidden_size;
+
+  // the gates are copied out of the interleaved tile so the activation functions can work on contiguous values
+  constexpr int max_units = 64;
+  float pi[max_units];
+  float po[max_units];
+  float pf[max_units];
+  float pc[max_units];
+  float pC_clipped[max_units];  // temporary storage for the clipped Ct value that is the input to h()
+
+  for (int unit = unit_begin, unit_end = unit_begin + unit_count; unit < unit_end; unit += max_units) {
+    const int count = std::min(max_units, unit_end - unit);
+    const float* gates = C_row + 4 * (unit - unit_begin);
+
+    for (int h = 0; h < count; h++) {
+      pi[h] = gates[4 * h + 0];
+      po[h] = gates[4 * h + 1];
+      pf[h] = gates[4 * h + 2];
+      pc[h] = gates[4 * h + 3];
+    }
 
-    // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
+    float* pC = pC_row + unit;
 
     // Input Gate
-    if (use_peepholes_) {
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
-                                   hidden_size_);
+    if (lstm_.use_peepholes_) {
+      deepcpu::elementwise_product(pC, lstm_.peephole_i_.data() + unit, pi, count);
     }
 
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
+    const float* pBi = lstm_.use_bias_ ? lstm_.bias_WRi_.data() + unit : nullptr;
+    lstm_.clip_with_bias_ptr_(lstm_.clip_, pBi, pi, count);  // post: pi has input to f() to calculate i
+    lstm_.activation_f_.func(pi, count, lstm_.activation_f_.alpha, lstm_.activation_f_.beta);
 
     // Forget Gate
-    if (input_forget_) {
-      for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+    if (lstm_.input_forget_) {
+      for (int h = 0; h < count; h++) pf[h] = 1.0f - pi[h];
     } else {
-      if (use_peepholes_) {
-        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_), pf,
-                                     hidden_size_);
+      if (lstm_.use_peepholes_) {
+        deepcpu::elementwise_product(pC, lstm_.peephole_f_.data() + unit, pf, count);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
-      activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      const float* pBf = lstm_.use_bias_ ? lstm_.bias_WRf_.data() + unit : nullptr;
+      lstm_.clip_with_bias_ptr_(lstm_.clip_, pBf, pf, count);
+      lstm_.activation_f_.func(pf, count, lstm_.activation_f_.alpha, lstm_.activation_f_.beta);
     }
 
-    // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
-
     // Block Gate
-    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
-    activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
-
-    // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
+    const float* pBc = lstm_.use_bias_ ? lstm_.bias_WRc_.data() + unit : nullptr;
+    lstm_.clip_with_bias_ptr_(lstm_.clip_, pBc, pc, count);
+    lstm_.activation_g_.func(pc, count, lstm_.activation_g_.alpha, lstm_.activation_g_.beta);
 
     // C_current. use previous C value as input, and update in-place
-    float* pC_cur = pCprev_hidden_size;
-#ifdef PREVIOUS_BROKEN_VERSION
-    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size + b * hidden_size_, pi, pf, pc,
-                                        pCprev_hidden_size + b * hidden_size_, hidden_size_);
-    // DumpMatrix("C", pCprev_hidden_size + b * hidden_size_, 1, hidden_size_);
-#else
-    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
-    // DumpMatrix("C", pC_cur, 1, hidden_size_);
-#endif
+    deepcpu::merge_lstm_gates_to_memory(pC, pi, pf, pc, pC, count);
 
     // Output Gate
-    if (use_peepholes_)
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_), po,
-                                   hidden_size_);
+    if (lstm_.use_peepholes_) {
+      deepcpu::elementwise_product(pC, lstm_.peephole_o_.data() + unit, po, count);
+    }
 
     // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("o" + row_str, po, 1, hidden_size_);
+    const float* pBo = lstm_.use_bias_ ? lstm_.bias_WRo_.data() + unit : nullptr;
+    lstm_.clip_with_bias_ptr_(lstm_.clip_, pBo, po, count);
+    lstm_.activation_f_.func(po, count, lstm_.activation_f_.alpha, lstm_.activation_f_.beta);
 
     // calculate 'Ht'
-    float* pH =
-        SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
-
-    // the C_prev_clipped location is not actually used as input - it's temporary storage for writing
-    // the clipped Ct value to, before calling h(). As such a) it could just be a local variable
-    // of std::vector<float> with size of hidden_size_, b) the previous version wasn't 'broken' by never
-    // incrementing what C_prev_clipped pointed to.
-#ifdef PREVIOUS_BROKEN_VERSION
-    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped, C_prev_clipped_end, hidden_size_);
-#else
-    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
-#endif
-
-    activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
-
-    // DumpMatrix("H" + row_str, pH, 1, hidden_size_);
+    lstm_.activation_h_.func(pC, pC_clipped, po, pH_row + unit, count, lstm_.activation_h_.alpha,
+                             lstm_.activation_h_.beta);
   }
-
-  auto num_rows = local_fused_hidden_rows - row;
-  std::string rows_str = " rows[" + std::to_string(row) + ".." + std::to_string(num_rows) + "]";
-
-  DumpMatrix("i" + rows_str, &*out, num_rows, hidden_size_, 0, hidden_size_x4);
-  DumpMatrix("o" + rows_str, &*out, num_rows, hidden_size_, 1 * hidden_size_, hidden_size_x4);
-  DumpMatrix("f" + rows_str, &*out, num_rows, hidden_size_, 2 * hidden_size_, hidden_size_x4);
-  DumpMatrix("c" + rows_str, &*out, num_rows, hidden_size_, 3 * hidden_size_, hidden_size_x4);
-  DumpMatrix("C" + rows_str, &*C_prev, num_rows, hidden_size_);  // Ct overwrites the input C_prev value
-  DumpMatrix("H" + rows_str, &*batched_output, num_rows, hidden_size_);
 }
 
 template <typename T>
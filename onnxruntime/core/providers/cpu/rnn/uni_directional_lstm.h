@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
@@ -22,6 +24,24 @@ struct ActivationInfo {
 // copying the peephole values into UniDirectionalLstm seems unnecessary. don't do that until proven necessary
 #define LSTM_NO_PEEPHOLE_COPY
 
+// UniDirectionalLstm computes the gates of each hidden unit in the epilogue of the recurrent GEMM, so every tile of
+// the GEMM output must hold all four gates of the hidden units it covers. The weights (and per-column quantization
+// parameters) are therefore reordered from the ONNX layout of four [iofc] gate blocks to i, o, f, c for each hidden
+// unit, i.e. gate column g * hidden_size + h moves to 4 * h + g.
+// src and dst are viewed as [outer_size, 4 * hidden_size, inner_size], e.g. outer_size is num_directions and
+// inner_size is input_size for the [num_directions, 4*hidden_size, input_size] ONNX W.
+template <typename T>
+void InterleaveGates(const T* src, T* dst, size_t hidden_size, size_t outer_size, size_t inner_size) {
+  for (size_t outer = 0; outer < outer_size; ++outer) {
+    for (size_t gate = 0; gate < 4; ++gate) {
+      for (size_t h = 0; h < hidden_size; ++h) {
+        std::copy_n(src + ((outer * 4 + gate) * hidden_size + h) * inner_size, inner_size,
+                    dst + ((outer * hidden_size + h) * 4 + gate) * inner_size);
+      }
+    }
+  }
+}
+
 template <typename T>
 class UniDirectionalLstm {
  public:
@@ -32,6 +52,7 @@ class UniDirectionalLstm {
                      const ActivationFuncs::Entry& activation_func_f, const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h, float clip, concurrency::ThreadPool* thread_pool);
 
+  // input_weights and recurrent_weights must have their gates interleaved by InterleaveGates.
   template <typename WeightT>
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights, gsl::span<T>& outputs,
@@ -43,13 +64,32 @@ class UniDirectionalLstm {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
-  void SetNumThreads();
+  // Epilogue of the Ht-1 * R[iofc] GEMM. Each call covers complete hidden units, so it adds the bias and peepholes,
+  // clips and applies the activations to all four gates, updates Ct in place of Ct-1, and writes Ht to the output.
+  class GateEpilogue : public GemmRowEpilogue {
+   public:
+    GateEpilogue(const UniDirectionalLstm& lstm, int step, int row_offset, int min_sequence_length,
+                 const gsl::span<const int>& sequence_lengths, T* output, bool output_sequence)
+        : lstm_(lstm),
+          step_(step),
+          row_offset_(row_offset),
+          min_sequence_length_(min_sequence_length),
+          sequence_lengths_(sequence_lengths),
+          output_(output),
+          output_sequence_(output_sequence) {}
+    void Process(float* C_row, int row, int col_begin, int col_count) const override;
+
+   private:
+    const UniDirectionalLstm& lstm_;
+    int step_;
+    int row_offset_;  // batch row of the first row of the GEMM
+    int min_sequence_length_;
+    gsl::span<const int> sequence_lengths_;
+    T* output_;
+    bool output_sequence_;
+  };
 
-  void GateComputations(span_T_iter& out, span_T_iter& out_end, span_T_iter& C_prev,
-                        const span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
-                        span_T_iter& C_prev_clipped, const span_T_iter& C_prev_clipped_end, span_T_iter& batched_output,
-                        span_T_iter& batched_output_end, const gsl::span<const int>& seq_lengths,
-                        int min_sequence_length, int step, int row, int local_fused_hidden_rows, bool output_sequence);
+  void SetNumThreads();
 
   void AllocateBuffers();
 
@@ -83,9 +123,7 @@ class UniDirectionalLstm {
   gsl::span<T> hidden0_, batched_hidden0_;
 
   IAllocatorUniquePtr<T> internal_memory_prev_ptr_, batched_internal_memory_prev_ptr_;
-  IAllocatorUniquePtr<T> batched_internal_memory_clipped_ptr_;
   gsl::span<T> internal_memory_prev_, batched_internal_memory_prev_;
-  gsl::span<T> batched_internal_memory_clipped_;
 
   IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
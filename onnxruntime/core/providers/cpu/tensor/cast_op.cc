@@ -10,9 +10,7 @@
 #include "core/util/math_cpuonly.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 // FUTURE:
 // Float16 and String have expensive special cased handling. Enable by default, but provide an easy way to disable
@@ -48,14 +46,7 @@ inline void CastData<MLFloat16, float>(const Tensor& in, Tensor& out, const Tens
   auto out_data = out.MutableData<float>();
   auto in_data = in.Data<MLFloat16>();
   auto shape_size = shape.Size();
-#if defined(_M_AMD64)
   MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)),
-                                                    shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
 }
 
 template <>
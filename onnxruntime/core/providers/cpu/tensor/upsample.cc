@@ -1,7 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include "core/common/safeint.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
 #include <sstream>
@@ -66,7 +65,8 @@ Status UpsampleNearest(const T* input,
                        float extrapolation_value,
                        bool use_nearest2x_optimization,
                        GetOriginalCoordinateFunc get_original_coordinate,
-                       GetNearestPixelFunc get_nearest_pixel) {
+                       GetNearestPixelFunc get_nearest_pixel,
+                       concurrency::ThreadPool* tp) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL,
                   is_resize ? "Resize: input/output value is nullptr"
@@ -184,19 +184,40 @@ Status UpsampleNearest(const T* input,
     CalculateInputMapping(input_mapping_1, 1);
     CalculateInputMapping(input_mapping_2, 2);
     CalculateInputMapping(input_mapping_3, 3);
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[output_dim0_inx];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[output_dim1_inx];
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          int64_t input_idx_2 = input_idx_1 + input_mapping_2[output_dim2_inx];
-          for (int64_t output_dim3_inx = 0; output_dim3_inx < output_shape[3]; output_dim3_inx++) {
-            int64_t input_idx_3 = input_idx_2 + input_mapping_3[output_dim3_inx];
-            output[output_idx++] = (input_idx_3 < 0) ? static_cast<T>(extrapolation_value) : input[input_idx_3];
+
+    // the output rows are computed in parallel. when the innermost axis is not resized, the input rows are copied.
+    const int64_t output_rows = output_shape[0] * output_shape[1] * output_shape[2];
+    const int64_t output_row_size = output_shape[3];
+    const bool copy_rows = scales[3] == 1.0f;
+    const double row_cost = static_cast<double>(output_row_size);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(output_rows),
+        TensorOpCost{row_cost * sizeof(T), row_cost * sizeof(T), copy_rows ? 0.0 : row_cost * 2},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            const int64_t output_dim2_inx = row % output_shape[2];
+            const int64_t output_dim1_inx = (row / output_shape[2]) % output_shape[1];
+            const int64_t output_dim0_inx = row / (output_shape[2] * output_shape[1]);
+            const int64_t input_idx_2 = input_mapping_0[output_dim0_inx] + input_mapping_1[output_dim1_inx] +
+                                        input_mapping_2[output_dim2_inx];
+            T* output_row = output + row * output_row_size;
+
+            if (copy_rows) {
+              // input_idx_2 is negative when the row is out of the range of the input
+              if (input_idx_2 < 0) {
+                std::fill_n(output_row, output_row_size, static_cast<T>(extrapolation_value));
+              } else {
+                std::copy_n(input + input_idx_2, output_row_size, output_row);
+              }
+              continue;
+            }
+
+            for (int64_t output_dim3_inx = 0; output_dim3_inx < output_row_size; output_dim3_inx++) {
+              int64_t input_idx_3 = input_idx_2 + input_mapping_3[output_dim3_inx];
+              output_row[output_dim3_inx] = (input_idx_3 < 0) ? static_cast<T>(extrapolation_value) : input[input_idx_3];
+            }
           }
-        }
-      }
-    }
+        });
     return Status::OK();
   }
 
@@ -297,148 +318,275 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
-// The following method supports a 4-D input in 'Linear mode'
-// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
-// the scale values for the outermost 2 dimensions are 1.
-// This is the common use-case where the 4-D input (batched multi-channel images)
-// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
+// Returns true if a 4-D input is resized as NHWC, i.e. the scale of the channel axis is not 1. ScalesValidation
+// ensures that the outermost and innermost scale values are 1 in that case.
+static bool IsNhwcResize(const vector<float>& scales) {
+  return scales.size() == 4 && scales[1] != 1.0f;
+}
+
+// Returns the axes that are interpolated by the linear and cubic modes.
+static vector<size_t> GetInterpolatedAxes(const vector<float>& scales) {
+  switch (scales.size()) {
+    case 2:
+      return {0, 1};
+    case 3:
+      return {0, 1, 2};
+    case 4:
+      return IsNhwcResize(scales) ? vector<size_t>{1, 2} : vector<size_t>{2, 3};
+    default:
+      return {2, 3, 4};
+  }
+}
+
+// Computes the linear interpolation table of an axis: the 2 nearest input coordinates of each output coordinate and
+// their weights.
+static void ComputeLinearAxisTable(int64_t input_size, int64_t output_size, float scale, float roi_start, float roi_end,
+                                   const GetOriginalCoordinateFunc& get_original_coordinate, ResizeAxisTable& table) {
+  table.indices.resize(2 * output_size);
+  table.weights.resize(2 * output_size);
+  table.out_of_range.resize(output_size);
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in_i = scale == 1 ? static_cast<float>(i)
+                            : get_original_coordinate(static_cast<float>(i), scale,
+                                                      static_cast<float>(output_size),
+                                                      static_cast<float>(input_size),
+                                                      roi_start, roi_end);
+    table.out_of_range[i] = in_i < 0 || in_i > static_cast<float>(input_size - 1);
+    in_i = std::max(0.0f, std::min(in_i, static_cast<float>(input_size - 1)));
+
+    const int64_t in_i1 = std::min(static_cast<int64_t>(in_i), input_size - 1);
+    const int64_t in_i2 = std::min(in_i1 + 1, input_size - 1);
+    float d1 = std::fabs(in_i - in_i1);
+    float d2 = std::fabs(in_i - in_i2);
+
+    if (in_i1 == in_i2) {
+      d1 = 0.5f;
+      d2 = 0.5f;
+    }
+
+    // each input coordinate is weighted by the distance of the output coordinate to the other one
+    table.indices[2 * i] = in_i1;
+    table.indices[2 * i + 1] = in_i2;
+    table.weights[2 * i] = d2;
+    table.weights[2 * i + 1] = d1;
+  }
+}
+
+// Calculates cubic coeff based on Robert Keys approach
+// https://ieeexplore.ieee.org/document/1163711
+std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff_a = -0.75) {
+  auto abs_s = std::abs(s);
+  std::array<float, CubicModeGridLength> coeffs;
+  coeffs[0] = static_cast<float>(((cubic_coeff_a * (abs_s + 1) - 5 * cubic_coeff_a) * (abs_s + 1) + 8 * cubic_coeff_a) * (abs_s + 1) - 4 * cubic_coeff_a);
+  coeffs[1] = static_cast<float>(((cubic_coeff_a + 2) * abs_s - (cubic_coeff_a + 3)) * abs_s * abs_s + 1);
+  coeffs[2] = static_cast<float>(((cubic_coeff_a + 2) * (1 - abs_s) - (cubic_coeff_a + 3)) * (1 - abs_s) * (1 - abs_s) + 1);
+  coeffs[3] = static_cast<float>(((cubic_coeff_a * (2 - abs_s) - 5 * cubic_coeff_a) * (2 - abs_s) + 8 * cubic_coeff_a) * (2 - abs_s) - 4 * cubic_coeff_a);
+  return coeffs;
+}
+
+// Computes the cubic interpolation table of an axis: the 4 input coordinates around each output coordinate, clamped
+// to the input, and their coefficients normalized by the sum of the coefficients.
+static void ComputeCubicAxisTable(int64_t input_size, int64_t output_size, float scale, float roi_start, float roi_end,
+                                  float cubic_coeff_a, bool exclude_outside,
+                                  const GetOriginalCoordinateFunc& get_original_coordinate, ResizeAxisTable& table) {
+  table.indices.resize(CubicModeGridLength * output_size);
+  table.weights.resize(CubicModeGridLength * output_size);
+  table.out_of_range.resize(output_size);
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    const float in_i = scale == 1 ? static_cast<float>(i)
+                                  : get_original_coordinate(static_cast<float>(i), scale,
+                                                            static_cast<float>(output_size),
+                                                            static_cast<float>(input_size),
+                                                            roi_start, roi_end);
+    table.out_of_range[i] = in_i < 0 || in_i > static_cast<float>(input_size - 1);
+
+    const auto in_int = static_cast<int64_t>(std::floor(in_i));
+    auto coeffs = GetCubicCoeffs(in_i - in_int, cubic_coeff_a);
+    float coeff_sum = 1;
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (size_t j = 0; j < CubicModeGridLength; ++j) {
+        const int64_t in_j = in_int - 1 + static_cast<int64_t>(j);
+        if (in_j < 0 || in_j >= input_size) {
+          coeffs[j] = 0.0f;
+        }
+        coeff_sum += coeffs[j];
+      }
+    }
+
+    for (size_t j = 0; j < CubicModeGridLength; ++j) {
+      const int64_t in_j = in_int - 1 + static_cast<int64_t>(j);
+      table.indices[CubicModeGridLength * i + j] = std::max(static_cast<int64_t>(0), std::min(in_j, input_size - 1));
+      table.weights[CubicModeGridLength * i + j] = coeffs[j] / coeff_sum;
+    }
+  }
+}
+
+// The following method supports 'Bilinear' Upsampling/Resizing of a batch of images: a 2-D input of shape [H, W],
+// a 4-D input of shape [N, C, H, W] with the scales [1.0, 1.0, height_scale, width_scale] (num_planes = N * C and
+// channels = 1), or a 4-D input of shape [N, H, W, C] with the scales [1.0, height_scale, width_scale, 1.0]
+// (num_planes = N and the C channels of a pixel are interpolated together along the innermost axis).
+// The output rows are computed in parallel.
 template <typename T>
-void UpsampleBilinear(int64_t batch_size,
-                      int64_t num_channels,
+void UpsampleBilinear(int64_t num_planes,
                       int64_t input_height,
                       int64_t input_width,
                       int64_t output_height,
                       int64_t output_width,
-                      float height_scale,
-                      float width_scale,
-                      const std::vector<float>& roi,
+                      int64_t channels,
+                      const ResizeAxisTable& y_table,
+                      const ResizeAxisTable& x_table,
                       bool use_extrapolation,
                       float extrapolation_value,
                       const T* XdataBase,
                       T* YdataBase,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate,
                       concurrency::ThreadPool* tp) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  // For each index in the output height and output width, cache its corresponding indices in the input
-  // while multiplying it with the input stride for that dimension (cache because we don't have to re-compute
-  // each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
-
-  // For each index in the output height and output width, cache its corresponding "weights/scales" for its
-  // corresponding indices in the input which proportionately indicates how much they will influence the final
-  // pixel value in the output
-  // (cache because we don't have to re-compute each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
-
-  // Limit number of allocations to just 1
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-
-  // Get pointers to appropriate memory locations in the scratch buffer
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-
-  // input_width is the stride for the height dimension
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = input_width_mul_y1 + output_height;
-
-  // stride for width is 1 (no multiplication needed)
-  int64_t* in_x1 = input_width_mul_y1 + 2 * output_height;
-  int64_t* in_x2 = in_x1 + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-
-  float* dy1 = scale_data;
-  float* dy2 = dy1 + output_height;
-
-  float* dx1 = dy1 + 2 * output_height;
-  float* dx2 = dx1 + output_width;
-
-  // Start processing
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
-
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
+  const int64_t input_row_size = input_width * channels;
+  const int64_t output_row_size = output_width * channels;
+
+  const double row_cost = static_cast<double>(output_row_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{row_cost * 4 * sizeof(T), row_cost * sizeof(T), row_cost * 8},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t plane = row / output_height;
+          const int64_t y = row % output_height;
+          const T* Xdata = XdataBase + plane * input_height * input_row_size;
+          T* Ydata = YdataBase + row * output_row_size;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation && y_table.out_of_range[y]) {
+            std::fill_n(Ydata, output_row_size, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
-  }
+          const T* Xrow1 = Xdata + y_table.indices[2 * y] * input_row_size;
+          const T* Xrow2 = Xdata + y_table.indices[2 * y + 1] * input_row_size;
+          const float dy2 = y_table.weights[2 * y];
+          const float dy1 = y_table.weights[2 * y + 1];
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
-
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::fabs(in_x - in_x1[x]);
-    dx2[x] = std::fabs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
-    }
-  }
-  
- for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_channels,
-                                                  [&](std::ptrdiff_t c) {
-                                                    const T* Xdata = XdataBase + (n * num_channels + c) * (input_height * input_width);
-                                                    T* Ydata = YdataBase + (n * num_channels + c) * (output_height * output_width);
-                                                    for (int64_t y = 0; y < output_height; ++y) {
-                                                      for (int64_t x = 0; x < output_width; ++x) {
-                                                        // when use_extrapolation is set and original index of x or y is out of the dim range
-                                                        // then use extrapolation_value as the output value.
-                                                        if (use_extrapolation &&
-                                                            ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-                                                             (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-                                                          Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-                                                          continue;
-                                                        }
-
-                                                        T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-                                                        T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-                                                        T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-                                                        T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
-
-                                                        Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                                                                     dx1[x] * dy2[y] * X21 +
-                                                                                                     dx2[x] * dy1[y] * X12 +
-                                                                                                     dx1[x] * dy1[y] * X22);
-                                                      }
-                                                    }
-                                                    Xdata += input_height * input_width;
-                                                    Ydata += output_width * output_height;
-                                                  });
-  }
+          for (int64_t x = 0; x < output_width; ++x) {
+            T* Ypixel = Ydata + x * channels;
+
+            if (use_extrapolation && x_table.out_of_range[x]) {
+              std::fill_n(Ypixel, channels, static_cast<T>(extrapolation_value));
+              continue;
+            }
+
+            const int64_t in_x1 = x_table.indices[2 * x] * channels;
+            const int64_t in_x2 = x_table.indices[2 * x + 1] * channels;
+            const float dx2 = x_table.weights[2 * x];
+            const float dx1 = x_table.weights[2 * x + 1];
+
+            for (int64_t c = 0; c < channels; ++c) {
+              T X11 = Xrow1[in_x1 + c];
+              T X21 = Xrow1[in_x2 + c];
+              T X12 = Xrow2[in_x1 + c];
+              T X22 = Xrow2[in_x2 + c];
+
+              Ypixel[c] = static_cast<T>(dx2 * dy2 * X11 +
+                                         dx1 * dy2 * X21 +
+                                         dx2 * dy1 * X12 +
+                                         dx1 * dy1 * X22);
+            }
+          }
+        }
+      });
+}
+
+// float images of a single channel are interpolated separably: the 2 input rows are first blended along the
+// innermost axis, which vectorizes, and the output row is then interpolated from the blended row.
+template <>
+void UpsampleBilinear<float>(int64_t num_planes,
+                             int64_t input_height,
+                             int64_t input_width,
+                             int64_t output_height,
+                             int64_t output_width,
+                             int64_t channels,
+                             const ResizeAxisTable& y_table,
+                             const ResizeAxisTable& x_table,
+                             bool use_extrapolation,
+                             float extrapolation_value,
+                             const float* XdataBase,
+                             float* YdataBase,
+                             concurrency::ThreadPool* tp) {
+  const int64_t input_row_size = input_width * channels;
+  const int64_t output_row_size = output_width * channels;
+
+  const double row_cost = static_cast<double>(output_row_size + input_row_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{row_cost * 2 * sizeof(float), row_cost * sizeof(float), row_cost * 3},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> blended_row(channels == 1 ? input_width : 0);
+
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t plane = row / output_height;
+          const int64_t y = row % output_height;
+          const float* Xdata = XdataBase + plane * input_height * input_row_size;
+          float* Ydata = YdataBase + row * output_row_size;
+
+          if (use_extrapolation && y_table.out_of_range[y]) {
+            std::fill_n(Ydata, output_row_size, extrapolation_value);
+            continue;
+          }
+
+          const float* Xrow1 = Xdata + y_table.indices[2 * y] * input_row_size;
+          const float* Xrow2 = Xdata + y_table.indices[2 * y + 1] * input_row_size;
+          const float dy2 = y_table.weights[2 * y];
+          const float dy1 = y_table.weights[2 * y + 1];
+
+          if (channels == 1) {
+            float* blended = blended_row.data();
+            for (int64_t x = 0; x < input_width; ++x) {
+              blended[x] = dy2 * Xrow1[x] + dy1 * Xrow2[x];
+            }
+
+            for (int64_t x = 0; x < output_width; ++x) {
+              Ydata[x] = x_table.weights[2 * x] * blended[x_table.indices[2 * x]] +
+                         x_table.weights[2 * x + 1] * blended[x_table.indices[2 * x + 1]];
+            }
+
+            if (use_extrapolation) {
+              for (int64_t x = 0; x < output_width; ++x) {
+                if (x_table.out_of_range[x]) {
+                  Ydata[x] = extrapolation_value;
+                }
+              }
+            }
+            continue;
+          }
+
+          for (int64_t x = 0; x < output_width; ++x) {
+            float* Ypixel = Ydata + x * channels;
+
+            if (use_extrapolation && x_table.out_of_range[x]) {
+              std::fill_n(Ypixel, channels, extrapolation_value);
+              continue;
+            }
+
+            const float* X1 = Xrow1 + x_table.indices[2 * x] * channels;
+            const float* X2 = Xrow1 + x_table.indices[2 * x + 1] * channels;
+            const float* X3 = Xrow2 + x_table.indices[2 * x] * channels;
+            const float* X4 = Xrow2 + x_table.indices[2 * x + 1] * channels;
+            const float w1 = x_table.weights[2 * x] * dy2;
+            const float w2 = x_table.weights[2 * x + 1] * dy2;
+            const float w3 = x_table.weights[2 * x] * dy1;
+            const float w4 = x_table.weights[2 * x + 1] * dy1;
+
+            for (int64_t c = 0; c < channels; ++c) {
+              Ypixel[c] = w1 * X1[c] + w2 * X2[c] + w3 * X3[c] + w4 * X4[c];
+            }
+          }
+        }
+      });
 }
 
 // The following method supports a 5-D input in 'Linear mode'
@@ -446,401 +594,225 @@ void UpsampleBilinear(int64_t batch_size,
 // the scale values for the outermost 2 dimensions are 1.
 // This is the common use-case where the 5-D input (batched multi-channel volumes)
 // is usually of shape [N, C, D, H, W] and the scales are [1.0, 1.0, depth_scale, height_scale, width_scale]
+// The output rows are computed in parallel.
 template <typename T>
-void UpsampleTrilinear(int64_t batch_size,
-                       int64_t num_channels,
+void UpsampleTrilinear(int64_t num_planes,
                        int64_t input_depth,
                        int64_t input_height,
                        int64_t input_width,
                        int64_t output_depth,
                        int64_t output_height,
                        int64_t output_width,
-                       float depth_scale,
-                       float height_scale,
-                       float width_scale,
-                       const std::vector<float>& roi,
+                       const ResizeAxisTable& z_table,
+                       const ResizeAxisTable& y_table,
+                       const ResizeAxisTable& x_table,
                        bool use_extrapolation,
                        float extrapolation_value,
                        const T* XdataBase,
                        T* YdataBase,
-                       AllocatorPtr& alloc,
-                       GetOriginalCoordinateFunc get_original_coordinate,
                        concurrency::ThreadPool* tp) {
-  std::vector<float> z_original;
-  z_original.reserve(output_depth);
-
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  // For each index in the output height and output width, cache its corresponding indices in the input
-  // while multiplying it with the input stride for that dimension (cache because we don't have to re-compute
-  // each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) *
-                                    (output_depth + output_height + output_width);
-
-  // For each index in the output height and output width, cache its corresponding "weights/scales" for its
-  // corresponding indices in the input which proportionately indicates how much they will influence the final
-  // pixel value in the output
-  // (cache because we don't have to re-compute each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) *
-                                      (output_depth + output_height + output_width);
-
-  // Limit number of allocations to just 1
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-
-  // Get pointers to appropriate memory locations in the scratch buffer
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-
-  // input_width * input_height is the stride for the depth dimension
-  int64_t* input_height_width_mul_z1 = idx_data;
-  int64_t* input_height_width_mul_z2 = input_height_width_mul_z1 + output_depth;
-
-  // input_width is the stride for the height dimension
-  int64_t* input_width_mul_y1 = input_height_width_mul_z1 + 2 * output_depth;
-  int64_t* input_width_mul_y2 = input_width_mul_y1 + output_height;
-
-  // stride for width is 1 (no multiplication needed)
-  int64_t* in_x1 = input_width_mul_y1 + 2 * output_height;
-  int64_t* in_x2 = in_x1 + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-
-  float* dz1 = scale_data;
-  float* dz2 = dz1 + output_depth;
-
-  float* dy1 = dz1 + 2 * output_depth;
-  float* dy2 = dy1 + output_height;
-
-  float* dx1 = dy1 + 2 * output_height;
-  float* dx2 = dx1 + output_width;
-
-  // Start processing
-  auto roi_z_start = roi.size() / 2 - 3;
-  auto roi_z_end = roi.size() - 3;
-  for (int64_t z = 0; z < output_depth; ++z) {
-    float in_z = depth_scale == 1 ? static_cast<float>(z)
-                                  : get_original_coordinate(static_cast<float>(z), depth_scale,
-                                                            static_cast<float>(output_depth), static_cast<float>(input_depth),
-                                                            roi[roi_z_start], roi[roi_z_end]);
-    z_original.emplace_back(in_z);
-    in_z = std::max(0.0f, std::min(in_z, static_cast<float>(input_depth - 1)));
-
-    const int64_t in_z1 = std::min(static_cast<int64_t>(in_z), input_depth - 1);
-    const int64_t in_z2 = std::min(in_z1 + 1, input_depth - 1);
-    dz1[z] = std::fabs(in_z - in_z1);
-    dz2[z] = std::fabs(in_z - in_z2);
-
-    if (in_z1 == in_z2) {
-      dz1[z] = 0.5f;
-      dz2[z] = 0.5f;
-    }
-
-    input_height_width_mul_z1[z] = input_height * input_width * in_z1;
-    input_height_width_mul_z2[z] = input_height * input_width * in_z2;
-  }
-
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height), static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
-
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
-
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
-  }
+  const int64_t input_plane_size = input_height * input_width;
+
+  const double row_cost = static_cast<double>(output_width);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_depth * output_height),
+      TensorOpCost{row_cost * 8 * sizeof(T), row_cost * sizeof(T), row_cost * 16},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t volume = row / (output_depth * output_height);
+          const int64_t z = (row / output_height) % output_depth;
+          const int64_t y = row % output_height;
+          const T* Xdata = XdataBase + volume * input_depth * input_plane_size;
+          T* Ydata = YdataBase + row * output_width;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation && (z_table.out_of_range[z] || y_table.out_of_range[y])) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x), width_scale,
-                                                            static_cast<float>(output_width), static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
-
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::fabs(in_x - in_x1[x]);
-    dx2[x] = std::fabs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
-    }
-  }
+          // subscript ordering in the variable - (yz)
+          const T* Xrow11 = Xdata + z_table.indices[2 * z] * input_plane_size + y_table.indices[2 * y] * input_width;
+          const T* Xrow21 = Xdata + z_table.indices[2 * z] * input_plane_size + y_table.indices[2 * y + 1] * input_width;
+          const T* Xrow12 = Xdata + z_table.indices[2 * z + 1] * input_plane_size + y_table.indices[2 * y] * input_width;
+          const T* Xrow22 = Xdata + z_table.indices[2 * z + 1] * input_plane_size + y_table.indices[2 * y + 1] * input_width;
+          const float dz2 = z_table.weights[2 * z];
+          const float dz1 = z_table.weights[2 * z + 1];
+          const float dy2 = y_table.weights[2 * y];
+          const float dy1 = y_table.weights[2 * y + 1];
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_channels,
-                                                  [&](std::ptrdiff_t c) {
-                                                    const T* Xdata = XdataBase + (n * num_channels + c) * (input_depth * input_height * input_width);
-                                                    T* Ydata = YdataBase + (n * num_channels + c) * (output_depth * output_height * output_width);
-                                                    for (int64_t z = 0; z < output_depth; ++z) {
-                                                      for (int64_t y = 0; y < output_height; ++y) {
-                                                        for (int64_t x = 0; x < output_width; ++x) {
-                                                          // when use_extrapolation is set and original index of x or y is out of the dim range
-                                                          // then use extrapolation_value as the output value.
-                                                          if (use_extrapolation &&
-                                                              ((z_original[z] < 0 || z_original[z] > static_cast<float>(input_depth - 1)) ||
-                                                               (y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-                                                               (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-                                                            Ydata[output_width * output_height * z + output_width * y + x] =
-                                                                static_cast<T>(extrapolation_value);
-                                                            continue;
-                                                          }
-
-                                                          // subscript ordering in the variable - (xyz)
-                                                          T X111 = Xdata[input_height_width_mul_z1[z] + input_width_mul_y1[y] + in_x1[x]];
-                                                          T X211 = Xdata[input_height_width_mul_z1[z] + input_width_mul_y1[y] + in_x2[x]];
-                                                          T X121 = Xdata[input_height_width_mul_z1[z] + input_width_mul_y2[y] + in_x1[x]];
-                                                          T X221 = Xdata[input_height_width_mul_z1[z] + input_width_mul_y2[y] + in_x2[x]];
-
-                                                          T X112 = Xdata[input_height_width_mul_z2[z] + input_width_mul_y1[y] + in_x1[x]];
-                                                          T X212 = Xdata[input_height_width_mul_z2[z] + input_width_mul_y1[y] + in_x2[x]];
-                                                          T X122 = Xdata[input_height_width_mul_z2[z] + input_width_mul_y2[y] + in_x1[x]];
-                                                          T X222 = Xdata[input_height_width_mul_z2[z] + input_width_mul_y2[y] + in_x2[x]];
-
-                                                          Ydata[output_width * output_height * z + output_width * y + x] =
-                                                              static_cast<T>(dx2[x] * dy2[y] * dz2[z] * X111 +
-                                                                             dx1[x] * dy2[y] * dz2[z] * X211 +
-                                                                             dx2[x] * dy1[y] * dz2[z] * X121 +
-                                                                             dx1[x] * dy1[y] * dz2[z] * X221 +
-
-                                                                             dx2[x] * dy2[y] * dz1[z] * X112 +
-                                                                             dx1[x] * dy2[y] * dz1[z] * X212 +
-                                                                             dx2[x] * dy1[y] * dz1[z] * X122 +
-                                                                             dx1[x] * dy1[y] * dz1[z] * X222);
-                                                        }
-                                                      }
-                                                    }
-                                                    Xdata += input_depth * input_height * input_width;
-                                                    Ydata += output_depth * output_width * output_height;
-                                                  });
-  }
-}
+          for (int64_t x = 0; x < output_width; ++x) {
+            if (use_extrapolation && x_table.out_of_range[x]) {
+              Ydata[x] = static_cast<T>(extrapolation_value);
+              continue;
+            }
 
-// Calculates cubic coeff based on Robert Keys approach
-// https://ieeexplore.ieee.org/document/1163711
-std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff_a = -0.75) {
-  auto abs_s = std::abs(s);
-  std::array<float, CubicModeGridLength> coeffs;
-  coeffs[0] = static_cast<float>(((cubic_coeff_a * (abs_s + 1) - 5 * cubic_coeff_a) * (abs_s + 1) + 8 * cubic_coeff_a) * (abs_s + 1) - 4 * cubic_coeff_a);
-  coeffs[1] = static_cast<float>(((cubic_coeff_a + 2) * abs_s - (cubic_coeff_a + 3)) * abs_s * abs_s + 1);
-  coeffs[2] = static_cast<float>(((cubic_coeff_a + 2) * (1 - abs_s) - (cubic_coeff_a + 3)) * (1 - abs_s) * (1 - abs_s) + 1);
-  coeffs[3] = static_cast<float>(((cubic_coeff_a * (2 - abs_s) - 5 * cubic_coeff_a) * (2 - abs_s) + 8 * cubic_coeff_a) * (2 - abs_s) - 4 * cubic_coeff_a);
-  return coeffs;
+            const int64_t in_x1 = x_table.indices[2 * x];
+            const int64_t in_x2 = x_table.indices[2 * x + 1];
+            const float dx2 = x_table.weights[2 * x];
+            const float dx1 = x_table.weights[2 * x + 1];
+
+            // subscript ordering in the variable - (xyz)
+            T X111 = Xrow11[in_x1];
+            T X211 = Xrow11[in_x2];
+            T X121 = Xrow21[in_x1];
+            T X221 = Xrow21[in_x2];
+
+            T X112 = Xrow12[in_x1];
+            T X212 = Xrow12[in_x2];
+            T X122 = Xrow22[in_x1];
+            T X222 = Xrow22[in_x2];
+
+            Ydata[x] = static_cast<T>(dx2 * dy2 * dz2 * X111 +
+                                      dx1 * dy2 * dz2 * X211 +
+                                      dx2 * dy1 * dz2 * X121 +
+                                      dx1 * dy1 * dz2 * X221 +
+
+                                      dx2 * dy2 * dz1 * X112 +
+                                      dx1 * dy2 * dz1 * X212 +
+                                      dx2 * dy1 * dz1 * X122 +
+                                      dx1 * dy1 * dz1 * X222);
+          }
+        }
+      });
 }
 
-// Get the tensor data at the requested coordinate
+// Converts an interpolated value to the output type. Cubic interpolation can overshoot the range of the input, so
+// integer outputs are saturated.
 template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
+T SaturateCubicResult(float value) {
+  return static_cast<T>(std::max(static_cast<float>(std::numeric_limits<T>::lowest()),
+                                 std::min(value, static_cast<float>(std::numeric_limits<T>::max()))));
 }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
-
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
-
-  return result;
+template <>
+float SaturateCubicResult<float>(float value) {
+  return value;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
-void ResizeBiCubic(
-    int64_t batch_size,
-    int64_t num_channels,
-    int64_t input_height,
-    int64_t input_width,
-    int64_t output_height,
-    int64_t output_width,
-    float height_scale,
-    float width_scale,
-    float cubic_coeff_a,
-    bool use_extrapolation,
-    float extrapolation_value,
-    bool exclude_outside,
-    const std::vector<float>& roi,
-    const T* Xdata,
-    T* Ydata,
-    GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
+// The following method supports 'Bicubic' Upsampling/Resizing of a batch of images in the same layouts as
+// UpsampleBilinear. The 4 input rows of an output row are first interpolated along the width, and the output row is
+// then interpolated from these rows along the innermost axis. The interpolated input rows are kept in a ring of 4
+// rows so that they are reused by the following output rows. The output rows are computed in parallel.
+template <typename T>
+void ResizeBiCubic(int64_t num_planes,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   int64_t channels,
+                   const ResizeAxisTable& y_table,
+                   const ResizeAxisTable& x_table,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   const T* XdataBase,
+                   T* YdataBase,
+                   concurrency::ThreadPool* tp) {
+  const int64_t input_row_size = input_width * channels;
+  const int64_t output_row_size = output_width * channels;
+  constexpr int64_t grid_length = static_cast<int64_t>(CubicModeGridLength);
+
+  const double row_cost = static_cast<double>(output_row_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{row_cost * grid_length * sizeof(T), row_cost * sizeof(T), row_cost * 4 * grid_length},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the input rows interpolated along the width, indexed by the input row (including the plane) modulo 4.
+        // the 4 input rows of an output row are consecutive (before clamping) so they never share a slot.
+        std::vector<float> interpolated_rows(grid_length * output_row_size);
+        int64_t interpolated_row_index[CubicModeGridLength] = {-1, -1, -1, -1};
+
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t plane = row / output_height;
+          const int64_t y = row % output_height;
+          T* Ydata = YdataBase + row * output_row_size;
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          if (use_extrapolation && y_table.out_of_range[y]) {
+            std::fill_n(Ydata, output_row_size, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
+          const float* rows[CubicModeGridLength];
+
+          for (int64_t i = 0; i < grid_length; ++i) {
+            const int64_t input_row = plane * input_height + y_table.indices[grid_length * y + i];
+            float* interpolated = interpolated_rows.data() + (input_row % grid_length) * output_row_size;
+            rows[i] = interpolated;
+
+            if (interpolated_row_index[input_row % grid_length] == input_row) {
+              continue;
+            }
+            interpolated_row_index[input_row % grid_length] = input_row;
+
+            const T* Xrow = XdataBase + input_row * input_row_size;
+            for (int64_t x = 0; x < output_width; ++x) {
+              const int64_t* in_x = x_table.indices.data() + grid_length * x;
+              const float* coeff_x = x_table.weights.data() + grid_length * x;
+              const T* X0 = Xrow + in_x[0] * channels;
+              const T* X1 = Xrow + in_x[1] * channels;
+              const T* X2 = Xrow + in_x[2] * channels;
+              const T* X3 = Xrow + in_x[3] * channels;
+              float* out = interpolated + x * channels;
+
+              for (int64_t c = 0; c < channels; ++c) {
+                out[c] = coeff_x[0] * X0[c] + coeff_x[1] * X1[c] + coeff_x[2] * X2[c] + coeff_x[3] * X3[c];
+              }
             }
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
+          const float* coeff_y = y_table.weights.data() + grid_length * y;
+          for (int64_t i = 0; i < output_row_size; ++i) {
+            Ydata[i] = SaturateCubicResult<T>(coeff_y[0] * rows[0][i] + coeff_y[1] * rows[1][i] +
+                                              coeff_y[2] * rows[2][i] + coeff_y[3] * rows[3][i]);
           }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (x_table.out_of_range[x]) {
+                std::fill_n(Ydata + x * channels, channels, static_cast<T>(extrapolation_value));
+              }
+            }
+          }
         }
-      }
+      });
+}
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+template <typename T>
+std::shared_ptr<const ResizeTables> Upsample<T>::GetResizeTables(const std::vector<int64_t>& input_dims,
+                                                                 const std::vector<int64_t>& output_dims,
+                                                                 const std::vector<float>& scales,
+                                                                 const std::vector<float>& roi) const {
+  std::lock_guard<OrtMutex> lock(resize_tables_mutex_);
+
+  if (resize_tables_ != nullptr && resize_tables_->input_dims == input_dims &&
+      resize_tables_->output_dims == output_dims && resize_tables_->scales == scales && resize_tables_->roi == roi) {
+    return resize_tables_;
+  }
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
+  auto tables = std::make_shared<ResizeTables>();
+  tables->input_dims = input_dims;
+  tables->output_dims = output_dims;
+  tables->scales = scales;
+  tables->roi = roi;
+
+  const size_t rank = input_dims.size();
+  for (size_t axis : GetInterpolatedAxes(scales)) {
+    tables->axes.emplace_back();
+    if (mode_ == UpsampleMode::CUBIC) {
+      ComputeCubicAxisTable(input_dims[axis], output_dims[axis], scales[axis], roi[axis], roi[rank + axis],
+                            cubic_coeff_a_, exclude_outside_, get_original_coordinate_, tables->axes.back());
+    } else {
+      ComputeLinearAxisTable(input_dims[axis], output_dims[axis], scales[axis], roi[axis], roi[rank + axis],
+                             get_original_coordinate_, tables->axes.back());
     }
   }
+
+  resize_tables_ = tables;
+  return resize_tables_;
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -882,36 +854,35 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     case UpsampleMode::NN:
       return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(),
                                 scales, roi, is_resize_, use_extrapolation_, extrapolation_value_,
-                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_);
+                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_,
+                                context->GetOperatorThreadPool());
     case UpsampleMode::LINEAR: {
       // Supports 'bilinear' and 'trilinear' sampling only
 
-      //'bilinear' == 2-D input or 4-D input with outermost 2 scales as 1
+      //'bilinear' == 2-D input or 4-D input with outermost 2 scales as 1 (NCHW) or with the outermost and
+      // innermost scales as 1 (NHWC)
       if (dims.size() == 2 || dims.size() == 4) {
         bool is_2D = dims.size() == 2;
+        bool is_nhwc = IsNhwcResize(scales);
+
+        const int64_t num_planes = is_2D ? 1 : (is_nhwc ? dims[0] : dims[0] * dims[1]);
+        const int64_t channels = is_nhwc ? dims[3] : 1;
+        const int64_t input_height = is_2D ? dims[0] : (is_nhwc ? dims[1] : dims[2]);
+        const int64_t input_width = is_2D ? dims[1] : (is_nhwc ? dims[2] : dims[3]);
+
+        const int64_t output_height = is_2D ? output_dims[0] : (is_nhwc ? output_dims[1] : output_dims[2]);
+        const int64_t output_width = is_2D ? output_dims[1] : (is_nhwc ? output_dims[2] : output_dims[3]);
 
-        const int64_t batch_size = is_2D ? 1 : dims[0];
-        const int64_t num_channels = is_2D ? 1 : dims[1];
-        const int64_t input_height = is_2D ? dims[0] : dims[2];
-        const int64_t input_width = is_2D ? dims[1] : dims[3];
-
-        const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
-        const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
-
-        AllocatorPtr alloc;
-        ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-        UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                         is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
-                         use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                         Y->template MutableData<T>(), alloc, get_original_coordinate_, 
-                         output_height*output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+        auto tables = GetResizeTables(dims, output_dims, scales, roi);
+        UpsampleBilinear(num_planes, input_height, input_width, output_height, output_width, channels,
+                         tables->axes[0], tables->axes[1], use_extrapolation_, extrapolation_value_,
+                         X->template Data<T>(), Y->template MutableData<T>(), context->GetOperatorThreadPool());
         return Status::OK();
       } else if (dims.size() == 3 || dims.size() == 5) {
         //'trilinear' == 3-D input or 5-D input with outermost 2 scales as 1
         bool is_3D = dims.size() == 3;
 
-        const int64_t batch_size = is_3D ? 1 : dims[0];
-        const int64_t num_channels = is_3D ? 1 : dims[1];
+        const int64_t num_volumes = is_3D ? 1 : dims[0] * dims[1];
         const int64_t input_depth = is_3D ? dims[0] : dims[2];
         const int64_t input_height = is_3D ? dims[1] : dims[3];
         const int64_t input_width = is_3D ? dims[2] : dims[4];
@@ -920,14 +891,11 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         const int64_t output_height = is_3D ? output_dims[1] : output_dims[3];
         const int64_t output_width = is_3D ? output_dims[2] : output_dims[4];
 
-        AllocatorPtr alloc;
-        ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-        UpsampleTrilinear(batch_size, num_channels, input_depth, input_height, input_width,
+        auto tables = GetResizeTables(dims, output_dims, scales, roi);
+        UpsampleTrilinear(num_volumes, input_depth, input_height, input_width,
                           output_depth, output_height, output_width,
-                          is_3D ? scales[0] : scales[2], is_3D ? scales[1] : scales[3],
-                          is_3D ? scales[2] : scales[4], roi, use_extrapolation_, extrapolation_value_,
-                          X->template Data<T>(), Y->template MutableData<T>(), alloc, get_original_coordinate_, 
-                          output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                          tables->axes[0], tables->axes[1], tables->axes[2], use_extrapolation_, extrapolation_value_,
+                          X->template Data<T>(), Y->template MutableData<T>(), context->GetOperatorThreadPool());
         return Status::OK();
       } else {
         // User shouldn't hit this as the check has been performed in ScalesValidation()
@@ -951,17 +919,19 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         return Status(ONNXRUNTIME, FAIL, oss.str());
       }
       bool is_2D = dims.size() == 2;
-      const int64_t batch_size = is_2D ? 1 : dims[0];
-      const int64_t num_channels = is_2D ? 1 : dims[1];
-      const int64_t input_height = is_2D ? dims[0] : dims[2];
-      const int64_t input_width = is_2D ? dims[1] : dims[3];
-      const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
-      const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
-
-      ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->template Data<float>(), Y->template MutableData<float>(),
-                    get_original_coordinate_);
+      bool is_nhwc = IsNhwcResize(scales);
+
+      const int64_t num_planes = is_2D ? 1 : (is_nhwc ? dims[0] : dims[0] * dims[1]);
+      const int64_t channels = is_nhwc ? dims[3] : 1;
+      const int64_t input_height = is_2D ? dims[0] : (is_nhwc ? dims[1] : dims[2]);
+      const int64_t input_width = is_2D ? dims[1] : (is_nhwc ? dims[2] : dims[3]);
+      const int64_t output_height = is_2D ? output_dims[0] : (is_nhwc ? output_dims[1] : output_dims[2]);
+      const int64_t output_width = is_2D ? output_dims[1] : (is_nhwc ? output_dims[2] : output_dims[3]);
+
+      auto tables = GetResizeTables(dims, output_dims, scales, roi);
+      ResizeBiCubic(num_planes, input_height, input_width, output_height, output_width, channels,
+                    tables->axes[0], tables->axes[1], use_extrapolation_, extrapolation_value_,
+                    X->template Data<T>(), Y->template MutableData<T>(), context->GetOperatorThreadPool());
       return Status::OK();
     }
     default:
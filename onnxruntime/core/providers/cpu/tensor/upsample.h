@@ -4,7 +4,9 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -19,6 +21,26 @@ const size_t CubicModeGridLength = 4;
 using GetNearestPixelFunc = std::function<int64_t(float, bool)>;
 using GetOriginalCoordinateFunc = std::function<float(float, float, float, float, float, float)>;
 
+// Interpolation table of a resized axis for the linear and cubic modes. For each output coordinate of the axis the
+// table holds the indices of the input coordinates that contribute to it (2 for linear, 4 for cubic), clamped to the
+// input, and their weights.
+struct ResizeAxisTable {
+  std::vector<int64_t> indices;
+  std::vector<float> weights;
+  // set when the original coordinate is outside of the input, in which case the output takes the extrapolation value
+  std::vector<uint8_t> out_of_range;
+};
+
+// The interpolation tables of the resized axes and the shapes they were computed for, so that they can be reused
+// while the shapes don't change.
+struct ResizeTables {
+  std::vector<int64_t> input_dims;
+  std::vector<int64_t> output_dims;
+  std::vector<float> scales;
+  std::vector<float> roi;
+  std::vector<ResizeAxisTable> axes;
+};
+
 enum UpsampleMode {
   NN = 0,      // nearest neighbour
   LINEAR = 1,  // linear interpolation
@@ -282,20 +304,24 @@ class UpsampleBase {
       }
     }
 
+    // 4-D inputs are resized as NCHW when the outermost 2 scale values are 1, else as NHWC when the outermost and
+    // innermost scale values are 1
     if (UpsampleMode::LINEAR == mode) {
       ORT_ENFORCE(scales.size() == 2 ||
-                      (scales.size() == 4 && scales[0] == 1 && scales[1] == 1) ||
+                      (scales.size() == 4 && scales[0] == 1 && (scales[1] == 1 || scales[3] == 1)) ||
                       scales.size() == 3 ||
                       (scales.size() == 5 && scales[0] == 1 && scales[1] == 1),
                   "'Linear' mode only support 2-D inputs or 3-D inputs ('Bilinear', 'Trilinear') "
-                  "or 4-D inputs or 5-D inputs with the corresponding outermost 2 scale values being 1 in the ",
+                  "or 4-D inputs or 5-D inputs with the corresponding outermost 2 scale values being 1 "
+                  "(or for 4-D inputs the outermost and innermost scale values being 1) in the ",
                   is_resize_ ? "Resize operator" : "Upsample operator");
     }
 
     else if (UpsampleMode::CUBIC == mode) {
-      ORT_ENFORCE(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && scales[1] == 1),
+      ORT_ENFORCE(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && (scales[1] == 1 || scales[3] == 1)),
                   "'Cubic' mode only support 2-D inputs ('Bicubic') or 4-D inputs "
-                  "with the corresponding outermost 2 scale values being 1 in the ",
+                  "with the corresponding outermost 2 scale values being 1 "
+                  "(or the outermost and innermost scale values being 1) in the ",
                   is_resize_ ? "Resize operator" : "Upsample operator");
     }
   }
@@ -361,6 +387,17 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const std::vector<int64_t>& output_dims) const;
+
+ private:
+  // Returns the interpolation tables of the resized axes for the linear and cubic modes, reusing the tables of the
+  // previous run when the shapes, scales and roi are the same.
+  std::shared_ptr<const ResizeTables> GetResizeTables(const std::vector<int64_t>& input_dims,
+                                                      const std::vector<int64_t>& output_dims,
+                                                      const std::vector<float>& scales,
+                                                      const std::vector<float>& roi) const;
+
+  mutable OrtMutex resize_tables_mutex_;
+  mutable std::shared_ptr<const ResizeTables> resize_tables_;
 };
 
 }  // namespace onnxruntime
@@ -56,6 +56,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
   if (roi.size() != 2 * X->Shape().GetDims().size())
     return Status(ONNXRUNTIME, INVALID_ARGUMENT,
                   "Resize: size of roi array should be 2 * N where N is the rank of input tensor X.");
+  if (rank == 4 && (mode_ == UpsampleMode::LINEAR || mode_ == UpsampleMode::CUBIC) && scales[1] != 1.0f)
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT,
+                  is_resize_ ? "Resize: 4-D inputs can only be resized as NCHW in 'Linear' and 'Cubic' modes."
+                             : "Upsample: 4-D inputs can only be resized as NCHW in 'Linear' mode.");
 
   Tensor* Y = context->Output(0, output_dims);
 
@@ -371,6 +371,13 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+  if (node_capture_) {
+    auto status = node_capture_->WriteToFile();
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, ERROR) << "Error writing the node capture: " << status.ErrorMessage();
+    }
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   if (session_activity_started_)
     TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
@@ -1147,6 +1154,13 @@ common::Status InferenceSession::Initialize() {
         session_profiler_,
         session_options_.use_deterministic_compute);
 
+    const std::string node_capture_file = session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigNodeCaptureFile,
+                                                                              "");
+    if (!node_capture_file.empty()) {
+      node_capture_ = onnxruntime::make_unique<NodeCapture>(node_capture_file);
+      session_state_->SetNodeCapture(node_capture_.get());
+    }
+
     onnxruntime::Graph& graph = model_->MainGraph();
 
     // Collect the kernel registries from execution provider instances;
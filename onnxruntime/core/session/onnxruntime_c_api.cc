@@ -803,6 +803,31 @@ ORT_API_STATUS_IMPL(OrtApis::FillStringTensorElement, _Inout_ OrtValue* value, _
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::FillStringTensorFromContent, _Inout_ OrtValue* value,
+                    _In_reads_(s_len) const void* s, size_t s_len,
+                    _In_reads_(offsets_len) const size_t* offsets, size_t offsets_len) {
+  TENSOR_READWRITE_API_BEGIN
+  auto* dst = tensor->MutableData<std::string>();
+  auto len = static_cast<size_t>(tensor->Shape().Size());
+  if (offsets_len != len) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets buffer is not equal to tensor size");
+  }
+  // validate all the offsets before touching the tensor
+  for (size_t i = 0; i != len; ++i) {
+    const size_t end = (i + 1 == len) ? s_len : offsets[i + 1];
+    if (offsets[i] > end || end > s_len) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets must be increasing and within the data length");
+    }
+  }
+  const char* p = static_cast<const char*>(s);
+  for (size_t i = 0; i != len; ++i) {
+    const size_t end = (i + 1 == len) ? s_len : offsets[i + 1];
+    dst[i].assign(p + offsets[i], end - offsets[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorDataLength, _In_ const OrtValue* value, _Out_ size_t* out) {
   TENSOR_READ_API_BEGIN
   const auto* src = tensor.Data<std::string>();
@@ -2043,6 +2068,7 @@ static constexpr OrtApi ort_api_1_to_6 = {
     &OrtApis::CreateEnvWithCustomLoggerAndGlobalThreadPools,
     &OrtApis::OrtSessionOptionsAppendExecutionProvider_CUDA,
     &OrtApis::SetGlobalDenormalAsZero,
+    &OrtApis::FillStringTensorFromContent,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
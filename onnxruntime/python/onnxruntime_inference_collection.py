@@ -101,13 +101,17 @@ class Session:
         """
         self._enable_fallback = True
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, output_buffers=None, zero_copy_outputs=False):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param output_buffers: optional dictionary ``{ output_name: numpy_array }`` of preallocated,
+            C-contiguous arrays the outputs are written into. The same arrays are returned.
+        :param zero_copy_outputs: if True, CPU tensor outputs are returned as numpy arrays that
+            reference the memory allocated by onnxruntime instead of a copy of it.
 
         ::
 
@@ -120,8 +124,9 @@ class Session:
             raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+        output_buffers = output_buffers or {}
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return self._sess.run(output_names, input_feed, run_options, output_buffers, zero_copy_outputs)
         except C.EPFail as err:
             if self._enable_fallback:
                 print("EP Error: {} using {}".format(str(err), self._providers))
@@ -129,10 +134,35 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return self._sess.run(output_names, input_feed, run_options, output_buffers, zero_copy_outputs)
             else:
                 raise
 
+    def run_many(self, output_names, input_feeds, run_options=None, max_concurrency=0, zero_copy_outputs=False):
+        """
+        Compute the predictions for a list of independent inputs. The runs execute concurrently
+        without holding the GIL.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per run
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param max_concurrency: maximum number of runs executing at the same time, 0 for one per core
+        :param zero_copy_outputs: see :meth:`run`
+        :return: list with the outputs of each run
+
+        ::
+
+            sess.run_many([output_name], [{input_name: x1}, {input_name: x2}])
+        """
+        num_required_inputs = len(self._inputs_meta)
+        for input_feed in input_feeds:
+            if len(input_feed) < num_required_inputs:
+                raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs,
+                                                                                          len(input_feed)))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_many(output_names, input_feeds, run_options, max_concurrency, zero_copy_outputs)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -248,6 +248,8 @@ static void CopyDataToTensor(PyArrayObject* darray, int npy_type, std::unique_pt
     std::string* dst = p_tensor->MutableData<std::string>();
     const auto item_size = PyArray_ITEMSIZE(darray);
     const char* src = reinterpret_cast<const char*>(PyArray_DATA(darray));
+    // bytes are copied straight out of the numpy buffer without creating python objects
+    py::gil_scoped_release release;
     for (int i = 0; i < total_items; i++, src += item_size) {
       if (npy_type == NPY_STRING) {
         dst[i] = src;
@@ -273,7 +275,9 @@ static void CopyDataToTensor(PyArrayObject* darray, int npy_type, std::unique_pt
     if (!IAllocator::CalcMemSizeForArray(p_tensor->DataType()->Size(), p_tensor->Shape().Size(), &len)) {
       throw std::runtime_error("length overflow");
     }
-    mem_cpy_to_device(buffer, PyArray_DATA(darray), len);
+    const void* src = PyArray_DATA(darray);
+    py::gil_scoped_release release;
+    mem_cpy_to_device(buffer, src, len);
   }
 }
 
@@ -218,7 +218,10 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_DML(in
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <thread>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -311,6 +314,8 @@ void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj,
       PyArray_DATA(reinterpret_cast<PyArrayObject*>(obj.ptr())));
 
   if (numpy_type != NPY_OBJECT) {
+    // the array is allocated, the copy below does not touch any python object
+    py::gil_scoped_release release;
     //if it is not cpu tensor, need to copy to host
     auto device_type = rtensor.Location().device.Type();
     if (device_type != OrtDevice::CPU) {
@@ -432,6 +437,122 @@ static void AddTensorAsPyObj(const OrtValue& val, std::vector<py::object>& pyobj
   pyobjs.push_back(obj);
 }
 
+// Hands a CPU tensor to numpy without copying it. The returned array's base object is a capsule holding a
+// reference to the OrtValue, so the ORT buffer stays alive for as long as the array (or any view of it) does.
+// String tensors, tensors on another device and tensors that do not own their buffer (e.g. an initializer
+// or a feed that is returned as an output) are copied as usual.
+static void AddTensorAsPyObjNoCopy(const OrtValue& val, std::vector<py::object>& pyobjs) {
+  const Tensor& rtensor = val.Get<Tensor>();
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(rtensor.DataType());
+  if (numpy_type == NPY_OBJECT || rtensor.Location().device.Type() != OrtDevice::CPU || !rtensor.OwnsBuffer()) {
+    AddTensorAsPyObj(val, pyobjs, nullptr, nullptr);
+    return;
+  }
+
+  const TensorShape& shape = rtensor.Shape();
+  std::vector<npy_intp> npy_dims;
+  for (size_t n = 0; n < shape.NumDimensions(); ++n) {
+    npy_dims.push_back(shape[n]);
+  }
+
+  auto obj = py::reinterpret_steal<py::object>(PyArray_New(
+      &PyArray_Type, static_cast<int>(shape.NumDimensions()), npy_dims.data(), numpy_type, nullptr,
+      const_cast<void*>(rtensor.DataRaw()), 0, NPY_ARRAY_CARRAY, nullptr));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+
+  py::capsule owner(new OrtValue(val), [](void* p) { delete static_cast<OrtValue*>(p); });
+  // PyArray_SetBaseObject steals the reference to the capsule.
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), owner.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+  pyobjs.push_back(obj);
+}
+
+// Wraps a preallocated numpy array passed through run(..., output_buffers=...) as a fetch so the session
+// writes the output straight into it. Shape and element type are validated by the execution frame.
+static OrtValue CreateFetchFromNumpyBuffer(const std::string& name, const py::object& buffer) {
+  if (!PyArray_Check(buffer.ptr())) {
+    throw std::runtime_error("Output buffer for '" + name + "' must be a numpy array.");
+  }
+  PyArrayObject* darray = reinterpret_cast<PyArrayObject*>(buffer.ptr());
+  if (!PyArray_ISCARRAY(darray)) {
+    throw std::runtime_error("Output buffer for '" + name + "' must be a writeable C-contiguous numpy array.");
+  }
+  const int type_num = PyArray_TYPE(darray);
+  if (type_num == NPY_OBJECT) {
+    throw std::runtime_error("Output buffer for '" + name + "': only non-string tensors can be bound.");
+  }
+
+  std::vector<int64_t> shape(PyArray_NDIM(darray));
+  const npy_intp* npy_dims = PyArray_DIMS(darray);
+  for (size_t i = 0; i < shape.size(); ++i) {
+    shape[i] = npy_dims[i];
+  }
+
+  auto p_tensor = onnxruntime::make_unique<Tensor>(NumpyTypeToOnnxRuntimeType(type_num), TensorShape(shape),
+                                                   PyArray_DATA(darray), GetAllocator()->Info());
+  OrtValue ml_value;
+  ml_value.Init(p_tensor.release(),
+                DataTypeImpl::GetType<Tensor>(),
+                DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  return ml_value;
+}
+
+// Converts the python inputs of one run into OrtValues. Must be called with the GIL held.
+static void CreateFeedsFromPyObjs(PyInferenceSession* sess, const std::map<std::string, py::object>& pyfeeds,
+                                  NameMLValMap& feeds) {
+  auto px = sess->GetSessionHandle()->GetModelInputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+  }
+  for (const auto& _ : pyfeeds) {
+    OrtValue ml_value;
+    CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
+    if (PyErr_Occurred()) {
+      PyObject *ptype, *pvalue, *ptraceback;
+      PyErr_Fetch(&ptype, &pvalue, &ptraceback);
+
+      PyObject* pStr = PyObject_Str(ptype);
+      std::string sType = py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      pStr = PyObject_Str(pvalue);
+      sType += ": ";
+      sType += py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      throw std::runtime_error(sType);
+    }
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+}
+
+// Converts the outputs of one run into python objects. Outputs bound through output_buffers are returned as the
+// caller's arrays. Must be called with the GIL held.
+static std::vector<py::object> GetPyObjsFromFetches(const std::vector<std::string>& output_names,
+                                                    const std::vector<OrtValue>& fetches,
+                                                    const std::map<std::string, py::object>& output_buffers,
+                                                    bool zero_copy_outputs) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    const OrtValue& _ = fetches[i];
+    auto it = output_buffers.find(output_names[i]);
+    if (it != output_buffers.end()) {
+      rfetch.push_back(it->second);
+    } else if (_.IsTensor()) {
+      if (zero_copy_outputs) {
+        AddTensorAsPyObjNoCopy(_, rfetch);
+      } else {
+        AddTensorAsPyObj(_, rfetch, nullptr, nullptr);
+      }
+    } else {
+      AddNonTensorAsPyObj(_, rfetch, nullptr, nullptr);
+    }
+  }
+  return rfetch;
+}
+
 static inline void RegisterExecutionProvider(InferenceSession* sess, onnxruntime::IExecutionProviderFactory& f) {
   auto p = f.CreateProvider();
   OrtPybindThrowIfError(sess->RegisterExecutionProvider(std::move(p)));
@@ -1678,58 +1799,104 @@ including arg name, arg type (contains both type and shape).)pbdoc")
             InitializeSession(sess->GetSessionHandle(), provider_types, provider_options);
           },
           R"pbdoc(Load a model saved in ONNX or ORT format.)pbdoc")
-      .def("run",
-           [](PyInferenceSession* sess, std::vector<std::string> output_names,
-              std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
-               -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto _ : pyfeeds) {
-               OrtValue ml_value;
-               auto px = sess->GetSessionHandle()->GetModelInputs();
-               if (!px.first.IsOK() || !px.second) {
-                 throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-               }
-               CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
-               if (PyErr_Occurred()) {
-                 PyObject *ptype, *pvalue, *ptraceback;
-                 PyErr_Fetch(&ptype, &pvalue, &ptraceback);
-
-                 PyObject* pStr = PyObject_Str(ptype);
-                 std::string sType = py::reinterpret_borrow<py::str>(pStr);
-                 Py_XDECREF(pStr);
-                 pStr = PyObject_Str(pvalue);
-                 sType += ": ";
-                 sType += py::reinterpret_borrow<py::str>(pStr);
-                 Py_XDECREF(pStr);
-                 throw std::runtime_error(sType);
-               }
-               feeds.insert(std::make_pair(_.first, ml_value));
-             }
-
-             std::vector<OrtValue> fetches;
-             common::Status status;
-
-             {
-               // release GIL to allow multiple python threads to invoke Run() in parallel.
-               py::gil_scoped_release release;
-               if (run_options != nullptr) {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
-               } else {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
-               }
-             }
-
-             std::vector<py::object> rfetch;
-             rfetch.reserve(fetches.size());
-             for (auto _ : fetches) {
-               if (_.IsTensor()) {
-                 AddTensorAsPyObj(_, rfetch, nullptr, nullptr);
-               } else {
-                 AddNonTensorAsPyObj(_, rfetch, nullptr, nullptr);
-               }
-             }
-             return rfetch;
-           })
+      .def(
+          "run",
+          [](PyInferenceSession* sess, std::vector<std::string> output_names,
+             std::map<std::string, py::object> pyfeeds, RunOptions* run_options,
+             std::map<std::string, py::object> output_buffers, bool zero_copy_outputs)
+              -> std::vector<py::object> {
+            NameMLValMap feeds;
+            CreateFeedsFromPyObjs(sess, pyfeeds, feeds);
+
+            // Outputs with a caller provided buffer are preallocated so the session writes into them directly.
+            std::vector<OrtValue> fetches;
+            if (!output_buffers.empty()) {
+              fetches.resize(output_names.size());
+              for (size_t i = 0; i < output_names.size(); ++i) {
+                auto it = output_buffers.find(output_names[i]);
+                if (it != output_buffers.end()) {
+                  fetches[i] = CreateFetchFromNumpyBuffer(it->first, it->second);
+                }
+              }
+            }
+
+            {
+              // release GIL to allow multiple python threads to invoke Run() in parallel.
+              py::gil_scoped_release release;
+              if (run_options != nullptr) {
+                OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+              } else {
+                OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+              }
+            }
+
+            return GetPyObjsFromFetches(output_names, fetches, output_buffers, zero_copy_outputs);
+          },
+          py::arg("output_names"), py::arg("input_feed"), py::arg("run_options") = nullptr,
+          py::arg("output_buffers") = std::map<std::string, py::object>(), py::arg("zero_copy_outputs") = false,
+          R"pbdoc(Run the model. Outputs listed in output_buffers are written into the given numpy arrays.
+If zero_copy_outputs is set, CPU tensor outputs are returned as numpy arrays backed by ORT memory instead of copies.)pbdoc")
+      .def(
+          "run_many",
+          [](PyInferenceSession* sess, std::vector<std::string> output_names,
+             std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options,
+             int max_concurrency, bool zero_copy_outputs) -> std::vector<std::vector<py::object>> {
+            const size_t num_runs = pyfeeds_list.size();
+            std::vector<NameMLValMap> feeds_list(num_runs);
+            for (size_t i = 0; i < num_runs; ++i) {
+              CreateFeedsFromPyObjs(sess, pyfeeds_list[i], feeds_list[i]);
+            }
+
+            if (max_concurrency <= 0) {
+              max_concurrency = static_cast<int>(std::thread::hardware_concurrency());
+            }
+            const size_t num_threads = std::max<size_t>(
+                1, std::min<size_t>(static_cast<size_t>(max_concurrency), num_runs));
+
+            std::vector<std::vector<OrtValue>> fetches_list(num_runs);
+            std::vector<common::Status> statuses(num_runs);
+            {
+              // Every run only touches ORT objects, so the whole batch executes without the GIL.
+              py::gil_scoped_release release;
+              InferenceSession* session = sess->GetSessionHandle();
+              // Each run is issued from a plain thread, exactly as if the caller had called Run() from that many
+              // threads. Running them as work items of a thread pool would nest the session's own intra-op
+              // parallel sections inside that pool's section, which the Eigen pool does not support. The runs
+              // share the session's intra-op pool, so at most num_threads threads are added on top of it.
+              std::atomic<size_t> next_run{0};
+              auto run_worker = [&]() {
+                for (size_t i = next_run++; i < num_runs; i = next_run++) {
+                  statuses[i] = run_options != nullptr
+                                    ? session->Run(*run_options, feeds_list[i], output_names, &fetches_list[i])
+                                    : session->Run(feeds_list[i], output_names, &fetches_list[i]);
+                }
+              };
+              std::vector<std::thread> threads;
+              threads.reserve(num_threads - 1);
+              for (size_t t = 1; t < num_threads; ++t) {
+                threads.emplace_back(run_worker);
+              }
+              run_worker();
+              for (auto& thread : threads) {
+                thread.join();
+              }
+            }
+            for (const auto& status : statuses) {
+              OrtPybindThrowIfError(status);
+            }
+
+            const std::map<std::string, py::object> no_output_buffers;
+            std::vector<std::vector<py::object>> results;
+            results.reserve(num_runs);
+            for (const auto& fetches : fetches_list) {
+              results.push_back(GetPyObjsFromFetches(output_names, fetches, no_output_buffers, zero_copy_outputs));
+            }
+            return results;
+          },
+          py::arg("output_names"), py::arg("input_feeds"), py::arg("run_options") = nullptr,
+          py::arg("max_concurrency") = 0, py::arg("zero_copy_outputs") = false,
+          R"pbdoc(Run the model once for each dictionary of inputs in input_feeds. The runs execute concurrently on up to
+max_concurrency threads (0 means one per core) with the GIL released. Returns one list of outputs per run.)pbdoc")
       .def("end_profiling", [](PyInferenceSession* sess) -> std::string {
         return sess->GetSessionHandle()->EndProfiling();
       })
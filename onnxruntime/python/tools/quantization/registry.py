@@ -9,6 +9,7 @@ from .operators.activation import QLinearActivation
 from .operators.binary_op import QLinearBinaryOp
 from .operators.maxpool import QMaxPool
 from. operators.lstm import LSTMQuant
+from .operators.gru import GRUQuant
 
 CommonOpsRegistry = {"Gather": GatherQuant, "EmbedLayerNormalization": EmbedLayerNormalizationQuant}
 
@@ -17,6 +18,7 @@ IntegerOpsRegistry = {
     "MatMul": MatMulInteger,
     "Attention": AttentionQuant,
     "LSTM": LSTMQuant,
+    "GRU": GRUQuant,
 }
 IntegerOpsRegistry.update(CommonOpsRegistry)
 
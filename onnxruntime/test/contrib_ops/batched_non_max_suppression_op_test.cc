@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<float> kBoxes = {0.0f, 0.0f, 1.0f, 1.0f,
+                                          0.0f, 0.1f, 1.0f, 1.1f,
+                                          0.0f, -0.1f, 1.0f, 0.9f,
+                                          0.0f, 10.0f, 1.0f, 11.0f,
+                                          0.0f, 10.1f, 1.0f, 11.1f,
+                                          0.0f, 100.0f, 1.0f, 101.0f};
+
+TEST(BatchedNonMaxSuppressionOpTest, PaddedOutputs) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("max_total_boxes", 5);
+
+  std::vector<float> boxes = kBoxes;
+  boxes.insert(boxes.end(), kBoxes.begin(), kBoxes.end());
+  test.AddInput<float>("boxes", {2, 6, 4}, boxes);
+  test.AddInput<float>("scores", {2, 2, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.8f,
+                        0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f});
+  test.AddMissingOptionalInput<int64_t>();
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.4f});
+
+  test.AddOutput<int64_t>("num_selected", {2}, {4L, 1L});
+  test.AddOutput<float>("selected_boxes", {2, 5, 4},
+                        {0.0f, 10.0f, 1.0f, 11.0f,
+                         0.0f, 10.0f, 1.0f, 11.0f,
+                         0.0f, 0.0f, 1.0f, 1.0f,
+                         0.0f, 0.0f, 1.0f, 1.0f,
+                         0.0f, 0.0f, 0.0f, 0.0f,
+
+                         0.0f, 100.0f, 1.0f, 101.0f,
+                         0.0f, 0.0f, 0.0f, 0.0f,
+                         0.0f, 0.0f, 0.0f, 0.0f,
+                         0.0f, 0.0f, 0.0f, 0.0f,
+                         0.0f, 0.0f, 0.0f, 0.0f});
+  test.AddOutput<float>("selected_scores", {2, 5},
+                        {0.95f, 0.95f, 0.9f, 0.9f, 0.0f,
+                         0.8f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.AddOutput<int64_t>("selected_classes", {2, 5},
+                          {0L, 1L, 0L, 1L, -1L,
+                           0L, -1L, -1L, -1L, -1L});
+  test.AddOutput<int64_t>("selected_indices", {2, 5},
+                          {3L, 3L, 0L, 0L, -1L,
+                           5L, -1L, -1L, -1L, -1L});
+  test.Run();
+}
+
+TEST(BatchedNonMaxSuppressionOpTest, MaxTotalBoxes) {
+  OpTester test("BatchedNonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("max_total_boxes", 3);
+  test.AddInput<float>("boxes", {1, 6, 4}, kBoxes);
+  test.AddInput<float>("scores", {1, 2, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.2f, 0.85f, 0.6f, 0.1f, 0.5f, 0.3f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {2L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+
+  test.AddOutput<int64_t>("num_selected", {1}, {3L});
+  test.AddOutput<float>("selected_boxes", {1, 3, 4},
+                        {0.0f, 10.0f, 1.0f, 11.0f,
+                         0.0f, 0.0f, 1.0f, 1.0f,
+                         0.0f, 0.1f, 1.0f, 1.1f});
+  test.AddOutput<float>("selected_scores", {1, 3}, {0.95f, 0.9f, 0.85f});
+  test.AddOutput<int64_t>("selected_classes", {1, 3}, {0L, 0L, 1L});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,424 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/util/qmath.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename QType,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+static std::vector<float> ApplyQDQ(const std::vector<float>& data, size_t channel_count, bool per_channel = false) {
+  std::vector<float> result(data.size());
+  size_t size_per_dir = data.size() / channel_count;
+
+  for (size_t dir_idx = 0; dir_idx < channel_count; dir_idx++) {
+    QType zp = 0;
+    float scale = 1.0f;
+    const float* data_buf = data.data() + size_per_dir * dir_idx;
+    if (per_channel) {
+      GetQuantizationParameter<QType, true, true>(data_buf, size_per_dir, scale, zp);
+    } else {
+      GetQuantizationParameter<QType, true, false>(data_buf, size_per_dir, scale, zp);
+    }
+
+    std::vector<QType> quant_data(size_per_dir);
+    MlasQuantizeLinear(data_buf, quant_data.data(), size_per_dir, scale, zp);
+
+    std::transform(quant_data.begin(),
+                   quant_data.end(),
+                   result.begin() + size_per_dir * dir_idx,
+                   [&zp, &scale](QType q) {
+                     return (static_cast<int32_t>(q) - zp) * scale;
+                   });
+  }
+
+  return result;
+}
+
+// quantize w which has shape [num_direction, row, col] and write it transposed to [num_direction, col, row]
+template <typename QType,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+static void QuantizeWeight(std::vector<QType>& w_quant,
+                           std::vector<float>& scale,
+                           std::vector<QType>& zp,
+                           const std::vector<float>& w,
+                           size_t num_direction,
+                           size_t row,
+                           size_t col,
+                           bool per_channel) {
+  std::vector<QType> w_quant_tmp(w.size());
+
+  size_t quant_param_size = per_channel ? num_direction * row : num_direction;
+  size_t quant_span = per_channel ? col : row * col;
+  scale.resize(quant_param_size);
+  zp.resize(quant_param_size);
+
+  for (size_t quant_param_idx = 0; quant_param_idx < quant_param_size; quant_param_idx++) {
+    if (per_channel) {
+      GetQuantizationParameter<QType, true, true>(w.data() + quant_param_idx * quant_span, quant_span, scale[quant_param_idx], zp[quant_param_idx]);
+    } else {
+      GetQuantizationParameter<QType, true, false>(w.data() + quant_param_idx * quant_span, quant_span, scale[quant_param_idx], zp[quant_param_idx]);
+    }
+
+    MlasQuantizeLinear(w.data() + quant_param_idx * quant_span,
+                       w_quant_tmp.data() + quant_param_idx * quant_span,
+                       quant_span,
+                       scale[quant_param_idx],
+                       zp[quant_param_idx]);
+  }
+
+  w_quant.resize(w.size());
+  for (size_t dir_idx = 0; dir_idx < num_direction; dir_idx++) {
+    QType* w_quant_tmp_buf = w_quant_tmp.data() + dir_idx * row * col;
+    QType* w_quant_buf = w_quant.data() + dir_idx * row * col;
+    for (size_t c = 0; c < col; c++) {
+      for (size_t r = 0; r < row; r++) {
+        *w_quant_buf++ = *(w_quant_tmp_buf + r * col + c);
+      }
+    }
+  }
+}
+
+template <typename QType,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+static void ComputeRefOutput(std::vector<float>& Y_data,
+                             std::vector<float>& Y_h_data,
+                             int64_t input_size,
+                             int64_t batch_size,
+                             int64_t hidden_size,
+                             const std::vector<float>& X_data,
+                             const std::vector<float>& W_data,
+                             const std::vector<float>& R_data,
+                             const std::vector<float>* B_data,
+                             const std::vector<float>& initial_h_data,
+                             const std::string& direction,
+                             const std::vector<std::string>& activations,
+                             bool per_channel) {
+  OpTester test("GRU", 7 /*opset_version*/, onnxruntime::kOnnxDomain /*domain*/, false /*verify_output*/);
+
+  test.AddAttribute<std::vector<std::string>>("activations", activations);
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", 1);
+
+  int64_t seq_length = 1;  // only use seq length 1
+  int64_t num_directions = (direction == "bidirectional") ? 2 : 1;
+  std::vector<int64_t> X_dims = {seq_length, batch_size, input_size};
+  std::vector<int64_t> W_dims = {num_directions, 3 * hidden_size, input_size};
+  std::vector<int64_t> R_dims = {num_directions, 3 * hidden_size, hidden_size};
+
+  test.AddInput<float>("X", X_dims, ApplyQDQ<uint8_t>(X_data, 1));
+  test.AddInput<float>("W", W_dims, ApplyQDQ<QType>(W_data, per_channel ? num_directions * 3 * hidden_size : num_directions, per_channel));
+  test.AddInput<float>("R", R_dims, ApplyQDQ<QType>(R_data, per_channel ? num_directions * 3 * hidden_size : num_directions, per_channel));
+
+  if (B_data) {
+    std::vector<int64_t> B_dims = {num_directions, 6 * hidden_size};
+    test.AddInput<float>("B", B_dims, *B_data);
+  } else {
+    test.AddMissingOptionalInput<float>();
+  }
+
+  // sequence_lens
+  test.AddMissingOptionalInput<int>();
+
+  std::vector<int64_t> initial_h_dims = {num_directions, batch_size, hidden_size};
+  test.AddInput<float>("initial_h", initial_h_dims, ApplyQDQ<uint8_t>(initial_h_data, num_directions));
+
+  size_t y_data_size = seq_length * num_directions * batch_size * hidden_size;
+  Y_data.resize(y_data_size);
+  std::vector<int64_t> Y_dims = {seq_length, num_directions, batch_size, hidden_size};
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+
+  size_t y_h_data_size = num_directions * batch_size * hidden_size;
+  Y_h_data.resize(y_h_data_size);
+  std::vector<int64_t> Y_h_dims{num_directions, batch_size, hidden_size};
+  test.AddOutput<float>("Y_h", Y_h_dims, Y_h_data);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+  std::vector<MLValue> outputs = test.GetFetches();
+
+  const float* y_buffer = outputs[0].Get<Tensor>().Data<float>();
+  std::copy(y_buffer, y_buffer + y_data_size, Y_data.begin());
+
+  const float* y_h_buffer = outputs[1].Get<Tensor>().Data<float>();
+  std::copy(y_h_buffer, y_h_buffer + y_h_data_size, Y_h_data.begin());
+}
+
+// Reference for the cases the GRU op can't model: it applies the same dynamic quantization as the quantized kernel,
+// which quantizes X once for the whole sequence, Ht-1 at every step, and rt (.) Ht-1 at every step when
+// linear_before_reset is 0. W_data and R_data are already quantized and dequantized.
+static void ComputeQuantRefOutput(std::vector<float>& Y_data,
+                                  std::vector<float>& Y_h_data,
+                                  int64_t seq_length,
+                                  int64_t input_size,
+                                  int64_t batch_size,
+                                  int64_t hidden_size,
+                                  const std::vector<float>& X_data,
+                                  const std::vector<float>& W_data,
+                                  const std::vector<float>& R_data,
+                                  const std::vector<float>* B_data,
+                                  const std::vector<float>& initial_h_data,
+                                  const std::string& direction,
+                                  bool linear_before_reset) {
+  const int64_t num_directions = (direction == "bidirectional") ? 2 : 1;
+  const int64_t batch_hidden = batch_size * hidden_size;
+  Y_data.assign(seq_length * num_directions * batch_hidden, 0.0f);
+  Y_h_data.assign(num_directions * batch_hidden, 0.0f);
+
+  auto sigmoid = [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+  auto dot = [](const float* a, const float* b, int64_t count) {
+    float sum = 0.0f;
+    for (int64_t k = 0; k < count; k++) {
+      sum += a[k] * b[k];
+    }
+    return sum;
+  };
+
+  const std::vector<float> X_qdq = ApplyQDQ<uint8_t>(X_data, 1);
+
+  for (int64_t dir = 0; dir < num_directions; dir++) {
+    const bool reverse = direction == "reverse" || dir == 1;
+    const float* W = W_data.data() + dir * 3 * hidden_size * input_size;
+    const float* R = R_data.data() + dir * 3 * hidden_size * hidden_size;
+    // Wb[zrh] followed by Rb[zrh]
+    std::vector<float> B(6 * hidden_size, 0.0f);
+    if (B_data) {
+      std::copy(B_data->begin() + dir * 6 * hidden_size, B_data->begin() + (dir + 1) * 6 * hidden_size, B.begin());
+    }
+
+    std::vector<float> H_prev(initial_h_data.begin() + dir * batch_hidden,
+                              initial_h_data.begin() + (dir + 1) * batch_hidden);
+    std::vector<float> z(batch_hidden);
+    std::vector<float> r(batch_hidden);
+    std::vector<float> h_linear(batch_hidden);  // Ht-1 * (Rh^T) + Rbh, or rt (.) Ht-1
+    std::vector<float> H(batch_hidden);
+
+    for (int64_t step = 0; step < seq_length; step++) {
+      const int64_t t = reverse ? seq_length - 1 - step : step;
+      const std::vector<float> H_prev_qdq = ApplyQDQ<uint8_t>(H_prev, 1);
+
+      for (int64_t b = 0; b < batch_size; b++) {
+        const float* x = X_qdq.data() + (t * batch_size + b) * input_size;
+        const float* h = H_prev_qdq.data() + b * hidden_size;
+        for (int64_t j = 0; j < hidden_size; j++) {
+          const int64_t i = b * hidden_size + j;
+          z[i] = sigmoid(dot(x, W + j * input_size, input_size) + dot(h, R + j * hidden_size, hidden_size) +
+                         B[j] + B[3 * hidden_size + j]);
+          r[i] = sigmoid(dot(x, W + (hidden_size + j) * input_size, input_size) +
+                         dot(h, R + (hidden_size + j) * hidden_size, hidden_size) +
+                         B[hidden_size + j] + B[4 * hidden_size + j]);
+          h_linear[i] = linear_before_reset
+                            ? dot(h, R + (2 * hidden_size + j) * hidden_size, hidden_size) + B[5 * hidden_size + j]
+                            : r[i] * H_prev[i];
+        }
+      }
+
+      // rt (.) Ht-1 is quantized as a whole before the GEMM with Rh
+      const std::vector<float> rh_qdq = linear_before_reset ? h_linear : ApplyQDQ<uint8_t>(h_linear, 1);
+
+      for (int64_t b = 0; b < batch_size; b++) {
+        const float* x = X_qdq.data() + (t * batch_size + b) * input_size;
+        for (int64_t j = 0; j < hidden_size; j++) {
+          const int64_t i = b * hidden_size + j;
+          float h_gate = dot(x, W + (2 * hidden_size + j) * input_size, input_size) + B[2 * hidden_size + j];
+          if (linear_before_reset) {
+            h_gate += r[i] * h_linear[i];
+          } else {
+            h_gate += dot(rh_qdq.data() + b * hidden_size, R + (2 * hidden_size + j) * hidden_size, hidden_size) +
+                      B[5 * hidden_size + j];
+          }
+          H[i] = (1.0f - z[i]) * std::tanh(h_gate) + z[i] * H_prev[i];
+        }
+      }
+
+      std::copy(H.begin(), H.end(), Y_data.begin() + (t * num_directions + dir) * batch_hidden);
+      H_prev = H;
+    }
+
+    std::copy(H_prev.begin(), H_prev.end(), Y_h_data.begin() + dir * batch_hidden);
+  }
+}
+
+// A single step with linear_before_reset is checked against the GRU op, as both recurrent GEMMs then quantize Ht-1,
+// which lets the reference apply the same quantization to initial_h up front. Other cases use ComputeQuantRefOutput.
+template <typename QType,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+static void RunQuantGRU(int64_t input_size,
+                        int64_t batch_size,
+                        int64_t hidden_size,
+                        bool has_bias,
+                        bool is_initializer_W,
+                        bool is_initializer_R,
+                        bool per_channel,
+                        const std::string& direction,
+                        int64_t seq_len,
+                        bool linear_before_reset) {
+  OpTester test("DynamicQuantizeGRU", 1 /*opset_version*/, onnxruntime::kMSDomain /*domain*/);
+
+  int num_directions = (direction == "bidirectional") ? 2 : 1;
+
+  std::vector<std::string> activations;
+  if (num_directions == 2) {
+    activations = {"sigmoid", "tanh", "sigmoid", "tanh"};
+  } else {
+    activations = {"sigmoid", "tanh"};
+  }
+  test.AddAttribute<std::vector<std::string>>("activations", activations);
+
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset ? 1 : 0);
+
+  RandomValueGenerator rand_gen;
+
+  // X
+  std::vector<int64_t> X_dims = {seq_len, batch_size, input_size};
+  std::vector<float> X_data = rand_gen.Gaussian<float>({seq_len, batch_size, input_size}, 0.0f, 0.25f);
+  test.AddInput<float>("X", X_dims, X_data);
+
+  // W
+  std::vector<int64_t> W_dims = {num_directions, input_size, 3 * hidden_size};
+  std::vector<float> W_data = rand_gen.Gaussian<float>({num_directions, 3 * hidden_size, input_size}, 0.0f, 0.25f);
+
+  std::vector<float> w_scale;
+  std::vector<QType> w_zp;
+  std::vector<QType> w_quant;
+  QuantizeWeight(w_quant, w_scale, w_zp, W_data, num_directions, 3 * hidden_size, input_size, per_channel);
+  test.AddInput<QType>("W", W_dims, w_quant, is_initializer_W);
+
+  // R
+  std::vector<int64_t> R_dims = {num_directions, hidden_size, 3 * hidden_size};
+  std::vector<float> R_data = rand_gen.Gaussian<float>({num_directions, 3 * hidden_size, hidden_size}, 0.0f, 0.25f);
+
+  std::vector<float> r_scale;
+  std::vector<QType> r_zp;
+  std::vector<QType> r_quant;
+  QuantizeWeight(r_quant, r_scale, r_zp, R_data, num_directions, 3 * hidden_size, hidden_size, per_channel);
+  test.AddInput<QType>("R", R_dims, r_quant, is_initializer_R);
+
+  std::vector<float> B_data;
+  if (has_bias) {
+    std::vector<int64_t> B_dims = {num_directions, 6 * hidden_size};
+    B_data = rand_gen.Gaussian<float>(B_dims, 0.0f, 0.25f);
+
+    test.AddInput<float>("B", B_dims, B_data);
+  } else {
+    test.AddMissingOptionalInput<float>();
+  }
+
+  // sequence_lens
+  test.AddMissingOptionalInput<int>();
+
+  // initial_h
+  std::vector<int64_t> initial_h_dims = {num_directions, batch_size, hidden_size};
+  std::vector<float> initial_h_data = rand_gen.Gaussian<float>(initial_h_dims, 0.0f, 0.25f);
+  test.AddInput<float>("initial_h", initial_h_dims, initial_h_data);
+
+  std::vector<int64_t> per_tensor_dims = {num_directions};
+  std::vector<int64_t> per_channel_dims = {num_directions, 3 * hidden_size};
+  test.AddInput<float>("W_scale", per_channel ? per_channel_dims : per_tensor_dims, w_scale);
+  test.AddInput<QType>("W_zero_point", per_channel ? per_channel_dims : per_tensor_dims, w_zp);
+
+  test.AddInput<float>("R_scale", per_channel ? per_channel_dims : per_tensor_dims, r_scale);
+  test.AddInput<QType>("R_zero_point", per_channel ? per_channel_dims : per_tensor_dims, r_zp);
+
+  std::vector<float> Y_data;
+  std::vector<float> Y_h_data;
+  if (seq_len == 1 && linear_before_reset) {
+    ComputeRefOutput<QType>(Y_data, Y_h_data,
+                            input_size, batch_size, hidden_size,
+                            X_data, W_data, R_data,
+                            has_bias ? &B_data : nullptr,
+                            initial_h_data,
+                            direction, activations, per_channel);
+  } else {
+    const size_t channel_count = per_channel ? num_directions * 3 * hidden_size : num_directions;
+    ComputeQuantRefOutput(Y_data, Y_h_data,
+                          seq_len, input_size, batch_size, hidden_size,
+                          X_data,
+                          ApplyQDQ<QType>(W_data, channel_count, per_channel),
+                          ApplyQDQ<QType>(R_data, channel_count, per_channel),
+                          has_bias ? &B_data : nullptr,
+                          initial_h_data,
+                          direction, linear_before_reset);
+  }
+
+  std::vector<int64_t> Y_dims = {seq_len, num_directions, batch_size, hidden_size};
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+
+  std::vector<int64_t> Y_h_dims{num_directions, batch_size, hidden_size};
+  test.AddOutput<float>("Y_h", Y_h_dims, Y_h_data);
+
+  if (seq_len > 1 || !linear_before_reset) {
+    // ComputeQuantRefOutput accumulates in a different order than the kernel, which can move a value of Ht-1 or
+    // rt (.) Ht-1 across a rounding boundary when it is quantized
+    test.SetOutputAbsErr("Y", 2e-3f);
+    test.SetOutputAbsErr("Y_h", 2e-3f);
+  }
+
+  test.Run();
+}
+
+template <typename QType,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+static void RunQuantGRU(int64_t input_size,
+                        int64_t batch_size,
+                        int64_t hidden_size,
+                        bool per_channel = false,
+                        int64_t seq_len = 1,
+                        bool linear_before_reset = true) {
+  for (bool has_bias : {false, true}) {
+    for (bool is_initializer : {false, true}) {
+      for (const char* direction : {"forward", "reverse", "bidirectional"}) {
+        RunQuantGRU<QType>(input_size, batch_size, hidden_size,
+                           has_bias,
+                           is_initializer /*is_initializer_W*/, is_initializer /*is_initializer_R*/,
+                           per_channel, direction, seq_len, linear_before_reset);
+      }
+    }
+  }
+}
+
+TEST(DynamicQuantGRUTest, SmallSize) {
+  RunQuantGRU<int8_t>(2, 1, 16);
+  RunQuantGRU<int8_t>(2, 1, 16, true /*per_channel*/);
+  RunQuantGRU<uint8_t>(2, 1, 16);
+}
+
+TEST(DynamicQuantGRUTest, LargeSize) {
+  RunQuantGRU<int8_t>(12, 3, 278);
+  RunQuantGRU<int8_t>(12, 3, 278, true /*per_channel*/);
+  RunQuantGRU<uint8_t>(12, 3, 278);
+}
+
+TEST(DynamicQuantGRUTest, NoLinearBeforeReset) {
+  RunQuantGRU<int8_t>(2, 1, 16, false /*per_channel*/, 1 /*seq_len*/, false /*linear_before_reset*/);
+  RunQuantGRU<int8_t>(2, 1, 16, true /*per_channel*/, 1 /*seq_len*/, false /*linear_before_reset*/);
+  RunQuantGRU<uint8_t>(2, 1, 16, false /*per_channel*/, 1 /*seq_len*/, false /*linear_before_reset*/);
+  RunQuantGRU<int8_t>(12, 3, 278, false /*per_channel*/, 1 /*seq_len*/, false /*linear_before_reset*/);
+}
+
+TEST(DynamicQuantGRUTest, MultiStep) {
+  for (bool linear_before_reset : {true, false}) {
+    RunQuantGRU<int8_t>(2, 1, 16, false /*per_channel*/, 5 /*seq_len*/, linear_before_reset);
+    RunQuantGRU<int8_t>(2, 1, 16, true /*per_channel*/, 5 /*seq_len*/, linear_before_reset);
+    RunQuantGRU<uint8_t>(2, 1, 16, false /*per_channel*/, 5 /*seq_len*/, linear_before_reset);
+    RunQuantGRU<int8_t>(12, 3, 278, false /*per_channel*/, 4 /*seq_len*/, linear_before_reset);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -223,5 +223,90 @@ TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias) {
           hidden_size);
 }
 
+TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias_OptionalOutputs) {
+  int batch_size = 2;
+  int sequence_length = 2;
+  int hidden_size = 4;
+
+  OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size},
+                       {0.7f, -0.4f, -0.2f, 1.2f,
+                        0.4f, 0.3f, 0.1f, -0.4f,
+                        0.7f, -0.4f, -0.2f, 1.2f,
+                        0.4f, 0.3f, 0.1f, -0.4f});
+  test.AddInput<float>("skip", {batch_size, sequence_length, hidden_size},
+                       {0.1f, -0.2f, 0.3f, 1.0f,
+                        0.5f, 0.1f, 0.4f, 1.6f,
+                        1.8f, -0.3f, 0.0f, 1.f,
+                        -0.5f, 0.4f, 0.8f, -0.6f});
+  test.AddInput<float>("gamma", {hidden_size}, {0.3f, 0.2f, 4.0f, 2.2f});
+  test.AddInput<float>("beta", {hidden_size}, {0.2f, 0.1f, 0.4f, 1.6f});
+  test.AddInput<float>("bias", {hidden_size}, {0.1f, -0.1f, 0.2f, -0.2f});
+  test.AddAttribute("epsilon", epsilon_);
+
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                        {0.28433859348297119f, -0.17090578377246857f, -0.92897164821624756f, 4.6924152374267578f,
+                         0.46111652255058289f, -0.21333980560302734f, -0.29631003737449646f, 3.5148544311523438f,
+                         0.55470430850982666f, -0.15080101788043976f, -2.3229825496673584f, 3.255286693572998f,
+                         0.15631480515003204f, 0.21066918969154358f, 4.9432611465454102f, -1.7957965135574341f});
+  test.AddOutput<float>("mean", {batch_size, sequence_length, 1}, {0.625f, 0.75f, 0.95f, 0.125f});
+  test.AddOutput<float>("inv_std_var", {batch_size, sequence_length, 1},
+                        {1.0222859f, 3.4815531f, 0.71657436f, 1.1649387f});
+  test.AddOutput<float>("input_skip_bias_sum", {batch_size, sequence_length, hidden_size},
+                        {0.9f, -0.7f, 0.3f, 2.0f,
+                         1.0f, 0.3f, 0.7f, 1.0f,
+                         2.6f, -0.8f, 0.0f, 2.0f,
+                         0.0f, 0.6f, 1.1f, -1.2f});
+
+  // mean and inv_std_var are produced by the CPU kernel only
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias_InputSkipBiasSum_CUDA) {
+  if (!HasCudaEnvironment(0)) {
+    return;
+  }
+
+  int batch_size = 2;
+  int sequence_length = 2;
+  int hidden_size = 4;
+
+  OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size},
+                       {0.7f, -0.4f, -0.2f, 1.2f,
+                        0.4f, 0.3f, 0.1f, -0.4f,
+                        0.7f, -0.4f, -0.2f, 1.2f,
+                        0.4f, 0.3f, 0.1f, -0.4f});
+  test.AddInput<float>("skip", {batch_size, sequence_length, hidden_size},
+                       {0.1f, -0.2f, 0.3f, 1.0f,
+                        0.5f, 0.1f, 0.4f, 1.6f,
+                        1.8f, -0.3f, 0.0f, 1.f,
+                        -0.5f, 0.4f, 0.8f, -0.6f});
+  test.AddInput<float>("gamma", {hidden_size}, {0.3f, 0.2f, 4.0f, 2.2f});
+  test.AddInput<float>("beta", {hidden_size}, {0.2f, 0.1f, 0.4f, 1.6f});
+  test.AddInput<float>("bias", {hidden_size}, {0.1f, -0.1f, 0.2f, -0.2f});
+  test.AddAttribute("epsilon", epsilon_);
+
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                        {0.28433859348297119f, -0.17090578377246857f, -0.92897164821624756f, 4.6924152374267578f,
+                         0.46111652255058289f, -0.21333980560302734f, -0.29631003737449646f, 3.5148544311523438f,
+                         0.55470430850982666f, -0.15080101788043976f, -2.3229825496673584f, 3.255286693572998f,
+                         0.15631480515003204f, 0.21066918969154358f, 4.9432611465454102f, -1.7957965135574341f});
+  // mean and inv_std_var are not produced by the CUDA kernel
+  test.AddMissingOptionalOutput<float>();
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("input_skip_bias_sum", {batch_size, sequence_length, hidden_size},
+                        {0.9f, -0.7f, 0.3f, 2.0f,
+                         1.0f, 0.3f, 0.7f, 1.0f,
+                         2.6f, -0.8f, 0.0f, 2.0f,
+                         0.0f, 0.6f, 1.1f, -1.2f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -677,6 +677,48 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_SingleCharSeparatorsNC) {
+  // Separators that each match one ASCII char, including an escaped
+  // regex meta character, are split in a single pass over the string.
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      u8" ",
+      u8",",
+      u8"\\."};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, separators, 2);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"a, bc.Понедельник", u8"",
+                                 u8"  中文 x,,yz ", u8"..."};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(4));
+  std::vector<std::string> output{
+      start_mark,
+      u8"bc",
+      u8"Понедельник",
+      end_mark,
+      start_mark,
+      end_mark,
+      padval,
+      padval,
+      start_mark,
+      u8"中文",
+      u8"yz",
+      end_mark,
+      start_mark,
+      end_mark,
+      padval,
+      padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(u8"a.");
@@ -5,10 +5,13 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cstdio>
 #include <functional>
 #include <iterator>
 #include <thread>
 #include <fstream>
+#include <limits>
+#include <sstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/denormal.h"
@@ -47,6 +50,7 @@
 #include "test/util/include/inference_session_wrapper.h"
 
 #include "gtest/gtest.h"
+#include "single_include/nlohmann/json.hpp"
 
 using namespace std;
 using namespace ONNX_NAMESPACE;
@@ -379,6 +383,103 @@ TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   RunModel(session_object, run_options);
 }
 
+static nlohmann::json ReadNodeCaptureFile(const std::string& file_name) {
+  std::ifstream in(file_name);
+  EXPECT_TRUE(in.good()) << "Failed to open " << file_name;
+  // throws if the file is not valid JSON
+  nlohmann::json capture = nlohmann::json::parse(in);
+  in.close();
+  std::remove(file_name.c_str());
+  return capture;
+}
+
+TEST(InferenceSessionTests, NodeCaptureFile) {
+  const std::string capture_file = "inference_session_node_capture.json";
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.NodeCaptureFile";
+    ASSERT_STATUS_OK(so.AddConfigEntry(kOrtSessionOptionsConfigNodeCaptureFile, capture_file.c_str()));
+
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+    RunModel(session_object, run_options);
+    // the file is written when the session is destroyed
+  }
+
+  const auto capture = ReadNodeCaptureFile(capture_file);
+  const auto& nodes = capture.at("nodes");
+  ASSERT_EQ(nodes.size(), 1u);
+
+  // both runs of the Mul node are aggregated into one record
+  const auto& record = nodes[0];
+  EXPECT_EQ(record.at("op_type").get<std::string>(), "Mul");
+  EXPECT_EQ(record.at("domain").get<std::string>(), "");
+  EXPECT_EQ(record.at("provider").get<std::string>(), kCpuExecutionProvider);
+  EXPECT_EQ(record.at("count").get<int>(), 2);
+  EXPECT_LE(record.at("min_ns").get<int64_t>(), record.at("max_ns").get<int64_t>());
+  EXPECT_EQ(record.at("outputs").get<int>(), 1);
+
+  const auto& inputs = record.at("inputs");
+  ASSERT_EQ(inputs.size(), 2u);
+  for (const auto& input : inputs) {
+    EXPECT_EQ(input.at("type").get<int>(), ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    EXPECT_EQ(input.at("shape").get<std::vector<int64_t>>(), std::vector<int64_t>({3, 2}));
+  }
+  // X is fed, W is an initializer that can't be overridden
+  EXPECT_FALSE(inputs[0].at("constant").get<bool>());
+  EXPECT_TRUE(inputs[1].at("constant").get<bool>());
+}
+
+TEST(InferenceSessionTests, NodeCaptureFileNonFiniteAttribute) {
+  onnxruntime::Model model("node_capture", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto& node = graph.AddNode("leaky_relu", "LeakyRelu", "", {&input_arg}, {&output_arg});
+  node.AddAttribute("alpha", -std::numeric_limits<float>::infinity());
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  const std::string capture_file = "inference_session_node_capture_non_finite.json";
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.NodeCaptureFileNonFiniteAttribute";
+    ASSERT_STATUS_OK(so.AddConfigEntry(kOrtSessionOptionsConfigNodeCaptureFile, capture_file.c_str()));
+
+    InferenceSession session_object{so, GetEnvironment()};
+    std::stringstream model_stream(model_data);
+    ASSERT_STATUS_OK(session_object.Load(model_stream));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {3, 2},
+                         {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value);
+    NameMLValMap feeds{{"X", ml_value}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches));
+  }
+
+  const auto capture = ReadNodeCaptureFile(capture_file);
+  const auto& nodes = capture.at("nodes");
+  ASSERT_EQ(nodes.size(), 1u);
+  const auto& attributes = nodes[0].at("attributes");
+  ASSERT_EQ(attributes.size(), 1u);
+  EXPECT_EQ(attributes[0].at("name").get<std::string>(), "alpha");
+  EXPECT_EQ(attributes[0].at("f").get<std::string>(), "-Infinity");
+}
+
 TEST(InferenceSessionTests, DisableCPUArena) {
   SessionOptions so;
 
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/kernel_benchmark/kernel_benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "core/graph/constants.h"
+#include "single_include/nlohmann/json.hpp"
+
+using namespace ONNX_NAMESPACE;
+using json = nlohmann::json;
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+namespace {
+
+bool ParseHex(const std::string& hex, std::string& bytes) {
+  auto digit = [](char c) -> int {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+  };
+  if (hex.size() % 2 != 0) {
+    return false;
+  }
+  bytes.resize(hex.size() / 2);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    const int high = digit(hex[2 * i]);
+    const int low = digit(hex[2 * i + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    bytes[i] = static_cast<char>(high << 4 | low);
+  }
+  return true;
+}
+
+// Float attribute values are numbers, or "NaN", "Infinity" and "-Infinity" as JSON has no literals for them.
+float ParseFloat(const json& value) {
+  if (value.is_string()) {
+    const std::string& s = value.get_ref<const std::string&>();
+    if (s == "NaN") return std::numeric_limits<float>::quiet_NaN();
+    if (s == "Infinity") return std::numeric_limits<float>::infinity();
+    if (s == "-Infinity") return -std::numeric_limits<float>::infinity();
+    ORT_THROW("Invalid float value ", s);
+  }
+  return value.get<float>();
+}
+
+// Returns false for the attributes that are not recorded, i.e. graphs.
+bool ParseAttribute(const json& record, AttributeProto& attribute) {
+  attribute.set_name(record.at("name").get<std::string>());
+  attribute.set_type(static_cast<AttributeProto_AttributeType>(record.at("type").get<int>()));
+  switch (attribute.type()) {
+    case AttributeProto_AttributeType_FLOAT:
+      attribute.set_f(ParseFloat(record.at("f")));
+      return true;
+    case AttributeProto_AttributeType_INT:
+      attribute.set_i(record.at("i").get<int64_t>());
+      return true;
+    case AttributeProto_AttributeType_STRING:
+      attribute.set_s(record.at("s").get<std::string>());
+      return true;
+    case AttributeProto_AttributeType_FLOATS:
+      for (const auto& v : record.at("floats")) {
+        attribute.add_floats(ParseFloat(v));
+      }
+      return true;
+    case AttributeProto_AttributeType_INTS:
+      for (const auto& v : record.at("ints")) {
+        attribute.add_ints(v.get<int64_t>());
+      }
+      return true;
+    case AttributeProto_AttributeType_STRINGS:
+      for (const auto& v : record.at("strings")) {
+        attribute.add_strings(v.get<std::string>());
+      }
+      return true;
+    case AttributeProto_AttributeType_TENSOR: {
+      std::string bytes;
+      return ParseHex(record.at("t").get<std::string>(), bytes) && attribute.mutable_t()->ParseFromString(bytes);
+    }
+    default:
+      return false;
+  }
+}
+
+// Adds the recorded input to spec. Returns false for inputs that are not tensors.
+bool AddInput(const json& record, OpSpec& spec) {
+  if (record.is_null()) {
+    spec.Missing();
+    return true;
+  }
+  const auto type = static_cast<TensorProto_DataType>(record.at("type").get<int>());
+  if (type == TensorProto_DataType_UNDEFINED) {
+    return false;
+  }
+  const auto shape = record.at("shape").get<std::vector<int64_t>>();
+  const bool is_constant = record.at("constant").get<bool>();
+
+  auto values = record.find("values");
+  if (values != record.end()) {
+    TensorProto value;
+    value.set_data_type(type);
+    for (auto dim : shape) {
+      value.add_dims(dim);
+    }
+    for (const auto& v : *values) {
+      if (type == TensorProto_DataType_INT64) {
+        value.add_int64_data(v.get<int64_t>());
+      } else {
+        value.add_int32_data(v.get<int32_t>());
+      }
+    }
+    if (is_constant) {
+      spec.Constant(value);
+    } else {
+      spec.Input(value);
+    }
+    return true;
+  }
+
+  // integer tensors too large to be recorded are usually indices. 0 is valid for most.
+  const bool is_float = type == TensorProto_DataType_FLOAT || type == TensorProto_DataType_DOUBLE ||
+                        type == TensorProto_DataType_FLOAT16;
+  const double low = is_float ? -1.0 : 0.0;
+  if (is_constant) {
+    spec.Constant(type, shape, low, 1.0);
+  } else {
+    spec.Input(type, shape, low, 1.0);
+  }
+  return true;
+}
+
+bool CreateOpSpec(const json& record, OpSpec& spec) {
+  for (const auto& attribute_record : record.at("attributes")) {
+    AttributeProto attribute;
+    if (!ParseAttribute(attribute_record, attribute)) {
+      return false;
+    }
+    spec.Attr(attribute);
+  }
+  for (const auto& input_record : record.at("inputs")) {
+    if (!AddInput(input_record, spec)) {
+      return false;
+    }
+  }
+  spec.Outputs(record.at("outputs").get<size_t>());
+  return true;
+}
+
+}  // namespace
+
+Status RegisterCaptureBenchmarks(const std::string& capture_path) {
+  std::ifstream stream(capture_path);
+  ORT_RETURN_IF_NOT(stream.good(), "Failed to open ", capture_path);
+
+  Status status;
+  size_t skipped = 0;
+  ORT_TRY {
+    const json capture = json::parse(stream);
+    size_t index = 0;
+    for (const auto& record : capture.at("nodes")) {
+      const std::string op_type = record.at("op_type").get<std::string>();
+      std::string name = record.at("name").get<std::string>();
+      if (name.empty()) {
+        name = std::to_string(index);
+      }
+      ++index;
+
+      // the runner only creates CPU kernels
+      OpSpec spec(op_type, record.at("since_version").get<int>(), record.at("domain").get<std::string>());
+      if (record.at("provider").get<std::string>() != kCpuExecutionProvider || !CreateOpSpec(record, spec)) {
+        ++skipped;
+        continue;
+      }
+
+      // the mean kernel time in the session that recorded the capture, to compare with the replay
+      const auto count = std::max<int64_t>(record.at("count").get<int64_t>(), 1);
+      const auto captured_ns = record.at("total_ns").get<int64_t>() / count;
+      RegisterOpBenchmark(op_type + "/" + name + "/captured_ns:" + std::to_string(captured_ns), spec);
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid node capture ", capture_path, ": ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  if (skipped != 0) {
+    std::cerr << skipped << " nodes of other execution providers or with subgraphs or non-tensor inputs are not "
+              << "benchmarked" << std::endl;
+  }
+  return Status::OK();
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/platform/threadpool.h"
+#include "test/kernel_benchmark/kernel_runner.h"
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+// Intra op thread counts every benchmark is run with.
+const std::vector<int>& ThreadCounts();
+void SetThreadCounts(std::vector<int> thread_counts);
+
+// Intra op thread pool with num_threads threads, nullptr for 1 thread. Pools are created once and reused.
+concurrency::ThreadPool* GetThreadPool(int num_threads);
+
+// Registers a benchmark of the CPU kernel of spec for each of ThreadCounts(), named
+// <name>/intra_op_threads:<count>.
+void RegisterOpBenchmark(const std::string& name, const OpSpec& spec);
+
+// Registers the operator benchmarks with shapes taken from common models (op_benchmarks.cc).
+void RegisterOpBenchmarks();
+
+// Registers the benchmarks of the MLAS routines (mlas_benchmarks.cc).
+void RegisterMlasBenchmarks();
+
+// Registers a benchmark for each node of the model, with the shapes and initializers of the model (model_benchmarks.cc).
+// Symbolic dims of the model inputs are set to 1.
+Status RegisterModelBenchmarks(const PathString& model_path);
+
+// Registers a benchmark for each node recorded by a session with the kOrtSessionOptionsConfigNodeCaptureFile config,
+// with synthetic data of the recorded types and shapes (capture_benchmarks.cc).
+Status RegisterCaptureBenchmarks(const std::string& capture_path);
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
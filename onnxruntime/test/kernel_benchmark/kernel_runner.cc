@@ -0,0 +1,373 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/kernel_benchmark/kernel_runner.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+
+#include "core/common/make_unique.h"
+#include "core/framework/callback.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/fuse_nodes_funcs.h"
+#include "core/framework/kernel_registry.h"
+#include "core/framework/mem_buffer.h"
+#include "core/framework/node_index_info.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/platform/env.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/util/math.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+namespace {
+
+template <typename T, typename Convert>
+void FillRawData(TensorProto& value, size_t count, double low, double high, Convert convert) {
+  // fixed seed so that every run of a benchmark sees the same data
+  static std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(low, high);
+  std::string raw(count * sizeof(T), '\0');
+  T* data = reinterpret_cast<T*>(&raw[0]);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = convert(distribution(generator));
+  }
+  value.set_raw_data(std::move(raw));
+}
+
+template <typename T>
+void FillRawData(TensorProto& value, size_t count, double low, double high) {
+  FillRawData<T>(value, count, low, high, [](double v) { return static_cast<T>(std::floor(v)); });
+}
+
+TensorProto MakeRandomTensor(TensorProto_DataType type, const std::vector<int64_t>& shape, double low, double high) {
+  TensorProto value;
+  value.set_data_type(type);
+  size_t count = 1;
+  for (auto dim : shape) {
+    ORT_ENFORCE(dim >= 0, "Invalid dim ", dim);
+    value.add_dims(dim);
+    count *= static_cast<size_t>(dim);
+  }
+
+  switch (type) {
+    case TensorProto_DataType_FLOAT:
+      FillRawData<float>(value, count, low, high, [](double v) { return static_cast<float>(v); });
+      break;
+    case TensorProto_DataType_DOUBLE:
+      FillRawData<double>(value, count, low, high, [](double v) { return v; });
+      break;
+    case TensorProto_DataType_FLOAT16:
+      FillRawData<MLFloat16>(value, count, low, high,
+                             [](double v) { return MLFloat16(math::floatToHalf(static_cast<float>(v))); });
+      break;
+    case TensorProto_DataType_BOOL:
+      FillRawData<bool>(value, count, low, high, [low, high](double v) { return v >= (low + high) / 2; });
+      break;
+    case TensorProto_DataType_INT8:
+      FillRawData<int8_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_UINT8:
+      FillRawData<uint8_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_INT16:
+      FillRawData<int16_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_UINT16:
+      FillRawData<uint16_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_INT32:
+      FillRawData<int32_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_UINT32:
+      FillRawData<uint32_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_INT64:
+      FillRawData<int64_t>(value, count, low, high);
+      break;
+    case TensorProto_DataType_UINT64:
+      FillRawData<uint64_t>(value, count, low, high);
+      break;
+    default:
+      ORT_THROW("Random inputs of type ", TensorProto_DataType_Name(type), " are not supported");
+  }
+  return value;
+}
+
+// Execution frame for the single node. Outputs are allocated from the CPU provider with the element type inferred
+// for them when the graph was resolved.
+class BenchmarkExecutionFrame final : public IExecutionFrame {
+ public:
+  BenchmarkExecutionFrame(const IExecutionProvider& provider, const std::vector<MLDataType>& element_types,
+                          const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                          const std::unordered_map<int, OrtValue>& initializers,
+                          const std::vector<int>& fetch_mlvalue_idxs, const OrtValueNameIdxMap& ort_value_idx_map,
+                          const NodeIndexInfo& node_index_info)
+      : IExecutionFrame(ort_value_idx_map, node_index_info, fetch_mlvalue_idxs),
+        provider_(provider),
+        element_types_(element_types) {
+    Init(feed_mlvalue_idxs, feeds, initializers, {});
+  }
+
+ private:
+  AllocatorPtr GetAllocatorImpl(const OrtMemoryInfo& info) const override {
+    return provider_.GetAllocator(info.id, info.mem_type);
+  }
+
+  Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape,
+                                     size_t /*nnz*/) override {
+    MLDataType element_type = element_types_[ort_value_idx];
+    if (element_type == nullptr || shape == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Only tensor outputs are supported");
+    }
+    if (shape->Size() < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor shape cannot contain any negative value");
+    }
+
+    auto p_tensor = onnxruntime::make_unique<Tensor>(element_type, *shape,
+                                                     provider_.GetAllocator(0, OrtMemTypeDefault));
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    return Status::OK();
+  }
+
+  Status CopyTensor(const Tensor& src, Tensor& dest) const override {
+    if (src.IsDataTypeString()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Copying string tensors is not supported");
+    }
+    std::memcpy(dest.MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    return Status::OK();
+  }
+
+  const IExecutionProvider& provider_;
+  const std::vector<MLDataType>& element_types_;
+};
+
+}  // namespace
+
+OpSpec& OpSpec::Input(TensorProto_DataType type, const std::vector<int64_t>& shape, double low, double high) {
+  return Input(MakeRandomTensor(type, shape, low, high));
+}
+
+OpSpec& OpSpec::Input(const TensorProto& value) {
+  InputSpec input;
+  input.value = value;
+  inputs.push_back(std::move(input));
+  return *this;
+}
+
+OpSpec& OpSpec::Constant(TensorProto_DataType type, const std::vector<int64_t>& shape, double low, double high) {
+  return Constant(MakeRandomTensor(type, shape, low, high));
+}
+
+OpSpec& OpSpec::Constant(const std::vector<int64_t>& values) {
+  TensorProto value;
+  value.set_data_type(TensorProto_DataType_INT64);
+  value.add_dims(static_cast<int64_t>(values.size()));
+  for (auto v : values) {
+    value.add_int64_data(v);
+  }
+  return Constant(value);
+}
+
+OpSpec& OpSpec::Constant(const std::vector<float>& values) {
+  TensorProto value;
+  value.set_data_type(TensorProto_DataType_FLOAT);
+  value.add_dims(static_cast<int64_t>(values.size()));
+  for (auto v : values) {
+    value.add_float_data(v);
+  }
+  return Constant(value);
+}
+
+OpSpec& OpSpec::Constant(const TensorProto& value) {
+  InputSpec input;
+  input.is_constant = true;
+  input.value = value;
+  inputs.push_back(std::move(input));
+  return *this;
+}
+
+OpSpec& OpSpec::Missing() {
+  InputSpec input;
+  input.exists = false;
+  inputs.push_back(std::move(input));
+  return *this;
+}
+
+OpSpec& OpSpec::Attr(const AttributeProto& attribute) {
+  attributes.push_back(attribute);
+  return *this;
+}
+
+OpSpec& OpSpec::Outputs(size_t count) {
+  num_outputs = count;
+  return *this;
+}
+
+struct KernelRunner::Impl {
+  explicit Impl(const logging::Logger& logger) : logger(logger) {}
+
+  OrtValue CreateValue(const TensorProto& proto) {
+    size_t size = 0;
+    ORT_THROW_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(proto, &size));
+    AllocatorPtr allocator = provider.GetAllocator(0, OrtMemTypeDefault);
+    // allocate at least one byte so that empty tensors have a valid buffer
+    buffers.emplace_back(allocator->Alloc(std::max<size_t>(size, 1)), BufferDeleter(allocator));
+    OrtValue value;
+    OrtCallback deleter{nullptr, nullptr};
+    ORT_THROW_IF_ERROR(utils::TensorProtoToMLValue(Env::Default(), nullptr, proto,
+                                                   MemBuffer(buffers.back().get(), size, allocator->Info()),
+                                                   value, deleter));
+    deleters.emplace_back(deleter);
+    return value;
+  }
+
+  const logging::Logger& logger;
+  CPUExecutionProvider provider{CPUExecutionProviderInfo(true)};
+  std::unique_ptr<Model> model;
+  OrtValueNameIdxMap ort_value_idx_map;
+  std::unique_ptr<NodeIndexInfo> node_index_info;
+  FuncManager funcs_mgr;
+  DataTransferManager data_transfer_mgr;
+
+  std::vector<BufferUniquePtr> buffers;
+  std::vector<ScopedOrtCallbackInvoker> deleters;
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<OrtValue> feeds;
+  std::unordered_map<int, OrtValue> initializers;
+  std::unordered_map<int, BufferUniquePtr> initializer_buffers;
+  std::vector<int> fetch_mlvalue_idxs;
+  // element type of every value, nullptr if it is not a tensor
+  std::vector<MLDataType> element_types;
+
+  std::unique_ptr<OpKernel> kernel;
+  std::unique_ptr<BenchmarkExecutionFrame> frame;
+};
+
+KernelRunner::KernelRunner(const OpSpec& spec, const logging::Logger& logger)
+    : impl_(onnxruntime::make_unique<Impl>(logger)) {
+  Impl& s = *impl_;
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, spec.domain.empty() ? spec.opset : 12}};
+  if (!spec.domain.empty()) {
+    domain_to_version[spec.domain] = spec.opset;
+  }
+  s.model = onnxruntime::make_unique<Model>("kernel_benchmark", false, ModelMetaData(), PathString(),
+                                            IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                            std::vector<FunctionProto>(), logger);
+  Graph& graph = s.model->MainGraph();
+
+  std::vector<NodeArg*> input_args;
+  for (size_t i = 0; i < spec.inputs.size(); ++i) {
+    const auto& input = spec.inputs[i];
+    if (!input.exists) {
+      input_args.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+      continue;
+    }
+
+    const std::string name = "input_" + std::to_string(i);
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(input.value.data_type());
+    auto* shape = type.mutable_tensor_type()->mutable_shape();
+    for (auto dim : input.value.dims()) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+    input_args.push_back(&graph.GetOrCreateNodeArg(name, &type));
+    if (input.is_constant) {
+      TensorProto initializer = input.value;
+      initializer.set_name(name);
+      graph.AddInitializedTensor(initializer);
+    }
+  }
+
+  std::vector<NodeArg*> output_args;
+  for (size_t i = 0; i < spec.num_outputs; ++i) {
+    output_args.push_back(&graph.GetOrCreateNodeArg("output_" + std::to_string(i), nullptr));
+  }
+
+  NodeAttributes attributes;
+  for (const auto& attribute : spec.attributes) {
+    attributes[attribute.name()] = attribute;
+  }
+  Node& node = graph.AddNode("node", spec.op_type, "", input_args, output_args, &attributes, spec.domain);
+  ORT_THROW_IF_ERROR(graph.Resolve());
+  node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  for (size_t i = 0; i < spec.inputs.size(); ++i) {
+    const auto& input = spec.inputs[i];
+    if (!input.exists) {
+      continue;
+    }
+    const int idx = s.ort_value_idx_map.Add(input_args[i]->Name());
+    OrtValue value = s.CreateValue(input.value);
+    if (input.is_constant) {
+      s.initializers[idx] = value;
+      // keep the buffer of a constant apart so that it can be freed if the kernel packs it
+      s.initializer_buffers[idx] = std::move(s.buffers.back());
+      s.buffers.pop_back();
+    } else {
+      s.feed_mlvalue_idxs.push_back(idx);
+      s.feeds.push_back(value);
+    }
+  }
+  for (const auto* output_arg : output_args) {
+    s.fetch_mlvalue_idxs.push_back(s.ort_value_idx_map.Add(output_arg->Name()));
+  }
+
+  s.element_types.resize(s.ort_value_idx_map.MaxIdx() + 1);
+  for (const auto* node_arg : output_args) {
+    int idx = 0;
+    ORT_THROW_IF_ERROR(s.ort_value_idx_map.GetIdx(node_arg->Name(), idx));
+    const auto* type = node_arg->TypeAsProto();
+    if (type != nullptr && type->has_tensor_type()) {
+      s.element_types[idx] = DataTypeImpl::TypeFromProto(*type)->AsTensorType()->GetElementType();
+    }
+  }
+
+  auto registry = s.provider.GetKernelRegistry();
+  ORT_THROW_IF_ERROR(registry->TryCreateKernel(node, s.provider, s.initializers, s.ort_value_idx_map, s.funcs_mgr,
+                                               s.data_transfer_mgr, s.kernel));
+
+  // Pre-pack the constant inputs like SessionState::PrepackConstantInitializedTensors does, so that the kernel runs
+  // on its packed weights. A packed constant is released since the kernel no longer reads it.
+  for (size_t i = 0; i < spec.inputs.size(); ++i) {
+    if (!spec.inputs[i].exists || !spec.inputs[i].is_constant) {
+      continue;
+    }
+    int idx = 0;
+    ORT_THROW_IF_ERROR(s.ort_value_idx_map.GetIdx(input_args[i]->Name(), idx));
+    bool is_packed = false;
+    ORT_THROW_IF_ERROR(s.kernel->PrePack(s.initializers[idx].Get<Tensor>(), static_cast<int>(i), is_packed));
+    if (is_packed) {
+      s.initializers.erase(idx);
+      s.initializer_buffers.erase(idx);
+    }
+  }
+
+  GraphViewer graph_viewer(graph);
+  s.node_index_info = onnxruntime::make_unique<NodeIndexInfo>(graph_viewer, s.ort_value_idx_map);
+  s.frame = onnxruntime::make_unique<BenchmarkExecutionFrame>(s.provider, s.element_types, s.feed_mlvalue_idxs,
+                                                              s.feeds, s.initializers, s.fetch_mlvalue_idxs,
+                                                              s.ort_value_idx_map, *s.node_index_info);
+}
+
+KernelRunner::~KernelRunner() = default;
+
+Status KernelRunner::Run(concurrency::ThreadPool* thread_pool) {
+  OpKernelContext context(impl_->frame.get(), impl_->kernel.get(), thread_pool, impl_->logger);
+  return impl_->kernel->Compute(&context);
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
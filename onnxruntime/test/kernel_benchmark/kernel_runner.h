@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/status.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+// Description of a single node to benchmark: the op, its attributes and the type, shape and data of every input.
+// Inputs are either fed at run time or passed to the kernel as constant initializers, which lets kernels such as
+// Conv, Gemm and MatMul pre-pack their weights the way they do in a session.
+struct OpSpec {
+  struct InputSpec {
+    bool exists{true};
+    bool is_constant{false};
+    ONNX_NAMESPACE::TensorProto value;
+  };
+
+  OpSpec(std::string op_type, int opset, std::string domain = "")
+      : op_type(std::move(op_type)), domain(std::move(domain)), opset(opset) {}
+
+  // Input filled with uniform random values in [low, high]. Integer types round the values down.
+  OpSpec& Input(ONNX_NAMESPACE::TensorProto_DataType type, const std::vector<int64_t>& shape,
+                double low = -1.0, double high = 1.0);
+  // Input fed with the given value, e.g. a shape computed by another node.
+  OpSpec& Input(const ONNX_NAMESPACE::TensorProto& value);
+  // Constant input filled with uniform random values in [low, high], e.g. weights.
+  OpSpec& Constant(ONNX_NAMESPACE::TensorProto_DataType type, const std::vector<int64_t>& shape,
+                   double low = -1.0, double high = 1.0);
+  // 1-D constant input with the given values, e.g. shapes, axes or indices.
+  OpSpec& Constant(const std::vector<int64_t>& values);
+  OpSpec& Constant(const std::vector<float>& values);
+  // Constant input with the given value, e.g. an initializer of a model.
+  OpSpec& Constant(const ONNX_NAMESPACE::TensorProto& value);
+  // Omitted optional input.
+  OpSpec& Missing();
+
+  OpSpec& Attr(const ONNX_NAMESPACE::AttributeProto& attribute);
+  OpSpec& Outputs(size_t count);
+
+  std::string op_type;
+  std::string domain;
+  int opset;
+  std::vector<ONNX_NAMESPACE::AttributeProto> attributes;
+  std::vector<InputSpec> inputs;
+  size_t num_outputs{1};
+};
+
+// Creates the CPU kernel registered for a single node and runs it through OpKernelContext, without a session,
+// so that the measured time is the time spent in OpKernel::Compute.
+// Constant inputs are pre-packed by the kernel before the first run, and the outputs are allocated by the first run
+// and reused by later runs, like a session with memory patterns does.
+class KernelRunner {
+ public:
+  // Throws if the node is invalid or no CPU kernel is registered for it.
+  KernelRunner(const OpSpec& spec, const logging::Logger& logger);
+  ~KernelRunner();
+
+  // Runs the kernel once with the given intra op thread pool, which may be nullptr to run sequentially.
+  Status Run(concurrency::ThreadPool* thread_pool);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRunner);
+};
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
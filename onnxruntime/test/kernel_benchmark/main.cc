@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of the CPU kernels, run directly through OpKernelContext without a session.
+//
+// Usage: onnxruntime_kernel_benchmark [--model=<model.onnx> | --capture=<capture.json>]
+//                                     [--intra_op_threads=<n>[,<n>...]] [benchmark flags]
+//   --model             benchmark every node of the model with its shapes and initializers instead of the
+//                       built-in operator benchmarks
+//   --capture           replay the nodes recorded with the session config "session.node_capture_file" instead of the
+//                       built-in operator benchmarks
+//   --intra_op_threads  thread counts to sweep. Default: 1, then powers of 2 up to the number of cores.
+// Use --benchmark_filter to select benchmarks, e.g. --benchmark_filter=Conv/ or --benchmark_filter=Mlas.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include "core/common/logging/logging.h"
+#include "core/common/make_unique.h"
+#include "core/platform/env.h"
+#include "core/session/onnxruntime_cxx_api.h"
+#include "core/util/thread_utils.h"
+#include "test/kernel_benchmark/kernel_benchmark.h"
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+static std::vector<int>& MutableThreadCounts() {
+  static std::vector<int> thread_counts = []() {
+    std::vector<int> counts;
+    const int num_cores = std::max(1, Env::Default().GetNumCpuCores());
+    for (int n = 1; n < num_cores; n *= 2) {
+      counts.push_back(n);
+    }
+    counts.push_back(num_cores);
+    return counts;
+  }();
+  return thread_counts;
+}
+
+const std::vector<int>& ThreadCounts() {
+  return MutableThreadCounts();
+}
+
+void SetThreadCounts(std::vector<int> thread_counts) {
+  MutableThreadCounts() = std::move(thread_counts);
+}
+
+concurrency::ThreadPool* GetThreadPool(int num_threads) {
+  static std::map<int, std::unique_ptr<concurrency::ThreadPool>> thread_pools;
+  auto it = thread_pools.find(num_threads);
+  if (it == thread_pools.end()) {
+    OrtThreadPoolParams params;
+    params.thread_pool_size = num_threads;
+    it = thread_pools.emplace(num_threads, concurrency::CreateThreadPool(&Env::Default(), params,
+                                                                         concurrency::ThreadPoolType::INTRA_OP))
+             .first;
+  }
+  return it->second.get();
+}
+
+void RegisterOpBenchmark(const std::string& name, const OpSpec& spec) {
+  auto shared_spec = std::make_shared<const OpSpec>(spec);
+  for (int num_threads : ThreadCounts()) {
+    auto run = [shared_spec, num_threads](benchmark::State& state) {
+      std::unique_ptr<KernelRunner> runner;
+      Status status;
+      ORT_TRY {
+        runner = onnxruntime::make_unique<KernelRunner>(*shared_spec, logging::LoggingManager::DefaultLogger());
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+        });
+      }
+      concurrency::ThreadPool* thread_pool = GetThreadPool(num_threads);
+      if (status.IsOK()) {
+        // the first run allocates the outputs, keep it out of the measurement
+        status = runner->Run(thread_pool);
+      }
+      if (!status.IsOK()) {
+        state.SkipWithError(status.ErrorMessage().c_str());
+        return;
+      }
+
+      for (auto _ : state) {
+        status = runner->Run(thread_pool);
+        if (!status.IsOK()) {
+          state.SkipWithError(status.ErrorMessage().c_str());
+          break;
+        }
+      }
+    };
+    benchmark::RegisterBenchmark((name + "/intra_op_threads:" + std::to_string(num_threads)).c_str(), run)
+        ->UseRealTime()
+        ->Unit(benchmark::TimeUnit::kMicrosecond);
+  }
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
+
+static bool ParseThreadCounts(const char* value, std::vector<int>& thread_counts) {
+  std::istringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    const int n = std::atoi(item.c_str());
+    if (n <= 0) {
+      return false;
+    }
+    thread_counts.push_back(n);
+  }
+  return !thread_counts.empty();
+}
+
+int main(int argc, char** argv) {
+  using namespace onnxruntime::kernel_benchmark;
+
+  // take our own flags out of argv before the benchmark library sees them
+  std::string model_path;
+  std::string capture_path;
+  int remaining_argc = 1;
+  for (int i = 1; i < argc; ++i) {
+    static const char kModelFlag[] = "--model=";
+    static const char kCaptureFlag[] = "--capture=";
+    static const char kThreadsFlag[] = "--intra_op_threads=";
+    if (std::strncmp(argv[i], kModelFlag, sizeof(kModelFlag) - 1) == 0) {
+      model_path = argv[i] + sizeof(kModelFlag) - 1;
+    } else if (std::strncmp(argv[i], kCaptureFlag, sizeof(kCaptureFlag) - 1) == 0) {
+      capture_path = argv[i] + sizeof(kCaptureFlag) - 1;
+    } else if (std::strncmp(argv[i], kThreadsFlag, sizeof(kThreadsFlag) - 1) == 0) {
+      std::vector<int> thread_counts;
+      if (!ParseThreadCounts(argv[i] + sizeof(kThreadsFlag) - 1, thread_counts)) {
+        std::cerr << "invalid value of --intra_op_threads: " << argv[i] << std::endl;
+        return -1;
+      }
+      SetThreadCounts(std::move(thread_counts));
+    } else {
+      argv[remaining_argc++] = argv[i];
+    }
+  }
+  argc = remaining_argc;
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return -1;
+
+  // creates the default logger and registers the contrib op schemas
+  Ort::Env env(ORT_LOGGING_LEVEL_ERROR, "kernel_benchmark");
+
+  if (!capture_path.empty()) {
+    auto status = RegisterCaptureBenchmarks(capture_path);
+    if (!status.IsOK()) {
+      std::cerr << "failed to load " << capture_path << ": " << status.ErrorMessage() << std::endl;
+      return -1;
+    }
+  } else if (model_path.empty()) {
+    RegisterOpBenchmarks();
+    RegisterMlasBenchmarks();
+  } else {
+    auto status = RegisterModelBenchmarks(onnxruntime::ToWideString(model_path));
+    if (!status.IsOK()) {
+      std::cerr << "failed to load " << model_path << ": " << status.ErrorMessage() << std::endl;
+      return -1;
+    }
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
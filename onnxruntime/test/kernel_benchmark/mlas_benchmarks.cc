@@ -0,0 +1,238 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/kernel_benchmark/kernel_benchmark.h"
+
+#include <random>
+#include <tuple>
+
+#include <benchmark/benchmark.h>
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+namespace {
+
+template <typename T>
+std::vector<T> RandomBuffer(size_t count, float low, float high) {
+  static std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(low, high);
+  std::vector<T> buffer(count);
+  for (auto& v : buffer) {
+    v = static_cast<T>(distribution(generator));
+  }
+  return buffer;
+}
+
+// Registers fn(state, thread_pool) for each of ThreadCounts().
+template <typename Fn>
+void RegisterMlasBenchmark(const std::string& name, Fn fn) {
+  for (int num_threads : ThreadCounts()) {
+    benchmark::RegisterBenchmark((name + "/intra_op_threads:" + std::to_string(num_threads)).c_str(),
+                                 [fn, num_threads](benchmark::State& state) { fn(state, GetThreadPool(num_threads)); })
+        ->UseRealTime()
+        ->Unit(benchmark::TimeUnit::kMicrosecond);
+  }
+}
+
+struct GemmShape {
+  const char* name;
+  size_t M;
+  size_t N;
+  size_t K;
+};
+
+// BERT-base projections and FFN, the ResNet-50 classifier and 3x3 convolutions as im2col GEMMs.
+const GemmShape kGemmShapes[] = {
+    {"bert_qkv", 128, 768, 768},
+    {"bert_ffn", 128, 3072, 768},
+    {"resnet50_fc", 1, 1000, 2048},
+    {"resnet50_3x3_im2col", 64, 3136, 576},
+    {"square_1024", 1024, 1024, 1024},
+};
+
+void RegisterSgemmBenchmarks() {
+  for (const auto& shape : kGemmShapes) {
+    RegisterMlasBenchmark(std::string("MlasSgemm/") + shape.name,
+                          [shape](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+                            auto A = RandomBuffer<float>(shape.M * shape.K, -1.0f, 1.0f);
+                            auto B = RandomBuffer<float>(shape.K * shape.N, -1.0f, 1.0f);
+                            std::vector<float> C(shape.M * shape.N);
+                            for (auto _ : state) {
+                              MlasGemm(CblasNoTrans, CblasNoTrans, shape.M, shape.N, shape.K, 1.0f, A.data(),
+                                       shape.K, B.data(), shape.N, 0.0f, C.data(), shape.N, thread_pool);
+                            }
+                          });
+    RegisterMlasBenchmark(std::string("MlasSgemmPackedB/") + shape.name,
+                          [shape](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+                            auto A = RandomBuffer<float>(shape.M * shape.K, -1.0f, 1.0f);
+                            auto B = RandomBuffer<float>(shape.K * shape.N, -1.0f, 1.0f);
+                            // aligned like the packed weights of the Gemm and MatMul kernels
+                            AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+                            BufferUniquePtr packed_B(allocator->Alloc(MlasGemmPackBSize(shape.N, shape.K)),
+                                                     BufferDeleter(allocator));
+                            MlasGemmPackB(CblasNoTrans, shape.N, shape.K, B.data(), shape.N, packed_B.get());
+                            std::vector<float> C(shape.M * shape.N);
+                            for (auto _ : state) {
+                              MlasGemm(CblasNoTrans, shape.M, shape.N, shape.K, 1.0f, A.data(), shape.K,
+                                       packed_B.get(), 0.0f, C.data(), shape.N, thread_pool);
+                            }
+                          });
+  }
+}
+
+void RegisterQgemmBenchmarks() {
+  for (const auto& shape : kGemmShapes) {
+    for (bool b_is_signed : {false, true}) {
+      RegisterMlasBenchmark(std::string(b_is_signed ? "MlasQgemmU8S8/" : "MlasQgemmU8U8/") + shape.name,
+                            [shape, b_is_signed](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+                              auto A = RandomBuffer<uint8_t>(shape.M * shape.K, 0.0f, 255.0f);
+                              auto B = b_is_signed ? RandomBuffer<uint8_t>(shape.K * shape.N, 0.0f, 127.0f)
+                                                   : RandomBuffer<uint8_t>(shape.K * shape.N, 0.0f, 255.0f);
+                              std::vector<int32_t> C(shape.M * shape.N);
+                              const uint8_t offb = b_is_signed ? 0 : 128;
+                              for (auto _ : state) {
+                                MlasGemm(shape.M, shape.N, shape.K, A.data(), shape.K, 128, B.data(), shape.N, offb,
+                                         b_is_signed, C.data(), shape.N, thread_pool);
+                              }
+                            });
+    }
+  }
+}
+
+struct ConvShape {
+  const char* name;
+  int64_t channels;
+  int64_t height;
+  int64_t width;
+  int64_t filters;
+  int64_t group;
+  int64_t kernel;
+  int64_t stride;
+  int64_t pad;
+};
+
+const ConvShape kConvShapes[] = {
+    {"resnet50_conv1", 3, 224, 224, 64, 1, 7, 2, 3},
+    {"resnet50_3x3", 64, 56, 56, 64, 1, 3, 1, 1},
+    {"resnet50_1x1", 256, 56, 56, 64, 1, 1, 1, 0},
+    {"mobilenetv2_depthwise", 144, 56, 56, 144, 144, 3, 1, 1},
+};
+
+void RegisterConvBenchmarks() {
+  for (const auto& shape : kConvShapes) {
+    RegisterMlasBenchmark(std::string("MlasConv/") + shape.name,
+                          [shape](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+                            const int64_t out_height = (shape.height + 2 * shape.pad - shape.kernel) / shape.stride + 1;
+                            const int64_t out_width = (shape.width + 2 * shape.pad - shape.kernel) / shape.stride + 1;
+                            const int64_t input_shape[] = {shape.height, shape.width};
+                            const int64_t kernel_shape[] = {shape.kernel, shape.kernel};
+                            const int64_t dilation_shape[] = {1, 1};
+                            const int64_t padding[] = {shape.pad, shape.pad, shape.pad, shape.pad};
+                            const int64_t stride_shape[] = {shape.stride, shape.stride};
+                            const int64_t output_shape[] = {out_height, out_width};
+
+                            MLAS_ACTIVATION activation;
+                            activation.ActivationKind = MlasIdentityActivation;
+                            MLAS_CONV_PARAMETERS parameters;
+                            size_t working_buffer_size = 0;
+                            MlasConvPrepare(&parameters, 2, 1, static_cast<size_t>(shape.group),
+                                            static_cast<size_t>(shape.channels / shape.group), input_shape,
+                                            kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                                            static_cast<size_t>(shape.filters / shape.group), &activation,
+                                            &working_buffer_size, thread_pool);
+
+                            auto input = RandomBuffer<float>(static_cast<size_t>(shape.channels * shape.height *
+                                                                                 shape.width),
+                                                             -1.0f, 1.0f);
+                            auto filter = RandomBuffer<float>(static_cast<size_t>(shape.filters *
+                                                                                  (shape.channels / shape.group) *
+                                                                                  shape.kernel * shape.kernel),
+                                                              -1.0f, 1.0f);
+                            auto bias = RandomBuffer<float>(static_cast<size_t>(shape.filters), -1.0f, 1.0f);
+                            std::vector<float> working_buffer(working_buffer_size);
+                            std::vector<float> output(static_cast<size_t>(shape.filters * out_height * out_width));
+                            for (auto _ : state) {
+                              MlasConv(&parameters, input.data(), filter.data(), bias.data(), working_buffer.data(),
+                                       output.data(), thread_pool);
+                            }
+                          });
+  }
+}
+
+void RegisterPoolBenchmarks() {
+  const std::pair<const char*, MLAS_POOLING_KIND> kinds[] = {
+      {"MlasMaxPool/resnet50", MlasMaximumPooling},
+      {"MlasAveragePool/resnet50", MlasAveragePoolingExcludePad},
+  };
+  for (const auto& kind : kinds) {
+    const MLAS_POOLING_KIND pooling_kind = kind.second;
+    RegisterMlasBenchmark(kind.first, [pooling_kind](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+      const int64_t input_shape[] = {1, 64, 112, 112};
+      const int64_t kernel_shape[] = {3, 3};
+      const int64_t padding[] = {1, 1, 1, 1};
+      const int64_t stride_shape[] = {2, 2};
+      const int64_t output_shape[] = {1, 64, 56, 56};
+      auto input = RandomBuffer<float>(64 * 112 * 112, -1.0f, 1.0f);
+      std::vector<float> output(64 * 56 * 56);
+      for (auto _ : state) {
+        MlasPool(pooling_kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape, input.data(),
+                 output.data(), thread_pool);
+      }
+    });
+  }
+}
+
+void RegisterSoftmaxBenchmarks() {
+  const std::tuple<const char*, size_t, size_t> shapes[] = {
+      std::make_tuple("MlasSoftmax/bert_attention", 12 * 128, 128),
+      std::make_tuple("MlasSoftmax/lm_head", 8, 32000),
+  };
+  for (const auto& shape : shapes) {
+    const size_t N = std::get<1>(shape);
+    const size_t D = std::get<2>(shape);
+    RegisterMlasBenchmark(std::get<0>(shape), [N, D](benchmark::State& state, concurrency::ThreadPool* thread_pool) {
+      auto input = RandomBuffer<float>(N * D, -5.0f, 5.0f);
+      std::vector<float> output(N * D);
+      for (auto _ : state) {
+        MlasComputeSoftmax(input.data(), output.data(), N, D, false, thread_pool);
+      }
+    });
+  }
+}
+
+// MlasTranspose is single threaded.
+void RegisterTransposeBenchmarks() {
+  benchmark::RegisterBenchmark("MlasTranspose/float_768x3072", [](benchmark::State& state) {
+    auto input = RandomBuffer<uint32_t>(768 * 3072, 0.0f, 1000.0f);
+    std::vector<uint32_t> output(input.size());
+    for (auto _ : state) {
+      MlasTranspose(input.data(), output.data(), 768, 3072);
+    }
+  })->Unit(benchmark::TimeUnit::kMicrosecond);
+  benchmark::RegisterBenchmark("MlasTranspose/uint8_768x3072", [](benchmark::State& state) {
+    auto input = RandomBuffer<uint8_t>(768 * 3072, 0.0f, 255.0f);
+    std::vector<uint8_t> output(input.size());
+    for (auto _ : state) {
+      MlasTranspose(input.data(), output.data(), 768, 3072);
+    }
+  })->Unit(benchmark::TimeUnit::kMicrosecond);
+}
+
+}  // namespace
+
+void RegisterMlasBenchmarks() {
+  RegisterSgemmBenchmarks();
+  RegisterQgemmBenchmarks();
+  RegisterConvBenchmarks();
+  RegisterPoolBenchmarks();
+  RegisterSoftmaxBenchmarks();
+  RegisterTransposeBenchmarks();
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
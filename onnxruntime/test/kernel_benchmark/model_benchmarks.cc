@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/kernel_benchmark/kernel_benchmark.h"
+
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/common/logging/logging.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+namespace {
+
+// Fixes the symbolic and unknown dims of the model inputs to 1 so that the shapes of all the nodes can be inferred.
+void FixInputDims(GraphProto& graph) {
+  std::unordered_set<std::string> initializers;
+  for (const auto& initializer : graph.initializer()) {
+    initializers.insert(initializer.name());
+  }
+  for (auto& input : *graph.mutable_input()) {
+    if (initializers.count(input.name()) != 0 || !input.type().has_tensor_type() ||
+        !input.type().tensor_type().has_shape()) {
+      continue;
+    }
+    for (auto& dim : *input.mutable_type()->mutable_tensor_type()->mutable_shape()->mutable_dim()) {
+      if (!dim.has_dim_value()) {
+        dim.set_dim_value(1);
+      }
+    }
+  }
+}
+
+// Builds the spec of the node. Returns false if the shape or type of an input is not known.
+bool CreateOpSpec(const Graph& graph, const Node& node, OpSpec& spec) {
+  for (const auto& attribute : node.GetAttributes()) {
+    spec.Attr(attribute.second);
+  }
+
+  for (const auto* input : node.InputDefs()) {
+    if (!input->Exists()) {
+      spec.Missing();
+      continue;
+    }
+
+    const TensorProto* initializer = nullptr;
+    if (graph.GetInitializedTensor(input->Name(), initializer)) {
+      spec.Constant(*initializer);
+      continue;
+    }
+
+    const auto* type = input->TypeAsProto();
+    const auto* shape = input->Shape();
+    if (type == nullptr || !type->has_tensor_type() || shape == nullptr) {
+      return false;
+    }
+    std::vector<int64_t> dims;
+    for (const auto& dim : shape->dim()) {
+      if (!dim.has_dim_value()) {
+        return false;
+      }
+      dims.push_back(dim.dim_value());
+    }
+
+    const auto elem_type = static_cast<TensorProto_DataType>(type->tensor_type().elem_type());
+    if (elem_type == TensorProto_DataType_FLOAT || elem_type == TensorProto_DataType_DOUBLE ||
+        elem_type == TensorProto_DataType_FLOAT16) {
+      spec.Input(elem_type, dims);
+    } else {
+      // integer inputs that are computed by other nodes are usually indices or shapes. 0 is valid for most.
+      spec.Input(elem_type, dims, 0.0, 1.0);
+    }
+  }
+
+  spec.Outputs(node.OutputDefs().size());
+  return true;
+}
+
+// Identical nodes, e.g. in the repeated layers of a transformer, are benchmarked once.
+std::string GetSpecKey(const OpSpec& spec) {
+  std::ostringstream key;
+  key << spec.domain << ':' << spec.op_type << ':' << spec.opset;
+  for (const auto& attribute : spec.attributes) {
+    key << '|' << attribute.SerializeAsString();
+  }
+  for (const auto& input : spec.inputs) {
+    key << '|' << input.exists << input.is_constant << ':' << input.value.data_type();
+    for (auto dim : input.value.dims()) {
+      key << ',' << dim;
+    }
+  }
+  return key.str();
+}
+
+}  // namespace
+
+Status RegisterModelBenchmarks(const PathString& model_path) {
+  ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(Model::Load(model_path, model_proto));
+  FixInputDims(*model_proto.mutable_graph());
+
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+  Model model(model_proto, model_path, nullptr, logger);
+  Graph& graph = model.MainGraph();
+  ORT_RETURN_IF_ERROR(graph.Resolve());
+
+  struct NodeBenchmark {
+    std::string name;
+    OpSpec spec;
+    size_t count;
+  };
+  std::vector<NodeBenchmark> benchmarks;
+  std::unordered_map<std::string, size_t> benchmark_index;
+  size_t skipped = 0;
+
+  GraphViewer graph_viewer(graph);
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node* node = graph.GetNode(node_index);
+    const auto version = domain_to_version.find(node->Domain());
+    OpSpec spec(node->OpType(), version != domain_to_version.end() ? version->second : 1, node->Domain());
+    if (node->ContainsSubgraph() || !CreateOpSpec(graph, *node, spec)) {
+      ++skipped;
+      continue;
+    }
+
+    const std::string key = GetSpecKey(spec);
+    auto it = benchmark_index.find(key);
+    if (it != benchmark_index.end()) {
+      ++benchmarks[it->second].count;
+      continue;
+    }
+    benchmark_index.emplace(key, benchmarks.size());
+    const std::string node_name = node->Name().empty() ? std::to_string(node_index) : node->Name();
+    benchmarks.push_back({node->OpType() + "/" + node_name, std::move(spec), 1});
+  }
+
+  for (const auto& entry : benchmarks) {
+    // the number of nodes the benchmark stands for, to weigh its time in the model
+    RegisterOpBenchmark(entry.name + "/nodes:" + std::to_string(entry.count), entry.spec);
+  }
+  if (skipped != 0) {
+    std::cerr << skipped << " nodes with subgraphs or inputs of unknown shape are not benchmarked" << std::endl;
+  }
+  return Status::OK();
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
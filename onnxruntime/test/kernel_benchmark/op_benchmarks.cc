@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/kernel_benchmark/kernel_benchmark.h"
+
+#include <onnx/defs/attr_proto_util.h>
+
+#include "core/graph/constants.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace kernel_benchmark {
+
+namespace {
+
+constexpr auto kFloat = TensorProto_DataType_FLOAT;
+constexpr auto kBool = TensorProto_DataType_BOOL;
+constexpr auto kUInt8 = TensorProto_DataType_UINT8;
+constexpr auto kInt32 = TensorProto_DataType_INT32;
+constexpr auto kInt64 = TensorProto_DataType_INT64;
+
+AttributeProto Int(const std::string& name, int64_t value) {
+  return MakeAttribute(name, value);
+}
+
+AttributeProto Ints(const std::string& name, const std::vector<int64_t>& values) {
+  return MakeAttribute(name, values);
+}
+
+AttributeProto Float(const std::string& name, float value) {
+  return MakeAttribute(name, value);
+}
+
+AttributeProto String(const std::string& name, const std::string& value) {
+  return MakeAttribute(name, value);
+}
+
+TensorProto ScalarFloat(float value) {
+  TensorProto tensor;
+  tensor.set_data_type(kFloat);
+  tensor.add_float_data(value);
+  return tensor;
+}
+
+TensorProto ScalarUInt8(uint8_t value) {
+  TensorProto tensor;
+  tensor.set_data_type(kUInt8);
+  tensor.add_int32_data(value);
+  return tensor;
+}
+
+TensorProto ScalarInt64(int64_t value) {
+  TensorProto tensor;
+  tensor.set_data_type(kInt64);
+  tensor.add_int64_data(value);
+  return tensor;
+}
+
+// Shapes are taken from ResNet-50, MobileNetV2, BERT-base (sequence length 128), YOLOv3, SSD and
+// a speech LSTM, all with batch size 1.
+void RegisterConvBenchmarks() {
+  RegisterOpBenchmark("Conv/resnet50_conv1", OpSpec("Conv", 11)
+                                                 .Input(kFloat, {1, 3, 224, 224})
+                                                 .Constant(kFloat, {64, 3, 7, 7})
+                                                 .Constant(kFloat, {64})
+                                                 .Attr(Ints("strides", {2, 2}))
+                                                 .Attr(Ints("pads", {3, 3, 3, 3})));
+  RegisterOpBenchmark("Conv/resnet50_3x3", OpSpec("Conv", 11)
+                                               .Input(kFloat, {1, 64, 56, 56})
+                                               .Constant(kFloat, {64, 64, 3, 3})
+                                               .Constant(kFloat, {64})
+                                               .Attr(Ints("pads", {1, 1, 1, 1})));
+  RegisterOpBenchmark("Conv/resnet50_1x1", OpSpec("Conv", 11)
+                                               .Input(kFloat, {1, 256, 56, 56})
+                                               .Constant(kFloat, {64, 256, 1, 1})
+                                               .Constant(kFloat, {64}));
+  RegisterOpBenchmark("Conv/mobilenetv2_depthwise", OpSpec("Conv", 11)
+                                                        .Input(kFloat, {1, 144, 56, 56})
+                                                        .Constant(kFloat, {144, 1, 3, 3})
+                                                        .Constant(kFloat, {144})
+                                                        .Attr(Int("group", 144))
+                                                        .Attr(Ints("pads", {1, 1, 1, 1})));
+  RegisterOpBenchmark("ConvTranspose/unet_upsample", OpSpec("ConvTranspose", 11)
+                                                         .Input(kFloat, {1, 256, 32, 32})
+                                                         .Constant(kFloat, {256, 128, 2, 2})
+                                                         .Attr(Ints("strides", {2, 2})));
+  RegisterOpBenchmark("QLinearConv/resnet50_3x3", OpSpec("QLinearConv", 11)
+                                                      .Input(kUInt8, {1, 64, 56, 56}, 0, 256)
+                                                      .Constant(ScalarFloat(0.02f))
+                                                      .Constant(ScalarUInt8(128))
+                                                      .Constant(kUInt8, {64, 64, 3, 3}, 0, 256)
+                                                      .Constant(ScalarFloat(0.01f))
+                                                      .Constant(ScalarUInt8(128))
+                                                      .Constant(ScalarFloat(0.05f))
+                                                      .Constant(ScalarUInt8(128))
+                                                      .Constant(kInt32, {64}, -1000, 1000)
+                                                      .Attr(Ints("pads", {1, 1, 1, 1})));
+}
+
+void RegisterGemmBenchmarks() {
+  RegisterOpBenchmark("MatMul/bert_qkv", OpSpec("MatMul", 13)
+                                             .Input(kFloat, {1, 128, 768})
+                                             .Constant(kFloat, {768, 768}));
+  RegisterOpBenchmark("MatMul/bert_ffn", OpSpec("MatMul", 13)
+                                             .Input(kFloat, {1, 128, 768})
+                                             .Constant(kFloat, {768, 3072}));
+  RegisterOpBenchmark("MatMul/bert_attention_scores", OpSpec("MatMul", 13)
+                                                          .Input(kFloat, {1, 12, 128, 64})
+                                                          .Input(kFloat, {1, 12, 64, 128}));
+  RegisterOpBenchmark("Gemm/resnet50_fc", OpSpec("Gemm", 11)
+                                              .Input(kFloat, {1, 2048})
+                                              .Constant(kFloat, {1000, 2048})
+                                              .Constant(kFloat, {1000})
+                                              .Attr(Int("transB", 1)));
+  RegisterOpBenchmark("MatMulInteger/bert_qkv", OpSpec("MatMulInteger", 10)
+                                                    .Input(kUInt8, {1, 128, 768}, 0, 256)
+                                                    .Constant(kUInt8, {768, 768}, 0, 256));
+  RegisterOpBenchmark("QLinearMatMul/bert_qkv", OpSpec("QLinearMatMul", 10)
+                                                    .Input(kUInt8, {1, 128, 768}, 0, 256)
+                                                    .Constant(ScalarFloat(0.02f))
+                                                    .Constant(ScalarUInt8(128))
+                                                    .Constant(kUInt8, {768, 768}, 0, 256)
+                                                    .Constant(ScalarFloat(0.01f))
+                                                    .Constant(ScalarUInt8(128))
+                                                    .Constant(ScalarFloat(0.05f))
+                                                    .Constant(ScalarUInt8(128)));
+  RegisterOpBenchmark("Einsum/bert_attention_scores", OpSpec("Einsum", 12)
+                                                          .Input(kFloat, {1, 12, 128, 64})
+                                                          .Input(kFloat, {1, 12, 128, 64})
+                                                          .Attr(String("equation", "bhid,bhjd->bhij")));
+  RegisterOpBenchmark("Attention/bert_base", OpSpec("Attention", 1, kMSDomain)
+                                                 .Input(kFloat, {1, 128, 768})
+                                                 .Constant(kFloat, {768, 2304})
+                                                 .Constant(kFloat, {2304})
+                                                 .Input(kInt32, {1, 128}, 1, 2)
+                                                 .Attr(Int("num_heads", 12)));
+  RegisterOpBenchmark("LSTM/speech", OpSpec("LSTM", 7)
+                                         .Input(kFloat, {32, 1, 256})
+                                         .Constant(kFloat, {1, 1024, 256})
+                                         .Constant(kFloat, {1, 1024, 256})
+                                         .Constant(kFloat, {1, 2048})
+                                         .Attr(Int("hidden_size", 256)));
+}
+
+void RegisterElementwiseBenchmarks() {
+  RegisterOpBenchmark("Add/bert_bias", OpSpec("Add", 13)
+                                           .Input(kFloat, {1, 128, 768})
+                                           .Constant(kFloat, {768}));
+  RegisterOpBenchmark("Add/resnet50_residual", OpSpec("Add", 13)
+                                                   .Input(kFloat, {1, 256, 56, 56})
+                                                   .Input(kFloat, {1, 256, 56, 56}));
+  RegisterOpBenchmark("Mul/bert_attention_scale", OpSpec("Mul", 13)
+                                                      .Input(kFloat, {1, 12, 128, 128})
+                                                      .Constant(ScalarFloat(0.125f)));
+  RegisterOpBenchmark("Sub/layernorm_decomposed", OpSpec("Sub", 13)
+                                                      .Input(kFloat, {1, 128, 768})
+                                                      .Input(kFloat, {1, 128, 1}));
+  RegisterOpBenchmark("Div/layernorm_decomposed", OpSpec("Div", 13)
+                                                      .Input(kFloat, {1, 128, 768})
+                                                      .Input(kFloat, {1, 128, 1}, 0.5, 1.5));
+  RegisterOpBenchmark("Pow/layernorm_decomposed", OpSpec("Pow", 12)
+                                                      .Input(kFloat, {1, 128, 768})
+                                                      .Constant(ScalarFloat(2.0f)));
+  RegisterOpBenchmark("Sqrt/bert", OpSpec("Sqrt", 13).Input(kFloat, {1, 128, 768}, 0.0, 2.0));
+  RegisterOpBenchmark("Exp/bert_softmax", OpSpec("Exp", 13).Input(kFloat, {1, 12, 128, 128}));
+  RegisterOpBenchmark("Erf/bert_gelu", OpSpec("Erf", 13).Input(kFloat, {1, 128, 3072}));
+  RegisterOpBenchmark("Relu/resnet50", OpSpec("Relu", 13).Input(kFloat, {1, 64, 112, 112}));
+  RegisterOpBenchmark("Sigmoid/yolov3", OpSpec("Sigmoid", 13).Input(kFloat, {1, 255, 52, 52}));
+  RegisterOpBenchmark("Tanh/lstm", OpSpec("Tanh", 13).Input(kFloat, {1, 128, 3072}));
+  RegisterOpBenchmark("LeakyRelu/yolov3", OpSpec("LeakyRelu", 6)
+                                              .Input(kFloat, {1, 128, 52, 52})
+                                              .Attr(Float("alpha", 0.1f)));
+  RegisterOpBenchmark("Clip/mobilenetv2_relu6", OpSpec("Clip", 12)
+                                                    .Input(kFloat, {1, 144, 56, 56}, -3.0, 9.0)
+                                                    .Constant(ScalarFloat(0.0f))
+                                                    .Constant(ScalarFloat(6.0f)));
+  RegisterOpBenchmark("Gelu/bert", OpSpec("Gelu", 1, kMSDomain).Input(kFloat, {1, 128, 3072}));
+  RegisterOpBenchmark("Where/bert_mask", OpSpec("Where", 9)
+                                             .Input(kBool, {1, 12, 128, 128}, 0, 1)
+                                             .Input(kFloat, {1, 12, 128, 128})
+                                             .Constant(ScalarFloat(-10000.0f)));
+  RegisterOpBenchmark("Cast/float_to_float16", OpSpec("Cast", 13)
+                                                   .Input(kFloat, {1, 128, 768})
+                                                   .Attr(Int("to", TensorProto_DataType_FLOAT16)));
+  RegisterOpBenchmark("Cast/int64_to_float", OpSpec("Cast", 13)
+                                                 .Input(kInt64, {1, 128, 768}, 0, 100)
+                                                 .Attr(Int("to", kFloat)));
+  RegisterOpBenchmark("QuantizeLinear/bert", OpSpec("QuantizeLinear", 10)
+                                                 .Input(kFloat, {1, 128, 768})
+                                                 .Constant(ScalarFloat(0.02f))
+                                                 .Constant(ScalarUInt8(128)));
+  RegisterOpBenchmark("DequantizeLinear/bert", OpSpec("DequantizeLinear", 10)
+                                                   .Input(kUInt8, {1, 128, 768}, 0, 256)
+                                                   .Constant(ScalarFloat(0.02f))
+                                                   .Constant(ScalarUInt8(128)));
+  RegisterOpBenchmark("DynamicQuantizeLinear/bert", OpSpec("DynamicQuantizeLinear", 11)
+                                                        .Input(kFloat, {1, 128, 768})
+                                                        .Outputs(3));
+}
+
+void RegisterNormalizationBenchmarks() {
+  RegisterOpBenchmark("BatchNormalization/resnet50", OpSpec("BatchNormalization", 9)
+                                                         .Input(kFloat, {1, 64, 112, 112})
+                                                         .Constant(kFloat, {64})
+                                                         .Constant(kFloat, {64})
+                                                         .Constant(kFloat, {64})
+                                                         .Constant(kFloat, {64}, 0.5, 1.5));
+  RegisterOpBenchmark("InstanceNormalization/style_transfer", OpSpec("InstanceNormalization", 6)
+                                                                  .Input(kFloat, {1, 64, 128, 128})
+                                                                  .Constant(kFloat, {64})
+                                                                  .Constant(kFloat, {64}));
+  RegisterOpBenchmark("LayerNormalization/bert", OpSpec("LayerNormalization", 1)
+                                                     .Input(kFloat, {1, 128, 768})
+                                                     .Constant(kFloat, {768})
+                                                     .Constant(kFloat, {768})
+                                                     .Attr(Int("axis", -1)));
+  RegisterOpBenchmark("SkipLayerNormalization/bert", OpSpec("SkipLayerNormalization", 1, kMSDomain)
+                                                         .Input(kFloat, {1, 128, 768})
+                                                         .Input(kFloat, {1, 128, 768})
+                                                         .Constant(kFloat, {768})
+                                                         .Constant(kFloat, {768})
+                                                         .Constant(kFloat, {768}));
+  RegisterOpBenchmark("LRN/alexnet", OpSpec("LRN", 1)
+                                         .Input(kFloat, {1, 96, 55, 55})
+                                         .Attr(Int("size", 5)));
+  RegisterOpBenchmark("Softmax/bert_attention", OpSpec("Softmax", 11)
+                                                    .Input(kFloat, {1, 12, 128, 128})
+                                                    .Attr(Int("axis", 3)));
+  RegisterOpBenchmark("LogSoftmax/lm_head", OpSpec("LogSoftmax", 11)
+                                                .Input(kFloat, {8, 32000})
+                                                .Attr(Int("axis", 1)));
+}
+
+void RegisterPoolingAndReductionBenchmarks() {
+  RegisterOpBenchmark("MaxPool/resnet50", OpSpec("MaxPool", 12)
+                                              .Input(kFloat, {1, 64, 112, 112})
+                                              .Attr(Ints("kernel_shape", {3, 3}))
+                                              .Attr(Ints("strides", {2, 2}))
+                                              .Attr(Ints("pads", {1, 1, 1, 1})));
+  RegisterOpBenchmark("AveragePool/inceptionv3", OpSpec("AveragePool", 11)
+                                                     .Input(kFloat, {1, 192, 35, 35})
+                                                     .Attr(Ints("kernel_shape", {3, 3}))
+                                                     .Attr(Ints("pads", {1, 1, 1, 1})));
+  RegisterOpBenchmark("GlobalAveragePool/resnet50", OpSpec("GlobalAveragePool", 1).Input(kFloat, {1, 2048, 7, 7}));
+  RegisterOpBenchmark("ReduceMean/bert_layernorm", OpSpec("ReduceMean", 11)
+                                                       .Input(kFloat, {1, 128, 768})
+                                                       .Attr(Ints("axes", {-1})));
+  RegisterOpBenchmark("ReduceSum/channels", OpSpec("ReduceSum", 11)
+                                                .Input(kFloat, {1, 256, 56, 56})
+                                                .Attr(Ints("axes", {1})));
+  RegisterOpBenchmark("ReduceMax/bert_softmax", OpSpec("ReduceMax", 12)
+                                                    .Input(kFloat, {1, 12, 128, 128})
+                                                    .Attr(Ints("axes", {-1})));
+  RegisterOpBenchmark("ArgMax/classifier", OpSpec("ArgMax", 12)
+                                               .Input(kFloat, {32, 1000})
+                                               .Attr(Int("axis", 1)));
+  RegisterOpBenchmark("TopK/ssd", OpSpec("TopK", 11)
+                                      .Input(kFloat, {1, 19248})
+                                      .Constant(std::vector<int64_t>{200})
+                                      .Outputs(2));
+  RegisterOpBenchmark("NonMaxSuppression/ssd", OpSpec("NonMaxSuppression", 11)
+                                                   .Input(kFloat, {1, 1917, 4}, 0.0, 1.0)
+                                                   .Input(kFloat, {1, 91, 1917}, 0.0, 1.0)
+                                                   .Constant(ScalarInt64(100))
+                                                   .Constant(ScalarFloat(0.5f))
+                                                   .Constant(ScalarFloat(0.3f)));
+}
+
+void RegisterDataMovementBenchmarks() {
+  RegisterOpBenchmark("Transpose/bert_heads", OpSpec("Transpose", 13)
+                                                  .Input(kFloat, {1, 128, 12, 64})
+                                                  .Attr(Ints("perm", {0, 2, 1, 3})));
+  RegisterOpBenchmark("Transpose/nchw_to_nhwc", OpSpec("Transpose", 13)
+                                                    .Input(kFloat, {1, 64, 112, 112})
+                                                    .Attr(Ints("perm", {0, 2, 3, 1})));
+  RegisterOpBenchmark("Reshape/bert_heads", OpSpec("Reshape", 13)
+                                                .Input(kFloat, {1, 128, 768})
+                                                .Constant(std::vector<int64_t>{1, 128, 12, 64}));
+  RegisterOpBenchmark("Concat/densenet", OpSpec("Concat", 13)
+                                             .Input(kFloat, {1, 128, 28, 28})
+                                             .Input(kFloat, {1, 128, 28, 28})
+                                             .Input(kFloat, {1, 128, 28, 28})
+                                             .Attr(Int("axis", 1)));
+  RegisterOpBenchmark("Split/bert_qkv", OpSpec("Split", 11)
+                                            .Input(kFloat, {1, 128, 2304})
+                                            .Attr(Int("axis", 2))
+                                            .Attr(Ints("split", {768, 768, 768}))
+                                            .Outputs(3));
+  RegisterOpBenchmark("Slice/bert_qkv", OpSpec("Slice", 11)
+                                            .Input(kFloat, {1, 128, 2304})
+                                            .Constant(std::vector<int64_t>{768})
+                                            .Constant(std::vector<int64_t>{1536})
+                                            .Constant(std::vector<int64_t>{2}));
+  RegisterOpBenchmark("Gather/bert_embedding", OpSpec("Gather", 11)
+                                                   .Constant(kFloat, {30522, 768})
+                                                   .Input(kInt64, {1, 128}, 0, 30522));
+  RegisterOpBenchmark("Expand/bert_mask", OpSpec("Expand", 8)
+                                              .Input(kFloat, {1, 1, 1, 128})
+                                              .Constant(std::vector<int64_t>{1, 12, 128, 128}));
+  RegisterOpBenchmark("Tile/bert_heads", OpSpec("Tile", 6)
+                                             .Input(kFloat, {1, 128, 64})
+                                             .Constant(std::vector<int64_t>{12, 1, 1}));
+  RegisterOpBenchmark("Pad/resnet50_conv1", OpSpec("Pad", 11)
+                                                .Input(kFloat, {1, 3, 224, 224})
+                                                .Constant(std::vector<int64_t>{0, 0, 3, 3, 0, 0, 3, 3}));
+  RegisterOpBenchmark("Resize/yolov3_nearest", OpSpec("Resize", 11)
+                                                   .Input(kFloat, {1, 256, 13, 13})
+                                                   .Constant(std::vector<float>{})
+                                                   .Constant(std::vector<float>{1.0f, 1.0f, 2.0f, 2.0f})
+                                                   .Attr(String("mode", "nearest")));
+  RegisterOpBenchmark("Resize/fpn_linear", OpSpec("Resize", 11)
+                                               .Input(kFloat, {1, 64, 128, 128})
+                                               .Constant(std::vector<float>{})
+                                               .Constant(std::vector<float>{1.0f, 1.0f, 2.0f, 2.0f})
+                                               .Attr(String("mode", "linear")));
+}
+
+}  // namespace
+
+void RegisterOpBenchmarks() {
+  RegisterConvBenchmarks();
+  RegisterGemmBenchmarks();
+  RegisterElementwiseBenchmarks();
+  RegisterNormalizationBenchmarks();
+  RegisterPoolingAndReductionBenchmarks();
+  RegisterDataMovementBenchmarks();
+}
+
+}  // namespace kernel_benchmark
+}  // namespace onnxruntime
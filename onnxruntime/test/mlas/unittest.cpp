@@ -20,6 +20,7 @@ Abstract:
 #include <limits>
 #include <memory>
 #include <random>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -440,6 +441,11 @@ public:
         for (size_t b = 1; b < 16; b++) {
             Test(b, b, b, 1.0f, 0.0f);
         }
+        for (size_t b = 1; b <= 8; b++) {
+            Test(b, b + 3, 8, 0.5f, 1.0f);
+            Test(b + 5, b, 4, -1.0f, 0.25f);
+            Test(2, 32, b, 1.0f, -0.5f);
+        }
         for (size_t b = 16; b <= 256; b <<= 1) {
             Test(b, b, b, 1.0f, 0.0f);
         }
@@ -527,6 +533,445 @@ public:
     }
 };
 
+class MlasFgemmPackedHalfTest : public MlasTestBase
+{
+private:
+    static
+    unsigned short
+    FloatToHalf(
+        float Value
+        )
+    {
+        //
+        // The test values are small integers, which are exactly representable
+        // as half precision normal values.
+        //
+
+        uint32_t Bits;
+        memcpy(&Bits, &Value, sizeof(float));
+
+        if ((Bits & 0x7FFFFFFF) == 0) {
+            return (unsigned short)(Bits >> 16);
+        }
+
+        uint32_t Sign = (Bits >> 16) & 0x8000;
+        uint32_t Exponent = ((Bits >> 23) & 0xFF) - 127 + 15;
+        uint32_t Mantissa = (Bits >> 13) & 0x3FF;
+
+        return (unsigned short)(Sign | (Exponent << 10) | Mantissa);
+    }
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M);
+        const float* B = BufferB.GetBuffer(N * K);
+        unsigned short* BHalf = BufferBHalf.GetBuffer(N * K, true);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        for (size_t i = 0; i < N * K; i++) {
+            BHalf[i] = FloatToHalf(B[i]);
+        }
+
+        Test(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, BHalf, B, N, beta, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, BHalf, B, K, beta, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, BHalf, B, N, beta, C, CReference, N);
+        Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, BHalf, B, K, beta, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const unsigned short* BHalf,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        size_t PackedBSize = MlasGemmPackBHalfSize(N, K);
+        void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+        MlasGemmPackBHalf(TransB, N, K, BHalf, ldb, PackedB);
+        MlasGemmPackedBHalf(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, threadpool);
+
+        //
+        // The packed single precision path is the reference for the packed
+        // half precision path, as both use the same kernels and blocking.
+        //
+
+        PackedBSize = MlasGemmPackBSize(N, K);
+        PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+        MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+        MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, CReference, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<unsigned short> BufferBHalf;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 1.0f, 0.0f);
+            Test(b + 1, b + 3, b + 5, 0.5f, 1.0f);
+        }
+        for (size_t b = 256; b < 320; b += 32) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+
+        Test(1, 1000, 576, 1.0f, 0.0f);
+        Test(128, 768, 3072, 1.0f, 0.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const float multipliers[] = { 0.0f, -0.0f, 0.25f, -0.5f, 1.0f, -1.0f };
+
+        for (size_t a = 0; a < _countof(multipliers); a++) {
+            for (size_t b = 0; b < _countof(multipliers); b++) {
+                for (size_t M = 1; M < 64; M += 7) {
+                    for (size_t N = 1; N < 200; N += 13) {
+                        for (size_t K = 1; K < 600; K += 47) {
+                            Test(M, N, K, multipliers[a], multipliers[b]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+class MlasFgemmBatchTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M * BatchSize);
+        const float* B = BufferB.GetBuffer(N * K * BatchSize);
+        float* C = BufferC.GetBuffer(N * M * BatchSize);
+        float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+        Test(CblasNoTrans, CblasNoTrans, BatchSize, M, N, K, alpha, A, K, B, N, beta, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, BatchSize, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, BatchSize, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
+        Test(CblasTrans, CblasTrans, BatchSize, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        //
+        // Each matrix of the batch is computed with the non-batched routine
+        // for the reference. The strided form broadcasts matrix B and the
+        // pointer array form visits the matrices in reverse order.
+        //
+
+        std::fill_n(C, M * N * BatchSize, -0.5f);
+        std::fill_n(CReference, M * N * BatchSize, -0.5f);
+
+        MlasGemmBatch(TransA, TransB, M, N, K, alpha, A, lda, M * K, B, ldb, 0,
+            beta, C, ldc, M * N, BatchSize, threadpool);
+
+        for (size_t b = 0; b < BatchSize; b++) {
+            MlasGemm(TransA, TransB, M, N, K, alpha, A + M * K * b, lda, B, ldb,
+                beta, CReference + M * N * b, ldc, threadpool);
+        }
+
+        Check(TransA, TransB, BatchSize, M, N, K, alpha, beta, C, CReference);
+
+        std::fill_n(C, M * N * BatchSize, -0.5f);
+        std::fill_n(CReference, M * N * BatchSize, -0.5f);
+
+        std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+        for (size_t b = 0; b < BatchSize; b++) {
+            const size_t i = BatchSize - b - 1;
+            Data[b].A = A + M * K * i;
+            Data[b].lda = lda;
+            Data[b].B = B + N * K * i;
+            Data[b].ldb = ldb;
+            Data[b].C = C + M * N * i;
+            Data[b].ldc = ldc;
+        }
+
+        MlasGemmBatch(TransA, TransB, M, N, K, alpha, Data.data(), BatchSize, beta, threadpool);
+
+        for (size_t b = 0; b < BatchSize; b++) {
+            MlasGemm(TransA, TransB, M, N, K, alpha, A + M * K * b, lda, B + N * K * b, ldb,
+                beta, CReference + M * N * b, ldc, threadpool);
+        }
+
+        Check(TransA, TransB, BatchSize, M, N, K, alpha, beta, C, CReference);
+    }
+
+    void
+    Check(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta,
+        const float* C,
+        const float* CReference
+        )
+    {
+        for (size_t f = 0; f < M * N * BatchSize; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransA=%d, TransB=%d, BatchSize=%zd, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, BatchSize, M, N, K, alpha, beta, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t BatchSize = 1; BatchSize <= 12; BatchSize += 3) {
+            for (size_t b = 1; b < 16; b++) {
+                Test(BatchSize, b, b, b, 1.0f, 0.0f);
+            }
+            Test(BatchSize, 16, 48, 32, 0.5f, 1.0f);
+            Test(BatchSize, 67, 19, 33, 1.0f, 0.0f);
+            Test(BatchSize, 128, 128, 64, 0.125f, 0.0f);
+        }
+
+        Test(48, 7, 9, 5, 1.0f, 0.0f);
+        Test(3, 128, 768, 256, 1.0f, 0.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const float multipliers[] = { 0.0f, -0.0f, 0.25f, -0.5f, 1.0f, -1.0f };
+
+        for (size_t a = 0; a < _countof(multipliers); a++) {
+            for (size_t b = 0; b < _countof(multipliers); b++) {
+                for (size_t BatchSize = 1; BatchSize < 20; BatchSize += 6) {
+                    for (size_t M = 1; M < 64; M += 13) {
+                        for (size_t N = 1; N < 200; N += 29) {
+                            for (size_t K = 1; K < 300; K += 61) {
+                                Test(BatchSize, M, N, K, multipliers[a], multipliers[b]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+class MlasFgemmOutputProcessorTest : public MlasTestBase
+{
+private:
+    //
+    // Transforms each element in place and counts the number of times the
+    // element has been visited. The tiles passed to the processor are
+    // disjoint, so the counters do not need to be atomic.
+    //
+
+    class CountingOutputProcessor : public MLAS_SGEMM_OUTPUT_PROCESSOR
+    {
+    public:
+        CountingOutputProcessor(
+            float* C,
+            size_t ldc,
+            int* Counts
+            ) :
+            C_(C),
+            ldc_(ldc),
+            Counts_(Counts)
+        {
+        }
+
+        void
+        Process(
+            float* C,
+            size_t StartM,
+            size_t StartN,
+            size_t CountM,
+            size_t CountN,
+            size_t ldc
+            ) const override
+        {
+            for (size_t m = 0; m < CountM; m++) {
+                for (size_t n = 0; n < CountN; n++) {
+                    const size_t Offset = (StartM + m) * ldc_ + (StartN + n);
+                    if (C + m * ldc + n != C_ + Offset) {
+                        printf("tile address mismatch StartM=%zd, StartN=%zd!\n", StartM, StartN);
+                        return;
+                    }
+                    C[m * ldc + n] = C[m * ldc + n] * 2.0f + 1.0f;
+                    Counts_[Offset]++;
+                }
+            }
+        }
+
+    private:
+        float* C_;
+        size_t ldc_;
+        int* Counts_;
+    };
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M);
+        const float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        Test(CblasNoTrans, M, N, K, A, K, B, N, beta, C, CReference, false);
+        Test(CblasTrans, M, N, K, A, K, B, K, beta, C, CReference, false);
+        Test(CblasNoTrans, M, N, K, A, K, B, N, beta, C, CReference, true);
+        Test(CblasTrans, M, N, K, A, K, B, K, beta, C, CReference, true);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        bool Packed
+        )
+    {
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        std::vector<int> Counts(M * N, 0);
+        CountingOutputProcessor OutputProcessor(C, N, Counts.data());
+
+        if (Packed) {
+            size_t PackedBSize = MlasGemmPackBSize(N, K);
+            void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+            MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+            MlasGemm(CblasNoTrans, M, N, K, 1.0f, A, lda, PackedB, beta, C, N, threadpool, &OutputProcessor);
+        } else {
+            MlasGemm(CblasNoTrans, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, C, N, threadpool, &OutputProcessor);
+        }
+
+        MlasGemm(CblasNoTrans, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, CReference, N, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (Counts[f] != 1 || C[f] != CReference[f] * 2.0f + 1.0f) {
+                printf("mismatch TransB=%d, Packed=%d, M=%zd, N=%zd, K=%zd, beta=%f  visits=%d %f %f!\n", TransB, int(Packed), M, N, K, beta, Counts[f], C[f], CReference[f] * 2.0f + 1.0f);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 0.0f);
+        }
+        Test(1, 1024, 256, 1.0f);
+        Test(4, 512, 128, 1.0f);
+        Test(16, 48, 32, 0.0f);
+        Test(67, 19, 33, 1.0f);
+        Test(32, 1000, 300, 0.0f);
+        Test(128, 128, 64, 1.0f);
+    }
+};
+
 #ifdef MLAS_SUPPORTS_GEMM_U8X8
 
 template<bool Packed>
@@ -1236,6 +1681,9 @@ public:
             Test(1, 1, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
             Test(1, 1, 16, i, i, 32, i, 1, 0, 0, 0, 0, 1, 1, 1, 1);
             Test(1, 1, 16, i, i, 32, 1, i, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+            Test(2, 16, 1, i, i, 1, 3, 3, 0, 0, 1, 1, 1, 1, 2, 2);
+            Test(1, 32, 1, i, i, 1, 5, 5, 2, 2, 2, 2, 2, 2, 1, 1);
         }
     }
 
@@ -1257,6 +1705,24 @@ public:
             Test(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
         }
 
+        // Depthwise convolutions.
+        for (unsigned ih = 0; ih < _countof(is); ih++) {
+            for (unsigned iw = 0; iw < _countof(is); iw++) {
+                for (unsigned kh = 1; kh <= 5; kh += 2) {
+                    for (unsigned kw = 1; kw <= 5; kw += 2) {
+                        for (unsigned p = 0; p < 16; p++) {
+                            for (unsigned d = 0; d < 4; d++) {
+                                for (unsigned s = 0; s < 4; s++) {
+                                    Test(2, 3, 1, is[ih], is[iw], 1, kh, kw, p & 1, (p >> 1) & 1, (p >> 2) & 1,
+                                        (p >> 3) & 1, 1 + (d & 1), 1 + (d >> 1), 1 + (s & 1), 1 + (s >> 1));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         for (unsigned ic = 0; ic < _countof(cs); ic++) {
             for (unsigned ih = 0; ih < _countof(is); ih++) {
                 for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -1514,6 +1980,61 @@ public:
 
 };
 
+class MlasConvDepthwiseNhwcTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t Channels,
+        size_t OutputCount,
+        size_t KernelSize,
+        bool UseBias
+        )
+    {
+        const float* Input = BufferInput.GetBuffer(OutputCount * KernelSize * Channels);
+        const float* Filter = BufferFilter.GetBuffer(KernelSize * Channels);
+        const float* Bias = UseBias ? BufferBias.GetBuffer(Channels) : nullptr;
+        float* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+        float* OutputReference = BufferOutputReference.GetBuffer(OutputCount * Channels);
+
+        MlasConvDepthwise(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize);
+
+        for (size_t n = 0; n < OutputCount; n++) {
+            for (size_t c = 0; c < Channels; c++) {
+                float Accumulator = (Bias != nullptr) ? Bias[c] : 0.0f;
+                for (size_t k = 0; k < KernelSize; k++) {
+                    Accumulator += Input[(n * KernelSize + k) * Channels + c] * Filter[k * Channels + c];
+                }
+                OutputReference[n * Channels + c] = Accumulator;
+            }
+        }
+
+        if (memcmp(Output, OutputReference, OutputCount * Channels * sizeof(float)) != 0) {
+            printf("mismatch: channels=%zd,outputs=%zd,kernel=%zd,bias=%d!!!\n",
+                Channels, OutputCount, KernelSize, int(UseBias));
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferFilter;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t c = 1; c <= 37; c++) {
+            Test(c, 7, 9, true);
+            Test(c, 3, 25, false);
+            Test(c, 16, 1, true);
+        }
+    }
+};
+
 class MlasPool2DTest : public MlasTestBase
 {
 protected:
@@ -2510,6 +3031,345 @@ public:
     }
 };
 
+class MlasLayerNormTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferSkip;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferGamma;
+    MatrixGuardBuffer<float> BufferBeta;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferSumOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+    MatrixGuardBuffer<float> BufferSumOutputReference;
+    MatrixGuardBuffer<float> BufferStatistics;
+    MatrixGuardBuffer<float> BufferStatisticsReference;
+
+    void
+    Test(
+        size_t N,
+        size_t D,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D);
+        float* Skip = BufferSkip.GetBuffer(N * D);
+        float* Bias = BufferBias.GetBuffer(D);
+        float* Gamma = BufferGamma.GetBuffer(D);
+        float* Beta = BufferBeta.GetBuffer(D);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+        std::uniform_real_distribution<float> weight_distribution(-1.0f, 1.0f);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            Input[nd] = distribution(generator);
+            Skip[nd] = weight_distribution(generator);
+        }
+
+        for (size_t d = 0; d < D; d++) {
+            Bias[d] = weight_distribution(generator);
+            Gamma[d] = weight_distribution(generator);
+            Beta[d] = weight_distribution(generator);
+        }
+
+        for (int Simplified = 0; Simplified < 2; Simplified++) {
+            Test(Input, nullptr, nullptr, Gamma, Beta, N, D, Simplified != 0);
+            Test(Input, Skip, nullptr, Gamma, nullptr, N, D, Simplified != 0);
+            Test(Input, Skip, Bias, Gamma, Beta, N, D, Simplified != 0);
+        }
+    }
+
+    void
+    Test(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        const float* Gamma,
+        const float* Beta,
+        size_t N,
+        size_t D,
+        bool Simplified
+        )
+    {
+        float* Output = BufferOutput.GetBuffer(N * D);
+        float* SumOutput = BufferSumOutput.GetBuffer(N * D);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+        float* SumOutputReference = BufferSumOutputReference.GetBuffer(N * D);
+        float* Statistics = BufferStatistics.GetBuffer(N * 2);
+        float* StatisticsReference = BufferStatisticsReference.GetBuffer(N * 2);
+
+        constexpr float Epsilon = 1e-5f;
+
+        //
+        // The sum output is only produced when a skip or bias is supplied.
+        //
+
+        if (Skip == nullptr && Bias == nullptr) {
+            SumOutput = nullptr;
+        }
+
+        MlasLayerNormalization(Input, Skip, Bias, Gamma, Beta, Output, SumOutput,
+                               Statistics, Statistics + N, N, D, Epsilon, Simplified, threadpool);
+        ReferenceLayerNorm(Input, Skip, Bias, Gamma, Beta, OutputReference, SumOutputReference,
+                           StatisticsReference, StatisticsReference + N, N, D, Epsilon, Simplified);
+
+        constexpr float AbsoluteTolerance = 1e-5f;
+        constexpr float RelativeTolerance = 1e-5f;
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("layernorm(%d) difference: %u/%u %.8f %.8f\n", int32_t(Simplified), unsigned(N), unsigned(D), Output[nd], OutputReference[nd]);
+            }
+            if (SumOutput != nullptr && SumOutput[nd] != SumOutputReference[nd]) {
+                printf("layernorm(%d) sum difference: %u/%u %.8f %.8f\n", int32_t(Simplified), unsigned(N), unsigned(D), SumOutput[nd], SumOutputReference[nd]);
+            }
+        }
+
+        for (size_t n = 0; n < N * 2; n++) {
+            float diff = std::fabs(Statistics[n] - StatisticsReference[n]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(StatisticsReference[n]) * RelativeTolerance) {
+                printf("layernorm(%d) statistics difference: %u/%u %.8f %.8f\n", int32_t(Simplified), unsigned(N), unsigned(D), Statistics[n], StatisticsReference[n]);
+            }
+        }
+
+        //
+        // Verify the operation in place.
+        //
+
+        std::copy_n(Input, N * D, Output);
+
+        MlasLayerNormalization(Output, Skip, Bias, Gamma, Beta, Output, nullptr,
+                               nullptr, nullptr, N, D, Epsilon, Simplified, threadpool);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("layernorm(%d) in place difference: %u/%u %.8f %.8f\n", int32_t(Simplified), unsigned(N), unsigned(D), Output[nd], OutputReference[nd]);
+            }
+        }
+    }
+
+    void
+    ReferenceLayerNorm(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        const float* Gamma,
+        const float* Beta,
+        float* Output,
+        float* SumOutput,
+        float* Mean,
+        float* InvStdDev,
+        size_t N,
+        size_t D,
+        float Epsilon,
+        bool Simplified
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                float Value = Input[d];
+                if (Skip != nullptr) {
+                    Value += Skip[d];
+                }
+                if (Bias != nullptr) {
+                    Value += Bias[d];
+                }
+                SumOutput[d] = Value;
+                Sum += Value;
+            }
+
+            double RowMean = Simplified ? 0.0 : Sum / D;
+            double SumSquares = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                double Centered = SumOutput[d] - RowMean;
+                SumSquares += Centered * Centered;
+            }
+
+            double RowInvStdDev = 1.0 / std::sqrt(SumSquares / D + Epsilon);
+
+            for (size_t d = 0; d < D; d++) {
+                double Value = (SumOutput[d] - RowMean) * RowInvStdDev * Gamma[d];
+                if (Beta != nullptr) {
+                    Value += Beta[d];
+                }
+                Output[d] = float(Value);
+            }
+
+            Mean[n] = float(RowMean);
+            InvStdDev[n] = float(RowInvStdDev);
+
+            Input += D;
+            Output += D;
+            SumOutput += D;
+            if (Skip != nullptr) {
+                Skip += D;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t d = 1; d < 128; d++) {
+            Test(1, d, -10.f, 10.f);
+        }
+
+        Test(3, 128, 20.f, 30.f);
+        Test(63, 95, -150.f, 190.f);
+        Test(16, 768, -10.f, 10.f);
+        Test(128, 1024, 1000.f, 1001.f);
+    }
+};
+
+class MlasChannelNormTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferScale;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        size_t C,
+        size_t ChannelSize,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        const size_t Count = N * C * ChannelSize;
+
+        float* Input = BufferInput.GetBuffer(Count);
+        float* Scale = BufferScale.GetBuffer(C);
+        float* Bias = BufferBias.GetBuffer(C);
+        float* Output = BufferOutput.GetBuffer(Count);
+        float* OutputReference = BufferOutputReference.GetBuffer(Count);
+
+        std::default_random_engine generator(static_cast<unsigned>(Count));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+        std::uniform_real_distribution<float> weight_distribution(-1.0f, 1.0f);
+
+        for (size_t i = 0; i < Count; i++) {
+            Input[i] = distribution(generator);
+        }
+
+        for (size_t c = 0; c < C; c++) {
+            Scale[c] = weight_distribution(generator);
+            Bias[c] = weight_distribution(generator);
+        }
+
+        constexpr float Epsilon = 1e-5f;
+        constexpr float AbsoluteTolerance = 1e-5f;
+        constexpr float RelativeTolerance = 1e-5f;
+
+        //
+        // Verify the channel affine transform.
+        //
+
+        MlasChannelAffine(Input, Scale, Bias, Output, N, C, ChannelSize, threadpool);
+
+        for (size_t i = 0; i < Count; i++) {
+            const size_t c = (i / ChannelSize) % C;
+            float diff = std::fabs(Output[i] - (Input[i] * Scale[c] + Bias[c]));
+            if (diff > AbsoluteTolerance && diff > std::fabs(Output[i]) * RelativeTolerance) {
+                printf("channelaffine difference: %u/%u/%u %.8f\n", unsigned(N), unsigned(C), unsigned(ChannelSize), Output[i]);
+            }
+        }
+
+        //
+        // Verify the instance normalization, including in place.
+        //
+
+        ReferenceInstanceNorm(Input, Scale, Bias, OutputReference, N, C, ChannelSize, Epsilon);
+
+        for (int InPlace = 0; InPlace < 2; InPlace++) {
+
+            if (InPlace != 0) {
+                std::copy_n(Input, Count, Output);
+                MlasInstanceNormalization(Output, Scale, Bias, Output, N, C, ChannelSize, Epsilon, threadpool);
+            } else {
+                MlasInstanceNormalization(Input, Scale, Bias, Output, N, C, ChannelSize, Epsilon, threadpool);
+            }
+
+            for (size_t i = 0; i < Count; i++) {
+                float diff = std::fabs(Output[i] - OutputReference[i]);
+                if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[i]) * RelativeTolerance) {
+                    printf("instancenorm(%d) difference: %u/%u/%u %.8f %.8f\n", InPlace, unsigned(N), unsigned(C), unsigned(ChannelSize), Output[i], OutputReference[i]);
+                }
+            }
+        }
+    }
+
+    void
+    ReferenceInstanceNorm(
+        const float* Input,
+        const float* Scale,
+        const float* Bias,
+        float* Output,
+        size_t N,
+        size_t C,
+        size_t ChannelSize,
+        float Epsilon
+        )
+    {
+        for (size_t nc = 0; nc < N * C; nc++) {
+
+            double Sum = 0.0;
+
+            for (size_t i = 0; i < ChannelSize; i++) {
+                Sum += Input[i];
+            }
+
+            double Mean = Sum / ChannelSize;
+            double SumSquares = 0.0;
+
+            for (size_t i = 0; i < ChannelSize; i++) {
+                double Centered = Input[i] - Mean;
+                SumSquares += Centered * Centered;
+            }
+
+            double InvStdDev = 1.0 / std::sqrt(SumSquares / ChannelSize + Epsilon);
+
+            for (size_t i = 0; i < ChannelSize; i++) {
+                Output[i] = float((Input[i] - Mean) * InvStdDev * Scale[nc % C] + Bias[nc % C]);
+            }
+
+            Input += ChannelSize;
+            Output += ChannelSize;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t i = 1; i < 64; i++) {
+            Test(1, 3, i, -10.f, 10.f);
+        }
+
+        Test(2, 16, 49, -150.f, 190.f);
+        Test(1, 64, 1024, 20.f, 30.f);
+        Test(4, 32, 3136, -10.f, 10.f);
+        Test(2, 8, 4096, 1000.f, 1001.f);
+    }
+};
+
 class MlasComputeExpTest : public MlasTestBase
 {
 private:
@@ -2863,6 +3723,12 @@ RunThreadedTests(
     onnxruntime::make_unique<MlasFgemmTest<float, false>>()->ExecuteShort();
     printf("SGEMM packed tests.\n");
     onnxruntime::make_unique<MlasFgemmTest<float, true>>()->ExecuteShort();
+    printf("SGEMM packed half tests.\n");
+    onnxruntime::make_unique<MlasFgemmPackedHalfTest>()->ExecuteShort();
+    printf("SGEMM batch tests.\n");
+    onnxruntime::make_unique<MlasFgemmBatchTest>()->ExecuteShort();
+    printf("SGEMM output processor tests.\n");
+    onnxruntime::make_unique<MlasFgemmOutputProcessorTest>()->ExecuteShort();
 #ifdef MLAS_SUPPORTS_GEMM_DOUBLE
     printf("DGEMM tests.\n");
     onnxruntime::make_unique<MlasFgemmTest<double, false>>()->ExecuteShort();
@@ -2900,6 +3766,9 @@ RunThreadedTests(
         onnxruntime::make_unique<MlasNchwcConv2DTest>()->ExecuteShort();
     }
 
+    printf("Conv depthwise NHWC tests.\n");
+    onnxruntime::make_unique<MlasConvDepthwiseNhwcTest>()->ExecuteShort();
+
     printf("Pool2D tests.\n");
     onnxruntime::make_unique<MlasPool2DTest>()->ExecuteShort();
     if (MlasNchwcGetBlockSize() > 1) {
@@ -2911,6 +3780,12 @@ RunThreadedTests(
 
     printf("Softmax tests.\n");
     onnxruntime::make_unique<MlasSoftmaxTest>()->ExecuteShort();
+
+    printf("Layer normalization tests.\n");
+    onnxruntime::make_unique<MlasLayerNormTest>()->ExecuteShort();
+
+    printf("Channel normalization tests.\n");
+    onnxruntime::make_unique<MlasChannelNormTest>()->ExecuteShort();
 }
 
 int
@@ -286,5 +286,60 @@ TEST(CseTests, MergeConstants) {
   ASSERT_EQ(op_count["Add"], 2);
 }
 
+TEST(CseTests, NestedDuplicatesMergedInOnePass) {
+  Model model("CseNestedDuplicates", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  // Add(Neg(Relu(x)), Neg(Relu(x))). the Neg nodes only become duplicates once the Relu nodes are merged.
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& relu_1_out = graph.GetOrCreateNodeArg("relu_1_out", &float_tensor_type);
+  auto& relu_2_out = graph.GetOrCreateNodeArg("relu_2_out", &float_tensor_type);
+  auto& neg_1_out = graph.GetOrCreateNodeArg("neg_1_out", &float_tensor_type);
+  auto& neg_2_out = graph.GetOrCreateNodeArg("neg_2_out", &float_tensor_type);
+  auto& result = graph.GetOrCreateNodeArg("Result", &float_tensor_type);
+  graph.AddNode("relu_1", "Relu", "", {&x}, {&relu_1_out});
+  graph.AddNode("relu_2", "Relu", "", {&x}, {&relu_2_out});
+  graph.AddNode("neg_1", "Neg", "", {&relu_1_out}, {&neg_1_out});
+  graph.AddNode("neg_2", "Neg", "", {&relu_2_out}, {&neg_2_out});
+  graph.AddNode("add", "Add", "", {&neg_1_out, &neg_2_out}, {&result});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyCse(model, 1);
+
+  const auto& graph_outputs = GetSortedNames(graph.GetOutputs());
+  ASSERT_EQ(graph_outputs, (std::vector<std::string>{"Result"}));
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["Relu"], 1);
+  ASSERT_EQ(op_count["Neg"], 1);
+  ASSERT_EQ(op_count["Add"], 1);
+}
+
+TEST(CseTests, NoDuplicatesLeavesGraphUnmodified) {
+  auto model_uri = ORT_TSTR("testdata/transform/cse/cse1.onnx");
+  std::shared_ptr<Model> model;
+  ASSERT_TRUE(Model::Load(model_uri, model, nullptr,
+                          DefaultLoggingManager().DefaultLogger())
+                  .IsOK());
+  Graph& graph = model->MainGraph();
+
+  CommonSubexpressionElimination cse;
+  bool modified = false;
+  ASSERT_TRUE(cse.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()).IsOK());
+  ASSERT_TRUE(modified);
+
+  // the graph has no duplicates left, so a second application must not report any change
+  const auto op_count = CountOpsInGraph(graph);
+  modified = false;
+  ASSERT_TRUE(cse.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()).IsOK());
+  ASSERT_FALSE(modified);
+  ASSERT_EQ(CountOpsInGraph(graph), op_count);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -26,6 +26,27 @@ class DummyGraphTransformer : public GraphTransformer {
   }
 };
 
+// Dummy graph transformer that counts how often it is applied, and reports the graph as modified
+// for the first num_modifications applications.
+class CountingGraphTransformer : public GraphTransformer {
+ public:
+  CountingGraphTransformer(const std::string& name, int num_modifications) noexcept
+      : GraphTransformer(name), num_modifications_(num_modifications) {}
+
+  int NumInvocations() const {
+    return num_invocations_;
+  }
+
+ private:
+  const int num_modifications_;
+  mutable int num_invocations_{0};
+
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    modified = num_invocations_++ < num_modifications_;
+    return Status::OK();
+  }
+};
+
 // Dummy graph transformer that does nothing, but just sets the modified value
 // This is currently used to test custom transformer selection feature
 class DummyRewriteRule : public RewriteRule {
@@ -56,6 +56,7 @@
 #include "test/common/tensor_op_test_utils.h"
 #include "test/compare_ortvalue.h"
 #include "test/framework/test_utils.h"
+#include "test/optimizer/dummy_graph_transformer.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/test_environment.h"
@@ -301,6 +302,204 @@ TEST_F(GraphTransformationTests, ConstantFoldingWithScalarShapeToInitializer) {
   ASSERT_TRUE(op_to_count["Add"] == 1);
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingReinfersOnlyConsumersOfFoldedNodes) {
+  Model model("ConstantFoldingReinfer", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  auto add_int64_initializer = [&graph](const std::string& name, const std::vector<int64_t>& values) {
+    TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(TensorProto_DataType_INT64);
+    tensor.add_dims(values.size());
+    for (auto value : values) {
+      tensor.add_int64_data(value);
+    }
+    graph.AddInitializedTensor(tensor);
+  };
+
+  add_int64_initializer("shape", {2, 3});
+  add_int64_initializer("zeros", {0, 0});
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto float_6_type(float_tensor_type);
+  float_6_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  TypeProto int64_tensor_type;
+  int64_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  // Add(shape, zeros) is folded. that makes the output shape of the Reshape and, through it, the Identity known, so the
+  // Shape of the Identity output can be folded in the same pass.
+  auto& x = graph.GetOrCreateNodeArg("x", &float_6_type);
+  auto& target_shape = graph.GetOrCreateNodeArg("target_shape", &int64_tensor_type);
+  auto& reshaped = graph.GetOrCreateNodeArg("reshaped", &float_tensor_type);
+  auto& identity_out = graph.GetOrCreateNodeArg("identity_out", &float_tensor_type);
+  auto& identity_shape = graph.GetOrCreateNodeArg("identity_shape", &int64_tensor_type);
+  auto& x_out = graph.GetOrCreateNodeArg("x_out", &float_tensor_type);
+  graph.AddNode("add", "Add", "", {graph.GetNodeArg("shape"), graph.GetNodeArg("zeros")}, {&target_shape});
+  graph.AddNode("reshape", "Reshape", "", {&x, &target_shape}, {&reshaped});
+  graph.AddNode("identity", "Identity", "", {&reshaped}, {&identity_out});
+  graph.AddNode("identity_shape", "Shape", "", {&identity_out}, {&identity_shape});
+  graph.AddNode("reshape_out", "Reshape", "", {&identity_out, &identity_shape}, {&x_out});
+
+  // a branch that no folded node feeds into
+  auto& y = graph.GetOrCreateNodeArg("y", &float_6_type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &float_tensor_type);
+  auto& relu_shape = graph.GetOrCreateNodeArg("relu_shape", &int64_tensor_type);
+  auto& y_out = graph.GetOrCreateNodeArg("y_out", &float_tensor_type);
+  graph.AddNode("relu", "Relu", "", {&y}, {&relu_out});
+  graph.AddNode("relu_shape", "Shape", "", {&relu_out}, {&relu_shape});
+  graph.AddNode("reshape_y", "Reshape", "", {&relu_out, &relu_shape}, {&y_out});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // shape inferencing would restore this shape if the Relu node was revisited
+  relu_out.ClearShape();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  std::unique_ptr<CPUExecutionProvider> e =
+      onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConstantFolding>(*e.get()), TransformerLevel::Level1);
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["Identity"], 1);
+  EXPECT_EQ(op_to_count["Reshape"], 3);
+  // only the Shape of the Relu output is left
+  ASSERT_EQ(op_to_count["Shape"], 1);
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Shape") {
+      EXPECT_EQ(node.Name(), "relu_shape");
+    }
+  }
+
+  const TensorProto* folded_shape = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("identity_shape", folded_shape));
+  Initializer folded_shape_values(*folded_shape, graph.ModelPath());
+  ASSERT_EQ(folded_shape_values.size(), 2);
+  EXPECT_EQ(folded_shape_values.data<int64_t>()[0], 2);
+  EXPECT_EQ(folded_shape_values.data<int64_t>()[1], 3);
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingNodesOfTheSameOpType) {
+  Model model("ConstantFoldingSameOpType", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TensorProto float_constant;
+  float_constant.set_name("float_constant");
+  float_constant.set_data_type(TensorProto_DataType_FLOAT);
+  float_constant.add_dims(1);
+  float_constant.add_dims(2);
+  float_constant.add_dims(3);
+  for (int i = 0; i < 6; ++i) {
+    float_constant.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(float_constant);
+
+  TensorProto int64_constant;
+  int64_constant.set_name("int64_constant");
+  int64_constant.set_data_type(TensorProto_DataType_INT64);
+  int64_constant.add_dims(2);
+  int64_constant.add_int64_data(1);
+  int64_constant.add_int64_data(3);
+  graph.AddInitializedTensor(int64_constant);
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto int64_tensor_type;
+  int64_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto* float_constant_arg = graph.GetNodeArg("float_constant");
+  auto* int64_constant_arg = graph.GetNodeArg("int64_constant");
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+
+  // several nodes of the same op type that differ in their attributes or input types, and so must each get a kernel
+  // configured for that node
+  auto& transpose_1_out = graph.GetOrCreateNodeArg("transpose_1_out", &float_tensor_type);
+  auto& transpose_2_out = graph.GetOrCreateNodeArg("transpose_2_out", &float_tensor_type);
+  auto& float_sum = graph.GetOrCreateNodeArg("float_sum", &float_tensor_type);
+  auto& int64_sum = graph.GetOrCreateNodeArg("int64_sum", &int64_tensor_type);
+  graph.AddNode("transpose_1", "Transpose", "", {float_constant_arg}, {&transpose_1_out})
+      .AddAttribute("perm", std::vector<int64_t>{2, 1, 0});
+  graph.AddNode("transpose_2", "Transpose", "", {float_constant_arg}, {&transpose_2_out})
+      .AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+  graph.AddNode("float_add", "Add", "", {float_constant_arg, float_constant_arg}, {&float_sum});
+  graph.AddNode("int64_add", "Add", "", {int64_constant_arg, int64_constant_arg}, {&int64_sum});
+
+  auto& out_1 = graph.GetOrCreateNodeArg("out_1", &float_tensor_type);
+  auto& out_2 = graph.GetOrCreateNodeArg("out_2", &float_tensor_type);
+  auto& out_3 = graph.GetOrCreateNodeArg("out_3", &float_tensor_type);
+  auto& out_4 = graph.GetOrCreateNodeArg("out_4", &float_tensor_type);
+  graph.AddNode("add_1", "Add", "", {&transpose_1_out, &x}, {&out_1});
+  graph.AddNode("add_2", "Add", "", {&transpose_2_out, &x}, {&out_2});
+  graph.AddNode("add_3", "Add", "", {&float_sum, &x}, {&out_3});
+  graph.AddNode("reshape", "Reshape", "", {&x, &int64_sum}, {&out_4});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  std::unique_ptr<CPUExecutionProvider> e =
+      onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConstantFolding>(*e.get()), TransformerLevel::Level1);
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Transpose"], 0);
+  EXPECT_EQ(op_to_count["Add"], 3);
+
+  auto check_folded_value = [&graph](const std::string& name, const std::vector<int64_t>& expected_dims,
+                                     const std::vector<float>& expected_values) {
+    const TensorProto* tensor = nullptr;
+    ASSERT_TRUE(graph.GetInitializedTensor(name, tensor)) << name << " was not folded";
+    ASSERT_EQ(std::vector<int64_t>(tensor->dims().begin(), tensor->dims().end()), expected_dims) << name;
+
+    Initializer values(*tensor, graph.ModelPath());
+    ASSERT_EQ(values.size(), static_cast<int64_t>(expected_values.size())) << name;
+    for (size_t i = 0; i < expected_values.size(); ++i) {
+      EXPECT_EQ(values.data<float>()[i], expected_values[i]) << name << "[" << i << "]";
+    }
+  };
+
+  check_folded_value("transpose_1_out", {3, 2, 1}, {0.f, 3.f, 1.f, 4.f, 2.f, 5.f});
+  check_folded_value("transpose_2_out", {1, 3, 2}, {0.f, 3.f, 1.f, 4.f, 2.f, 5.f});
+  check_folded_value("float_sum", {1, 2, 3}, {0.f, 2.f, 4.f, 6.f, 8.f, 10.f});
+
+  const TensorProto* int64_sum_tensor = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("int64_sum", int64_sum_tensor));
+  Initializer int64_sum_values(*int64_sum_tensor, graph.ModelPath());
+  ASSERT_EQ(int64_sum_values.size(), 2);
+  EXPECT_EQ(int64_sum_values.data<int64_t>()[0], 2);
+  EXPECT_EQ(int64_sum_values.data<int64_t>()[1], 6);
+}
+
+TEST_F(GraphTransformationTests, TransformersAtFixedPointAreSkipped) {
+  auto model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+
+  auto modifying_transformer = onnxruntime::make_unique<CountingGraphTransformer>("Modifying", 2);
+  const auto* modifying_transformer_ptr = modifying_transformer.get();
+  auto unmodifying_transformer = onnxruntime::make_unique<CountingGraphTransformer>("Unmodifying", 0);
+  const auto* unmodifying_transformer_ptr = unmodifying_transformer.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{10};
+  graph_transformation_mgr.Register(std::move(modifying_transformer), TransformerLevel::Level2);
+  graph_transformation_mgr.Register(std::move(unmodifying_transformer), TransformerLevel::Level2);
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  // step 0 and 1: both applied, 'Modifying' reports changes.
+  // step 2: 'Modifying' is applied and reports no change. 'Unmodifying' made no change when it was applied after
+  // the last modification of the graph so is skipped.
+  ASSERT_EQ(modifying_transformer_ptr->NumInvocations(), 3);
+  ASSERT_EQ(unmodifying_transformer_ptr->NumInvocations(), 2);
+}
+
 TEST_F(GraphTransformationTests, ShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "shape-add.onnx";
   std::shared_ptr<Model> model;
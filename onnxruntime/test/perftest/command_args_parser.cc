@@ -33,6 +33,10 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [requests_per_second]: Open loop mode. Fires requests at the given rate with Poisson arrivals, whether\n"
+      "\t\tor not earlier requests completed, and runs them on the -c parallel runs. Latencies include the queueing delay.\n"
+      "\t-j [json_file]: Writes the run configuration, throughput, latency and queueing percentiles and CPU usage\n"
+      "\t\tsamples to the file as JSON.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|ngraph|openvino|nuphar|dml|acl]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'ngraph', 'openvino', 'nuphar', 'dml' or 'acl'. "
       "Default:'cpu'.\n"
@@ -56,7 +60,7 @@ namespace perftest {
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:Q:j:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
@@ -149,6 +153,17 @@ namespace perftest {
           return false;
         }
         break;
+      case 'Q': {
+        const long qps = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (qps <= 0) {
+          return false;
+        }
+        test_config.run_config.target_qps = static_cast<size_t>(qps);
+        break;
+      }
+      case 'j':
+        test_config.model_info.json_result_file_path = optarg;
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
@@ -4,6 +4,7 @@
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
 #include <random>
+#include <core/platform/ort_mutex.h>
 #include "test_configuration.h"
 #include "test_session.h"
 class TestModelInfo;
@@ -38,6 +39,8 @@ class OnnxRuntimeTestSession : public TestSession {
 
  private:
   Ort::Session session_{nullptr};
+  // rand_engine_ is shared by concurrent runs
+  OrtMutex rand_mutex_;
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
@@ -7,7 +7,10 @@
 #endif
 
 #include "performance_runner.h"
+#include <deque>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -42,6 +45,79 @@ Eigen::ThreadPoolInterface* GetDefaultThreadPool(const onnxruntime::Env& env) {
 namespace onnxruntime {
 namespace perftest {
 
+// Interval between the CPU usage samples written to the JSON result.
+static constexpr std::chrono::milliseconds kCpuUsageSampleInterval(500);
+
+// p in [0, 1]. sorted must not be empty.
+static double Percentile(const std::vector<double>& sorted, double p) {
+  return sorted[std::min(sorted.size() - 1, static_cast<size_t>(sorted.size() * p))];
+}
+
+static void WriteJsonString(std::ostream& os, const std::string& s) {
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+         << std::setfill(' ');
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+static void WriteJsonPercentiles(std::ostream& os, const std::vector<double>& values) {
+  std::vector<double> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  double sum = 0;
+  for (double v : sorted) {
+    sum += v;
+  }
+  os << "{\"min\": " << sorted.front() << ", \"max\": " << sorted.back()
+     << ", \"avg\": " << sum / sorted.size()
+     << ", \"p50\": " << Percentile(sorted, 0.5) << ", \"p90\": " << Percentile(sorted, 0.9)
+     << ", \"p95\": " << Percentile(sorted, 0.95) << ", \"p99\": " << Percentile(sorted, 0.99)
+     << ", \"p999\": " << Percentile(sorted, 0.999) << "}";
+}
+
+void PerformanceResult::DumpToJson(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open JSON result file '" << ToMBString(path) << "'.\n";
+    return;
+  }
+
+  const std::chrono::duration<double> run_time = end - start;
+  outfile << std::setprecision(9) << "{\n  \"model\": ";
+  WriteJsonString(outfile, model_name);
+  outfile << ",\n  \"test_mode\": \""
+          << (run_config.test_mode == TestMode::kFixDurationMode ? "duration" : "times") << "\",\n"
+          << "  \"concurrent_session_runs\": " << run_config.concurrent_session_runs << ",\n"
+          << "  \"target_qps\": " << run_config.target_qps << ",\n"
+          << "  \"requests\": " << time_costs.size() << ",\n"
+          << "  \"run_time_s\": " << run_time.count() << ",\n"
+          << "  \"throughput_qps\": " << (run_time.count() > 0 ? time_costs.size() / run_time.count() : 0.0) << ",\n";
+  if (!time_costs.empty()) {
+    outfile << "  \"latency_s\": ";
+    WriteJsonPercentiles(outfile, time_costs);
+    outfile << ",\n";
+  }
+  if (!queueing_delays.empty()) {
+    outfile << "  \"queueing_delay_s\": ";
+    WriteJsonPercentiles(outfile, queueing_delays);
+    outfile << ",\n";
+  }
+  outfile << "  \"avg_cpu_usage\": " << average_CPU_usage << ",\n"
+          << "  \"cpu_usage_sample_interval_ms\": " << kCpuUsageSampleInterval.count() << ",\n"
+          << "  \"cpu_usage_samples\": [";
+  for (size_t i = 0; i < cpu_usage_samples.size(); ++i) {
+    outfile << (i == 0 ? "" : ", ") << cpu_usage_samples[i];
+  }
+  outfile << "],\n  \"peak_workingset_size\": " << peak_workingset_size << "\n}" << std::endl;
+}
+
 void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics) const {
   bool have_file = !path.empty();
   std::ofstream outfile;
@@ -70,24 +146,24 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 
   if (!time_costs.empty() && f_include_statistics) {
     std::vector<double> sorted_time = time_costs;
-
-    size_t total = sorted_time.size();
-    size_t n50 = static_cast<size_t>(total * 0.5);
-    size_t n90 = static_cast<size_t>(total * 0.9);
-    size_t n95 = static_cast<size_t>(total * 0.95);
-    size_t n99 = static_cast<size_t>(total * 0.99);
-    size_t n999 = static_cast<size_t>(total * 0.999);
-
     std::sort(sorted_time.begin(), sorted_time.end());
+    std::vector<double> sorted_queueing = queueing_delays;
+    std::sort(sorted_queueing.begin(), sorted_queueing.end());
 
     auto output_stats = [&](std::ostream& ostream) {
-      ostream << "Min Latency: " << sorted_time[0] << " s\n";
-      ostream << "Max Latency: " << sorted_time[total - 1] << " s\n";
-      ostream << "P50 Latency: " << sorted_time[n50] << " s\n";
-      ostream << "P90 Latency: " << sorted_time[n90] << " s\n";
-      ostream << "P95 Latency: " << sorted_time[n95] << " s\n";
-      ostream << "P99 Latency: " << sorted_time[n99] << " s\n";
-      ostream << "P999 Latency: " << sorted_time[n999] << " s" << std::endl;
+      ostream << "Min Latency: " << sorted_time.front() << " s\n";
+      ostream << "Max Latency: " << sorted_time.back() << " s\n";
+      ostream << "P50 Latency: " << Percentile(sorted_time, 0.5) << " s\n";
+      ostream << "P90 Latency: " << Percentile(sorted_time, 0.9) << " s\n";
+      ostream << "P95 Latency: " << Percentile(sorted_time, 0.95) << " s\n";
+      ostream << "P99 Latency: " << Percentile(sorted_time, 0.99) << " s\n";
+      ostream << "P999 Latency: " << Percentile(sorted_time, 0.999) << " s" << std::endl;
+      if (!sorted_queueing.empty()) {
+        ostream << "P50 Queueing Delay: " << Percentile(sorted_queueing, 0.5) << " s\n";
+        ostream << "P90 Queueing Delay: " << Percentile(sorted_queueing, 0.9) << " s\n";
+        ostream << "P99 Queueing Delay: " << Percentile(sorted_queueing, 0.99) << " s\n";
+        ostream << "P999 Queueing Delay: " << Percentile(sorted_queueing, 0.999) << " s" << std::endl;
+      }
     };
 
     if (have_file) {
@@ -112,18 +188,54 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+
+  // Sample the CPU usage in intervals for the JSON result, so that regressions in how busy the cores are show up
+  // and not only the average over the whole run.
+  OrtMutex sampler_mutex;
+  OrtCondVar sampler_cv;
+  bool test_done = false;
+  std::thread cpu_sampler;
+  if (!performance_test_config_.model_info.json_result_file_path.empty()) {
+    cpu_sampler = std::thread([this, &sampler_mutex, &sampler_cv, &test_done]() {
+      std::unique_ptr<utils::ICPUUsage> interval_usage = utils::CreateICPUUsage();
+      std::unique_lock<OrtMutex> lock(sampler_mutex);
+      auto next_sample = std::chrono::steady_clock::now() + kCpuUsageSampleInterval;
+      while (!test_done) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < next_sample) {
+          sampler_cv.wait_for(lock, next_sample - now);
+          continue;
+        }
+        performance_result_.cpu_usage_samples.push_back(interval_usage->GetUsage());
+        interval_usage->Reset();
+        next_sample += kCpuUsageSampleInterval;
+      }
+    });
+  }
+
+  Status status;
   switch (performance_test_config_.run_config.test_mode) {
     case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
+      status = FixDurationTest();
       break;
     case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+      status = RepeatedTimesTest();
       break;
     default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
+  if (cpu_sampler.joinable()) {
+    {
+      std::lock_guard<OrtMutex> guard(sampler_mutex);
+      test_done = true;
+    }
+    sampler_cv.notify_all();
+    cpu_sampler.join();
+  }
+  ORT_RETURN_IF_ERROR(status);
+
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
 
@@ -138,6 +250,7 @@ Status PerformanceRunner::Run() {
             << "Average inference time cost: " << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms\n"
             // Time between start and end of run. Less than Total time cost when running requests in parallel.
             << "Total inference run time: " << inference_duration.count() << " s\n"
+            << "Throughput: " << performance_result_.time_costs.size() / inference_duration.count() << " requests/s\n"
             << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
@@ -146,6 +259,10 @@ Status PerformanceRunner::Run() {
 }
 
 Status PerformanceRunner::FixDurationTest() {
+  if (performance_test_config_.run_config.target_qps > 0) {
+    return RunOpenLoop();
+  }
+
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunFixDuration();
   }
@@ -154,6 +271,10 @@ Status PerformanceRunner::FixDurationTest() {
 }
 
 Status PerformanceRunner::RepeatedTimesTest() {
+  if (performance_test_config_.run_config.target_qps > 0) {
+    return RunOpenLoop();
+  }
+
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunRepeatedTimes();
   }
@@ -179,7 +300,9 @@ Status PerformanceRunner::RunParallelDuration() {
       count++;
       counter++;
       tpool->Schedule([this, &counter, &m, &cv]() {
-        session_->ThreadSafeRun();
+        auto status = RunOneIteration<false>();
+        if (!status.IsOK())
+          std::cerr << status.ErrorMessage();
         // Simplified version of Eigen::Barrier
         std::lock_guard<OrtMutex> lg(m);
         counter--;
@@ -230,6 +353,91 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOneRequest(std::chrono::time_point<std::chrono::high_resolution_clock> arrival) {
+  const auto start = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+  ORT_RETURN_IF_ERROR(RunSession(duration_seconds));
+  const std::chrono::duration<double> latency = std::chrono::high_resolution_clock::now() - arrival;
+  const std::chrono::duration<double> queueing_delay = start - arrival;
+
+  std::lock_guard<OrtMutex> guard(results_mutex_);
+  performance_result_.time_costs.emplace_back(latency.count());
+  performance_result_.queueing_delays.emplace_back(queueing_delay.count());
+  performance_result_.total_time_cost += duration_seconds.count();
+  if (performance_test_config_.run_config.f_verbose) {
+    std::cout << "iteration:" << performance_result_.time_costs.size() << ","
+              << "time_cost:" << latency.count() << ","
+              << "queueing_delay:" << queueing_delay.count() << std::endl;
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop() {
+  // Requests arrive as a Poisson process at the target rate, independent of how fast earlier requests complete, so
+  // that latencies include the queueing delay a server at that load would see. Requests are queued when all the
+  // concurrent session runs are busy.
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  std::deque<Clock::time_point> pending;
+  bool done = false;
+  OrtMutex m;
+  OrtCondVar cv;
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i != run_config.concurrent_session_runs; ++i) {
+    workers.emplace_back([this, &pending, &done, &m, &cv]() {
+      std::unique_lock<OrtMutex> lock(m);
+      for (;;) {
+        cv.wait(lock, [&pending, &done]() { return done || !pending.empty(); });
+        if (pending.empty()) {
+          return;
+        }
+        const auto arrival = pending.front();
+        pending.pop_front();
+        lock.unlock();
+        auto status = RunOneRequest(arrival);
+        if (!status.IsOK())
+          std::cerr << status.ErrorMessage();
+        lock.lock();
+      }
+    });
+  }
+
+  // Fixed seed so that every run sees the same arrival pattern.
+  std::mt19937 arrival_engine(0);
+  std::exponential_distribution<double> inter_arrival(static_cast<double>(run_config.target_qps));
+  const auto start = Clock::now();
+  const auto stop = start + std::chrono::seconds(run_config.duration_in_seconds);
+  auto arrival = start;
+  for (size_t requests = 0;; ++requests) {
+    if (run_config.test_mode == TestMode::KFixRepeatedTimesMode ? requests == run_config.repeated_times
+                                                                 : arrival >= stop) {
+      break;
+    }
+    std::this_thread::sleep_until(arrival);
+    {
+      std::lock_guard<OrtMutex> guard(m);
+      pending.push_back(arrival);
+    }
+    cv.notify_one();
+    arrival += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(inter_arrival(arrival_engine)));
+  }
+
+  //Join
+  {
+    std::lock_guard<OrtMutex> guard(m);
+    done = true;
+  }
+  cv.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
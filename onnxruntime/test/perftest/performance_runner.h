@@ -32,11 +32,18 @@ struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
   size_t peak_workingset_size{0};
   short average_CPU_usage{0};
+  // sum of the time spent in session runs
   double total_time_cost{0};
+  // latency of each request. In open loop mode it includes the time the request waited for a free session run.
   std::vector<double> time_costs;
+  // time each request waited between its arrival and the start of its run. Only recorded in open loop mode.
+  std::vector<double> queueing_delays;
+  // CPU usage over consecutive intervals of the test. Only recorded when a JSON result is requested.
+  std::vector<short> cpu_usage_samples;
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+  void DumpToJson(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config) const;
 };
 
 class PerformanceRunner {
@@ -51,16 +58,17 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.model_info.json_result_file_path.empty()) {
+      performance_result_.DumpToJson(performance_test_config_.model_info.json_result_file_path,
+                                     performance_test_config_.run_config);
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
   bool Initialize();
 
-  template <bool isWarmup>
-  Status RunOneIteration() {
-    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
-
+  Status RunSession(std::chrono::duration<double>& duration_seconds) {
     auto status = Status::OK();
     ORT_TRY {
       duration_seconds = session_->Run();
@@ -70,7 +78,13 @@ class PerformanceRunner {
         status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
       });
     }
-    ORT_RETURN_IF_ERROR(status);
+    return status;
+  }
+
+  template <bool isWarmup>
+  Status RunOneIteration() {
+    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+    ORT_RETURN_IF_ERROR(RunSession(duration_seconds));
 
     if (!isWarmup) {
       std::lock_guard<OrtMutex> guard(results_mutex_);
@@ -88,6 +102,8 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
+  Status RunOneRequest(std::chrono::time_point<std::chrono::high_resolution_clock> arrival);
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
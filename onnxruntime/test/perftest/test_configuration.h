@@ -27,6 +27,7 @@ struct ModelInfo {
   std::basic_string<ORTCHAR_T> model_file_path;
   std::basic_string<ORTCHAR_T> input_file_path;
   std::basic_string<ORTCHAR_T> result_file_path;
+  std::basic_string<ORTCHAR_T> json_result_file_path;
 };
 
 struct MachineConfig {
@@ -40,6 +41,9 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // Requests per second fired with Poisson arrivals regardless of completions (open loop).
+  // 0 runs the closed loop, where each of the concurrent runs starts a request when its previous one completes.
+  size_t target_qps{0};
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_memory_pattern{true};
@@ -10,11 +10,9 @@ namespace onnxruntime {
 namespace perftest {
 class TestSession {
  public:
+  // Runs the model once on one of the preloaded inputs. Implementations must be thread safe, as the -c and -Q modes
+  // call it from several threads at once.
   virtual std::chrono::duration<double> Run() = 0;
-  // TODO: implement it
-  // This function won't return duration, because it may vary largely.
-  // Please measure the perf at a higher level.
-  void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
 
   virtual ~TestSession() = default;
@@ -188,6 +188,56 @@ void TestMultiLoopSections(const std::string& name, int num_threads, int num_loo
   }
 }
 
+void TestNestedSections(const std::string& name, int num_threads, int num_loops) {
+  const int num_tasks = 1024;
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    ThreadPool::ParallelSection outer(tp);
+    for (int l = 0; l < num_loops; l++) {
+      ThreadPool::ParallelSection inner(tp);
+      ThreadPool::TrySimpleParallelFor(tp,
+                                       num_tasks,
+                                       [&](std::ptrdiff_t i) {
+                                         IncrementElement(*test_data, i);
+                                       });
+    }
+    // Loops after an inner section has ended still run in the outer section.
+    ThreadPool::TrySimpleParallelFor(tp,
+                                     num_tasks,
+                                     [&](std::ptrdiff_t i) {
+                                       IncrementElement(*test_data, i);
+                                     });
+  });
+  ValidateTestData(*test_data, num_loops + 1);
+}
+
+#if !defined(_OPENMP) && !defined(ORT_NO_EXCEPTIONS)
+// A section is per-thread state of the Eigen pool, so it cannot be combined with a section or loop of another pool.
+void TestCrossPoolNesting(int num_threads) {
+  const int num_tasks = 1024;
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest("TestCrossPoolNesting", num_threads, [&](ThreadPool* tp) {
+    CreateThreadPoolAndTest("TestCrossPoolNesting_Other", num_threads, [&](ThreadPool* other_tp) {
+      ThreadPool::ParallelSection ps(tp);
+      EXPECT_THROW(ThreadPool::ParallelSection other_ps(other_tp), onnxruntime::OnnxRuntimeException);
+      EXPECT_THROW(ThreadPool::TrySimpleParallelFor(other_tp,
+                                                    num_tasks,
+                                                    [&](std::ptrdiff_t i) {
+                                                      IncrementElement(*test_data, i);
+                                                    }),
+                   onnxruntime::OnnxRuntimeException);
+      // The section of the first pool is still usable.
+      ThreadPool::TrySimpleParallelFor(tp,
+                                       num_tasks,
+                                       [&](std::ptrdiff_t i) {
+                                         IncrementElement(*test_data, i);
+                                       });
+    });
+  });
+  ValidateTestData(*test_data);
+}
+#endif
+
 }  // namespace
 
 namespace onnxruntime {
@@ -381,6 +431,20 @@ TEST(ThreadPoolTest, TestMultiLoopSections_4Thread_100Loop) {
   TestMultiLoopSections("TestMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestNestedSections_0Thread_10Loop) {
+  TestNestedSections("TestNestedSections_0Thread_10Loop", 0, 10);
+}
+
+TEST(ThreadPoolTest, TestNestedSections_4Thread_100Loop) {
+  TestNestedSections("TestNestedSections_4Thread_100Loop", 4, 100);
+}
+
+#if !defined(_OPENMP) && !defined(ORT_NO_EXCEPTIONS)
+TEST(ThreadPoolTest, TestCrossPoolNesting_4Thread) {
+  TestCrossPoolNesting(4);
+}
+#endif
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestStackSize) {
   ThreadOptions to;
@@ -1038,6 +1038,92 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// The loop carried variable buffers are re-used across iterations. Check that a buffer that is also
+// returned as a loop output isn't overwritten by a later iteration.
+TEST(Loop, LoopCarriedVarAlsoLoopOutput) {
+  auto create_subgraph = []() {
+    Model model("Loop carried var as loop output", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    std::vector<NodeArg*> inputs;
+    std::vector<NodeArg*> outputs;
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in     x_in   one
+                           |          \    /
+                      [Identity]      [Add]
+                           |            |
+                       cond_out       x_out
+
+       Outputs: cond_out, x_out (loop carried), x_in (loop output)
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& x_in = graph.GetOrCreateNodeArg("x_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& x_out = graph.GetOrCreateNodeArg("x_out", &float_tensor);
+    auto& one = graph.GetOrCreateNodeArg("one", &float_tensor);
+
+    {
+      TensorProto one_proto;
+      one_proto.set_name("one");
+      one_proto.set_data_type(TensorProto_DataType_FLOAT);
+      one_proto.add_dims(2);
+      one_proto.add_float_data(1.f);
+      one_proto.add_float_data(1.f);
+      graph.AddInitializedTensor(one_proto);
+    }
+
+    {
+      inputs = {&x_in, &one};
+      outputs = {&x_out};
+      graph.AddNode("add", "Add", "x_in + 1", inputs, outputs);
+    }
+
+    {
+      inputs = {&cond_in};
+      outputs = {&cond_out};
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &x_in});
+    graph.SetOutputs({&cond_out, &x_out, &x_in});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("x", {2}, {0.f, 0.f});
+
+  test.AddOutput<float>("x_final", {2}, {4.f, 4.f});
+  test.AddOutput<float>("x_per_iteration", {4, 2}, {0.f, 0.f, 1.f, 1.f, 2.f, 2.f, 3.f, 3.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -207,6 +207,26 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run();
 }
 
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder) {
+  // Contracting the last 2 inputs first is cheaper than contracting left to right
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddInput<float>("z", {4, 1}, {1.f, 2.f, 3.f, 4.f});
+  test.AddOutput<float>("o", {2, 1}, {500.f, 1130.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmul_TransposedInputs) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,kj->ik");
+  test.AddInput<float>("x", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<float>("o", {2, 2}, {22.f, 49.f, 28.f, 64.f});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
@@ -468,6 +488,15 @@ TEST(Einsum, ExplicitEinsumReduceAxesInInputToScalarOutput) {
   test.Run();
 }
 
+TEST(Einsum, ExplicitEinsumReduceMultipleAxesOfOneInput) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "i,ijk->i");
+  test.AddInput<float>("x", {2}, {1.f, 2.f});
+  test.AddInput<float>("y", {2, 2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddOutput<float>("o", {2}, {21.f, 114.f});
+  test.Run();
+}
+
 // Implicit
 TEST(Einsum, ImplicitEinsumAsElementwiseMulOpWithOneScalar) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
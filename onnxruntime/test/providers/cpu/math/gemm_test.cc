@@ -36,14 +36,7 @@ TEST(GemmOpTest, GemmNoTransBIsInitializer) {
   TestGemmNoTrans(true);
 }
 
-// Only CUDA kernel has float 16 support
-#ifdef USE_CUDA
-TEST(GemmOpTest, GemmNoTrans_f16) {
-  int min_cuda_architecture = 530;
-  if (!HasCudaEnvironment(min_cuda_architecture)) {
-    LOGS_DEFAULT(WARNING) << "Hardware NOT support FP16";
-    return;
-  }
+static void TestGemmNoTransF16(bool b_is_initializer) {
   OpTester test("Gemm");
 
   test.AddAttribute("transA", (int64_t)0);
@@ -68,12 +61,24 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
   ConvertFloatToMLFloat16(Y.data(), f_Y.data(), 6);
 
   test.AddInput<MLFloat16>("A", {2, 4}, f_A);
-  test.AddInput<MLFloat16>("B", {4, 3}, f_B);
+  test.AddInput<MLFloat16>("B", {4, 3}, f_B, b_is_initializer);
   test.AddInput<MLFloat16>("C", {2, 3}, f_C);
   test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: fp16 is not supported
+
+  std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider};  //TensorRT: fp16 is not supported
+  if (!HasCudaEnvironment(530)) {
+    excluded_providers.insert(kCudaExecutionProvider);
+  }
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+}
+
+TEST(GemmOpTest, GemmNoTrans_f16) {
+  TestGemmNoTransF16(false);
+}
+
+TEST(GemmOpTest, GemmNoTrans_f16_BIsInitializer) {
+  TestGemmNoTransF16(true);
 }
-#endif
 
 static void TestGemmBroadcast(bool b_is_initializer) {
   OpTester test("Gemm");
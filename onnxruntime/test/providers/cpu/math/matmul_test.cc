@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
 
 namespace onnxruntime {
 namespace test {
@@ -125,6 +126,36 @@ TEST(MathOpTest, MatMulFloatType) {
   RunMatMulTest<float>(7, true);
 }
 
+// the float test cases, run as float16. All the values are exactly representable.
+static void RunMatMulFloat16Test(int32_t opset_version, bool is_b_constant) {
+  std::vector<float> common_input_vals{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (auto t : GenerateTestCases<float>()) {
+    OpTester test("MatMul", opset_version);
+
+    int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+    std::vector<float> input0_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size0);
+    test.AddInput<MLFloat16>("A", t.input0_dims, FloatsToMLFloat16s(input0_vals));
+
+    int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+    std::vector<float> input1_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size1);
+    test.AddInput<MLFloat16>("B", t.input1_dims, FloatsToMLFloat16s(input1_vals), is_b_constant);
+
+    test.AddOutput<MLFloat16>("Y", t.expected_dims, FloatsToMLFloat16s(t.expected_vals));
+
+    std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider, kOpenVINOExecutionProvider,
+                                                       kNnapiExecutionProvider};
+    if (!HasCudaEnvironment(530)) {
+      excluded_providers.insert(kCudaExecutionProvider);
+    }
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  }
+}
+
+TEST(MathOpTest, MatMulFloat16Type) {
+  RunMatMulFloat16Test(9, false);
+  RunMatMulFloat16Test(13, true);
+}
+
 TEST(MathOpTest, MatMulDoubleType) {
   RunMatMulTest<double>(7);
 }
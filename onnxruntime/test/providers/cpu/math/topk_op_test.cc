@@ -556,5 +556,40 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded(k, n, batch_size);
 }
 
+// rows along the last axis that are large relative to k are selected by filtering the values against a threshold,
+// and a row may be split across threads. the values repeat so that the ties are resolved by index.
+static void TestLargeRowSmallK(int64_t k, int64_t rows, int64_t cols, int64_t largest) {
+  std::vector<float> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < rows; ++i) {
+    const float* row = input_vals.data() + i * cols;
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+
+    for (int64_t j = 0; j < k; ++j) {
+      expected_vals.push_back(row[order[j]]);
+      expected_indices.push_back(order[j]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k}, false, -1, largest);
+}
+
+TEST(TopKOperator, LargeRowSmallK) {
+  TestLargeRowSmallK(1, 1, 100000, 1);
+  TestLargeRowSmallK(10, 1, 100000, 1);
+  TestLargeRowSmallK(10, 1, 100000, 0);
+  TestLargeRowSmallK(50, 3, 50000, 1);
+  TestLargeRowSmallK(64, 2, 8192, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
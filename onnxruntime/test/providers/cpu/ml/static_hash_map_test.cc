@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "core/providers/cpu/ml/static_hash_map.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace test {
+
+TEST(StaticHashMapTest, AssignAndFind) {
+  ml::StaticHashMap<std::string, int64_t> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Find("Beer"), nullptr);
+
+  EXPECT_TRUE(map.Assign("Beer", 0));
+  EXPECT_TRUE(map.Assign("Wine", 1));
+  // Later entries replace earlier ones like std::unordered_map::operator[]
+  EXPECT_FALSE(map.Assign("Beer", 2));
+  EXPECT_EQ(map.Size(), 2u);
+
+  ASSERT_NE(map.Find("Beer"), nullptr);
+  EXPECT_EQ(*map.Find("Beer"), 2);
+  ASSERT_NE(map.Find("Wine"), nullptr);
+  EXPECT_EQ(*map.Find("Wine"), 1);
+  EXPECT_EQ(map.Find("Water"), nullptr);
+  EXPECT_EQ(map.Find(""), nullptr);
+}
+
+TEST(StaticHashMapTest, GrowsLikeUnorderedMap) {
+  // Consecutive and strided integer keys through several rehashes
+  ml::StaticHashMap<int64_t, int64_t> map;
+  std::unordered_map<int64_t, int64_t> expected;
+  for (int64_t i = 0; i < 5000; ++i) {
+    const int64_t key = (i % 2 == 0) ? i : i * 1024;
+    map.Assign(key, -i);
+    expected[key] = -i;
+  }
+  ASSERT_EQ(map.Size(), expected.size());
+  for (int64_t key = -10; key < 5000 * 1024 + 10; key += 7) {
+    const auto* found = map.Find(key);
+    auto it = expected.find(key);
+    if (it == expected.end()) {
+      EXPECT_EQ(found, nullptr) << key;
+    } else {
+      ASSERT_NE(found, nullptr) << key;
+      EXPECT_EQ(*found, it->second) << key;
+    }
+  }
+}
+
+TEST(StaticHashMapTest, Reserve) {
+  ml::StaticHashMap<float, std::string> map;
+  map.Reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    map.Assign(i * 0.5f, std::to_string(i));
+  }
+  ASSERT_NE(map.Find(12.5f), nullptr);
+  EXPECT_EQ(*map.Find(12.5f), "25");
+  EXPECT_EQ(map.Find(12.25f), nullptr);
+  // -0.0f and 0.0f compare equal
+  ASSERT_NE(map.Find(-0.0f), nullptr);
+  EXPECT_EQ(*map.Find(-0.0f), "0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -61,6 +62,70 @@ void TestConvOp(const ConvOpAndTestAttributes& attributes,
   test.Run(expect_result, err_str, excluded_providers);
 }
 
+#ifndef DISABLE_CONTRIB_OPS
+
+// Transposes a tensor from channels first (NCHW) to channels last (NHWC).
+vector<float> ToChannelsLast(const vector<float>& data, const vector<int64_t>& shape, vector<int64_t>& nhwc_shape) {
+  const int64_t N = shape[0];
+  const int64_t C = shape[1];
+  const int64_t spatial_size = static_cast<int64_t>(data.size()) / (N * C);
+
+  nhwc_shape.assign(1, N);
+  nhwc_shape.insert(nhwc_shape.end(), shape.begin() + 2, shape.end());
+  nhwc_shape.push_back(C);
+
+  vector<float> nhwc_data(data.size());
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t c = 0; c < C; c++) {
+      for (int64_t s = 0; s < spatial_size; s++) {
+        nhwc_data[(n * spatial_size + s) * C + c] = data[(n * C + c) * spatial_size + s];
+      }
+    }
+  }
+  return nhwc_data;
+}
+
+// Runs the com.microsoft version of the operator with channels_last set, using
+// the same channels first test data as TestConvOp.
+void TestConvChannelsLastOp(const ConvOpAndTestAttributes& attributes,
+                            const vector<vector<float>>& inputs,
+                            const vector<vector<int64_t>>& input_shapes,
+                            const vector<float>& expected_output,
+                            const vector<int64_t>& expected_output_shape) {
+  OpTester test("Conv", 1, kMSDomain);
+  test.AddAttribute("auto_pad", attributes.auto_pad);
+  test.AddAttribute("group", attributes.group);
+  test.AddAttribute("kernel_shape", attributes.kernel_shape);
+  test.AddAttribute("channels_last", static_cast<int64_t>(1));
+
+  if (!attributes.dilations.empty()) {
+    test.AddAttribute("dilations", attributes.dilations);
+  }
+
+  if (!attributes.pads.empty()) {
+    test.AddAttribute("pads", attributes.pads);
+  }
+
+  if (!attributes.strides.empty()) {
+    test.AddAttribute("strides", attributes.strides);
+  }
+
+  vector<int64_t> X_shape;
+  vector<float> X = ToChannelsLast(inputs[0], input_shapes[0], X_shape);
+  test.AddInput<float>("X", X_shape, X);
+  test.AddInput<float>("W", input_shapes[1], inputs[1]);
+  if (inputs.size() == 3)
+    test.AddInput<float>("B", input_shapes[2], inputs[2]);
+
+  vector<int64_t> Y_shape;
+  vector<float> Y = ToChannelsLast(expected_output, expected_output_shape, Y_shape);
+  test.AddOutput<float>("Y", Y_shape, Y);
+
+  test.Run();
+}
+
+#endif
+
 }  // namespace
 
 // Conv
@@ -325,6 +390,30 @@ TEST(ConvTest, Conv2D_Bias_1) {
   TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, true);
 }
 
+TEST(ConvTest, Conv2D_Bias_Float16) {
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 2.0f, 1.0f, 1.0f};
+  vector<float> B = {1.0f, -1.0f};
+  vector<float> expected_vals = {13.0f, 17.0f, 25.0f, 29.0f, 13.0f, 18.0f, 28.0f, 33.0f};
+
+  for (bool weight_is_initializer : {false, true}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("group", int64_t{1});
+    test.AddAttribute("kernel_shape", vector<int64_t>{2, 2});
+
+    test.AddInput<MLFloat16>("X", {1, 1, 3, 3}, FloatsToMLFloat16s(X));
+    test.AddInput<MLFloat16>("W", {2, 1, 2, 2}, FloatsToMLFloat16s(W), weight_is_initializer);
+    test.AddInput<MLFloat16>("B", {2}, FloatsToMLFloat16s(B));
+    test.AddOutput<MLFloat16>("Y", {1, 2, 2, 2}, FloatsToMLFloat16s(expected_vals));
+
+    std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider, kOpenVINOExecutionProvider};
+    if (!HasCudaEnvironment(530)) {
+      excluded_providers.insert(kCudaExecutionProvider);
+    }
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  }
+}
+
 // Conv48
 TEST(ConvTest, Conv2D_Bias_2) {
   ConvOpAndTestAttributes attrs = {
@@ -677,5 +766,125 @@ TEST(ConvTest, Conv1D_asymmetric_padding) {
   TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, true);
 }
 
+TEST(ConvTest, Conv2D_Depthwise) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      3,                            // group
+      vector<int64_t>{3, 3},        // kernel_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{1, 1},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f,
+                     -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f,
+                     1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f};
+  vector<float> W = {-0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f,
+                     -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f};
+  vector<float> B = {-0.5f, 0.0f, 0.5f};
+  auto expected_vals = {-0.5f, -0.875f, -1.625f, -1.0f, -0.5f, 0.625f, 2.125f, -0.625f, -0.5f, -2.125f, -2.375f, -0.25f, -0.5f,
+                        1.875f, -0.125f, -1.5f, -0.5f, -0.125f, 1.625f, 0.875f, -0.125f, -1.375f, -1.5f, -1.25f, 0.25f, 3.375f,
+                        1.5f, 0.375f, -1.0f, -1.0f, -0.75f, -0.25f, 1.375f, 0.5f, -0.5f, -0.125f, -0.75f, 0.75f, 4.25f, -0.125f,
+                        0.875f, -1.0f, -1.0f, 0.875f, 0.25f, 2.5f, 0.875f, -0.5f};
+  vector<int64_t> X_shape = {1, 3, 4, 4};
+  vector<int64_t> W_shape = {3, 1, 3, 3};
+  vector<int64_t> B_shape = {3};
+  vector<int64_t> Y_shape = {1, 3, 4, 4};
+
+  TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+  TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, true);
+#ifndef DISABLE_CONTRIB_OPS
+  TestConvChannelsLastOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+#endif
+}
+
+TEST(ConvTest, Conv2D_Depthwise_Strided) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      vector<int64_t>{3, 3},        // kernel_shape
+      vector<int64_t>{1, 1, 0, 0},  // pads
+      vector<int64_t>{2, 2},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f,
+                     -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f,
+                     1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f,
+                     -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f,
+                     0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f,
+                     1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f};
+  vector<float> W = {-0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f,
+                     -0.25f, 0.0f};
+  auto expected_vals = {0.125f, -1.125f, -0.625f, -0.25f, 0.75f, -0.5f, -0.875f, -1.0f, -0.625f, -0.125f, -0.625f, 3.0f, 1.0f,
+                        -1.375f, -1.0f, 0.625f};
+  vector<int64_t> X_shape = {2, 2, 5, 5};
+  vector<int64_t> W_shape = {2, 1, 3, 3};
+  vector<int64_t> Y_shape = {2, 2, 2, 2};
+
+  TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+#ifndef DISABLE_CONTRIB_OPS
+  TestConvChannelsLastOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+#endif
+}
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ConvTest, Conv2D_ChannelsLast_Pointwise_Group) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      vector<int64_t>{1, 1},        // kernel_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f,
+                     -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f};
+  vector<float> W = {-0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f};
+  vector<float> B = {-0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.5f};
+  auto expected_vals = {-0.125f, 0.375f, 0.0f, -0.375f, -0.75f, -1.125f, 0.375f, -0.375f, -0.25f, -0.125f, 0.0f, 0.125f, -1.0f,
+                        0.75f, 0.75f, 0.75f, 0.75f, 0.75f, -0.75f, -0.875f, -0.125f, -0.25f, -0.375f, -0.5f, 0.5f, 0.875f, 0.375f,
+                        -1.0f, -0.625f, -0.25f, -0.125f, -0.5f, 0.875f, 1.375f, 1.0f, 0.625f};
+  vector<int64_t> X_shape = {1, 4, 2, 3};
+  vector<int64_t> W_shape = {6, 2, 1, 1};
+  vector<int64_t> B_shape = {6};
+  vector<int64_t> Y_shape = {1, 6, 2, 3};
+
+  TestConvChannelsLastOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
+TEST(ConvTest, Conv2D_ChannelsLast) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{0, 1, 1, 0},  // pads
+      vector<int64_t>{1, 2},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f,
+                     -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f};
+  vector<float> W = {-0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, -0.5f,
+                     -0.25f, 0.0f, 0.25f, 0.5f, -0.5f, -0.25f, 0.0f, 0.25f};
+  vector<float> B = {-0.5f, 0.0f, 0.5f};
+  auto expected_vals = {0.25f, 0.625f, -1.625f, -1.75f, 0.0f, -0.625f, 0.0f, -1.125f, -1.75f, -1.5f, 0.875f, 0.75f, 0.0f, -0.5f,
+                        0.125f, -0.5f, 1.25f, 1.375f, -0.375f, 1.375f, 0.625f, -0.375f, 0.875f, 0.75f};
+  vector<int64_t> X_shape = {1, 2, 4, 4};
+  vector<int64_t> W_shape = {3, 2, 2, 2};
+  vector<int64_t> B_shape = {3};
+  vector<int64_t> Y_shape = {1, 3, 4, 2};
+
+  TestConvChannelsLastOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
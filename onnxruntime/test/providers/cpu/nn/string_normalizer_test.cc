@@ -166,6 +166,27 @@ TEST(ContribOpTest, StringNormalizerTest) {
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 
+  // - case-INSENSETIVE approach en_US locale
+  // - ASCII and non-ASCII strings and stopwords
+  // - filter out monday and понедельник in any case
+  // - NONE preserves the case of the remaining strings
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "NONE", false, {u8"MONDAY", u8"понедельник"}, test_locale);
+    std::vector<int64_t> dims{1, 5};
+    std::vector<std::string> input = {std::string(u8"Monday"),
+                                      std::string(u8"TuesDay"),
+                                      std::string(u8"ПОНЕДЕЛЬНИК"),
+                                      std::string(u8"École"),
+                                      std::string(u8"monday")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string(u8"TuesDay"),
+                                       std::string(u8"École")};
+    test.AddOutput<std::string>("Y", {1, 2}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+
   // Empty output case
   // - casesensitive approach
   // - filter out monday
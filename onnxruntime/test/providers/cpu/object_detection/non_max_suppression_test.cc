@@ -288,6 +288,31 @@ TEST(NonMaxSuppressionOpTest, SelectFromIdenticalBoxes) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, SelectFromManyOverlappingBoxes) {
+  // the boxes that are not suppressed have the lowest scores, past the first chunk of sorted candidates
+  constexpr int64_t num_boxes = 200;
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  for (int64_t i = 0; i < num_boxes - 2; ++i) {
+    boxes.insert(boxes.end(), {0.0f, 0.0f, 1.0f, 1.0f});
+    scores.push_back(0.9f - 0.001f * i);
+  }
+  boxes.insert(boxes.end(), {0.0f, 10.0f, 1.0f, 11.0f, 0.0f, 20.0f, 1.0f, 21.0f});
+  scores.insert(scores.end(), {0.1f, 0.05f});
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {1, 1, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {3L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {3, 3},
+                          {0L, 0L, 0L,
+                           0L, 0L, num_boxes - 2,
+                           0L, 0L, num_boxes - 1});
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, InconsistentBoxAndScoreShapes) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
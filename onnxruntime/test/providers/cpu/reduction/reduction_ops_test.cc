@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
 #include <random>
 #include <cmath>
 #include <type_traits>
@@ -2080,5 +2081,79 @@ TEST(ReductionOpTest, ReduceInfLogSumExp) {
   test.Run();
 }
 
+// Compare ReduceSum/Mean/Max/Min against a naive reference for shapes and axes covering the
+// reduce inner ([K, R]), reduce outer ([R, K]) and reduce middle ([K, R, K]) fast paths, including
+// axes of dimension 1 that are merged away, as well as a pattern handled by the generic path.
+static void TestReduceAgainstReference(const std::vector<int64_t>& input_dims, const std::vector<int64_t>& axes) {
+  const int64_t rank = static_cast<int64_t>(input_dims.size());
+  const int64_t input_size = std::accumulate(input_dims.cbegin(), input_dims.cend(), int64_t{1},
+                                             std::multiplies<int64_t>());
+  std::vector<float> input(input_size);
+  for (int64_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>((i * 7) % 13) - 6.f;
+  }
+
+  std::vector<int64_t> output_dims(input_dims);
+  int64_t reduce_size = 1;
+  for (auto a : axes) {
+    output_dims[a] = 1;
+    reduce_size *= input_dims[a];
+  }
+  const int64_t output_size = input_size / reduce_size;
+
+  std::vector<float> sum(output_size, 0.f);
+  std::vector<float> max(output_size, std::numeric_limits<float>::lowest());
+  std::vector<float> min(output_size, std::numeric_limits<float>::max());
+  for (int64_t i = 0; i < input_size; ++i) {
+    int64_t remainder = i;
+    int64_t output_index = 0;
+    int64_t output_pitch = 1;
+    for (int64_t d = rank - 1; d >= 0; --d) {
+      int64_t index = remainder % input_dims[d];
+      remainder /= input_dims[d];
+      output_index += (output_dims[d] == 1 ? 0 : index) * output_pitch;
+      output_pitch *= output_dims[d];
+    }
+    sum[output_index] += input[i];
+    max[output_index] = std::max(max[output_index], input[i]);
+    min[output_index] = std::min(min[output_index], input[i]);
+  }
+
+  std::vector<float> mean(sum);
+  for (auto& v : mean) {
+    v /= static_cast<float>(reduce_size);
+  }
+
+  auto run = [&](const char* op, const std::vector<float>& expected) {
+    OpTester test(op);
+    test.AddAttribute("axes", axes);
+    test.AddAttribute("keepdims", (int64_t)1);
+    test.AddInput<float>("data", input_dims, input);
+    test.AddOutput<float>("reduced", output_dims, expected);
+    test.Run();
+  };
+
+  run("ReduceSum", sum);
+  run("ReduceMean", mean);
+  run("ReduceMax", max);
+  run("ReduceMin", min);
+}
+
+TEST(ReductionOpTest, ReduceFastPaths) {
+  // reduce inner
+  TestReduceAgainstReference({4, 3, 5}, {1, 2});
+  TestReduceAgainstReference({4, 1, 5, 1}, {2, 3});
+  // reduce outer
+  TestReduceAgainstReference({4, 3, 5}, {0});
+  TestReduceAgainstReference({2, 1, 3, 17}, {0, 2});
+  // reduce middle
+  TestReduceAgainstReference({2, 3, 4, 5}, {1});
+  TestReduceAgainstReference({3, 2, 4, 1, 5}, {1, 2, 3});
+  // only dimensions of 1 reduced
+  TestReduceAgainstReference({3, 1, 4}, {1});
+  // generic path
+  TestReduceAgainstReference({2, 3, 4, 5}, {0, 2});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
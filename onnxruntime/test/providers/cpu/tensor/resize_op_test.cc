@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/resize.h"
+#include "core/session/inference_session.h"
 #include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -87,6 +89,30 @@ TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_4DBilinear) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_4DBilinear_NHWC) {
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 0.6f, 0.6f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+
+  const int64_t N = 1, H = 2, W = 4, C = 2;
+  std::vector<float> X = {
+      1.0f, 11.0f, 2.0f, 12.0f, 3.0f, 13.0f, 4.0f, 14.0f,
+      5.0f, 15.0f, 6.0f, 16.0f, 7.0f, 17.0f, 8.0f, 18.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {2.66666651f, 12.6666665f, 4.3333331f, 14.3333331f};
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  // NHWC resizing is only supported by the CPU EP
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kTensorrtExecutionProvider, kNnapiExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 // Since NNAPI(TFLite) only using the scale calulate using the input/output size
 // For the above test (ResizeOpLinearDownSampleTest_4DBilinear)
 // The output size is [1,1,2,4].*[1,1,0.6,0.6]=[1,1,1,2]
@@ -802,6 +828,32 @@ TEST(ResizeOpTest, ResizeOpCubicDownSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_uint8) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  const int64_t N = 1, C = 1, H = 4, W = 4;
+  std::vector<uint8_t> X = {
+      10, 20, 30, 40,
+      50, 60, 70, 80,
+      90, 100, 110, 120,
+      130, 140, 150, 160};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {14, 27, 40,
+                            67, 80, 93,
+                            119, 132, 145};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_exclude_outside) {
   OpTester test("Resize", 13);
   std::vector<float> roi{};
@@ -945,6 +997,42 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_NHWC) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 2.0f, 2.0f, 1.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  // the first channel is the input of ResizeOpCubicUpSampleTest, the second channel is offset by 16
+  const int64_t N = 1, H = 4, W = 4, C = 2;
+  std::vector<float> X = {
+      1.0f, 17.0f, 2.0f, 18.0f, 3.0f, 19.0f, 4.0f, 20.0f,
+      5.0f, 21.0f, 6.0f, 22.0f, 7.0f, 23.0f, 8.0f, 24.0f,
+      9.0f, 25.0f, 10.0f, 26.0f, 11.0f, 27.0f, 12.0f, 28.0f,
+      13.0f, 29.0f, 14.0f, 30.0f, 15.0f, 31.0f, 16.0f, 32.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {
+      1.0f, 17.0f, 1.40625f, 17.40625f, 2.0f, 18.0f, 2.5f, 18.5f, 3.0f, 19.0f, 3.59375f, 19.59375f, 4.0f, 20.0f, 4.09375f, 20.09375f,
+      2.625f, 18.625f, 3.03125f, 19.03125f, 3.625f, 19.625f, 4.125f, 20.125f, 4.625f, 20.625f, 5.21875f, 21.21875f, 5.625f, 21.625f, 5.71875f, 21.71875f,
+      5.0f, 21.0f, 5.40625f, 21.40625f, 6.0f, 22.0f, 6.5f, 22.5f, 7.0f, 23.0f, 7.59375f, 23.59375f, 8.0f, 24.0f, 8.09375f, 24.09375f,
+      7.0f, 23.0f, 7.40625f, 23.40625f, 8.0f, 24.0f, 8.5f, 24.5f, 9.0f, 25.0f, 9.59375f, 25.59375f, 10.0f, 26.0f, 10.09375f, 26.09375f,
+      9.0f, 25.0f, 9.40625f, 25.40625f, 10.0f, 26.0f, 10.5f, 26.5f, 11.0f, 27.0f, 11.59375f, 27.59375f, 12.0f, 28.0f, 12.09375f, 28.09375f,
+      11.375f, 27.375f, 11.78125f, 27.78125f, 12.375f, 28.375f, 12.875f, 28.875f, 13.375f, 29.375f, 13.96875f, 29.96875f, 14.375f, 30.375f, 14.46875f, 30.46875f,
+      13.0f, 29.0f, 13.40625f, 29.40625f, 14.0f, 30.0f, 14.5f, 30.5f, 15.0f, 31.0f, 15.59375f, 31.59375f, 16.0f, 32.0f, 16.09375f, 32.09375f,
+      13.375f, 29.375f, 13.78125f, 29.78125f, 14.375f, 30.375f, 14.875f, 30.875f, 15.375f, 31.375f, 15.96875f, 31.96875f, 16.375f, 32.375f, 16.46875f, 32.46875f};
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  // NHWC resizing is only supported by the CPU EP
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kTensorrtExecutionProvider, kNnapiExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   OpTester test("Resize", 13);
   std::vector<float> scales{};
@@ -1224,5 +1312,87 @@ TEST(ResizeOpTest, ResizeOp_MissingRoiAndMissingScalesOptionalInputs) {
   test.AddOutput<float>("Y", {H, W}, X);
   test.Run();
 }
+
+// Runs the same Resize kernel with changing scales and input shapes, so the interpolation tables the kernel caches
+// from the previous run must not be reused.
+TEST(ResizeOpTest, ResizeOpLinearTablesRecomputedBetweenRuns) {
+  Model model("Resize", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}},
+              {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& roi = graph.GetOrCreateNodeArg("roi", &float_tensor);
+  auto& scales = graph.GetOrCreateNodeArg("scales", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  std::vector<NodeArg*> inputs{&x, &roi, &scales};
+  std::vector<NodeArg*> outputs{&y};
+  auto& node = graph.AddNode("resize", "Resize", "Resize X", inputs, outputs);
+  node.AddAttribute("mode", "linear");
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "ResizeOpLinearTablesRecomputedBetweenRuns";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  struct RunData {
+    std::vector<int64_t> input_dims;
+    std::vector<float> input;
+    std::vector<float> scales;
+    std::vector<int64_t> output_dims;
+    std::vector<float> output;
+  };
+
+  const std::vector<float> X_2x4 = {
+      1.0f, 2.0f, 3.0f, 4.0f,
+      5.0f, 6.0f, 7.0f, 8.0f};
+  const std::vector<float> X_4x4 = {
+      1.0f, 2.0f, 3.0f, 4.0f,
+      5.0f, 6.0f, 7.0f, 8.0f,
+      9.0f, 10.0f, 11.0f, 12.0f,
+      13.0f, 14.0f, 15.0f, 16.0f};
+
+  const std::vector<RunData> runs = {
+      // ResizeOpLinearDownSampleTest_4DBilinear
+      {{1, 1, 2, 4}, X_2x4, {1.0f, 1.0f, 0.6f, 0.6f}, {1, 1, 1, 2}, {2.66666651f, 4.3333331f}},
+      // same input and output shapes with new scales, ResizeOpLinearDownSampleTest_4DBilinear1
+      {{1, 1, 2, 4}, X_2x4, {1.0f, 1.0f, 0.5f, 0.5f}, {1, 1, 1, 2}, {3.5f, 5.5f}},
+      // new input shape with the same scales
+      {{1, 1, 4, 4}, X_4x4, {1.0f, 1.0f, 0.5f, 0.5f}, {1, 1, 2, 2}, {3.5f, 5.5f, 11.5f, 13.5f}},
+      // back to the first input shape and scales
+      {{1, 1, 2, 4}, X_2x4, {1.0f, 1.0f, 0.6f, 0.6f}, {1, 1, 1, 2}, {2.66666651f, 4.3333331f}},
+  };
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  for (const auto& run : runs) {
+    NameMLValMap feeds;
+    OrtValue ml_value;
+    CreateMLValue<float>(allocator, run.input_dims, run.input, &ml_value);
+    feeds.insert(std::make_pair("X", ml_value));
+    CreateMLValue<float>(allocator, {0}, {}, &ml_value);
+    feeds.insert(std::make_pair("roi", ml_value));
+    CreateMLValue<float>(allocator, {4}, run.scales, &ml_value);
+    feeds.insert(std::make_pair("scales", ml_value));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape().GetDims(), run.output_dims);
+    const float* output_data = output.Data<float>();
+    for (size_t i = 0; i < run.output.size(); ++i) {
+      EXPECT_NEAR(run.output[i], output_data[i], 1e-5f) << "i=" << i;
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
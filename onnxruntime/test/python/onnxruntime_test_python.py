@@ -234,6 +234,74 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelZeroCopyOutputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, zero_copy_outputs=True)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+        # the array keeps the onnxruntime buffer alive through its base object
+        self.assertIsNotNone(res[0].base)
+        del sess
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunMany(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        xs = [np.full((3, 2), i, dtype=np.float32) for i in range(8)]
+        res = sess.run_many(["Y"], [{"X": x} for x in xs], max_concurrency=4)
+        self.assertEqual(len(res), len(xs))
+        for x, r in zip(xs, res):
+            np.testing.assert_allclose(x * x, r[0], rtol=1e-05, atol=1e-08)
+
+    def testRunManyConcurrentCalls(self):
+        # run_many calls with different concurrency limits issued from several threads at once.
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        xs = [np.full((3, 2), i, dtype=np.float32) for i in range(16)]
+        errors = []
+
+        def run(max_concurrency):
+            try:
+                for _ in range(4):
+                    res = sess.run_many(["Y"], [{"X": x} for x in xs], max_concurrency=max_concurrency)
+                    for x, r in zip(xs, res):
+                        np.testing.assert_allclose(x * x, r[0], rtol=1e-05, atol=1e-08)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(c,)) for c in (1, 2, 3, 0)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+
+    def testRunManyUsesIntraOpPool(self):
+        # Each run is large enough for MatMul to split its work across the session's intra-op pool, so the
+        # concurrent runs all enter that pool's parallel sections.
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 4
+        sess = onnxrt.InferenceSession(get_name("matmul_large.onnx"), sess_options=so)
+        rng = np.random.RandomState(0)
+        feeds = [{"A": rng.rand(256, 384).astype(np.float32), "B": rng.rand(384, 320).astype(np.float32)}
+                 for _ in range(12)]
+        for max_concurrency in (1, 3, 0):
+            res = sess.run_many(["Y"], feeds, max_concurrency=max_concurrency)
+            self.assertEqual(len(res), len(feeds))
+            for feed, r in zip(feeds, res):
+                np.testing.assert_allclose(np.matmul(feed["A"], feed["B"]), r[0], rtol=1e-04, atol=1e-04)
+
+    def testRunModelOutputBuffers(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, output_buffers={"Y": y})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        self.assertIs(res[0], y)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(Exception):
+            sess.run(["Y"], {"X": x}, output_buffers={"Y": np.zeros((2, 3), dtype=np.float32)})
+
     def testRunModelFromBytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -749,6 +749,34 @@ TEST(CApiTest, fill_string_tensor) {
   ASSERT_EQ(len, expected_len);
 }
 
+TEST(CApiTest, fill_string_tensor_from_content) {
+  // contents as returned by GetStringTensorContent, including an empty string and an embedded '\0'
+  const std::string content("abc" "kmp\0x", 8);
+  const size_t offsets[] = {0, 3, 3};
+  int64_t expected_len = 3;
+  auto default_allocator = onnxruntime::make_unique<MockedOrtAllocator>();
+
+  Ort::Value tensor = Ort::Value::CreateTensor(default_allocator.get(), &expected_len, 1, ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  tensor.FillStringTensorFromContent(content.data(), content.size(), offsets, 3);
+
+  ASSERT_EQ(tensor.GetStringTensorElementLength(0), 3u);
+  ASSERT_EQ(tensor.GetStringTensorElementLength(1), 0u);
+  ASSERT_EQ(tensor.GetStringTensorElementLength(2), 5u);
+
+  // round trip
+  size_t data_len = tensor.GetStringTensorDataLength();
+  ASSERT_EQ(data_len, content.size());
+  std::string result(data_len, '\0');
+  std::vector<size_t> result_offsets(expected_len);
+  tensor.GetStringTensorContent((void*)result.data(), data_len, result_offsets.data(), result_offsets.size());
+  ASSERT_EQ(result, content);
+  ASSERT_TRUE(std::equal(result_offsets.begin(), result_offsets.end(), std::begin(offsets)));
+
+  // offsets out of order
+  const size_t bad_offsets[] = {0, 4, 3};
+  ASSERT_THROW(tensor.FillStringTensorFromContent(content.data(), content.size(), bad_offsets, 3), Ort::Exception);
+}
+
 TEST(CApiTest, get_string_tensor_element) {
   const char* s[] = {"abc", "kmp"};
   int64_t expected_len = 2;
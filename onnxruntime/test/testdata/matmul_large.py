@@ -0,0 +1,30 @@
+import onnx
+from onnx import helper
+from onnx import TensorProto
+
+# A MatMul with two dynamic inputs. Fed with a few hundred rows and columns it is big enough for the
+# CPU kernel to split the work across the session's intra-op thread pool.
+def GenerateModel(model_name):
+    nodes = [
+        helper.make_node("MatMul", ["A", "B"], ["Y"], "matmul"),
+    ]
+
+    inputs = [
+        helper.make_tensor_value_info('A', TensorProto.FLOAT, ['M', 'K']),
+        helper.make_tensor_value_info('B', TensorProto.FLOAT, ['K', 'N']),
+    ]
+
+    graph = helper.make_graph(
+        nodes,
+        "matmul_large",
+        inputs,
+        [
+            helper.make_tensor_value_info('Y', TensorProto.FLOAT, ['M', 'N']),
+        ])
+
+    model = helper.make_model(graph, opset_imports=[helper.make_operatorsetid("", 11)])
+    model.ir_version = 6
+    onnx.save(model, model_name)
+
+if __name__ == "__main__":
+    GenerateModel('matmul_large.onnx')
@@ -0,0 +1,304 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "batcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "serializing/tensorprotoutils.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct RequestBatcher::Request {
+  const std::vector<std::string>* input_names;
+  const std::vector<Ort::Value>* input_values;
+  const std::vector<std::string>* output_names;
+  int64_t rows;
+  // Requests can only be merged if their signatures are equal.
+  std::string signature;
+  uint64_t id;
+  std::chrono::steady_clock::time_point arrival;
+  std::promise<std::vector<Ort::Value>> result;
+};
+
+static std::string GetSignature(const std::vector<std::string>& input_names,
+                                const std::vector<Ort::Value>& input_values,
+                                const std::vector<std::string>& output_names) {
+  std::string signature;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    auto info = input_values[i].GetTensorTypeAndShapeInfo();
+    signature += input_names[i];
+    signature += ':' + std::to_string(static_cast<int>(info.GetElementType()));
+    const auto shape = info.GetShape();
+    for (size_t d = 1; d < shape.size(); ++d) {
+      signature += ',' + std::to_string(shape[d]);
+    }
+    signature += ';';
+  }
+  signature += "->";
+  for (const auto& name : output_names) {
+    signature += name + ';';
+  }
+  return signature;
+}
+
+// Bytes taken by the whole tensor.
+static size_t GetTensorBytes(const Ort::Value& value) {
+  auto info = value.GetTensorTypeAndShapeInfo();
+  return info.GetElementCount() * GetElementSize(info.GetElementType());
+}
+
+bool RequestBatcher::CanBatch(const std::vector<Ort::Value>& input_values) {
+  if (input_values.empty()) {
+    return false;
+  }
+
+  int64_t rows = -1;
+  for (const auto& value : input_values) {
+    if (!value.IsTensor()) {
+      return false;
+    }
+    auto info = value.GetTensorTypeAndShapeInfo();
+    const auto type = info.GetElementType();
+    if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING || type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED ||
+        type == ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64 || type == ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128) {
+      return false;
+    }
+    const auto shape = info.GetShape();
+    if (shape.empty() || shape[0] <= 0 || (rows != -1 && shape[0] != rows)) {
+      return false;
+    }
+    rows = shape[0];
+  }
+  return true;
+}
+
+RequestBatcher::RequestBatcher(const BatchingOptions& options, int num_workers, RunFn run)
+    : options_(options), run_(std::move(run)) {
+  for (int i = 0; i < std::max(1, num_workers); ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::vector<Ort::Value> RequestBatcher::Run(const std::vector<std::string>& input_names,
+                                            const std::vector<Ort::Value>& input_values,
+                                            const std::vector<std::string>& output_names) {
+  const int64_t rows = input_values[0].GetTensorTypeAndShapeInfo().GetShape()[0];
+  if (rows >= options_.max_batch_size) {
+    // already a full batch
+    return run_(input_names, input_values, output_names);
+  }
+
+  Request request;
+  request.input_names = &input_names;
+  request.input_values = &input_values;
+  request.output_names = &output_names;
+  request.rows = rows;
+  request.signature = GetSignature(input_names, input_values, output_names);
+  request.arrival = std::chrono::steady_clock::now();
+  auto result = request.result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request.id = next_request_id_++;
+    queue_.push_back(&request);
+  }
+  cv_.notify_all();
+
+  return result.get();
+}
+
+std::chrono::microseconds RequestBatcher::QueueingDelay() const {
+  int64_t delay_us = options_.max_delay_us;
+  if (options_.latency_slo_ms > 0) {
+    // leave enough of the latency budget to run a full batch
+    const auto expected_run_us = static_cast<int64_t>(run_us_per_row_ * options_.max_batch_size);
+    delay_us = std::min(delay_us, std::max<int64_t>(0, options_.latency_slo_ms * 1000 - expected_run_us));
+  }
+  return std::chrono::microseconds(delay_us);
+}
+
+int64_t RequestBatcher::PendingRows(const Request& head) const {
+  int64_t rows = 0;
+  for (const auto* request : queue_) {
+    if (request->signature == head.signature) {
+      rows += request->rows;
+    }
+  }
+  return rows;
+}
+
+std::vector<RequestBatcher::Request*> RequestBatcher::TakeBatch() {
+  std::vector<Request*> batch;
+  const Request& head = *queue_.front();
+  int64_t rows = 0;
+  for (auto it = queue_.begin(); it != queue_.end();) {
+    Request* request = *it;
+    if (request->signature == head.signature &&
+        (batch.empty() || rows + request->rows <= options_.max_batch_size)) {
+      rows += request->rows;
+      batch.push_back(request);
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return batch;
+}
+
+void RequestBatcher::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+
+    // Wait for the batch of the oldest request to fill up, unless another worker takes it first.
+    const Request* head = queue_.front();
+    const uint64_t head_id = head->id;
+    const auto deadline = head->arrival + QueueingDelay();
+    bool taken = false;
+    while (!stop_ && PendingRows(*head) < options_.max_batch_size && std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_until(lock, deadline);
+      if (queue_.empty() || queue_.front()->id != head_id) {
+        taken = true;
+        break;
+      }
+    }
+    if (taken) {
+      continue;
+    }
+
+    auto batch = TakeBatch();
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+// Runs the requests in batch as a single run of the concatenated inputs and splits the outputs back.
+// Returns false if the outputs can't be split along dim 0.
+static bool RunMerged(const RequestBatcher::RunFn& run, const std::vector<std::string>& input_names,
+                      const std::vector<const std::vector<Ort::Value>*>& request_inputs,
+                      const std::vector<int64_t>& request_rows, const std::vector<std::string>& output_names,
+                      std::vector<std::vector<Ort::Value>>& results) {
+  int64_t total_rows = 0;
+  for (auto rows : request_rows) {
+    total_rows += rows;
+  }
+
+  // Concatenate every input along dim 0.
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<Ort::Value> inputs;
+  inputs.reserve(input_names.size());
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    auto info = (*request_inputs[0])[i].GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    shape[0] = total_rows;
+    auto input = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+    auto* dst = input.GetTensorMutableData<uint8_t>();
+    for (const auto* values : request_inputs) {
+      auto& value = const_cast<Ort::Value&>((*values)[i]);
+      const size_t bytes = GetTensorBytes(value);
+      std::memcpy(dst, value.GetTensorMutableData<uint8_t>(), bytes);
+      dst += bytes;
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  auto outputs = run(input_names, inputs, output_names);
+
+  const bool splittable = std::all_of(outputs.begin(), outputs.end(), [total_rows](const Ort::Value& output) {
+    if (!output.IsTensor()) {
+      return false;
+    }
+    auto info = output.GetTensorTypeAndShapeInfo();
+    const auto shape = info.GetShape();
+    return info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING && !shape.empty() && shape[0] == total_rows;
+  });
+  if (!splittable) {
+    return false;
+  }
+
+  // Split every output back along dim 0.
+  results.clear();
+  results.resize(request_rows.size());
+  for (auto& output : outputs) {
+    auto info = output.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    const size_t row_bytes = GetTensorBytes(output) / static_cast<size_t>(total_rows);
+    const auto* src = output.GetTensorMutableData<uint8_t>();
+    for (size_t r = 0; r < request_rows.size(); ++r) {
+      shape[0] = request_rows[r];
+      auto slice = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+      const size_t bytes = row_bytes * static_cast<size_t>(request_rows[r]);
+      std::memcpy(slice.GetTensorMutableData<uint8_t>(), src, bytes);
+      src += bytes;
+      results[r].push_back(std::move(slice));
+    }
+  }
+  return true;
+}
+
+void RequestBatcher::RunBatch(const std::vector<Request*>& batch) {
+  if (batch.size() > 1) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<const std::vector<Ort::Value>*> request_inputs;
+    std::vector<int64_t> request_rows;
+    int64_t total_rows = 0;
+    for (const auto* request : batch) {
+      request_inputs.push_back(request->input_values);
+      request_rows.push_back(request->rows);
+      total_rows += request->rows;
+    }
+
+    std::vector<std::vector<Ort::Value>> results;
+    bool merged = false;
+    try {
+      merged = RunMerged(run_, *batch[0]->input_names, request_inputs, request_rows, *batch[0]->output_names,
+                         results);
+    } catch (...) {
+      // e.g. the model has a fixed dim 0, or the merged inputs don't fit in memory. Running the requests on their
+      // own reports any real error to each of them, and no request is left without a result.
+      merged = false;
+    }
+
+    if (merged) {
+      const auto run_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const double us_per_row = static_cast<double>(run_us.count()) / static_cast<double>(total_rows);
+        run_us_per_row_ = run_us_per_row_ == 0 ? us_per_row : 0.8 * run_us_per_row_ + 0.2 * us_per_row;
+      }
+      for (size_t r = 0; r < batch.size(); ++r) {
+        batch[r]->result.set_value(std::move(results[r]));
+      }
+      return;
+    }
+  }
+
+  for (auto* request : batch) {
+    try {
+      request->result.set_value(run_(*request->input_names, *request->input_values, *request->output_names));
+    } catch (...) {
+      request->result.set_exception(std::current_exception());
+    }
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
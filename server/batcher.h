@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct BatchingOptions {
+  // Largest number of rows (dim 0 summed over the merged requests) run at once. 1 disables batching.
+  int max_batch_size = 1;
+  // Longest time the oldest queued request waits for the batch to fill up.
+  int max_delay_us = 1000;
+  // Target end to end latency. When set, the queueing delay is shortened so that the wait plus the expected run
+  // time of the batch stays within it. 0 means no target.
+  int latency_slo_ms = 0;
+};
+
+struct ModelOptions {
+  // Number of sessions created for the model. Requests and batches are spread over them round robin.
+  int session_pool_size = 1;
+  BatchingOptions batching;
+};
+
+// Merges concurrent requests to the same model into a single run along dim 0.
+// Requests are compatible when they have the same input and output names and their inputs have the same element
+// types and the same dims apart from dim 0. A batch is run as soon as it is full or the oldest request in it has
+// waited for the queueing delay. If the merged run fails, e.g. because the model has a fixed dim 0, or its outputs
+// don't have the merged batch size as dim 0, the requests are run one by one instead.
+class RequestBatcher {
+ public:
+  using RunFn = std::function<std::vector<Ort::Value>(const std::vector<std::string>& input_names,
+                                                      const std::vector<Ort::Value>& input_values,
+                                                      const std::vector<std::string>& output_names)>;
+
+  // num_workers batches can run at the same time, normally one per session of the model.
+  RequestBatcher(const BatchingOptions& options, int num_workers, RunFn run);
+  ~RequestBatcher();
+  RequestBatcher(const RequestBatcher&) = delete;
+  RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+  // Whether the inputs can be merged with other requests: all are non-string tensors with at least one dim and
+  // the same dim 0.
+  static bool CanBatch(const std::vector<Ort::Value>& input_values);
+
+  // Queues the request and blocks until it has run as part of a batch. Throws Ort::Exception on failure.
+  std::vector<Ort::Value> Run(const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+ private:
+  struct Request;
+
+  void WorkerLoop();
+  std::chrono::microseconds QueueingDelay() const;
+  int64_t PendingRows(const Request& head) const;
+  std::vector<Request*> TakeBatch();
+  void RunBatch(const std::vector<Request*>& batch);
+
+  const BatchingOptions options_;
+  const RunFn run_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request*> queue_;
+  uint64_t next_request_id_ = 0;
+  bool stop_ = false;
+
+  // Exponential moving average of the run time per row, used to honor the latency target.
+  double run_us_per_row_ = 0;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include "environment.h"
+#include "executor.h"
 #include "onnxruntime_cxx_api.h"
 
 #ifdef USE_DNNL
@@ -86,23 +87,40 @@ void ServerEnvironment::RegisterExecutionProviders(){
 
 }
 
-void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
-  RegisterExecutionProviders();
-  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
+void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                                        const ModelOptions& model_options) {
+  // every model shares options_, so the providers must only be appended once
+  if (!providers_registered_) {
+    RegisterExecutionProviders();
+    providers_registered_ = true;
+  }
+  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_, model_options.session_pool_size));
 
   if (!result.second) {
     throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
   }
 
   auto iterator = result.first;
-  auto output_count = (iterator->second).session.GetOutputCount();
+  auto output_count = (iterator->second).sessions[0].GetOutputCount();
 
   Ort::AllocatorWithDefaultOptions allocator;
   for (size_t i = 0; i < output_count; i++) {
-    auto name = (iterator->second).session.GetOutputName(i, allocator);
+    auto name = (iterator->second).sessions[0].GetOutputName(i, allocator);
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (model_options.batching.max_batch_size > 1) {
+    const SessionHolder& holder = iterator->second;
+    (iterator->second).batcher = std::make_unique<RequestBatcher>(
+        model_options.batching, static_cast<int>(holder.sessions.size()),
+        [this, &holder](const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values,
+                        const std::vector<std::string>& output_names) {
+          Ort::RunOptions run_options{};
+          run_options.SetRunLogVerbosityLevel(static_cast<int>(severity_));
+          return Run(holder.NextSession(), run_options, input_names, input_values, output_names);
+        });
+  }
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
@@ -126,7 +144,17 @@ const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name,
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  return it->second.session;
+  return it->second.NextSession();
+}
+
+RequestBatcher* ServerEnvironment::GetBatcher(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batcher.get();
 }
 
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
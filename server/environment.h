@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
+#include "batcher.h"
 #include "onnxruntime_cxx_api.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
@@ -22,8 +25,12 @@ class ServerEnvironment {
 
   OrtLoggingLevel GetLogSeverity() const;
 
+  // Returns the next session of the model's pool, round robin.
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
-  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  // Returns the request batcher of the model, or nullptr if batching is disabled for it.
+  RequestBatcher* GetBatcher(const std::string& model_name, const std::string& model_version) const;
+  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                       const ModelOptions& model_options = ModelOptions());
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
@@ -38,13 +45,22 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  bool providers_registered_ = false;
 
   struct SessionHolder {
-    Ort::Session session;
+    std::vector<Ort::Session> sessions;
+    mutable std::atomic<size_t> next_session{0};
     std::vector<std::string> output_names;
-    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
-      session = Ort::Session(env, path.c_str(), options);
+    // Declared after the sessions so it is destroyed, and its workers joined, before them.
+    std::unique_ptr<RequestBatcher> batcher;
+    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options, int pool_size) {
+      for (int i = 0; i < std::max(1, pool_size); ++i) {
+        sessions.emplace_back(env, path.c_str(), options);
+      }
     };
+    const Ort::Session& NextSession() const {
+      return sessions[next_session.fetch_add(1, std::memory_order_relaxed) % sessions.size()];
+    }
     ~SessionHolder() = default;
     SessionHolder(const SessionHolder&) = delete;
     SessionHolder(const SessionHolder&&) = delete;
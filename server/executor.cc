@@ -23,6 +23,16 @@ protobufutil::Status Executor::SetMLValue(const onnx::TensorProto& input_tensor,
                                           /* out */ Ort::Value& ml_value) {
   auto logger = env_->GetLogger(request_id_);
 
+  // Tensors sent as raw_data are used in place: the request outlives the run.
+  try {
+    if (onnxruntime::server::TryWrapRawDataAsMLValue(input_tensor, *cpu_memory_info, ml_value)) {
+      return protobufutil::Status::OK;
+    }
+  } catch (const Ort::Exception& e) {
+    logger->error("TryWrapRawDataAsMLValue() failed. Message: {}", e.what());
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
   size_t cpu_tensor_length = 0;
   try {
     onnxruntime::server::GetSizeInBytesFromTensorProto<0>(input_tensor, &cpu_tensor_length);
@@ -101,8 +111,6 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
                                        const std::string& model_version,
                                        const onnxruntime::server::PredictRequest& request,
                                        /* out */ onnxruntime::server::PredictResponse& response) {
-  auto logger = env_->GetLogger(request_id_);
-
   // Convert PredictRequest to NameMLValMap
   MemBufferArray buffer_array;
   std::vector<std::string> input_names;
@@ -112,6 +120,18 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
     return conversion_status;
   }
 
+  std::vector<std::string> output_filter(request.output_filter().begin(), request.output_filter().end());
+  return Predict(model_name, model_version, input_names, input_values, output_filter, response);
+}
+
+protobufutil::Status Executor::Predict(const std::string& model_name,
+                                       const std::string& model_version,
+                                       const std::vector<std::string>& input_names,
+                                       const std::vector<Ort::Value>& input_values,
+                                       const std::vector<std::string>& output_filter,
+                                       /* out */ onnxruntime::server::PredictResponse& response) {
+  auto logger = env_->GetLogger(request_id_);
+
   Ort::RunOptions run_options{};
   run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
   run_options.SetRunTag(request_id_.c_str());
@@ -119,18 +139,20 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
   // Prepare the output names
   std::vector<std::string> output_names;
 
-  if (!request.output_filter().empty()) {
-    output_names.reserve(request.output_filter_size());
-    for (const auto& name : request.output_filter()) {
-      output_names.push_back(name);
-    }
+  if (!output_filter.empty()) {
+    output_names = output_filter;
   } else {
     output_names = env_->GetModelOutputNames(model_name, model_version);
   }
 
   std::vector<Ort::Value> outputs;
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    RequestBatcher* batcher = env_->GetBatcher(model_name, model_version);
+    if (batcher != nullptr && RequestBatcher::CanBatch(input_values)) {
+      outputs = batcher->Run(input_names, input_values, output_names);
+    } else {
+      outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    }
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
   }
@@ -13,6 +13,11 @@
 namespace onnxruntime {
 namespace server {
 
+// Runs the session on the named inputs and returns the requested outputs. Throws Ort::Exception on failure.
+std::vector<Ort::Value> Run(const Ort::Session& session, const Ort::RunOptions& options,
+                            const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values,
+                            const std::vector<std::string>& output_names);
+
 class Executor {
  public:
   Executor(ServerEnvironment* server_env, std::string request_id) : env_(server_env),
@@ -25,6 +30,16 @@ class Executor {
                                          const onnxruntime::server::PredictRequest& request,
                                          /* out */ onnxruntime::server::PredictResponse& response);
 
+  // Prediction method for inputs that were already decoded, e.g. from a binary tensor stream.
+  // The values and the memory they wrap must stay alive until the call returns.
+  // An empty output_filter requests all the model outputs.
+  google::protobuf::util::Status Predict(const std::string& model_name,
+                                         const std::string& model_version,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<Ort::Value>& input_values,
+                                         const std::vector<std::string>& output_filter,
+                                         /* out */ onnxruntime::server::PredictResponse& response);
+
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
@@ -10,11 +10,25 @@ namespace grpc {
 
 PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env) : environment_(env) {}
 
+// Optional client metadata selecting the hosted model, the same as the name and version in the HTTP route.
+static constexpr const char* kModelNameMetadata = "model-name";
+static constexpr const char* kModelVersionMetadata = "model-version";
+
+static std::string GetMetadata(const ::grpc::ServerContext* context, const char* key, const std::string& default_value) {
+  const auto& metadata = context->client_metadata();
+  auto search = metadata.find(key);
+  if (search == metadata.end() || search->second.length() == 0) {
+    return default_value;
+  }
+  return std::string{search->second.data(), search->second.length()};
+}
+
 ::grpc::Status PredictionServiceImpl::Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response) {
   auto request_id = SetRequestContext(context);
   onnxruntime::server::Executor executor(environment_.get(), request_id);
-  //TODO: (csteegz) Add modelspec for both paths.
-  auto status = executor.Predict("default", "1", *request, *response);  // Currently only support one model so hard coded.
+  auto model_name = GetMetadata(context, kModelNameMetadata, "default");
+  auto model_version = GetMetadata(context, kModelVersionMetadata, "1");
+  auto status = executor.Predict(model_name, model_version, *request, *response);
   if (!status.ok()) {
     return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
   }
@@ -7,6 +7,7 @@
 #include "http_server.h"
 #include "json_handling.h"
 #include "executor.h"
+#include "serializing/tensor_stream.h"
 #include "util.h"
 
 namespace onnxruntime {
@@ -53,21 +54,38 @@ void Predict(const std::string& name,
     GenerateErrorResponse(logger, http::status::bad_request, "Unknown 'Accept' header field in the request", context);
   }
 
-  // Deserialize the payload
-  auto body = context.request.body();
-  PredictRequest predict_request{};
-  http::status error_code;
-  std::string error_message;
-  bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
-  if (!parse_succeeded) {
-    GenerateErrorResponse(logger, error_code, error_message, context);
-    return;
-  }
-
   // Run Prediction
   Executor executor(env.get(), context.request_id);
   PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+  protobufutil::Status status;
+  if (request_type == SupportedContentType::TensorStream) {
+    // The tensors are decoded straight out of the request body, which stays alive until the run is done.
+    const auto& body = context.request.body();
+    MemBufferArray buffers;
+    std::vector<std::string> output_filter;
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    try {
+      Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+      DecodeTensorStream(body.data(), body.size(), *memory_info, buffers, output_filter, input_names, input_values);
+    } catch (const Ort::Exception& e) {
+      GenerateErrorResponse(logger, http::status::bad_request, e.what(), context);
+      return;
+    }
+    status = executor.Predict(effective_name, effective_version, input_names, input_values, output_filter,
+                              predict_response);
+  } else {
+    // Deserialize the payload
+    PredictRequest predict_request{};
+    http::status error_code;
+    std::string error_message;
+    bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
+    if (!parse_succeeded) {
+      GenerateErrorResponse(logger, error_code, error_message, context);
+      return;
+    }
+    status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+  }
   if (!status.ok()) {
     GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
     return;
@@ -101,7 +119,7 @@ void Predict(const std::string& name,
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
@@ -7,6 +7,7 @@
 #include <google/protobuf/stubs/status.h>
 
 #include "context.h"
+#include "serializing/tensor_stream.h"
 #include "util.h"
 
 namespace protobufutil = google::protobuf::util;
@@ -60,6 +61,8 @@ SupportedContentType GetRequestContentType(const HttpContext& context) {
       return SupportedContentType::Json;
     } else if (protobuf_mime_types.find(context.request["Content-Type"].to_string()) != protobuf_mime_types.end()) {
       return SupportedContentType::PbByteArray;
+    } else if (context.request["Content-Type"] == kTensorStreamContentType) {
+      return SupportedContentType::TensorStream;
     }
   }
 
@@ -60,16 +60,21 @@ int main(int argc, char* argv[]) {
 
   const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()});
   auto logger = env->GetAppLogger();
-  logger->info("Model path: {}, ", config.model_path);
-  logger->info("Model name: {}", config.model_name);
-  logger->info("Model version: {}", config.model_version);
-
-  try {
-    env->InitializeModel(config.model_path, config.model_name, config.model_version);
-    logger->debug("Initialize Model Successfully!");
-  } catch (const Ort::Exception& ex) {
-    logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
-    exit(EXIT_FAILURE);
+  for (const auto& model : config.models) {
+    logger->info("Model path: {}, ", model.path);
+    logger->info("Model name: {}", model.name);
+    logger->info("Model version: {}", model.version);
+    logger->info("Session pool size: {}, max batch size: {}, max batch delay: {}us, latency SLO: {}ms",
+                 model.options.session_pool_size, model.options.batching.max_batch_size,
+                 model.options.batching.max_delay_us, model.options.batching.latency_slo_ms);
+
+    try {
+      env->InitializeModel(model.path, model.name, model.version, model.options);
+      logger->debug("Initialize Model Successfully!");
+    } catch (const Ort::Exception& ex) {
+      logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
+      exit(EXIT_FAILURE);
+    }
   }
 
   //Setup GRPC Server
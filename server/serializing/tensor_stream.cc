@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "tensor_stream.h"
+
+#include <cstring>
+#include <limits>
+
+#include "tensorprotoutils.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+class StreamReader {
+ public:
+  StreamReader(const char* data, size_t len) : cur_(data), end_(data + len) {}
+
+  bool AtEnd() const { return cur_ == end_; }
+
+  template <typename T>
+  T Read() {
+    T v;
+    std::memcpy(&v, Take(sizeof(T)), sizeof(T));
+    return v;
+  }
+
+  std::string ReadString() {
+    const auto len = Read<uint32_t>();
+    return std::string(Take(len), len);
+  }
+
+  const char* Take(size_t n) {
+    if (static_cast<size_t>(end_ - cur_) < n) {
+      throw Ort::Exception("Tensor stream: truncated payload", OrtErrorCode::ORT_INVALID_ARGUMENT);
+    }
+    const char* p = cur_;
+    cur_ += n;
+    return p;
+  }
+
+ private:
+  const char* cur_;
+  const char* const end_;
+};
+}  // namespace
+
+void DecodeTensorStream(const char* data, size_t len, const OrtMemoryInfo& info, MemBufferArray& buffers,
+                        std::vector<std::string>& output_filter,
+                        std::vector<std::string>& names, std::vector<Ort::Value>& values) {
+  const uint16_t endian_probe = 1;
+  if (*reinterpret_cast<const uint8_t*>(&endian_probe) != 1) {
+    throw Ort::Exception("Tensor stream: big endian hosts are not supported", OrtErrorCode::ORT_NOT_IMPLEMENTED);
+  }
+
+  StreamReader reader(data, len);
+  const auto num_outputs = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_outputs; ++i) {
+    output_filter.push_back(reader.ReadString());
+  }
+
+  while (!reader.AtEnd()) {
+    std::string name = reader.ReadString();
+
+    const auto type = CApiElementTypeFromProtoType(reader.Read<int32_t>());
+    const size_t element_size = GetElementSize(type);
+
+    const auto num_dims = reader.Read<uint32_t>();
+    std::vector<int64_t> dims(num_dims);
+    size_t num_elements = 1;
+    for (auto& dim : dims) {
+      dim = reader.Read<int64_t>();
+      if (dim < 0) {
+        throw Ort::Exception("Tensor stream: negative dim for input " + name, OrtErrorCode::ORT_INVALID_ARGUMENT);
+      }
+      if (dim != 0 && num_elements > std::numeric_limits<size_t>::max() / static_cast<size_t>(dim)) {
+        throw Ort::Exception("Tensor stream: size overflow for input " + name, OrtErrorCode::ORT_INVALID_ARGUMENT);
+      }
+      num_elements *= static_cast<size_t>(dim);
+    }
+
+    const auto data_len = reader.Read<uint64_t>();
+    if (num_elements > std::numeric_limits<size_t>::max() / element_size || data_len != num_elements * element_size) {
+      throw Ort::Exception("Tensor stream: data length does not match the dims of input " + name,
+                           OrtErrorCode::ORT_INVALID_ARGUMENT);
+    }
+    const char* tensor_data = reader.Take(static_cast<size_t>(data_len));
+
+    // Use the payload in place when it is aligned for the element type, otherwise copy it out.
+    void* buffer = const_cast<char*>(tensor_data);
+    if (reinterpret_cast<uintptr_t>(tensor_data) % element_size != 0) {
+      buffer = buffers.AllocNewBuffer(static_cast<size_t>(data_len));
+      std::memcpy(buffer, tensor_data, static_cast<size_t>(data_len));
+    }
+
+    values.push_back(Ort::Value::CreateTensor(&info, buffer, static_cast<size_t>(data_len), dims.data(), dims.size(),
+                                              type));
+    names.push_back(std::move(name));
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "onnxruntime_c_api.h"
+#include "onnxruntime_cxx_api.h"
+
+#include "util.h"
+
+namespace onnxruntime {
+namespace server {
+
+/**
+ * Binary request payload carrying the input tensors without any protobuf or JSON encoding.
+ * All integers are little endian. The payload starts with the output filter:
+ *   uint32  number of requested outputs (0 requests all the model outputs), followed by that many names, each
+ *           a uint32 name length followed by the name bytes
+ * The rest of the payload is a sequence of tensors, each laid out as:
+ *   uint32  name length, followed by the name bytes
+ *   int32   element type (onnx::TensorProto_DataType, string tensors are not supported)
+ *   uint32  number of dims, followed by that many int64 dims
+ *   uint64  data length in bytes, followed by the tensor data
+ */
+constexpr const char* kTensorStreamContentType = "application/x-onnxruntime-tensors";
+
+/**
+ * Decode a binary tensor stream into the output filter and input values.
+ * Tensor data that is suitably aligned is used in place, so the payload must outlive the values. Other tensors
+ * are copied into buffers owned by `buffers`. Throws Ort::Exception on malformed payloads.
+ */
+void DecodeTensorStream(const char* data, size_t len, const OrtMemoryInfo& info, MemBufferArray& buffers,
+                        /* out */ std::vector<std::string>& output_filter,
+                        /* out */ std::vector<std::string>& names, /* out */ std::vector<Ort::Value>& values);
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -304,6 +304,30 @@ ONNXTensorElementDataType CApiElementTypeFromProtoType(int type) {
   }
 }
 
+size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    default:
+      throw Ort::Exception("Unsupported tensor element type", OrtErrorCode::ORT_INVALID_ARGUMENT);
+  }
+}
+
 ONNXTensorElementDataType GetTensorElementType(const onnx::TensorProto& tensor_proto) {
   return CApiElementTypeFromProtoType(tensor_proto.data_type());
 }
@@ -378,6 +402,36 @@ void TensorProtoToMLValue(const onnx::TensorProto& tensor_proto, const MemBuffer
   value = Ort::Value::CreateTensor(&allocator, tensor_data, m.GetLen(), tensor_shape_vec.data(), tensor_shape_vec.size(), (ONNXTensorElementDataType)tensor_proto.data_type());
   return;
 }
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& tensor_proto, const OrtMemoryInfo& info, Ort::Value& value) {
+  if (!tensor_proto.has_raw_data() || !IsLittleEndianOrder() ||
+      tensor_proto.data_location() == onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL) {
+    return false;
+  }
+  const ONNXTensorElementDataType ele_type = server::GetTensorElementType(tensor_proto);
+  if (ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING || ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+    return false;
+  }
+
+  size_t size_in_bytes = 0;
+  try {
+    GetSizeInBytesFromTensorProto<0>(tensor_proto, &size_in_bytes);
+  } catch (const Ort::Exception&) {
+    // let the copying path report the error
+    return false;
+  }
+
+  const std::string& raw_data = tensor_proto.raw_data();
+  // Every supported element type is at most 8 bytes wide, so 8 byte alignment suits all of them.
+  if (raw_data.size() != size_in_bytes || reinterpret_cast<uintptr_t>(raw_data.data()) % 8 != 0) {
+    return false;
+  }
+
+  std::vector<int64_t> tensor_shape_vec = GetTensorShapeFromTensorProto(tensor_proto);
+  value = Ort::Value::CreateTensor(&info, const_cast<char*>(raw_data.data()), raw_data.size(),
+                                   tensor_shape_vec.data(), tensor_shape_vec.size(), ele_type);
+  return true;
+}
+
 template void GetSizeInBytesFromTensorProto<256>(const onnx::TensorProto& tensor_proto,
                                                  size_t* out);
 template void GetSizeInBytesFromTensorProto<0>(const onnx::TensorProto& tensor_proto, size_t* out);
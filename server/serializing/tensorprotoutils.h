@@ -27,11 +27,21 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * Wrap the raw_data bytes of a TensorProto as a tensor without copying them.
+ * Returns false, leaving value untouched, if the bytes can't be used in place: no raw data, string tensor,
+ * big endian host, size not matching the dims or misaligned data. The TensorProto must outlive the value.
+ */
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& input, const OrtMemoryInfo& info, /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
 
 ONNXTensorElementDataType CApiElementTypeFromProtoType(int type);
 ONNXTensorElementDataType GetTensorElementType(const onnx::TensorProto& tensor_proto);
+
+// Size in bytes of one element of a fixed size tensor type. Throws for string and unsupported types.
+size_t GetElementSize(ONNXTensorElementDataType type);
 }  // namespace server
 }  // namespace onnxruntime
@@ -5,10 +5,14 @@
 
 #include <thread>
 #include <fstream>
+#include <set>
+#include <sstream>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/program_options.hpp"
 #include "onnxruntime_cxx_api.h"
+#include "batcher.h"
 
 namespace onnxruntime {
 namespace server {
@@ -33,6 +37,14 @@ static std::unordered_map<std::string, OrtLoggingLevel> supported_log_levels{
     {"error", ORT_LOGGING_LEVEL_ERROR},
     {"fatal", ORT_LOGGING_LEVEL_FATAL}};
 
+// A model hosted by the server
+struct ModelConfig {
+  std::string path;
+  std::string name;
+  std::string version;
+  ModelOptions options;
+};
+
 // Wrapper around Boost program_options and should provide all the functionality for options parsing
 // Provides sane default values
 class ServerConfiguration {
@@ -47,16 +59,34 @@ class ServerConfiguration {
   int num_http_threads = std::thread::hardware_concurrency();
   OrtLoggingLevel logging_level{};
 
+  // Defaults for the per model settings
+  int session_pool_size = 1;
+  int max_batch_size = 1;
+  int max_batch_delay_us = 1000;
+  int latency_slo_ms = 0;
+
+  // Every model to host: the one given by model_path, model_name and model_version followed by the --model ones.
+  // Filled by ParseInput.
+  std::vector<ModelConfig> models;
+
   ServerConfiguration() {
     desc.add_options()("help,h", "Shows a help message and exits");
     desc.add_options()("log_level", po::value(&log_level_str)->default_value(log_level_str), "Logging level. Allowed options (case sensitive): verbose, info, warning, error, fatal");
-    desc.add_options()("model_path", po::value(&model_path)->required(), "Path to ONNX model");
+    desc.add_options()("model_path", po::value(&model_path), "Path to ONNX model");
     desc.add_options()("model_name", po::value(&model_name)->default_value(model_name), "ONNX model name");
     desc.add_options()("model_version", po::value(&model_version)->default_value(model_version), "ONNX model version");
     desc.add_options()("address", po::value(&address)->default_value(address), "The base HTTP address");
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("model", po::value(&model_specs)->composing(),
+                       "Additional model to host, as name[:version]=path[?key=value&...]. Keys override the per model "
+                       "defaults below: session_pool_size, max_batch_size, max_batch_delay_us, latency_slo_ms. "
+                       "May be repeated");
+    desc.add_options()("session_pool_size", po::value(&session_pool_size)->default_value(session_pool_size), "Number of sessions per model");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Largest batch concurrent requests to a model are merged into. 1 disables batching");
+    desc.add_options()("max_batch_delay_us", po::value(&max_batch_delay_us)->default_value(max_batch_delay_us), "Longest time in microseconds a request waits for its batch to fill up");
+    desc.add_options()("latency_slo_ms", po::value(&latency_slo_ms)->default_value(latency_slo_ms), "Target request latency in milliseconds the batching delay adapts to. 0 disables it");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -93,6 +123,7 @@ class ServerConfiguration {
   po::options_description desc{"Allowed options"};
   po::variables_map vm{};
   std::string log_level_str = "info";
+  std::vector<std::string> model_specs;
 
   // Print help and return if there is a bad value
   Result ValidateOptions() {
@@ -103,12 +134,114 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
-    } else if (!file_exists(model_path)) {
+    } else if (model_path.empty() && model_specs.empty()) {
+      PrintHelp(std::cerr, "model_path or model must be given");
+      return Result::ExitFailure;
+    } else if (!model_path.empty() && !file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
     } else {
-      return Result::ContinueSuccess;
+      return BuildModels();
+    }
+  }
+
+  // Fills models from the command line, validating every model and its settings
+  Result BuildModels() {
+    ModelOptions defaults;
+    defaults.session_pool_size = session_pool_size;
+    defaults.batching.max_batch_size = max_batch_size;
+    defaults.batching.max_delay_us = max_batch_delay_us;
+    defaults.batching.latency_slo_ms = latency_slo_ms;
+
+    models.clear();
+    if (!model_path.empty()) {
+      models.push_back({model_path, model_name, model_version, defaults});
+    }
+
+    std::set<std::pair<std::string, std::string>> identifiers;
+    for (const auto& spec : model_specs) {
+      ModelConfig model{"", "", "1", defaults};
+      std::string error;
+      if (!ParseModelSpec(spec, model, error)) {
+        PrintHelp(std::cerr, "Invalid model '" + spec + "': " + error);
+        return Result::ExitFailure;
+      }
+      if (!file_exists(model.path)) {
+        PrintHelp(std::cerr, "Invalid model '" + spec + "': path must be the location of a valid file");
+        return Result::ExitFailure;
+      }
+      models.push_back(model);
+    }
+
+    for (const auto& model : models) {
+      if (!identifiers.insert({model.name, model.version}).second) {
+        PrintHelp(std::cerr, "Model " + model.name + " version " + model.version + " is given more than once");
+        return Result::ExitFailure;
+      }
+      if (model.options.session_pool_size <= 0 || model.options.batching.max_batch_size <= 0 ||
+          model.options.batching.max_delay_us < 0 || model.options.batching.latency_slo_ms < 0) {
+        PrintHelp(std::cerr, "session_pool_size and max_batch_size must be greater than 0, "
+                             "max_batch_delay_us and latency_slo_ms must not be negative");
+        return Result::ExitFailure;
+      }
+    }
+
+    return Result::ContinueSuccess;
+  }
+
+  // Parses name[:version]=path[?key=value&...] into model, which holds the defaults on entry
+  static bool ParseModelSpec(const std::string& spec, ModelConfig& model, std::string& error) {
+    const auto eq = spec.find('=');
+    if (eq == std::string::npos || eq == 0) {
+      error = "expected name[:version]=path";
+      return false;
+    }
+
+    const std::string identifier = spec.substr(0, eq);
+    const auto colon = identifier.find(':');
+    model.name = identifier.substr(0, colon);
+    if (colon != std::string::npos) {
+      model.version = identifier.substr(colon + 1);
+    }
+
+    std::string location = spec.substr(eq + 1);
+    const auto question = location.find('?');
+    model.path = location.substr(0, question);
+    if (model.name.empty() || model.version.empty() || model.path.empty()) {
+      error = "name, version and path must not be empty";
+      return false;
+    }
+    if (question == std::string::npos) {
+      return true;
+    }
+
+    std::istringstream settings(location.substr(question + 1));
+    std::string setting;
+    while (std::getline(settings, setting, '&')) {
+      const auto setting_eq = setting.find('=');
+      const std::string key = setting.substr(0, setting_eq);
+      int value = 0;
+      try {
+        value = std::stoi(setting_eq == std::string::npos ? "" : setting.substr(setting_eq + 1));
+      } catch (const std::exception&) {
+        error = "setting '" + setting + "' must have an integer value";
+        return false;
+      }
+
+      if (key == "session_pool_size") {
+        model.options.session_pool_size = value;
+      } else if (key == "max_batch_size") {
+        model.options.batching.max_batch_size = value;
+      } else if (key == "max_batch_delay_us") {
+        model.options.batching.max_delay_us = value;
+      } else if (key == "latency_slo_ms") {
+        model.options.batching.latency_slo_ms = value;
+      } else {
+        error = "unknown setting '" + key + "'";
+        return false;
+      }
     }
+    return true;
   }
 
   // Checks if program options contains help
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+static Ort::Value CreateFloatTensor(const std::vector<int64_t>& shape, const std::vector<float>& data) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  std::copy(data.begin(), data.end(), value.GetTensorMutableData<float>());
+  return value;
+}
+
+// Runs a model computing Y = X * 2, recording the dim 0 of every run.
+class DoublingModel {
+ public:
+  explicit DoublingModel(bool keep_batch_dim) : keep_batch_dim_(keep_batch_dim) {}
+
+  RequestBatcher::RunFn GetRunFn() {
+    return [this](const std::vector<std::string>&, const std::vector<Ort::Value>& input_values,
+                  const std::vector<std::string>&) {
+      auto& input = const_cast<Ort::Value&>(input_values[0]);
+      auto shape = input.GetTensorTypeAndShapeInfo().GetShape();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        run_rows_.push_back(shape[0]);
+      }
+      const float* x = input.GetTensorMutableData<float>();
+      std::vector<float> y(input.GetTensorTypeAndShapeInfo().GetElementCount());
+      for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = x[i] * 2;
+      }
+      if (!keep_batch_dim_) {
+        // flatten, so the output can't be split along dim 0 any more
+        shape = {static_cast<int64_t>(y.size())};
+      }
+      std::vector<Ort::Value> outputs;
+      outputs.push_back(CreateFloatTensor(shape, y));
+      return outputs;
+    };
+  }
+
+  std::vector<int64_t> RunRows() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return run_rows_;
+  }
+
+ private:
+  const bool keep_batch_dim_;
+  std::mutex mutex_;
+  std::vector<int64_t> run_rows_;
+};
+
+static void RunConcurrentRequests(RequestBatcher& batcher, int num_requests) {
+  std::vector<std::thread> clients;
+  std::atomic<int> failures{0};
+  for (int i = 0; i < num_requests; ++i) {
+    clients.emplace_back([&batcher, &failures, i]() {
+      const std::vector<std::string> input_names{"X"};
+      const std::vector<std::string> output_names{"Y"};
+      std::vector<Ort::Value> input_values;
+      input_values.push_back(CreateFloatTensor({1, 2}, {static_cast<float>(i), static_cast<float>(i + 1)}));
+      ASSERT_TRUE(RequestBatcher::CanBatch(input_values));
+
+      auto outputs = batcher.Run(input_names, input_values, output_names);
+      const float* y = outputs[0].GetTensorMutableData<float>();
+      if (outputs[0].GetTensorTypeAndShapeInfo().GetElementCount() != 2 || y[0] != 2.f * i || y[1] != 2.f * (i + 1)) {
+        ++failures;
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  EXPECT_EQ(failures.load(), 0);
+}
+
+TEST(RequestBatcherTest, MergesConcurrentRequests) {
+  DoublingModel model(true);
+  BatchingOptions options;
+  options.max_batch_size = 4;
+  // long enough for all the requests to arrive, the batch runs as soon as it is full
+  options.max_delay_us = 10 * 1000 * 1000;
+  {
+    RequestBatcher batcher(options, 1, model.GetRunFn());
+    RunConcurrentRequests(batcher, 4);
+  }
+  EXPECT_EQ(model.RunRows(), std::vector<int64_t>{4});
+}
+
+TEST(RequestBatcherTest, RunsRequestsOnTheirOwnIfOutputsCannotBeSplit) {
+  DoublingModel model(false);
+  BatchingOptions options;
+  options.max_batch_size = 2;
+  options.max_delay_us = 10 * 1000 * 1000;
+  {
+    RequestBatcher batcher(options, 1, model.GetRunFn());
+    RunConcurrentRequests(batcher, 2);
+  }
+  EXPECT_EQ(model.RunRows(), (std::vector<int64_t>{2, 1, 1}));
+}
+
+TEST(RequestBatcherTest, RunsRequestsOnTheirOwnIfMergedRunThrows) {
+  DoublingModel model(true);
+  auto run = model.GetRunFn();
+  // a merged run fails with an exception that is not an Ort::Exception
+  auto throwing_run = [&run](const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values,
+                             const std::vector<std::string>& output_names) {
+    auto& input = const_cast<Ort::Value&>(input_values[0]);
+    if (input.GetTensorTypeAndShapeInfo().GetShape()[0] > 1) {
+      throw std::runtime_error("batch too large");
+    }
+    return run(input_names, input_values, output_names);
+  };
+
+  BatchingOptions options;
+  options.max_batch_size = 2;
+  options.max_delay_us = 10 * 1000 * 1000;
+  {
+    RequestBatcher batcher(options, 1, throwing_run);
+    RunConcurrentRequests(batcher, 2);
+  }
+  EXPECT_EQ(model.RunRows(), (std::vector<int64_t>{1, 1}));
+}
+
+TEST(RequestBatcherTest, CanBatch) {
+  std::vector<Ort::Value> input_values;
+  input_values.push_back(CreateFloatTensor({2, 1}, {1.f, 2.f}));
+  EXPECT_TRUE(RequestBatcher::CanBatch(input_values));
+
+  // inputs with different dim 0
+  input_values.push_back(CreateFloatTensor({1, 2}, {1.f, 2.f}));
+  EXPECT_FALSE(RequestBatcher::CanBatch(input_values));
+
+  // scalar input
+  input_values.clear();
+  input_values.push_back(CreateFloatTensor({}, {1.f}));
+  EXPECT_FALSE(RequestBatcher::CanBatch(input_values));
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 
 #include "executor.h"
 #include "http/json_handling.h"
+#include "serializing/tensor_stream.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -52,6 +53,137 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1_RawData) {
+  // rawData is the base64 encoding of the float array [1,2,3,4,5,6], which is used in place by the executor.
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"rawData":"AACAPwAAAEAAAEBAAACAQAAAoEAAAMBA"}},"outputFilter":["Y"]})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  EXPECT_TRUE(protostatus.ok());
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  EXPECT_TRUE(prediction_res.ok());
+
+  const auto& output = response.outputs().at("Y");
+  ASSERT_EQ(output.raw_data().size(), 6 * sizeof(float));
+  const float* values = reinterpret_cast<const float*>(output.raw_data().data());
+  const float expected[] = {1, 4, 9, 16, 25, 36};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(expected[i], values[i]);
+  }
+}
+
+template <typename T>
+static void AppendToStream(std::string& stream, const T& value) {
+  stream.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void AppendToStream(std::string& stream, const std::string& name) {
+  AppendToStream(stream, static_cast<uint32_t>(name.size()));
+  stream += name;
+}
+
+// Builds a tensor stream with the given output filter and the float input X = [[1,2],[3,4],[5,6]].
+static std::string MakeMul1TensorStream(size_t offset, const std::vector<std::string>& output_filter) {
+  std::string stream(offset, '\0');
+  AppendToStream(stream, static_cast<uint32_t>(output_filter.size()));
+  for (const auto& output : output_filter) {
+    AppendToStream(stream, output);
+  }
+  AppendToStream(stream, std::string{"X"});
+  AppendToStream(stream, int32_t{onnx::TensorProto_DataType_FLOAT});
+  AppendToStream(stream, uint32_t{2});
+  AppendToStream(stream, int64_t{3});
+  AppendToStream(stream, int64_t{2});
+  AppendToStream(stream, uint64_t{6 * sizeof(float)});
+  for (float v : {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}) {
+    AppendToStream(stream, v);
+  }
+  return stream;
+}
+
+TEST_F(ExecutorTest, TestMul_1_TensorStream) {
+  // The tensor data starts 46 bytes into the stream. Two leading bytes align it so it is used in place,
+  // without them it is misaligned and gets copied.
+  for (size_t offset : {size_t{2}, size_t{0}}) {
+    std::string stream = MakeMul1TensorStream(offset, {"Y"});
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    MemBufferArray buffers;
+    std::vector<std::string> output_filter;
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    DecodeTensorStream(stream.data() + offset, stream.size() - offset, *memory_info, buffers, output_filter,
+                       input_names, input_values);
+    ASSERT_EQ(output_filter, std::vector<std::string>{"Y"});
+    ASSERT_EQ(input_names, std::vector<std::string>{"X"});
+
+    onnxruntime::server::Executor executor(env, "RequestId");
+    onnxruntime::server::PredictResponse response{};
+    auto prediction_res = executor.Predict("Name", "version", input_names, input_values, output_filter, response);
+    EXPECT_TRUE(prediction_res.ok());
+
+    const auto& output = response.outputs().at("Y");
+    ASSERT_EQ(output.raw_data().size(), 6 * sizeof(float));
+    const float* values = reinterpret_cast<const float*>(output.raw_data().data());
+    const float expected[] = {1, 4, 9, 16, 25, 36};
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_EQ(expected[i], values[i]);
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestMul_1_TensorStreamOutputFilter) {
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  // An empty filter requests all the model outputs, an unknown output name fails the run like it does for
+  // the protobuf and JSON requests.
+  for (const auto& filter : {std::vector<std::string>{}, std::vector<std::string>{"Z"}}) {
+    std::string stream = MakeMul1TensorStream(0, filter);
+
+    MemBufferArray buffers;
+    std::vector<std::string> output_filter;
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    DecodeTensorStream(stream.data(), stream.size(), *memory_info, buffers, output_filter, input_names, input_values);
+    ASSERT_EQ(output_filter, filter);
+
+    onnxruntime::server::Executor executor(env, "RequestId");
+    onnxruntime::server::PredictResponse response{};
+    auto prediction_res = executor.Predict("Name", "version", input_names, input_values, output_filter, response);
+    if (filter.empty()) {
+      EXPECT_TRUE(prediction_res.ok());
+      EXPECT_EQ(response.outputs().size(), 1u);
+      EXPECT_EQ(response.outputs().count("Y"), 1u);
+    } else {
+      EXPECT_FALSE(prediction_res.ok());
+    }
+  }
+}
+
+TEST(TensorStreamTest, TruncatedPayload) {
+  std::string stream;
+  AppendToStream(stream, uint32_t{0});
+  AppendToStream(stream, uint32_t{8});
+  stream += "X";
+
+  Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  MemBufferArray buffers;
+  std::vector<std::string> output_filter;
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> input_values;
+  EXPECT_THROW(DecodeTensorStream(stream.data(), stream.size(), *memory_info, buffers, output_filter, input_names,
+                                  input_values),
+               Ort::Exception);
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
@@ -51,6 +51,42 @@ TEST(ConfigParsingTests, Defaults) {
   EXPECT_EQ(config.logging_level, ORT_LOGGING_LEVEL_INFO);
 }
 
+TEST(ConfigParsingTests, MultipleModels) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("4"),
+      const_cast<char*>("--model"), const_cast<char*>("mul:2=testdata/mul_1.onnx?max_batch_size=8&latency_slo_ms=20"),
+      const_cast<char*>("--model"), const_cast<char*>("other=testdata/mul_1.onnx?session_pool_size=2")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(9, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  ASSERT_EQ(config.models.size(), 3u);
+  EXPECT_EQ(config.models[0].name, "default");
+  EXPECT_EQ(config.models[0].options.batching.max_batch_size, 4);
+  EXPECT_EQ(config.models[1].name, "mul");
+  EXPECT_EQ(config.models[1].version, "2");
+  EXPECT_EQ(config.models[1].path, "testdata/mul_1.onnx");
+  EXPECT_EQ(config.models[1].options.batching.max_batch_size, 8);
+  EXPECT_EQ(config.models[1].options.batching.latency_slo_ms, 20);
+  EXPECT_EQ(config.models[1].options.session_pool_size, 1);
+  EXPECT_EQ(config.models[2].name, "other");
+  EXPECT_EQ(config.models[2].version, "1");
+  EXPECT_EQ(config.models[2].options.session_pool_size, 2);
+  EXPECT_EQ(config.models[2].options.batching.max_batch_size, 4);
+}
+
+TEST(ConfigParsingTests, InvalidModelSpec) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model"), const_cast<char*>("mul=testdata/mul_1.onnx?max_batch=8")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(3, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
+}
+
 TEST(ConfigParsingTests, Help) {
   char* test_argv[] = {
       const_cast<char*>("/path/to/binary"),